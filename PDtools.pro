@@ -1,15 +1,18 @@
 cache()
 
 TEMPLATE = subdirs
-SUBDIRS = src
-#tests benchmarks
-#tests.depends = src
+SUBDIRS = src benchmarks tests
+tests.depends = src
 CONFIG += ordered
 
 src.subdirs = pd_lib
 test.depends = pd_lib
-#benchmarks.depends = pd_lib
+benchmarks.depends = src
 
 OTHER_FILES += \
     defaults.pri
 
+perfcheck.commands = cd benchmarks && $(MAKE) perfcheck
+perfcheck.depends = sub-benchmarks
+QMAKE_EXTRA_TARGETS += perfcheck
+
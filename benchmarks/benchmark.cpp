@@ -0,0 +1,172 @@
+#include "benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <numeric>
+
+#ifdef USE_MPI
+#include <mpi.h>
+#endif
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif
+
+namespace PDtools {
+//------------------------------------------------------------------------------
+string jsonString(const string &value) {
+  string escaped = "\"";
+  for (const char c : value) {
+    if (c == '"' || c == '\\')
+      escaped += '\\';
+    escaped += c;
+  }
+  return escaped + "\"";
+}
+//------------------------------------------------------------------------------
+Benchmark::Benchmark(const int nRepeats, const int nWarmup, const int myRank,
+                     const int nCores)
+    : m_nRepeats(std::max(nRepeats, 1)), m_nWarmup(nWarmup), m_myRank(myRank),
+      m_nCores(nCores) {}
+//------------------------------------------------------------------------------
+void Benchmark::setFilter(const vector<string> &filter) { m_filter = filter; }
+//------------------------------------------------------------------------------
+bool Benchmark::selected(const string &name) const {
+  if (m_filter.empty())
+    return true;
+
+  for (const string &pattern : m_filter) {
+    if (name.find(pattern) != string::npos)
+      return true;
+  }
+  return false;
+}
+//------------------------------------------------------------------------------
+void Benchmark::run(const string &name, const string &geometry,
+                    const unsigned int nParticles, const size_t nBonds,
+                    const std::function<void()> &f,
+                    const std::function<void()> &setup) {
+  if (!selected(name))
+    return;
+
+  arma::wall_clock timer;
+  vector<double> times;
+
+  for (int r = 0; r < m_nWarmup + m_nRepeats; r++) {
+    if (setup)
+      setup();
+#if USE_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+    timer.tic();
+    f();
+    const double t = timer.toc();
+
+    if (r >= m_nWarmup)
+      times.push_back(t);
+  }
+
+#if USE_MPI
+  vector<double> localTimes = times;
+  MPI_Allreduce(localTimes.data(), times.data(), m_nRepeats, MPI_DOUBLE,
+                MPI_MAX, MPI_COMM_WORLD);
+#endif
+
+  BenchmarkResult result;
+  result.name = name;
+  result.geometry = geometry;
+  result.nParticles = nParticles;
+  result.nBonds = nBonds;
+  result.times = times;
+
+  std::sort(times.begin(), times.end());
+  const int n = times.size();
+  result.t_min = times.front();
+  result.t_max = times.back();
+  result.t_median = n % 2 ? times[n / 2]
+                          : 0.5 * (times[n / 2 - 1] + times[n / 2]);
+  result.t_mean = std::accumulate(times.begin(), times.end(), 0.) / n;
+
+  vector<double> deviations;
+  for (const double t : times) {
+    deviations.push_back(std::fabs(t - result.t_median));
+  }
+  std::sort(deviations.begin(), deviations.end());
+  result.t_mad = n % 2 ? deviations[n / 2]
+                       : 0.5 * (deviations[n / 2 - 1] + deviations[n / 2]);
+
+  const double t = std::max(result.t_median, 1e-12);
+  result.particlesPerSecond = nParticles / t;
+  result.bondsPerSecond = nBonds / t;
+
+  m_results.push_back(result);
+  printResult(result);
+}
+//------------------------------------------------------------------------------
+void Benchmark::printResult(const BenchmarkResult &result) const {
+  if (m_myRank != 0)
+    return;
+
+  char line[256];
+  snprintf(line, sizeof(line), "%-40s %-22s %12.6f s %12.4e particles/s "
+                               "%12.4e bonds/s",
+           result.name.c_str(), result.geometry.c_str(), result.t_median,
+           result.particlesPerSecond, result.bondsPerSecond);
+  cout << line << endl;
+}
+//------------------------------------------------------------------------------
+void Benchmark::writeJson(const string &path) const {
+  if (m_myRank != 0)
+    return;
+
+  std::ofstream out(path);
+  if (!out) {
+    cerr << "ERROR: could not open " << path << endl;
+    return;
+  }
+
+  out << std::setprecision(10);
+  out << "{\n";
+  out << "  \"nRanks\": " << m_nCores << ",\n";
+  out << "  \"nThreads\": " << nThreads() << ",\n";
+  out << "  \"nRepeats\": " << m_nRepeats << ",\n";
+  out << "  \"nWarmup\": " << m_nWarmup << ",\n";
+  out << "  \"benchmarks\": [";
+
+  for (unsigned int k = 0; k < m_results.size(); k++) {
+    const BenchmarkResult &result = m_results[k];
+    out << (k > 0 ? ",\n" : "\n");
+    out << "    {\n";
+    out << "      \"name\": " << jsonString(result.name) << ",\n";
+    out << "      \"geometry\": " << jsonString(result.geometry) << ",\n";
+    out << "      \"nParticles\": " << result.nParticles << ",\n";
+    out << "      \"nBonds\": " << result.nBonds << ",\n";
+    out << "      \"t_min\": " << result.t_min << ",\n";
+    out << "      \"t_median\": " << result.t_median << ",\n";
+    out << "      \"t_mad\": " << result.t_mad << ",\n";
+    out << "      \"t_mean\": " << result.t_mean << ",\n";
+    out << "      \"t_max\": " << result.t_max << ",\n";
+    out << "      \"particlesPerSecond\": " << result.particlesPerSecond
+        << ",\n";
+    out << "      \"bondsPerSecond\": " << result.bondsPerSecond << ",\n";
+    out << "      \"times\": [";
+    for (unsigned int r = 0; r < result.times.size(); r++) {
+      out << (r > 0 ? ", " : "") << result.times[r];
+    }
+    out << "]\n";
+    out << "    }";
+  }
+  out << "\n  ]\n}\n";
+}
+//------------------------------------------------------------------------------
+int Benchmark::nThreads() {
+#ifdef USE_OPENMP
+  return omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
+//------------------------------------------------------------------------------
+}
@@ -0,0 +1,74 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "config.h"
+
+#include <functional>
+
+namespace PDtools {
+//------------------------------------------------------------------------------
+// The timing of one case on one geometry. The time of a repetition is the
+// slowest rank's, the throughputs are computed from the median. The median
+// absolute deviation of the times is the noise of the case, robust to the
+// odd slow repetition.
+struct BenchmarkResult {
+  string name;
+  string geometry;
+  unsigned int nParticles;
+  size_t nBonds;
+  vector<double> times;
+  double t_min;
+  double t_median;
+  double t_mad;
+  double t_mean;
+  double t_max;
+  double particlesPerSecond;
+  double bondsPerSecond;
+};
+
+//------------------------------------------------------------------------------
+// Runs the timed cases and writes the results as JSON.
+//
+// A case is run nWarmup times untimed and then nRepeats times timed. The
+// optional setup is called before every run, outside of the timing, to
+// restore the state the case changes. The ranks are synchronized before
+// every run. Cases are selected by substrings of their names.
+//------------------------------------------------------------------------------
+class Benchmark {
+public:
+  Benchmark(const int nRepeats, const int nWarmup, const int myRank,
+            const int nCores);
+
+  void setFilter(const vector<string> &filter);
+  bool selected(const string &name) const;
+
+  void run(const string &name, const string &geometry,
+           const unsigned int nParticles, const size_t nBonds,
+           const std::function<void()> &f,
+           const std::function<void()> &setup = nullptr);
+
+  const vector<BenchmarkResult> &results() const;
+  void printResult(const BenchmarkResult &result) const;
+  void writeJson(const string &path) const;
+
+  static int nThreads();
+
+protected:
+  const int m_nRepeats;
+  const int m_nWarmup;
+  const int m_myRank;
+  const int m_nCores;
+  vector<string> m_filter;
+  vector<BenchmarkResult> m_results;
+};
+//------------------------------------------------------------------------------
+// The value quoted and escaped as a JSON string
+string jsonString(const string &value);
+//------------------------------------------------------------------------------
+// Inline functions
+inline const vector<BenchmarkResult> &Benchmark::results() const {
+  return m_results;
+}
+//------------------------------------------------------------------------------
+}
+#endif // BENCHMARK_H
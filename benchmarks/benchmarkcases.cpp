@@ -0,0 +1,259 @@
+#include "benchmarkcases.h"
+#include "benchmark.h"
+#include "pdfixture.h"
+
+#include <PDtools/CalculateProperties/calculateproperties.h>
+#include <PDtools/Force/forces.h>
+#include <PDtools/Modfiers/modifiers.h>
+#include <PDtools/PdFunctions/pdfunctions.h>
+#include <PDtools/Solver/adr.h>
+
+#include <cstdio>
+
+namespace PDtools {
+//------------------------------------------------------------------------------
+namespace {
+// An ADR solver on the forces of a fixture, which owns them
+class BenchmarkADR : public ADR {
+public:
+  ~BenchmarkADR() { m_oneBodyForces.clear(); }
+
+  // As the start of ADR::solve()
+  void restart() {
+    m_particles->buildBondCache();
+    initialize();
+  }
+};
+}
+//------------------------------------------------------------------------------
+void runConnectionCases(Benchmark &benchmark, PdFixture &fixture) {
+  PD_Particles &particles = fixture.particles();
+  Grid &grid = fixture.grid();
+  const double delta = fixture.delta();
+  const double lc = fixture.lc();
+
+  // The bonds are counted from a first, untimed, call
+  setPdConnections(particles, grid, delta, lc);
+  const size_t nBonds = fixture.nBonds();
+
+  benchmark.run("connections/setPdConnections", fixture.name(),
+                fixture.nParticles(), nBonds,
+                [&]() { setPdConnections(particles, grid, delta, lc); });
+}
+//------------------------------------------------------------------------------
+void runGridCases(Benchmark &benchmark, PdFixture &fixture) {
+  PD_Particles &particles = fixture.particles();
+  Grid &grid = fixture.grid();
+  const size_t nBonds = fixture.nBonds();
+  const unsigned int nParticles = fixture.nParticles();
+
+  benchmark.run("grid/updateGrid", fixture.name(), nParticles, nBonds, [&]() {
+    grid.clearParticles();
+    updateGrid(grid, particles);
+  });
+
+  // As Solver::updateGhosts()
+  benchmark.run("grid/ghostExchange", fixture.name(), nParticles, nBonds,
+                [&]() {
+                  grid.clearGhostParticles();
+                  exchangeGhostParticles(grid, particles);
+#if USE_MPI
+                  particles.updateNeighbourColumns();
+#endif
+                });
+
+  particles.registerVerletList("benchmark");
+  const double radius = fixture.delta();
+  benchmark.run("grid/updateVerletList", fixture.name(), nParticles, nBonds,
+                [&]() {
+                  updateVerletList("benchmark", particles, grid, radius);
+                });
+}
+//------------------------------------------------------------------------------
+void runForceCases(Benchmark &benchmark, PdFixture &fixture) {
+  PD_Particles &particles = fixture.particles();
+  const ivec &colToId = particles.colToId();
+  const size_t nBonds = fixture.nBonds();
+  const unsigned int nParticles = fixture.nParticles();
+
+  for (Force *force : fixture.forces()) {
+    benchmark.run("force/" + force->name, fixture.name(), nParticles, nBonds,
+                  [&]() {
+                    const int nLocal = particles.nParticles();
+                    for (int i = 0; i < nLocal; i++) {
+                      force->calculateForces(colToId(i), i);
+                    }
+                  },
+                  [&]() { fixture.zeroForces(); });
+
+    if (!force->getHasUpdateState())
+      continue;
+
+    // In the order of Solver::updateForceStates(), without the ghost
+    // exchanges, which are timed separately
+    const bool localState = force->getHasLocalUpdateState();
+    benchmark.run("updateState/" + force->name, fixture.name(), nParticles,
+                  nBonds, [&]() {
+                    const int nLocal = particles.nParticles();
+                    if (!localState)
+                      force->updateState();
+                    for (int i = 0; i < nLocal; i++) {
+                      force->updateState(colToId(i), i);
+                    }
+                    if (localState)
+                      force->updateState();
+                  });
+  }
+}
+//------------------------------------------------------------------------------
+void runFractureCases(Benchmark &benchmark, PdFixture &fixture) {
+  // As Solver::modifiersStepOne() and Solver::modifiersStepTwo() for a
+  // single criterion. The criteria never break a bond, every run does the
+  // same work.
+  PD_Particles &particles = fixture.particles();
+  const ivec &colToId = particles.colToId();
+  const size_t nBonds = fixture.nBonds();
+  const unsigned int nParticles = fixture.nParticles();
+
+  for (const auto &criterion : fixture.fractureCriteria()) {
+    Modifier *modifier = criterion.second;
+    benchmark.run("fracture/" + criterion.first, fixture.name(), nParticles,
+                  nBonds, [&]() {
+                    const int nLocal = particles.nParticles();
+                    modifier->evaluateStepOne();
+                    if (modifier->hasStepOne()) {
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+                      for (int i = 0; i < nLocal; i++) {
+                        modifier->evaluateStepOne(colToId(i), i);
+                      }
+                    }
+                    if (modifier->hasUpdateOne()) {
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+                      for (int i = 0; i < nLocal; i++) {
+                        modifier->updateStepOne(colToId(i), i);
+                      }
+                    }
+                    modifier->evaluateStepOnePost();
+                    if (modifier->hasStepTwo()) {
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+                      for (int i = 0; i < nLocal; i++) {
+                        modifier->evaluateStepTwo(colToId(i), i);
+                      }
+                    }
+                    particles.publishBondBreaks();
+                  });
+  }
+}
+//------------------------------------------------------------------------------
+void runPropertyCases(Benchmark &benchmark, PdFixture &fixture) {
+  const size_t nBonds = fixture.nBonds();
+  const unsigned int nParticles = fixture.nParticles();
+
+  for (const auto &property : fixture.properties()) {
+    CalculateProperty *calculateProperty = property.second;
+    benchmark.run("property/" + property.first, fixture.name(), nParticles,
+                  nBonds, [&]() {
+                    calculateProperty->clean();
+                    calculateProperty->update();
+                  });
+  }
+}
+//------------------------------------------------------------------------------
+void runAdrCases(Benchmark &benchmark, PdFixture &fixture,
+                 const int nIterations) {
+  // A fixed number of ADR iterations with the bond force, from the strained
+  // state of the fixture. The error threshold is never reached, every run
+  // does the same work.
+  if (!benchmark.selected("adr/iterate"))
+    return;
+
+  PD_Particles &particles = fixture.particles();
+  Grid &grid = fixture.grid();
+  const size_t nBonds = fixture.nBonds();
+  const unsigned int nParticles = fixture.nParticles();
+
+  Force *bondForce = nullptr;
+  for (Force *force : fixture.forces()) {
+    if (dynamic_cast<PD_bondForce *>(force) != nullptr) {
+      bondForce = force;
+      break;
+    }
+  }
+  if (bondForce == nullptr)
+    return;
+
+  BenchmarkADR adr;
+  adr.setParticles(particles);
+  adr.setMainGrid(grid);
+  adr.setDim(fixture.dim());
+  adr.setRankAndCores(grid.myRank(), grid.nCores());
+  adr.setErrorThreshold(0);
+  adr.addForce(bondForce);
+
+  // The iterations move the particles, they are restored by id
+  const int nLocal = particles.nParticles();
+  const ivec &colToId = particles.colToId();
+  const mat &r = particles.r();
+  vector<int> ids(nLocal);
+  mat r_start(nLocal, M_DIM);
+  for (int i = 0; i < nLocal; i++) {
+    ids[i] = colToId(i);
+    for (int d = 0; d < M_DIM; d++) {
+      r_start(i, d) = r(i, d);
+    }
+  }
+
+  benchmark.run("adr/iterate", fixture.name(), nParticles, nBonds,
+                [&]() { adr.iterate(nIterations); },
+                [&]() {
+                  const IdToColMap &idToCol = particles.getIdToCol_v();
+                  mat &R = particles.r();
+                  for (int k = 0; k < nLocal; k++) {
+                    const int col = idToCol[ids[k]];
+                    if (col < 0)
+                      continue;
+                    for (int d = 0; d < M_DIM; d++) {
+                      R(col, d) = r_start(k, d);
+                    }
+                  }
+                  adr.restart();
+                });
+}
+//------------------------------------------------------------------------------
+void runIoCases(Benchmark &benchmark, PdFixture &fixture,
+                const string &ioPath) {
+  PD_Particles &particles = fixture.particles();
+  const size_t nBonds = fixture.nBonds();
+  const unsigned int nParticles = fixture.nParticles();
+  Grid &grid = fixture.grid();
+
+  vector<pair<string, double>> saveParameters = {
+      {"id", 1}, {"x", 1}, {"y", 1}, {"z", 1}, {"volume", 1}};
+  SaveParticles saveParticles("xyz", saveParameters);
+  saveParticles.setRankAndCores(grid.myRank(), grid.nCores());
+  saveParticles.setGrid(&grid);
+
+  benchmark.run("io/SaveParticles", fixture.name(), nParticles, nBonds,
+                [&]() { saveParticles.writeToFile(particles, ioPath); });
+
+  // The file written by several ranks is split in one file per rank
+  if (grid.nCores() == 1) {
+    benchmark.run("io/LoadPdParticles", fixture.name(), nParticles, nBonds,
+                  [&]() {
+                    PD_Particles loaded = load_pd(ioPath);
+                    (void)loaded;
+                  });
+  }
+
+  const string rankPath =
+      grid.myRank() == 0 ? ioPath : ioPath + std::to_string(grid.myRank());
+  std::remove(rankPath.c_str());
+}
+//------------------------------------------------------------------------------
+}
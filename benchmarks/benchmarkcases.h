@@ -0,0 +1,24 @@
+#ifndef BENCHMARKCASES_H
+#define BENCHMARKCASES_H
+
+#include "config.h"
+
+namespace PDtools {
+class Benchmark;
+class PdFixture;
+
+//------------------------------------------------------------------------------
+// The benchmark cases, named "<group>/<case>". The connection cases run on a
+// fixture after its first setup stage, the others after connect().
+//------------------------------------------------------------------------------
+void runConnectionCases(Benchmark &benchmark, PdFixture &fixture);
+void runGridCases(Benchmark &benchmark, PdFixture &fixture);
+void runForceCases(Benchmark &benchmark, PdFixture &fixture);
+void runFractureCases(Benchmark &benchmark, PdFixture &fixture);
+void runPropertyCases(Benchmark &benchmark, PdFixture &fixture);
+void runAdrCases(Benchmark &benchmark, PdFixture &fixture,
+                 const int nIterations);
+void runIoCases(Benchmark &benchmark, PdFixture &fixture,
+                const string &ioPath);
+}
+#endif // BENCHMARKCASES_H
@@ -1,5 +1,5 @@
 TEMPLATE  = app
-TARGET 	  = tests
+TARGET 	  = benchmarks
 CONFIG   += console
 CONFIG   -= app_bundle
 CONFIG   -= qt
@@ -8,11 +8,34 @@ CONFIG   += thread
 include(../defaults.pri)
 
 LIBS += $$TOP_OUT_PWD/src/PDtools/libPDtools.a
-LIBS += -lgtest
+DEFINES += RESOURCES_PATH=\\\"$$PWD/../resources\\\"
 
 SOURCES += \
     main.cpp \
-#    armadillo/testarmadillo.cpp
+    benchmark.cpp \
+    benchmarkcases.cpp \
+    pdfixture.cpp \
+    perfcheck.cpp
 
 HEADERS += \
-    test_resources.h
+    test_resources.h \
+    benchmark.h \
+    benchmarkcases.h \
+    pdfixture.h \
+    perfcheck.h
+
+OTHER_FILES += \
+    baseline/perfcheck.json
+
+# make perfcheck: fails if a case of the performance check regressed against
+# the baseline or is not in it, and is skipped while the baseline has no
+# cases. make perfcheck-baseline records the baseline on this system, keeping
+# the tolerances of the cases already in it.
+perfcheck.commands = ./$$TARGET --perfcheck $$PWD/baseline/perfcheck.json \
+                     -o perfcheck.json
+perfcheck.depends = $$TARGET
+perfcheck-baseline.commands = ./$$TARGET --perfcheck \
+                              $$PWD/baseline/perfcheck.json \
+                              --update-baseline -o perfcheck.json
+perfcheck-baseline.depends = $$TARGET
+QMAKE_EXTRA_TARGETS += perfcheck perfcheck-baseline
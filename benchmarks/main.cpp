@@ -1,19 +1,221 @@
-#include <vector>
-#include <armadillo>
-#include <stdio.h>
-//#include "test_resources.h"
-#include <ctime>
-//#include <gtest/gtest.h>
+#ifdef USE_MPI
+#include <mpi.h>
+#endif
+
+#include "benchmark.h"
+#include "benchmarkcases.h"
+#include "pdfixture.h"
+#include "perfcheck.h"
+#include "test_resources.h"
+
 #include <PDtools.h>
 
-using namespace std;
+#include <cstdlib>
+
+//------------------------------------------------------------------------------
+// Benchmarks of the hot paths: the force kernels, the neighbour and grid
+// updates, the ghost exchange, the fracture criteria, the properties and the
+// particle I/O. Every case is timed on every geometry and lattice, and the
+// results are written as JSON with the particles and bonds per second.
+//
+// With --perfcheck, a fixed subset of the cases, the force kernels, the
+// neighbour build and the ADR iterations, is run on the plate with a hole
+// and compared to a baseline, with the tolerance of each case recorded in it.
+// The exit status is 2 if a case regressed or is not in the baseline, and 1
+// if the baseline was recorded with other numbers of ranks or threads. Without
+// a recorded baseline the check is reported as skipped and passes.
+//------------------------------------------------------------------------------
+namespace {
+void printUsage() {
+  cerr << "usage: benchmarks [options]" << endl
+       << "  -g, --geometry <path>  geometry file, may be repeated" << endl
+       << "  -l, --lattice <n>      lattice of n particles per side, may be "
+          "repeated"
+       << endl
+       << "  -d, --dim <2|3>        dimension of the lattices (3)" << endl
+       << "  -m, --horizon <m>      the horizon delta/lc (3)" << endl
+       << "  -r, --repeats <n>      timed runs of each case (5, 11 with "
+          "--perfcheck)"
+       << endl
+       << "  -w, --warmup <n>       untimed runs of each case (1, 2 with "
+          "--perfcheck)"
+       << endl
+       << "  -i, --iterations <n>   ADR iterations of each adr/iterate run "
+          "(100)"
+       << endl
+       << "  -f, --filter <name>    only the cases whose name contains "
+          "<name>, may be repeated"
+       << endl
+       << "  -o, --output <path>    the JSON results (benchmarks.json)" << endl
+       << "  --io-path <path>       scratch file of the I/O cases "
+          "(benchmark_io.xyz)"
+       << endl
+       << "  --perfcheck <path>     compare the performance check to the "
+          "baseline <path>"
+       << endl
+       << "  --update-baseline      write the performance check as the "
+          "baseline"
+       << endl
+       << "  -t, --tolerance <x>    the smallest regression of the cases "
+          "without a tolerance in the baseline (0.1)"
+       << endl
+       << "Without geometries and lattices, the geometries in "
+       << RESOURCES_PATH << " and a 20^3 lattice are benchmarked." << endl;
+}
+}
+//------------------------------------------------------------------------------
+int main(int argc, char **argv) {
+  using namespace PDtools;
+
+#ifdef USE_MPI
+  MPI::Init(argc, argv);
+  const int myRank = MPI::COMM_WORLD.Get_rank();
+  const int nCores = MPI::COMM_WORLD.Get_size();
+#else
+  const int myRank = 0;
+  const int nCores = 1;
+#endif
+
+  vector<string> geometryPaths;
+  vector<int> lattices;
+  vector<string> filter;
+  int dim = 3;
+  double horizonFactor = 3;
+  int nRepeats = -1;
+  int nWarmup = -1;
+  int nIterations = 100;
+  string baselinePath;
+  bool updateBaseline = false;
+  double tolerance = 0.1;
+  string outputPath = "benchmarks.json";
+  string ioPath = "benchmark_io.xyz";
+
+  for (int a = 1; a < argc; a++) {
+    const string arg = argv[a];
+    const bool hasValue = a + 1 < argc;
+
+    if ((arg == "-g" || arg == "--geometry") && hasValue) {
+      geometryPaths.push_back(argv[++a]);
+    } else if ((arg == "-l" || arg == "--lattice") && hasValue) {
+      lattices.push_back(atoi(argv[++a]));
+    } else if ((arg == "-d" || arg == "--dim") && hasValue) {
+      dim = atoi(argv[++a]);
+    } else if ((arg == "-m" || arg == "--horizon") && hasValue) {
+      horizonFactor = atof(argv[++a]);
+    } else if ((arg == "-r" || arg == "--repeats") && hasValue) {
+      nRepeats = atoi(argv[++a]);
+    } else if ((arg == "-w" || arg == "--warmup") && hasValue) {
+      nWarmup = atoi(argv[++a]);
+    } else if ((arg == "-i" || arg == "--iterations") && hasValue) {
+      nIterations = atoi(argv[++a]);
+    } else if ((arg == "-f" || arg == "--filter") && hasValue) {
+      filter.push_back(argv[++a]);
+    } else if ((arg == "-o" || arg == "--output") && hasValue) {
+      outputPath = argv[++a];
+    } else if (arg == "--io-path" && hasValue) {
+      ioPath = argv[++a];
+    } else if (arg == "--perfcheck" && hasValue) {
+      baselinePath = argv[++a];
+    } else if (arg == "--update-baseline") {
+      updateBaseline = true;
+    } else if ((arg == "-t" || arg == "--tolerance") && hasValue) {
+      tolerance = atof(argv[++a]);
+    } else {
+      if (myRank == 0)
+        printUsage();
+#ifdef USE_MPI
+      MPI::Finalize();
+#endif
+      return arg == "-h" || arg == "--help" ? 0 : 1;
+    }
+  }
+
+  if (dim != 2 && dim != 3) {
+    if (myRank == 0)
+      cerr << "ERROR: the lattice dimension must be 2 or 3" << endl;
+#ifdef USE_MPI
+    MPI::Finalize();
+#endif
+    return 1;
+  }
+
+  const bool perfCheckMode = !baselinePath.empty();
+  if (updateBaseline && !perfCheckMode) {
+    if (myRank == 0)
+      cerr << "ERROR: --update-baseline needs --perfcheck <path>" << endl;
+#ifdef USE_MPI
+    MPI::Finalize();
+#endif
+    return 1;
+  }
+
+  if (perfCheckMode) {
+    // The timings are only comparable on the same system and cases
+    geometryPaths = {perfCheckGeometry};
+    lattices.clear();
+    if (filter.empty())
+      filter = perfCheckCases;
+    nRepeats = nRepeats < 0 ? 11 : nRepeats;
+    nWarmup = nWarmup < 0 ? 2 : nWarmup;
+  } else if (geometryPaths.empty() && lattices.empty()) {
+    geometryPaths = geometries;
+    lattices.push_back(20);
+  }
+  nRepeats = nRepeats < 0 ? 5 : nRepeats;
+  nWarmup = nWarmup < 0 ? 1 : nWarmup;
+
+  Benchmark benchmark(nRepeats, nWarmup, myRank, nCores);
+  benchmark.setFilter(filter);
+
+  auto runAll = [&](PdFixture &fixture) {
+    runConnectionCases(benchmark, fixture);
+    fixture.connect();
+    runGridCases(benchmark, fixture);
+    runForceCases(benchmark, fixture);
+    runFractureCases(benchmark, fixture);
+    runPropertyCases(benchmark, fixture);
+    runAdrCases(benchmark, fixture, nIterations);
+    runIoCases(benchmark, fixture, ioPath);
+  };
+
+  for (const string &path : geometryPaths) {
+    PdFixture fixture(myRank, nCores);
+    fixture.loadGeometry(path, horizonFactor);
+    runAll(fixture);
+  }
+
+  for (const int nPerSide : lattices) {
+    PdFixture fixture(myRank, nCores);
+    fixture.createLattice(nPerSide, dim, horizonFactor);
+    runAll(fixture);
+  }
+
+  benchmark.writeJson(outputPath);
+  if (myRank == 0)
+    cout << "Results written to " << outputPath << endl;
 
-int main(int argc, char **argv)
-{
-    (void) argc;
-    (void) argv;
-//    ::testing::GTEST_FLAG(filter) = "PD_ARMADILLO:*PD_COMPARE_TIMES_RADIUS_UNORDERED*";
-//    ::testing::InitGoogleTest(&argc, argv);
+  int status = 0;
+  if (perfCheckMode && updateBaseline) {
+    if (myRank == 0) {
+      writeBaseline(benchmark.results(), baselinePath, tolerance, nCores,
+                    Benchmark::nThreads());
+      cout << "Baseline written to " << baselinePath << endl;
+    }
+  } else if (perfCheckMode) {
+    // Compared by the first rank, all ranks exit with its status
+    if (myRank == 0) {
+      cout << endl;
+      const int nFailed = perfCheck(benchmark.results(), baselinePath,
+                                    tolerance, nCores, Benchmark::nThreads());
+      status = nFailed < 0 ? 1 : nFailed > 0 ? 2 : 0;
+    }
+#ifdef USE_MPI
+    MPI::COMM_WORLD.Bcast(&status, 1, MPI::INT, 0);
+#endif
+  }
 
-//    return RUN_ALL_TESTS();
+#ifdef USE_MPI
+  MPI::Finalize();
+#endif
+  return status;
 }
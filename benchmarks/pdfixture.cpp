@@ -0,0 +1,409 @@
+#include "pdfixture.h"
+
+#include <PDtools/CalculateProperties/calculateproperties.h>
+#include <PDtools/Force/forces.h>
+#include <PDtools/Modfiers/modifiers.h>
+#include <PDtools/Particles/latticegenerator.h>
+#include <PDtools/PdFunctions/pdfunctions.h>
+
+#include <cfloat>
+#ifdef USE_MPI
+#include <mpi.h>
+#endif
+
+namespace PDtools {
+//------------------------------------------------------------------------------
+namespace {
+// The criteria and forces are set up to never break a bond, so that every
+// repetition of a case does the same work
+const double UNBREAKABLE = 1e30;
+const double BENCHMARK_STRAIN = 1e-3;
+}
+//------------------------------------------------------------------------------
+PdFixture::PdFixture(const int myRank, const int nCores)
+    : m_myRank(myRank), m_nCores(nCores) {}
+//------------------------------------------------------------------------------
+PdFixture::~PdFixture() {
+  for (auto &property : m_properties)
+    delete property.second;
+  for (auto &criterion : m_fractureCriteria)
+    delete criterion.second;
+  for (Force *force : m_forces)
+    delete force;
+}
+//------------------------------------------------------------------------------
+void PdFixture::loadGeometry(const string &path, const double horizonFactor) {
+  m_name = path.substr(path.find_last_of('/') + 1);
+
+  // The whole geometry is read to find its bounds and resolution
+  PD_Particles loaded = load_pd(path);
+  const unsigned int nLoaded = loaded.nParticles();
+  if (nLoaded == 0) {
+    cerr << "ERROR: no particles in " << path << endl;
+    throw EmptyGeometry;
+  }
+
+  const int loadedDim = loaded.dim();
+  mat &r = loaded.r();
+  vector<pair<double, double>> bounds;
+  m_dim = 0;
+  for (int d = 0; d < M_DIM; d++) {
+    double r_min = 0;
+    double r_max = 0;
+    if (d < loadedDim) {
+      r_min = DBL_MAX;
+      r_max = -DBL_MAX;
+      for (unsigned int i = 0; i < nLoaded; i++) {
+        r_min = std::min(r_min, r(i, d));
+        r_max = std::max(r_max, r(i, d));
+      }
+    } else {
+      for (unsigned int i = 0; i < nLoaded; i++)
+        r(i, d) = 0;
+    }
+    if (r_max > r_min)
+      m_dim++;
+    bounds.push_back(pair<double, double>(r_min, r_max));
+  }
+
+  // The resolution from the volumes, or from the bounding box when the
+  // geometry has no volumes
+  double meanVolume = 0;
+  if (loaded.hasParameter("volume")) {
+    const int indexVolume = loaded.getParamId("volume");
+    const ParticleData &data = loaded.data();
+    for (unsigned int i = 0; i < nLoaded; i++)
+      meanVolume += data(i, indexVolume);
+    meanVolume /= nLoaded;
+  }
+
+  double boxMeasure = 1;
+  for (int d = 0; d < M_DIM; d++) {
+    const double extent = bounds[d].second - bounds[d].first;
+    if (extent > 0)
+      boxMeasure *= extent;
+  }
+
+  if (m_dim == 3 && meanVolume > 0)
+    m_lc = pow(meanVolume, 1. / 3.);
+  else
+    m_lc = pow(boxMeasure / nLoaded, 1. / m_dim);
+  m_h = m_dim == 3 ? bounds[2].second - bounds[2].first : m_lc;
+
+  setGrid(bounds, horizonFactor);
+
+  // Every rank keeps the particles of its own subdomain
+  if (m_nCores > 1) {
+    m_particles = load_pd(path, m_grid);
+    mat &r_local = m_particles.r();
+    for (int d = loadedDim; d < M_DIM; d++) {
+      for (unsigned int i = 0; i < m_particles.nParticles(); i++)
+        r_local(i, d) = 0;
+    }
+  } else {
+    m_particles = loaded;
+  }
+  m_particles.dim(m_dim);
+
+  if (meanVolume <= 0) {
+    const double volume = m_dim == 3 ? pow(m_lc, 3) : m_lc * m_lc * m_h;
+    m_particles.registerParameter("volume");
+    m_particles.setParameter("volume", volume);
+  }
+
+  setParticleParameters();
+}
+//------------------------------------------------------------------------------
+void PdFixture::createLattice(const int nPerSide, const int dim,
+                              const double horizonFactor) {
+  // A simple cubic (square in 2d) lattice filling the unit box
+  m_dim = dim;
+  m_lc = 1. / nPerSide;
+  m_h = m_dim == 3 ? 1. : m_lc;
+  m_name = "lattice-" + std::to_string(nPerSide);
+  for (int d = 1; d < m_dim; d++)
+    m_name += "x" + std::to_string(nPerSide);
+
+  vector<pair<double, double>> bounds;
+  for (int d = 0; d < M_DIM; d++) {
+    if (d < m_dim)
+      bounds.push_back(pair<double, double>(0.5 * m_lc, 1 - 0.5 * m_lc));
+    else
+      bounds.push_back(pair<double, double>(0, 0));
+  }
+  setGrid(bounds, horizonFactor);
+
+  // Every rank only generates the particles of its own subdomain
+  vector<pair<double, double>> box;
+  for (int d = 0; d < M_DIM; d++) {
+    if (d < m_dim)
+      box.push_back(pair<double, double>(0, 1));
+    else
+      box.push_back(pair<double, double>(-0.5 * m_h, 0.5 * m_h));
+  }
+  const LatticeGenerator::LatticeType type =
+      m_dim == 3 ? LatticeGenerator::Cubic : LatticeGenerator::Square;
+  LatticeGenerator lattice(type, m_lc, box);
+  m_particles = lattice.generate(m_grid);
+  if (m_particles.nParticles() == 0) {
+    cerr << "ERROR: no particles of " << m_name << " on rank " << m_myRank
+         << endl;
+    throw EmptyGeometry;
+  }
+
+  setParticleParameters();
+}
+//------------------------------------------------------------------------------
+void PdFixture::connect() {
+  // As in PdSolver::initialize(), with all the fracture criteria and
+  // properties the benchmark cases time
+  setPdConnections(m_particles, m_grid, m_delta, m_lc);
+  m_grid.clearGhostParticles();
+#if USE_MPI
+  exchangeInitialGhostParticles(m_grid, m_particles);
+#endif
+  cleanUpPdConnections(m_particles);
+
+  m_particles.registerPdParameter("volumeScaling", 1, BondData::Float);
+  applyVolumeCorrection(m_particles, m_delta, m_lc, m_dim);
+  setPD_N3L(m_particles);
+
+  //--------------------------------------------------------------------------
+  // The forces
+  //--------------------------------------------------------------------------
+  const bool planeStress = false;
+  const double alpha = 0.25;
+  m_forces.push_back(new PD_bondForce(m_particles));
+  m_forces.push_back(new PD_PMB(m_particles, m_lc, m_delta, alpha));
+  m_forces.push_back(new PD_LPS(m_particles, planeStress));
+  m_forces.push_back(new PD_LPSS(m_particles, planeStress));
+  m_forces.push_back(new PD_OSP(m_particles));
+
+  //--------------------------------------------------------------------------
+  // The fracture criteria
+  //--------------------------------------------------------------------------
+  const double mu = 30;
+  m_fractureCriteria = {
+      {"PmbFracture", new PmbFracture(alpha)},
+      {"SimpleFracture", new SimpleFracture(alpha)},
+      {"BondEnergyFracture",
+       new BondEnergyFracture(m_delta, UNBREAKABLE, m_forces, m_h)},
+      {"MohrCoulombBondFracture",
+       new MohrCoulombBondFracture(mu, UNBREAKABLE, UNBREAKABLE)},
+      {"MohrCoulombFracture",
+       new MohrCoulombFracture(mu, UNBREAKABLE, UNBREAKABLE)},
+      {"VonMisesFracture", new VonMisesFracture(UNBREAKABLE)}};
+
+  for (auto &criterion : m_fractureCriteria) {
+    Modifier *mod = criterion.second;
+    mod->setDim(m_dim);
+    mod->setGrid(&m_grid);
+    mod->setParticles(m_particles);
+    mod->registerParticleParameters();
+#if USE_MPI
+    for (const string &param : mod->initalGhostDependencies()) {
+      m_particles.addGhostParameter(param);
+    }
+#endif
+  }
+#if USE_MPI
+  m_grid.clearGhostParticles();
+  exchangeInitialGhostParticles(m_grid, m_particles);
+#endif
+  for (auto &criterion : m_fractureCriteria) {
+    criterion.second->initialize();
+  }
+
+  for (Force *force : m_forces) {
+    force->numericalInitialization(false);
+    force->initialize(m_E, m_nu, m_delta, m_dim, m_h, m_lc);
+  }
+
+  //--------------------------------------------------------------------------
+  // The properties, the principal stresses after the stress
+  //--------------------------------------------------------------------------
+  m_properties = {
+      {"stress", new CalculateStressStrain(m_forces, m_E, m_nu, m_delta,
+                                           planeStress)},
+      {"stress2", new CalculateStress(m_forces)},
+      {"strain", new CalculateStrain(m_delta, m_domain)},
+      {"principalStress", new CalculatePrincipalStress()},
+      {"damage", new CalculateDamage(m_delta)},
+      {"PdAngle", new CalculatePdAngles()}};
+
+  for (auto &property : m_properties) {
+    property.second->setDim(m_dim);
+    property.second->setParticles(m_particles);
+    property.second->initialize();
+  }
+
+#if USE_MPI
+  m_particles.clearGhostParameters();
+  for (Force *force : m_forces) {
+    for (const string &param : force->ghostDependencies()) {
+      m_particles.addGhostParameter(param);
+    }
+  }
+  for (auto &criterion : m_fractureCriteria) {
+    for (const string &param : criterion.second->ghostDependencies()) {
+      m_particles.addGhostParameter(param);
+    }
+  }
+#endif
+
+  // A small uniform strain, so that the kernels do not work on zeros
+  applyStrain(BENCHMARK_STRAIN);
+  m_particles.buildBondCache();
+  updateForceStates();
+
+  for (auto &property : m_properties) {
+    property.second->clean();
+    property.second->update();
+  }
+}
+//------------------------------------------------------------------------------
+unsigned int PdFixture::nParticles() const {
+  return m_particles.totParticles();
+}
+//------------------------------------------------------------------------------
+size_t PdFixture::nBonds() {
+  // The bonds of all ranks
+  size_t nBonds = 0;
+  const ivec &colToId = m_particles.colToId();
+  for (unsigned int i = 0; i < m_particles.nParticles(); i++) {
+    nBonds += m_particles.pdConnections(colToId(i)).size();
+  }
+#if USE_MPI
+  unsigned long localBonds = nBonds;
+  unsigned long totalBonds = 0;
+  MPI_Allreduce(&localBonds, &totalBonds, 1, MPI_UNSIGNED_LONG, MPI_SUM,
+                MPI_COMM_WORLD);
+  nBonds = totalBonds;
+#endif
+  return nBonds;
+}
+//------------------------------------------------------------------------------
+void PdFixture::zeroForces() {
+  const int nParticles =
+      m_particles.nParticles() + m_particles.nGhostParticles();
+  mat &F = m_particles.F();
+
+  for (int d = 0; d < m_dim; d++) {
+    double *Fd = F.colptr(d);
+    for (int i = 0; i < nParticles; i++) {
+      Fd[i] = 0;
+    }
+  }
+}
+//------------------------------------------------------------------------------
+void PdFixture::updateForceStates() {
+  // As Solver::updateForceStates()
+  const ivec &colToId = m_particles.colToId();
+  const int nParticles = m_particles.nParticles();
+  m_particles.publishBondBreaks();
+
+  for (Force *force : m_forces) {
+    if (!force->getHasUpdateState() || !force->getHasLocalUpdateState())
+      continue;
+    for (int i = 0; i < nParticles; i++) {
+      force->updateState(colToId(i), i);
+    }
+  }
+
+  m_grid.clearGhostParticles();
+  exchangeGhostParticles(m_grid, m_particles);
+#if USE_MPI
+  m_particles.updateNeighbourColumns();
+#endif
+
+  for (Force *force : m_forces) {
+    force->updateState();
+  }
+
+  bool hasUpdateState = false;
+  for (Force *force : m_forces) {
+    if (!force->getHasUpdateState() || force->getHasLocalUpdateState())
+      continue;
+    hasUpdateState = true;
+    for (int i = 0; i < nParticles; i++) {
+      force->updateState(colToId(i), i);
+    }
+  }
+  if (hasUpdateState) {
+    m_grid.clearGhostParticles();
+    exchangeGhostParticles(m_grid, m_particles);
+#if USE_MPI
+    m_particles.updateNeighbourColumns();
+#endif
+  }
+}
+//------------------------------------------------------------------------------
+void PdFixture::setGrid(const vector<pair<double, double>> &bounds,
+                        const double horizonFactor) {
+  m_delta = horizonFactor * m_lc;
+
+  // The bounds with room for the horizon, the thickness in the unused
+  // dimensions
+  m_domain.clear();
+  for (int d = 0; d < M_DIM; d++) {
+    const double r_min = bounds[d].first;
+    const double r_max = bounds[d].second;
+    if (d < m_dim) {
+      const double padding = m_delta + m_lc;
+      m_domain.push_back(pair<double, double>(r_min - padding, r_max + padding));
+    } else {
+      const double r_mid = 0.5 * (r_min + r_max);
+      m_domain.push_back(
+          pair<double, double>(r_mid - 0.5 * m_h, r_mid + 0.5 * m_h));
+    }
+  }
+
+  const double gridspacing = 1.45 * (m_delta + 0.5 * m_lc);
+  const arma::ivec3 periodicBoundaries = {0, 0, 0};
+  m_grid = Grid(m_domain, gridspacing, periodicBoundaries);
+  m_grid.setIdAndCores(m_myRank, m_nCores);
+  m_grid.dim(m_dim);
+  m_grid.initialize();
+  m_grid.setMyGridpoints();
+  m_grid.setInitialPositionScaling(1.0);
+}
+//------------------------------------------------------------------------------
+void PdFixture::setParticleParameters() {
+  // As in PdSolver::initialize(), up to the PD-connections
+  mat &r0 = m_particles.r0();
+  const mat &r = m_particles.r();
+  for (unsigned int i = 0; i < m_particles.nParticles(); i++) {
+    for (int d = 0; d < M_DIM; d++) {
+      r0(i, d) = r(i, d);
+    }
+  }
+  m_particles.v().zeros();
+
+  m_particles.registerParameter("rho", m_rho);
+  m_particles.registerParameter("s0", 1);
+  m_particles.registerParameter("radius");
+  m_particles.registerParameter("groupId");
+  calculateRadius(m_particles, m_dim, m_h);
+
+  m_grid.clearParticles();
+  m_grid.placeParticlesInGrid(m_particles);
+#ifdef USE_MPI
+  vector<string> ghostParameters = {"volume", "radius", "groupId"};
+  for (const string &param : ghostParameters) {
+    m_particles.addGhostParameter(param);
+  }
+  exchangeGhostParticles(m_grid, m_particles);
+#endif
+}
+//------------------------------------------------------------------------------
+void PdFixture::applyStrain(const double strain) {
+  mat &r = m_particles.r();
+  const mat &r0 = m_particles.r0();
+  for (unsigned int i = 0; i < m_particles.nParticles(); i++) {
+    for (int d = 0; d < m_dim; d++) {
+      r(i, d) = (1. + strain) * r0(i, d);
+    }
+  }
+}
+//------------------------------------------------------------------------------
+}
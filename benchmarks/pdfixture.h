@@ -0,0 +1,103 @@
+#ifndef PDFIXTURE_H
+#define PDFIXTURE_H
+
+#include "config.h"
+#include <PDtools.h>
+
+namespace PDtools {
+class Force;
+class Modifier;
+class CalculateProperty;
+
+//------------------------------------------------------------------------------
+// A peridynamic system set up the way PdSolver::initialize() does it, from a
+// geometry file or a synthetic lattice, for the benchmark cases.
+//
+// The setup has two stages. After the first stage the particles are gridded
+// and the ghosts exchanged, which is the input of setPdConnections(). The
+// second stage connects the particles and creates the forces, the fracture
+// criteria and the properties. Every rank only holds the particles of its
+// own subdomain.
+//------------------------------------------------------------------------------
+class PdFixture {
+public:
+  PdFixture(const int myRank, const int nCores);
+  ~PdFixture();
+
+  // First stage
+  void loadGeometry(const string &path, const double horizonFactor);
+  void createLattice(const int nPerSide, const int dim,
+                     const double horizonFactor);
+
+  // Second stage
+  void connect();
+
+  const string &name() const;
+  int dim() const;
+  double delta() const;
+  double lc() const;
+  unsigned int nParticles() const;
+  size_t nBonds();
+  PD_Particles &particles();
+  Grid &grid();
+  vector<Force *> &forces();
+  const vector<pair<string, Modifier *>> &fractureCriteria() const;
+  const vector<pair<string, CalculateProperty *>> &properties() const;
+
+  void zeroForces();
+  void updateForceStates();
+
+protected:
+  const int m_myRank;
+  const int m_nCores;
+  string m_name;
+  int m_dim = 3;
+  double m_lc = 1;
+  double m_delta = 3;
+  double m_h = 1;
+  double m_E = 1;
+  double m_nu = 0.25;
+  double m_rho = 1;
+  vector<pair<double, double>> m_domain;
+
+  PD_Particles m_particles;
+  Grid m_grid;
+  vector<Force *> m_forces;
+  vector<pair<string, Modifier *>> m_fractureCriteria;
+  vector<pair<string, CalculateProperty *>> m_properties;
+
+  enum ErrorCodes { EmptyGeometry };
+
+  void setGrid(const vector<pair<double, double>> &bounds,
+               const double horizonFactor);
+  void setParticleParameters();
+  void applyStrain(const double strain);
+};
+//------------------------------------------------------------------------------
+// Inline functions
+inline const string &PdFixture::name() const { return m_name; }
+
+inline int PdFixture::dim() const { return m_dim; }
+
+inline double PdFixture::delta() const { return m_delta; }
+
+inline double PdFixture::lc() const { return m_lc; }
+
+inline PD_Particles &PdFixture::particles() { return m_particles; }
+
+inline Grid &PdFixture::grid() { return m_grid; }
+
+inline vector<Force *> &PdFixture::forces() { return m_forces; }
+
+inline const vector<pair<string, Modifier *>> &
+PdFixture::fractureCriteria() const {
+  return m_fractureCriteria;
+}
+
+inline const vector<pair<string, CalculateProperty *>> &
+PdFixture::properties() const {
+  return m_properties;
+}
+//------------------------------------------------------------------------------
+}
+#endif // PDFIXTURE_H
@@ -0,0 +1,221 @@
+#include "perfcheck.h"
+#include "benchmark.h"
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+
+namespace PDtools {
+//------------------------------------------------------------------------------
+namespace {
+struct BaselineCase {
+  string name;
+  string geometry;
+  double t_median;
+  double t_mad;
+  double tolerance;
+  bool found;
+};
+
+// Cases recorded without a tolerance
+const double noTolerance = -1;
+
+// Reads the cases of the baseline, false if it can not be parsed
+bool readBaseline(const string &baselinePath, boost::property_tree::ptree &root,
+                  vector<BaselineCase> &baseline) {
+  namespace pt = boost::property_tree;
+  try {
+    pt::read_json(baselinePath, root);
+  } catch (const pt::json_parser_error &error) {
+    cerr << "ERROR: could not read the baseline " << baselinePath << ": "
+         << error.message() << endl;
+    return false;
+  }
+
+  for (const auto &child : root.get_child("benchmarks", pt::ptree())) {
+    const pt::ptree &entry = child.second;
+    BaselineCase baselineCase;
+    baselineCase.name = entry.get<string>("name", "");
+    baselineCase.geometry = entry.get<string>("geometry", "");
+    baselineCase.t_median = entry.get<double>("t_median", 0);
+    baselineCase.t_mad = entry.get<double>("t_mad", 0);
+    baselineCase.tolerance = entry.get<double>("tolerance", noTolerance);
+    baselineCase.found = false;
+    baseline.push_back(baselineCase);
+  }
+  return true;
+}
+
+bool fileExists(const string &path) { return std::ifstream(path).good(); }
+
+void printRow(const string &name, const string &geometry, const string &base,
+              const string &current, const string &change,
+              const string &allowed, const string &status) {
+  char line[256];
+  snprintf(line, sizeof(line), "%-32s %-14s %12s %12s %9s %9s  %s",
+           name.c_str(), geometry.c_str(), base.c_str(), current.c_str(),
+           change.c_str(), allowed.c_str(), status.c_str());
+  cout << line << endl;
+}
+
+string format(const char *fmt, const double value) {
+  char buffer[32];
+  snprintf(buffer, sizeof(buffer), fmt, value);
+  return buffer;
+}
+}
+//------------------------------------------------------------------------------
+int perfCheck(const vector<BenchmarkResult> &results,
+              const string &baselinePath, const double tolerance,
+              const int nRanks, const int nThreads) {
+  namespace pt = boost::property_tree;
+
+  // A checkout has no baseline until it is recorded on the reference system
+  pt::ptree root;
+  vector<BaselineCase> baseline;
+  if (fileExists(baselinePath) && !readBaseline(baselinePath, root, baseline))
+    return -1;
+
+  if (baseline.empty()) {
+    cout << "No baseline recorded in " << baselinePath << ", the performance "
+         << "check is skipped. Record it on the reference system with make "
+         << "perfcheck-baseline" << endl;
+    return 0;
+  }
+
+  // The times scale with the ranks and the threads
+  const int baselineRanks = root.get<int>("nRanks", 0);
+  const int baselineThreads = root.get<int>("nThreads", 0);
+  if (baselineRanks != nRanks || baselineThreads != nThreads) {
+    cerr << "ERROR: the baseline " << baselinePath << " was recorded with "
+         << baselineRanks << " rank(s) and " << baselineThreads
+         << " thread(s), this run has " << nRanks << " rank(s) and "
+         << nThreads << " thread(s)" << endl;
+    return -1;
+  }
+
+  cout << "Performance check against " << baselinePath << ", " << nRanks
+       << " rank(s) and " << nThreads << " thread(s)" << endl;
+  cout << endl;
+  printRow("case", "geometry", "baseline s", "current s", "change",
+           "allowed", "status");
+
+  // 1.4826 MAD estimates the standard deviation of normal noise
+  const double madToSigma = 1.4826;
+  const double nSigma = 3;
+  int nRegressions = 0;
+  int nNew = 0;
+
+  for (const BenchmarkResult &result : results) {
+    auto match = std::find_if(baseline.begin(), baseline.end(),
+                              [&](const BaselineCase &b) {
+                                return b.name == result.name &&
+                                       b.geometry == result.geometry;
+                              });
+    const string current = format("%.6f", result.t_median);
+
+    if (match == baseline.end() || match->t_median <= 0) {
+      printRow(result.name, result.geometry, "-", current, "-", "-",
+               "NOT IN BASELINE");
+      nNew++;
+      continue;
+    }
+    match->found = true;
+
+    const double t0 = match->t_median;
+    const double change = result.t_median / t0 - 1;
+    const double noise =
+        nSigma * madToSigma *
+        sqrt(match->t_mad * match->t_mad + result.t_mad * result.t_mad) / t0;
+    const double caseTolerance =
+        match->tolerance >= 0 ? match->tolerance : tolerance;
+    const double allowed = std::max(caseTolerance, noise);
+
+    string status = "ok";
+    if (change > allowed) {
+      status = "REGRESSION";
+      nRegressions++;
+    } else if (change < -allowed) {
+      status = "faster";
+    }
+
+    printRow(result.name, result.geometry, format("%.6f", t0), current,
+             format("%+.1f%%", 100 * change), format("%.1f%%", 100 * allowed),
+             status);
+  }
+
+  int nMissing = 0;
+  for (const BaselineCase &b : baseline) {
+    if (b.found)
+      continue;
+    printRow(b.name, b.geometry, format("%.6f", b.t_median), "-", "-", "-",
+             "missing");
+    nMissing++;
+  }
+
+  cout << endl;
+  const size_t nCompared = results.size() - nNew;
+  if (nRegressions > 0)
+    cout << nRegressions << " of " << nCompared
+         << " case(s) regressed beyond their allowed change" << endl;
+  else
+    cout << "No regressions in " << nCompared << " case(s)" << endl;
+  if (nNew > 0)
+    cerr << "ERROR: " << nNew << " case(s) not in the baseline, record it "
+         << "again with make perfcheck-baseline" << endl;
+  if (nMissing > 0)
+    cerr << "WARNING: " << nMissing << " baseline case(s) not run" << endl;
+
+  return nRegressions + nNew;
+}
+//------------------------------------------------------------------------------
+void writeBaseline(const vector<BenchmarkResult> &results,
+                   const string &baselinePath, const double tolerance,
+                   const int nRanks, const int nThreads) {
+  boost::property_tree::ptree root;
+  vector<BaselineCase> previous;
+  if (fileExists(baselinePath))
+    readBaseline(baselinePath, root, previous);
+
+  std::ofstream out(baselinePath);
+  if (!out) {
+    cerr << "ERROR: could not open " << baselinePath << endl;
+    return;
+  }
+
+  out << std::setprecision(10);
+  out << "{\n";
+  out << "  \"nRanks\": " << nRanks << ",\n";
+  out << "  \"nThreads\": " << nThreads << ",\n";
+  out << "  \"benchmarks\": [";
+
+  for (unsigned int k = 0; k < results.size(); k++) {
+    const BenchmarkResult &result = results[k];
+    auto match = std::find_if(previous.begin(), previous.end(),
+                              [&](const BaselineCase &b) {
+                                return b.name == result.name &&
+                                       b.geometry == result.geometry;
+                              });
+    const double caseTolerance =
+        match != previous.end() && match->tolerance >= 0 ? match->tolerance
+                                                         : tolerance;
+
+    out << (k > 0 ? ",\n" : "\n");
+    out << "    {\n";
+    out << "      \"name\": " << jsonString(result.name) << ",\n";
+    out << "      \"geometry\": " << jsonString(result.geometry) << ",\n";
+    out << "      \"nParticles\": " << result.nParticles << ",\n";
+    out << "      \"nBonds\": " << result.nBonds << ",\n";
+    out << "      \"t_median\": " << result.t_median << ",\n";
+    out << "      \"t_mad\": " << result.t_mad << ",\n";
+    out << "      \"tolerance\": " << caseTolerance << "\n";
+    out << "    }";
+  }
+  out << "\n  ]\n}\n";
+}
+//------------------------------------------------------------------------------
+}
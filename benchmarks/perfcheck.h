@@ -0,0 +1,44 @@
+#ifndef PERFCHECK_H
+#define PERFCHECK_H
+
+#include "config.h"
+
+namespace PDtools {
+struct BenchmarkResult;
+
+//------------------------------------------------------------------------------
+// Compares the results of a run to a baseline written by writeBaseline(),
+// case by case, matched by name and geometry, and prints the comparison as a
+// table.
+//
+// A case regresses when its median time grows by more than the allowed
+// change: the larger of the tolerance of the case and its noise, three
+// standard deviations of the difference of the medians. The standard
+// deviations are estimated from the median absolute deviations of the
+// baseline and of the run, 1.4826 MAD, so a noisy case gets a wider margin
+// and a single slow repetition does not move it. Cases recorded without a
+// tolerance get the given one.
+//
+// A case of the run that is not in the baseline fails the check, it is not
+// checked at all. Baseline cases that were not run, e.g. with a filter, are
+// listed with a warning.
+//
+// Returns the number of failed cases, 0 if no baseline is recorded yet, the
+// file is missing or has no cases, or -1 if the baseline can not be read or
+// was recorded with other numbers of ranks or threads than the run.
+//------------------------------------------------------------------------------
+int perfCheck(const vector<BenchmarkResult> &results,
+              const string &baselinePath, const double tolerance,
+              const int nRanks, const int nThreads);
+
+//------------------------------------------------------------------------------
+// Writes the results as the baseline of perfCheck(): the median times and
+// their noise, and the tolerance of every case. A case keeps the tolerance
+// of the previous baseline at the path, so tolerances tuned by hand survive
+// recording it again, new cases get the given one.
+//------------------------------------------------------------------------------
+void writeBaseline(const vector<BenchmarkResult> &results,
+                   const string &baselinePath, const double tolerance,
+                   const int nRanks, const int nThreads);
+}
+#endif // PERFCHECK_H
@@ -0,0 +1,105 @@
+#!/usr/bin/env python3
+"""Weak and strong scaling runs of Peridyn on generated lattices.
+
+The base configuration is a Peridyn configuration with a 'lattice' in place
+of 'particlesPath', where $length is the x-extent of the lattice box and of
+the domain, e.g.
+
+    domain = [0.0, $length, 0.0, 0.05, -0.0005, 0.0005];
+    lattice = {type = "square"; spacing = 0.0005;
+               box = [0.0, $length, 0.0, 0.05, -0.0005, 0.0005];};
+
+In a strong scaling study the length is the same on all the rank counts, in
+a weak scaling study it grows with the ranks, so that the particles per rank
+stay the same. Each run writes its configuration and output to the work
+directory, and the wall times, printed by Peridyn as 'seconds: <t>', are
+written to a CSV file with the speedup and the parallel efficiency relative
+to the smallest rank count.
+
+usage: scaling.py peridyn base.cfg --mode weak --ranks 1 2 4 8 --length 0.05
+"""
+import argparse
+import csv
+import os
+import re
+import string
+import subprocess
+import sys
+
+
+def run(args, ranks, length):
+    with open(args.config) as f:
+        config = string.Template(f.read()).substitute(length=repr(length))
+
+    name = "{}-{}".format(args.mode, ranks)
+    configPath = os.path.join(args.workdir, name + ".cfg")
+    with open(configPath, "w") as f:
+        f.write(config)
+
+    command = args.mpirun.split() + ["-np", str(ranks), args.peridyn,
+                                     configPath]
+    print(" ".join(command), flush=True)
+    result = subprocess.run(command, stdout=subprocess.PIPE,
+                            stderr=subprocess.STDOUT, universal_newlines=True)
+    with open(os.path.join(args.workdir, name + ".log"), "w") as f:
+        f.write(result.stdout)
+
+    match = re.search(r"seconds:\s*([0-9.eE+-]+)", result.stdout)
+    if result.returncode != 0 or match is None:
+        print("ERROR: the run on {} rank(s) failed, see {}.log".format(
+            ranks, name), file=sys.stderr)
+        return None
+    return float(match.group(1))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("peridyn", help="the Peridyn executable")
+    parser.add_argument("config", help="the base configuration")
+    parser.add_argument("--mode", choices=["weak", "strong"], default="weak")
+    parser.add_argument("--ranks", type=int, nargs="+", default=[1, 2, 4, 8])
+    parser.add_argument("--length", type=float, required=True,
+                        help="x-extent of the box, per smallest rank count "
+                             "in a weak scaling study")
+    parser.add_argument("--mpirun", default="mpirun")
+    parser.add_argument("--workdir", default="scaling")
+    parser.add_argument("--output", default=None,
+                        help="the CSV results (<workdir>/<mode>.csv)")
+    args = parser.parse_args()
+
+    os.makedirs(args.workdir, exist_ok=True)
+    ranks = sorted(args.ranks)
+    output = args.output or os.path.join(args.workdir, args.mode + ".csv")
+
+    rows = []
+    for n in ranks:
+        length = args.length
+        if args.mode == "weak":
+            length *= n / ranks[0]
+        seconds = run(args, n, length)
+        if seconds is not None:
+            rows.append((n, length, seconds))
+
+    if not rows:
+        return 1
+
+    n0, _, t0 = rows[0]
+    with open(output, "w", newline="") as f:
+        writer = csv.writer(f)
+        writer.writerow(["ranks", "length", "seconds", "speedup",
+                         "efficiency"])
+        for n, length, seconds in rows:
+            if args.mode == "weak":
+                speedup = t0 / seconds * n / n0
+            else:
+                speedup = t0 / seconds
+            efficiency = speedup * n0 / n
+            writer.writerow([n, length, seconds, speedup, efficiency])
+            print("{:6d} ranks {:12.4g} s  efficiency {:6.3f}".format(
+                n, seconds, efficiency))
+    print("Results written to " + output)
+    return 0 if len(rows) == len(ranks) else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -1,18 +1,23 @@
 #ifndef TEST_RESOURCES
 #define TEST_RESOURCES
 
-#include <stdio.h>
+#include <string>
 #include <vector>
-using namespace std;
 
-vector<string> geometries =
-{"../../PDtools/resources/geometries/small.xyz",
- "../../PDtools/resources/geometries/mesh.xyz",
- "../../PDtools/resources/geometries/happy.xyz",
-"../../PDtools/resources/geometries/cube.ply"};
-////vector<string> geometries =
-////{"../PDtools/resources/geometries/small.xyz",
-////"../PDtools/resources/geometries/mesh.xyz"};
+#ifndef RESOURCES_PATH
+#define RESOURCES_PATH "../resources"
+#endif
 
-#endif // TEST_RESOURCES
+// The geometries benchmarked when none are given on the command line
+const std::vector<std::string> geometries = {
+    RESOURCES_PATH "/geometries/1000.xyz",
+    RESOURCES_PATH "/geometries/mesh.xyz"};
+
+// The geometry and the cases of the performance check
+const std::string perfCheckGeometry =
+    RESOURCES_PATH "/geometries/PlateWithHole/run.xyz";
+const std::vector<std::string> perfCheckCases = {
+    "force/", "connections/setPdConnections", "grid/updateVerletList",
+    "adr/iterate"};
 
+#endif // TEST_RESOURCES
@@ -147,10 +147,6 @@ linux-icc-64 {
 #-------------------------------------------------------------------------------
 # Custom defines
 #-------------------------------------------------------------------------------
-DEFINES *= PARTICLE_BUFFER=1.5
-#DEFINES *= PARTICLE_BUFFER=1.3
-#DEFINES *= PARAMETER_BUFFER=30
-DEFINES *= PARAMETER_BUFFER=48
 DEFINES *= M_DIM=3
 #DEFINES *= ARMA_DONT_USE_WRAPPER # Comment out on abel
 #DEFINES *= ARMA_USE_BLAS
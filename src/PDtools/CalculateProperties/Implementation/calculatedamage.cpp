@@ -7,81 +7,119 @@ namespace PDtools {
 CalculateDamage::CalculateDamage(double delta)
     : CalculateProperty("damage"), m_delta(delta) {}
 //------------------------------------------------------------------------------
+CalculateDamage::~CalculateDamage() {
+  if (m_particles)
+    m_particles->unsubscribeBondBreaks(this);
+}
+//------------------------------------------------------------------------------
 void CalculateDamage::initialize() {
+  // Set by the volume correction, otherwise summed here
+  const bool hasInitialWeight = m_particles->hasParameter("initialWeight");
   m_iDamage = m_particles->registerParameter("damage");
   m_iInitialWeight = m_particles->registerParameter("initialWeight");
+  m_iConnectedWeight = m_particles->registerParameter("connectedWeight");
   m_indexConnected = m_particles->getPdParamId("connected");
   m_iVolumeScaling = m_particles->getPdParamId("volumeScaling");
   m_iVolume = m_particles->getParamId("volume");
   m_iDr0 = m_particles->getPdParamId("dr0");
 
-  const ivec &colToId = m_particles->colToId();
-  const ivec &idToCol = m_particles->getIdToCol_v();
+  calculateWeights(!hasInitialWeight);
+
+  if (m_incremental)
+    m_particles->subscribeBondBreaks(this);
+}
+//------------------------------------------------------------------------------
+void CalculateDamage::update() {
+  if (!m_incremental)
+    calculateWeights(false);
+
   const int nParticles = m_particles->nParticles();
-  mat &data = m_particles->data();
+  ParticleData &data = m_particles->data();
 
 #ifdef USE_OPENMP
 #pragma omp parallel for
 #endif
   for (int i = 0; i < nParticles; i++) {
-    const int id_i = colToId(i);
-    data(i, m_iInitialWeight) = m_particles->pdConnections(id_i).size();
+    data(i, m_iDamage) =
+        1. - data(i, m_iConnectedWeight) / data(i, m_iInitialWeight);
+  }
+}
+//------------------------------------------------------------------------------
+void CalculateDamage::bondsBroken(const vector<BondBreak> &brokenBonds) {
+  const ivec &colToId = m_particles->colToId();
+  const IdToColMap &idToCol = m_particles->getIdToCol_v();
+  const int nParticles = m_particles->nParticles();
+  ParticleData &data = m_particles->data();
 
-    const vector<pair<int, vector<double>>> &PDconnections =
-        m_particles->pdConnections(id_i);
+  for (const BondBreak &bondBreak : brokenBonds) {
+    const int id_i = bondBreak.id_i;
+    const int i = idToCol[id_i];
+    if (i < 0 || i >= nParticles || colToId(i) != id_i)
+      continue;
 
-    double initialWeight = 0;
-    for (const auto &con : PDconnections) {
+    const auto &con = m_particles->pdConnections(id_i)[bondBreak.l_j];
+    const int j = idToCol[bondBreak.id_j];
+    if (j < 0)
+      continue;
+    const double vol_j = data(j, m_iVolume);
+    const double volumeScaling = con.second[m_iVolumeScaling];
 
-      const int id_j = con.first;
-      const int j = idToCol[id_j];
+    data(i, m_iConnectedWeight) -= vol_j * volumeScaling;
+  }
+}
+//------------------------------------------------------------------------------
+void CalculateDamage::connectionsChanged(const vector<int> &ids) {
+  // The neighbourhood changed, the initial weight is summed again
+  const ivec &colToId = m_particles->colToId();
+  const IdToColMap &idToCol = m_particles->getIdToCol_v();
+  const int nParticles = m_particles->nParticles();
 
-      const double vol_j = data(j, m_iVolume);
-      const double volumeScaling = con.second[m_iVolumeScaling];
-      initialWeight += vol_j * volumeScaling;
-    }
-    if (initialWeight == 0)
-      initialWeight = 1.0;
+  for (const int id_i : ids) {
+    const int i = idToCol[id_i];
+    if (i < 0 || i >= nParticles || colToId(i) != id_i)
+      continue;
 
-    data(i, m_iInitialWeight) = initialWeight;
+    calculateWeights(id_i, i, true);
   }
 }
 //------------------------------------------------------------------------------
-void CalculateDamage::update() {
+void CalculateDamage::calculateWeights(const bool initial) {
   const ivec &colToId = m_particles->colToId();
   const int nParticles = m_particles->nParticles();
-  mat &data = m_particles->data();
-  const ivec &idToCol = m_particles->getIdToCol_v();
 
-  // Updating single particle states
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
   for (int i = 0; i < nParticles; i++) {
-    const int id_i = colToId(i);
-    const vector<pair<int, vector<double>>> &PDconnections =
-        m_particles->pdConnections(id_i);
-    const int jnum = PDconnections.size();
-    const double maxConnections = jnum;
-
-    if (maxConnections <= 0) {
-      data(i, m_iDamage) = 1.;
-      return;
-    }
-
-    double over = 0;
-    double under = data(i, m_iInitialWeight);
-
-    for (const auto &con : PDconnections) {
-      if (con.second[m_indexConnected] > 0.5) {
-        const int id_j = con.first;
-        const int j = idToCol[id_j];
-        const double vol_j = data(j, m_iVolume);
-        const double volumeScaling = con.second[m_iVolumeScaling];
-
-        over += vol_j * volumeScaling;
-      }
-    }
-
-    data(i, m_iDamage) = 1. - over / under;
+    calculateWeights(colToId(i), i, initial);
   }
 }
 //------------------------------------------------------------------------------
+void CalculateDamage::calculateWeights(const int id_i, const int i,
+                                       const bool initial) {
+  const IdToColMap &idToCol = m_particles->getIdToCol_v();
+  ParticleData &data = m_particles->data();
+  const BondList &PDconnections = m_particles->pdConnections(id_i);
+
+  double initialWeight = 0;
+  double connectedWeight = 0;
+  for (const auto &con : PDconnections) {
+    const int id_j = con.first;
+    const int j = idToCol[id_j];
+
+    const double vol_j = data(j, m_iVolume);
+    const double volumeScaling = con.second[m_iVolumeScaling];
+    initialWeight += vol_j * volumeScaling;
+
+    if (con.second[m_indexConnected] > 0.5)
+      connectedWeight += vol_j * volumeScaling;
+  }
+
+  if (initial)
+    data(i, m_iInitialWeight) = initialWeight;
+  if (data(i, m_iInitialWeight) == 0)
+    data(i, m_iInitialWeight) = 1.0;
+  data(i, m_iConnectedWeight) = connectedWeight;
+}
+//------------------------------------------------------------------------------
 }
@@ -2,24 +2,42 @@
 #define CALCULATEDAMAGE_H
 
 #include "PDtools/CalculateProperties/calculateproperty.h"
+#include "PDtools/Particles/pd_particles.h"
 
 namespace PDtools {
 //------------------------------------------------------------------------------
 
-class CalculateDamage : public CalculateProperty {
+// The damage is 1 - (connected volume)/(initial volume) of the neighbourhood.
+// The initial volume is taken from the volume correction when it is applied.
+// Incrementally, the connected volume is a running sum decremented for the
+// broken bonds, and an update is O(particles). Otherwise the connected bonds
+// are summed on every update.
+class CalculateDamage : public CalculateProperty, public BondBreakSubscriber {
 public:
   CalculateDamage(double delta);
+  ~CalculateDamage();
 
   virtual void initialize();
 
   virtual void update();
 
+  virtual void bondsBroken(const vector<BondBreak> &brokenBonds);
+
+  virtual void connectionsChanged(const vector<int> &ids);
+
+  void setIncremental(bool incremental) { m_incremental = incremental; }
+
   double weightFunction(const double dr0) const { return m_delta / dr0; }
 
 private:
+  void calculateWeights(const bool initial);
+  void calculateWeights(const int id_i, const int i, const bool initial);
+
   double m_delta;
+  bool m_incremental = true;
   int m_iDamage;
   int m_iInitialWeight;
+  int m_iConnectedWeight;
   int m_indexConnected;
   int m_iVolume;
   int m_iVolumeScaling;
@@ -12,8 +12,10 @@ void CalculatePdAngles::initialize() {
   m_indexConnected = m_particles->getPdParamId("connected");
 
   if (m_dim == 2) {
-    m_indexTheta = m_particles->registerPdParameter("theta");
-    m_indexTheta0 = m_particles->registerPdParameter("theta0");
+    m_indexTheta = m_particles->registerPdParameter("theta", 0,
+                                                    BondData::Float);
+    m_indexTheta0 = m_particles->registerPdParameter("theta0", 0,
+                                                     BondData::Float);
   } else {
     cerr << "Perperties - calculatePdAngles: dim " << m_dim
          << " is not supported" << endl;
@@ -21,7 +23,7 @@ void CalculatePdAngles::initialize() {
 
   // Calculating the initial angle
   const int nParticles = m_particles->nParticles();
-  const ivec &idToCol = m_particles->getIdToCol_v();
+  const IdToColMap &idToCol = m_particles->getIdToCol_v();
   const arma::ivec &colToId = m_particles->colToId();
 
   const mat &R = m_particles->r0();
@@ -29,8 +31,7 @@ void CalculatePdAngles::initialize() {
   double dr_ij[m_dim];
   for (int i = 0; i < nParticles; i++) {
     const int id_i = colToId[i];
-    vector<pair<int, vector<double>>> &PDconnections =
-        m_particles->pdConnections(id_i);
+    BondList &PDconnections = m_particles->pdConnections(id_i);
     const int nConnections = PDconnections.size();
 
     for (int l_j = 0; l_j < nConnections; l_j++) {
@@ -52,22 +53,17 @@ void CalculatePdAngles::initialize() {
 //------------------------------------------------------------------------------
 void CalculatePdAngles::update() {
   const int nParticles = m_particles->nParticles();
-  const ivec &idToCol = m_particles->getIdToCol_v();
+  const IdToColMap &idToCol = m_particles->getIdToCol_v();
   const arma::ivec &colToId = m_particles->colToId();
   const mat &R = m_particles->r();
 
   double dr_ij[m_dim];
   for (int i = 0; i < nParticles; i++) {
     const int id_i = colToId[i];
-    vector<pair<int, vector<double>>> &PDconnections =
-        m_particles->pdConnections(id_i);
-    const int nConnections = PDconnections.size();
+    BondList &PDconnections = m_particles->pdConnections(id_i);
 
-    for (int l_j = 0; l_j < nConnections; l_j++) {
+    m_particles->forEachConnectedBond(i, [&](const int l_j) {
       auto &con = PDconnections[l_j];
-      if (con.second[m_indexConnected] <= 0.5)
-        continue;
-
       const int id_j = con.first;
       const int j = idToCol[id_j];
 
@@ -76,7 +72,7 @@ void CalculatePdAngles::update() {
       }
       const double theta = atan2(dr_ij[1], dr_ij[0]);
       con.second[m_indexTheta] = theta - con.second[m_indexTheta0];
-    }
+    });
   }
 }
 //------------------------------------------------------------------------------
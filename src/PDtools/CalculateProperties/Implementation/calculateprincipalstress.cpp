@@ -0,0 +1,91 @@
+#include "calculateprincipalstress.h"
+
+#include "Particles/pd_particles.h"
+#include "PdFunctions/pdfunctions.h"
+
+namespace PDtools {
+//------------------------------------------------------------------------------
+CalculatePrincipalStress::CalculatePrincipalStress()
+    : CalculateProperty("principalStress") {
+  m_dependencies = {"stress", "stress2"};
+}
+//------------------------------------------------------------------------------
+void CalculatePrincipalStress::setPresentDependencies(
+    const vector<string> &types) {
+  // Without a stress property the tensor is the one the forces accumulate
+  m_needsForceStress = types.empty();
+}
+//------------------------------------------------------------------------------
+void CalculatePrincipalStress::initialize() {
+  switch (m_dim) {
+  case 1:
+    m_indexStress[0] = m_particles->registerParameter("s_xx");
+    break;
+  case 2:
+    m_indexStress[0] = m_particles->registerParameter("s_xx");
+    m_indexStress[1] = m_particles->registerParameter("s_yy");
+    m_indexStress[2] = m_particles->registerParameter("s_xy");
+    break;
+  case 3:
+    m_indexStress[0] = m_particles->registerParameter("s_xx");
+    m_indexStress[1] = m_particles->registerParameter("s_yy");
+    m_indexStress[2] = m_particles->registerParameter("s_xy");
+    m_indexStress[3] = m_particles->registerParameter("s_zz");
+    m_indexStress[4] = m_particles->registerParameter("s_xz");
+    m_indexStress[5] = m_particles->registerParameter("s_yz");
+    m_indexMid = m_particles->registerParameter("s_mid");
+    break;
+  }
+  m_indexMax = m_particles->registerParameter("s_max");
+  m_indexMin = m_particles->registerParameter("s_min");
+  m_indexVonMises = m_particles->registerParameter("s_vm");
+}
+//------------------------------------------------------------------------------
+void CalculatePrincipalStress::update() {
+  // The stress components are columns in the data matrix, the principal
+  // stresses of all the particles are computed in one pass over them.
+  const int nParticles = m_particles->nParticles();
+  ParticleData &data = m_particles->data();
+  double *s_max = data.colptr(m_indexMax);
+  double *s_min = data.colptr(m_indexMin);
+  double *s_vm = data.colptr(m_indexVonMises);
+
+  switch (m_dim) {
+  case 1: {
+    const double *s_xx = data.colptr(m_indexStress[0]);
+    for (int i = 0; i < nParticles; i++) {
+      s_max[i] = s_xx[i];
+      s_min[i] = s_xx[i];
+      s_vm[i] = fabs(s_xx[i]);
+    }
+    break;
+  }
+  case 2:
+    principalStresses2d(nParticles, data.colptr(m_indexStress[0]),
+                        data.colptr(m_indexStress[1]),
+                        data.colptr(m_indexStress[2]), s_max, s_min);
+    for (int i = 0; i < nParticles; i++) {
+      s_vm[i] = sqrt(s_max[i] * s_max[i] - s_max[i] * s_min[i] +
+                     s_min[i] * s_min[i]);
+    }
+    break;
+  case 3: {
+    double *s_mid = data.colptr(m_indexMid);
+    principalStresses3d(nParticles, data.colptr(m_indexStress[0]),
+                        data.colptr(m_indexStress[1]),
+                        data.colptr(m_indexStress[3]),
+                        data.colptr(m_indexStress[2]),
+                        data.colptr(m_indexStress[4]),
+                        data.colptr(m_indexStress[5]), s_max, s_mid, s_min);
+    for (int i = 0; i < nParticles; i++) {
+      const double d12 = s_max[i] - s_mid[i];
+      const double d23 = s_mid[i] - s_min[i];
+      const double d31 = s_min[i] - s_max[i];
+      s_vm[i] = sqrt(0.5 * (d12 * d12 + d23 * d23 + d31 * d31));
+    }
+    break;
+  }
+  }
+}
+//------------------------------------------------------------------------------
+}
@@ -0,0 +1,30 @@
+#ifndef CALCULATEPRINCIPALSTRESS_H
+#define CALCULATEPRINCIPALSTRESS_H
+
+#include "PDtools/CalculateProperties/calculateproperty.h"
+
+namespace PDtools {
+//------------------------------------------------------------------------------
+// The principal stresses (s_max >= s_mid >= s_min) and the von Mises stress
+// s_vm of each particle, computed from the stress property, or without one
+// from the stress accumulated by the forces. s_mid is only set in 3D, in 2D
+// s_vm is the plane stress von Mises stress.
+// Must be updated after the stress.
+class CalculatePrincipalStress : public CalculateProperty {
+public:
+  CalculatePrincipalStress();
+
+  virtual void setPresentDependencies(const vector<string> &types);
+  virtual void initialize();
+  virtual void update();
+
+private:
+  int m_indexStress[6];
+  int m_indexMax;
+  int m_indexMid;
+  int m_indexMin;
+  int m_indexVonMises;
+};
+//------------------------------------------------------------------------------
+}
+#endif // CALCULATEPRINCIPALSTRESS_H
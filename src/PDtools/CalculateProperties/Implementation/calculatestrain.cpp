@@ -49,7 +49,7 @@ void CalculateStrain::initialize() {
 //------------------------------------------------------------------------------
 void CalculateStrain::clean() {
   const int nParticles = m_particles->nParticles();
-  arma::mat &data = m_particles->data();
+  ParticleData &data = m_particles->data();
 
 // Zeroing the stress
 #ifdef USE_OPENMP
@@ -64,11 +64,11 @@ void CalculateStrain::clean() {
 //------------------------------------------------------------------------------
 void CalculateStrain::update() {
   const ivec &colToId = m_particles->colToId();
-  const ivec &idToCol = m_particles->getIdToCol_v();
+  const IdToColMap &idToCol = m_particles->getIdToCol_v();
   const int nParticles = m_particles->nParticles();
   const mat &r = m_particles->r();
   const mat &r0 = m_particles->r0();
-  mat &data = m_particles->data();
+  ParticleData &data = m_particles->data();
 
   mat F = zeros(m_dim, m_dim);
   mat K = zeros(m_dim, m_dim);
@@ -78,18 +78,13 @@ void CalculateStrain::update() {
 
   for (int i = 0; i < nParticles; i++) {
     const int id_i = colToId(i);
-    vector<pair<int, vector<double>>> &PDconnections_i =
-        m_particles->pdConnections(id_i);
-    const int nConnections = PDconnections_i.size();
+    BondList &PDconnections_i = m_particles->pdConnections(id_i);
     F.zeros();
     K.zeros();
     int nConnected = 0;
 
-    for (int l_j = 0; l_j < nConnections; l_j++) {
+    m_particles->forEachConnectedBond(i, [&](const int l_j) {
       const auto &con_i = PDconnections_i[l_j];
-      if (con_i.second[m_indexConnected] <= 0.5)
-        continue;
-
       const int id_j = con_i.first;
       const int j = idToCol[id_j];
 
@@ -112,7 +107,7 @@ void CalculateStrain::update() {
       }
 
       nConnected++;
-    }
+    });
 
     //        K(0, 0) = data(i, m_indexShapeFunction[0]);
     //        K(1, 1) = data(i, m_indexShapeFunction[1]);
@@ -151,18 +146,17 @@ void CalculateStrain::update() {
 //------------------------------------------------------------------------------
 void CalculateStrain::calulateShapeFunction() {
   const ivec &colToId = m_particles->colToId();
-  const ivec &idToCol = m_particles->getIdToCol_v();
+  const IdToColMap &idToCol = m_particles->getIdToCol_v();
   const int nParticles = m_particles->nParticles();
   const mat &r0 = m_particles->r0();
-  mat &data = m_particles->data();
+  ParticleData &data = m_particles->data();
 
   mat K = zeros(m_dim, m_dim);
   double dr0_ij[m_dim];
 
   for (int i = 0; i < nParticles; i++) {
     const int id_i = colToId(i);
-    vector<pair<int, vector<double>>> &PDconnections_i =
-        m_particles->pdConnections(id_i);
+    BondList &PDconnections_i = m_particles->pdConnections(id_i);
     const int nConnections = PDconnections_i.size();
     K.zeros();
 
@@ -41,7 +41,7 @@ void CalculateStress::initialize() {
 void CalculateStress::clean() {
   const int nParticles =
       m_particles->nParticles(); // + m_particles->nGhostParticles();
-  arma::mat &data = m_particles->data();
+  ParticleData &data = m_particles->data();
 
 // Zeroing the stress
 #ifdef USE_OPENMP
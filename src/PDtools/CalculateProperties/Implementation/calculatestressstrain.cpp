@@ -92,11 +92,11 @@ void CalculateStressStrain::update() {
 //------------------------------------------------------------------------------
 void CalculateStressStrain::update2d() {
   const ivec &colToId = m_particles->colToId();
-  const ivec &idToCol = m_particles->getIdToCol_v();
+  const IdToColMap &idToCol = m_particles->getIdToCol_v();
   const int nParticles = m_particles->nParticles();
   const mat &r = m_particles->r();
   const mat &r0 = m_particles->r0();
-  mat &data = m_particles->data();
+  ParticleData &data = m_particles->data();
 
   const double *d_volume = data.colptr(m_indexVolume);
   double *d_indexBrokenNow = data.colptr(m_indexBrokenNow);
@@ -169,17 +169,12 @@ void CalculateStressStrain::update2d() {
     K(1, 0) = K(0, 1);
 
     F.zeros();
-    vector<pair<int, vector<double>>> &PDconnections_i =
-        m_particles->pdConnections(id_i);
-    const int nConnections = PDconnections_i.size();
+    BondList &PDconnections_i = m_particles->pdConnections(id_i);
     int nConnected = 0;
 
-    for (int l_j = 0; l_j < nConnections; l_j++) {
+    m_particles->forEachConnectedBond(i, [&](const int l_j) {
 
       const auto &con_i = PDconnections_i[l_j];
-      if (con_i.second[m_indexConnected] <= 0.5)
-        continue;
-
       const int id_j = con_i.first;
       const int j = idToCol[id_j];
 
@@ -202,7 +197,7 @@ void CalculateStressStrain::update2d() {
       }
 
       nConnected++;
-    }
+    });
 
     if (nConnected <= 3) {
       for (int j = 0; j < m_nStressStrainElements; j++) {
@@ -260,11 +255,11 @@ void CalculateStressStrain::update2d() {
 //------------------------------------------------------------------------------
 void CalculateStressStrain::update3d() {
   const ivec &colToId = m_particles->colToId();
-  const ivec &idToCol = m_particles->getIdToCol_v();
+  const IdToColMap &idToCol = m_particles->getIdToCol_v();
   const int nParticles = m_particles->nParticles();
   const mat &r = m_particles->r();
   const mat &r0 = m_particles->r0();
-  mat &data = m_particles->data();
+  ParticleData &data = m_particles->data();
 
   const double *d_volume = data.colptr(m_indexVolume);
   double *d_indexBrokenNow = data.colptr(m_indexBrokenNow);
@@ -359,15 +354,10 @@ void CalculateStressStrain::update3d() {
     K(2, 1) = K(1, 2);
 
     F.zeros();
-    vector<pair<int, vector<double>>> &PDconnections_i =
-        m_particles->pdConnections(id_i);
-    const int nConnections = PDconnections_i.size();
+    BondList &PDconnections_i = m_particles->pdConnections(id_i);
     int nConnected = 0;
-    for (int l_j = 0; l_j < nConnections; l_j++) {
+    m_particles->forEachConnectedBond(i, [&](const int l_j) {
       const auto &con_i = PDconnections_i[l_j];
-      if (con_i.second[m_indexConnected] <= 0.5)
-        continue;
-
       const int id_j = con_i.first;
       const int j = idToCol[id_j];
       const double vol_j = d_volume[j];
@@ -391,7 +381,7 @@ void CalculateStressStrain::update3d() {
       }
 
       nConnected++;
-    }
+    });
 
     if (nConnected <= 3) {
       for (int j = 0; j < m_nStressStrainElements; j++) {
@@ -449,12 +439,11 @@ void CalculateStressStrain::update3d() {
 //------------------------------------------------------------------------------
 void CalculateStressStrain::computeK(int id, int i) {
   //    cout << "Recomputing K " << id << endl;
-  const ivec &idToCol = m_particles->getIdToCol_v();
+  const IdToColMap &idToCol = m_particles->getIdToCol_v();
   const mat &r0 = m_particles->r0();
-  mat &data = m_particles->data();
+  ParticleData &data = m_particles->data();
   mat K = zeros(m_dim, m_dim);
-  vector<pair<int, vector<double>>> &PDconnections_i =
-      m_particles->pdConnections(id);
+  BondList &PDconnections_i = m_particles->pdConnections(id);
   const int nConnections = PDconnections_i.size();
   double dr0_ij[m_dim];
 
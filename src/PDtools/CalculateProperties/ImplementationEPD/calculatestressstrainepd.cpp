@@ -93,7 +93,7 @@ void CalculateStressStrainEPD::update() {
   const int nParticles = m_particles->nParticles();
   const mat &r = m_particles->r();
   const mat &r0 = m_particles->r0();
-  mat &data = m_particles->data();
+  ParticleData &data = m_particles->data();
   vector<PD_quadElement> &quadElements = m_particles->getQuadElements();
   unordered_map<int, int> &idToElement = m_particles->getIdToElement();
 
@@ -121,16 +121,11 @@ void CalculateStressStrainEPD::update() {
     }
 
     F.zeros();
-    vector<pair<int, vector<double>>> &PDconnections_i =
-        m_particles->pdConnections(id_i);
-    const int nConnections = PDconnections_i.size();
+    BondList &PDconnections_i = m_particles->pdConnections(id_i);
     int nConnected = 0;
 
-    for (int l_j = 0; l_j < nConnections; l_j++) {
+    m_particles->forEachConnectedBond(i, [&](const int l_j) {
       const auto &con_i = PDconnections_i[l_j];
-      if (con_i.second[m_indexConnected] <= 0.5)
-        continue;
-
       const int polygon_id = con_i.first;
       const int polygon_i = idToElement.at(polygon_id);
 
@@ -169,7 +164,7 @@ void CalculateStressStrainEPD::update() {
         }
         nConnected++;
       }
-    }
+    });
 
     if (nConnected <= 3) {
       data(i, m_indexStrain[0]) = 0;
@@ -236,10 +231,9 @@ void CalculateStressStrainEPD::update() {
 //------------------------------------------------------------------------------
 void CalculateStressStrainEPD::computeK(int id, int i) {
   const mat &r0 = m_particles->r0();
-  mat &data = m_particles->data();
+  ParticleData &data = m_particles->data();
   mat K = zeros(m_dim, m_dim);
-  vector<pair<int, vector<double>>> &PDconnections_i =
-      m_particles->pdConnections(id);
+  BondList &PDconnections_i = m_particles->pdConnections(id);
   const int nConnections = PDconnections_i.size();
   double dr0_ij[m_dim];
 
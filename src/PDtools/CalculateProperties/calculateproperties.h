@@ -2,11 +2,13 @@
 #define CALCULATEPROPERTIES
 
 #include <PDtools/CalculateProperties/calculateproperty.h>
+#include <PDtools/CalculateProperties/propertyscheduler.h>
 #include <PDtools/CalculateProperties/Implementation/calculatepdangles.h>
 #include <PDtools/CalculateProperties/Implementation/calculatestress.h>
 #include <PDtools/CalculateProperties/Implementation/calculatestrain.h>
 #include <PDtools/CalculateProperties/Implementation/calculatedamage.h>
 #include <PDtools/CalculateProperties/Implementation/calculatestressstrain.h>
+#include <PDtools/CalculateProperties/Implementation/calculateprincipalstress.h>
 
 #endif // CALCULATEPROPERTIES
 
@@ -1,5 +1,7 @@
 #include "calculateproperty.h"
 
+#include <algorithm>
+
 namespace PDtools {
 //------------------------------------------------------------------------------
 CalculateProperty::CalculateProperty(string _type) : type(_type) {}
@@ -14,6 +16,32 @@ void CalculateProperty::setUpdateFrquency(int updateFrquency) {
   m_updateFrequency = updateFrquency;
 }
 //------------------------------------------------------------------------------
+void CalculateProperty::addConsumer(const int frequency) {
+  m_consumers.push_back(std::max(frequency, 1));
+}
+//------------------------------------------------------------------------------
+bool CalculateProperty::readOn(const int timeStep) const {
+  // Without consumers, on the update frequency
+  if (m_consumers.empty())
+    return timeStep % m_updateFrequency == 0;
+
+  for (const int frequency : m_consumers) {
+    if (timeStep % frequency == 0)
+      return true;
+  }
+  return false;
+}
+//------------------------------------------------------------------------------
+const vector<string> &CalculateProperty::dependencies() const {
+  return m_dependencies;
+}
+//------------------------------------------------------------------------------
+bool CalculateProperty::needsForceStress() const { return m_needsForceStress; }
+//------------------------------------------------------------------------------
+void CalculateProperty::setPresentDependencies(const vector<string> &types) {
+  (void)types;
+}
+//------------------------------------------------------------------------------
 void CalculateProperty::clean() {}
 //------------------------------------------------------------------------------
 int CalculateProperty::dim() const { return m_dim; }
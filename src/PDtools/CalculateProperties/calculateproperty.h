@@ -17,6 +17,12 @@ public:
   virtual void initialize();
   int updateFrequency() const;
   void setUpdateFrquency(int updateFrequency);
+  void addConsumer(const int frequency);
+  bool readOn(const int timeStep) const;
+  const vector<string> &dependencies() const;
+  bool needsForceStress() const;
+  // The types of the dependencies among the properties computed
+  virtual void setPresentDependencies(const vector<string> &types);
   virtual void clean();
   virtual void update() = 0;
   int dim() const;
@@ -24,9 +30,16 @@ public:
   void setParticles(PD_Particles &particles);
 
 protected:
-  PD_Particles *m_particles;
+  PD_Particles *m_particles = nullptr;
   int m_dim;
   int m_updateFrequency = 1;
+  // Every how many steps each consumer reads the property
+  vector<int> m_consumers;
+  // The types of the properties it is computed from, when they are present
+  vector<string> m_dependencies;
+  // Reads the stress accumulated by the forces, not its own. May depend on
+  // the dependencies present.
+  bool m_needsForceStress = false;
 };
 //------------------------------------------------------------------------------
 }
@@ -0,0 +1,110 @@
+#include "propertyscheduler.h"
+#include "calculateproperty.h"
+
+#include <functional>
+
+namespace PDtools {
+//------------------------------------------------------------------------------
+void PropertyScheduler::setProperties(
+    const vector<CalculateProperty *> &properties) {
+  const int nProperties = properties.size();
+
+  // The dependencies present, by the index in properties
+  vector<vector<int>> dependencies(nProperties);
+  for (int p = 0; p < nProperties; p++) {
+    vector<string> presentTypes;
+    for (const string &type : properties[p]->dependencies()) {
+      for (int q = 0; q < nProperties; q++) {
+        if (q != p && properties[q]->type == type) {
+          dependencies[p].push_back(q);
+          presentTypes.push_back(type);
+        }
+      }
+    }
+    properties[p]->setPresentDependencies(presentTypes);
+  }
+
+  // Depth first, keeping the given order where there are no dependencies
+  vector<int> order;
+  vector<int> state(nProperties, 0);
+  std::function<void(int)> visit = [&](const int p) {
+    if (state[p] == 2)
+      return;
+    if (state[p] == 1) {
+      cerr << "ERROR: the property '" << properties[p]->type
+           << "' depends on itself" << endl;
+      throw CyclicDependency;
+    }
+    state[p] = 1;
+    for (const int q : dependencies[p]) {
+      visit(q);
+    }
+    state[p] = 2;
+    order.push_back(p);
+  };
+  for (int p = 0; p < nProperties; p++) {
+    visit(p);
+  }
+
+  vector<int> position(nProperties);
+  m_properties.clear();
+  for (int k = 0; k < nProperties; k++) {
+    position[order[k]] = k;
+    m_properties.push_back(properties[order[k]]);
+  }
+
+  m_dependencies.assign(nProperties, vector<int>());
+  m_dependents.assign(nProperties, vector<int>());
+  for (int p = 0; p < nProperties; p++) {
+    for (const int q : dependencies[p]) {
+      m_dependencies[position[p]].push_back(position[q]);
+      m_dependents[position[q]].push_back(position[p]);
+    }
+  }
+
+  m_lastStep.assign(nProperties, -1);
+  m_lastState.assign(nProperties, -1);
+}
+//------------------------------------------------------------------------------
+bool PropertyScheduler::needed(const int p, const int timeStep) const {
+  if (m_properties[p]->readOn(timeStep))
+    return true;
+
+  for (const int q : m_dependents[p]) {
+    if (needed(q, timeStep))
+      return true;
+  }
+  return false;
+}
+//------------------------------------------------------------------------------
+const vector<int> &PropertyScheduler::schedule(const int timeStep,
+                                               const bool all) {
+  const int nProperties = m_properties.size();
+
+  // The dependents come after their dependencies
+  m_needed.assign(nProperties, 0);
+  for (int p = nProperties - 1; p >= 0; p--) {
+    if (all || m_properties[p]->readOn(timeStep))
+      m_needed[p] = 1;
+    if (!m_needed[p])
+      continue;
+    for (const int q : m_dependencies[p]) {
+      m_needed[q] = 1;
+    }
+  }
+
+  m_schedule.clear();
+  for (int p = 0; p < nProperties; p++) {
+    if (!m_needed[p])
+      continue;
+    if (m_lastStep[p] == timeStep && m_lastState[p] == m_state)
+      continue;
+
+    m_schedule.push_back(p);
+    m_lastStep[p] = timeStep;
+    m_lastState[p] = m_state;
+  }
+  return m_schedule;
+}
+//------------------------------------------------------------------------------
+}
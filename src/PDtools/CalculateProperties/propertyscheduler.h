@@ -0,0 +1,59 @@
+#ifndef PROPERTYSCHEDULER_H
+#define PROPERTYSCHEDULER_H
+
+#include "config.h"
+
+namespace PDtools {
+class CalculateProperty;
+
+//------------------------------------------------------------------------------
+// Decides which properties are computed on a step, from what their consumers
+// read.
+//
+// The consumers, the fracture criteria, the forces and the output, declare
+// every how many steps they read a property with
+// CalculateProperty::addConsumer(). A property is needed on a step that one
+// of its consumers reads, or that a needed property computed from it reads,
+// and is computed after the properties it depends on.
+//
+// A property is computed at most once per step and state. Asked again for
+// the same step, it is only recomputed if the forces have been evaluated
+// since, as in the relaxation of an ADR step.
+//------------------------------------------------------------------------------
+class PropertyScheduler {
+public:
+  // Ordered with the dependencies first
+  void setProperties(const vector<CalculateProperty *> &properties);
+  const vector<CalculateProperty *> &properties() const;
+
+  bool needed(const int p, const int timeStep) const;
+  void stateChanged();
+
+  // The properties to compute on the step, in order. They are counted as
+  // computed. With all, every property is computed, e.g. for an output
+  // that is not on a step multiple.
+  const vector<int> &schedule(const int timeStep, const bool all = false);
+
+protected:
+  vector<CalculateProperty *> m_properties;
+  vector<vector<int>> m_dependencies;
+  vector<vector<int>> m_dependents;
+  vector<int> m_lastStep;
+  vector<long> m_lastState;
+  long m_state = 0;
+  vector<char> m_needed;
+  vector<int> m_schedule;
+
+  enum ErrorCodes { CyclicDependency };
+};
+//------------------------------------------------------------------------------
+// Inline functions
+inline const vector<CalculateProperty *> &
+PropertyScheduler::properties() const {
+  return m_properties;
+}
+
+inline void PropertyScheduler::stateChanged() { m_state++; }
+//------------------------------------------------------------------------------
+}
+#endif // PROPERTYSCHEDULER_H
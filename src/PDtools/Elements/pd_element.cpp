@@ -41,12 +41,12 @@ PD_Particles initializeElementPd(const PdMesh &msh, const Grid &grid,
   particles.initializeMatrices();
   particles.initializeElements(nTriangles, nQuads, quadratureDegree);
 
-  ivec &idToCol = particles.getIdToCol_v();
+  IdToColMap &idToCol = particles.getIdToCol_v();
   arma::ivec &get_id = particles.colToId();
   arma::mat &r0 = particles.r0();
   arma::mat &r = particles.r();
   //    arma::mat & v = particles.v();
-  //    arma::mat & data = particles.data();
+  //    ParticleData & data = particles.data();
 
   int elementId = 0;
   int pd_nodeId = 0;
@@ -205,6 +205,7 @@ PD_Particles initializeElementPd(const PdMesh &msh, const Grid &grid,
   }
 
   particles.nParticles(pd_col);
+  particles.shrinkToFit();
   cout << pd_col << " " << nParticles << endl;
 
   //--------------------------------------------------------------------------
@@ -232,7 +233,7 @@ void updateElementQuadrature(PD_Particles &nodes) {
   // TODO: elements are not MPI ready - only the appropriate elements should be
   // updated
   const mat &R = nodes.r();
-  const ivec &idToCol = nodes.getIdToCol_v();
+  const IdToColMap &idToCol = nodes.getIdToCol_v();
   vector<PD_quadElement> &quadElements = nodes.getQuadElements();
   const mat &shapeFunction = nodes.getShapeFunction();
 
@@ -41,6 +41,14 @@ public:
     m_guassianQuadratureWeights = arma::vec(guassianQuadratureWeights);
   }
 
+  // The quadrature points and weights
+  size_t allocatedBytes() const {
+    return (m_guassianQuadraturePoints_initial.n_elem +
+            m_guassianQuadraturePoints.n_elem +
+            m_guassianQuadratureWeights.n_elem) *
+           sizeof(double);
+  }
+
 protected:
   size_t m_id;
   array<size_t, T> m_verticeIds;
@@ -8,7 +8,8 @@ DemForce::DemForce(PD_Particles &particles, double T, double C)
   m_indexVolume = m_particles.getParamId("volume");
   m_indexDr0 = m_particles.getPdParamId("dr0");
   m_indexVolumeScaling = m_particles.getPdParamId("volumeScaling");
-  m_indexStretch = m_particles.registerPdParameter("stretch");
+  m_indexStretch = m_particles.registerPdParameter("stretch", 0,
+                                                   BondData::Float);
   m_indexConnected = m_particles.getPdParamId("connected");
   m_indexRadius = m_particles.getParamId("radius");
   m_indexUnbreakable = m_particles.registerParameter("unbreakable");
@@ -29,18 +30,13 @@ DemForce::DemForce(PD_Particles &particles, double T, double C)
 }
 //------------------------------------------------------------------------------
 void DemForce::calculateForces(const int id_i, const int i) {
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_i);
-  const int nConnections = PDconnections.size();
+  BondList &PDconnections = m_particles.pdConnections(id_i);
   double dr_ij[m_dim];
   const double radius_i = m_data(i, m_indexRadius);
   const double A_i = M_PI * pow(radius_i, 2);
 
-  for (int l_j = 0; l_j < nConnections; l_j++) {
+  m_particles.forEachConnectedBond(i, [&](const int l_j) {
     auto &con = PDconnections[l_j];
-    if (con.second[m_indexConnected] <= 0.5)
-      continue;
-
     const int id_j = con.first;
     const int j = m_idToCol_v[id_j];
 
@@ -64,24 +60,19 @@ void DemForce::calculateForces(const int id_i, const int i) {
 
     if (normalForce > m_T * A) {
       if (!m_data(j, m_indexUnbreakable))
-        con.second[m_indexConnected] = 0;
+        m_particles.breakBond(id_i, con);
     }
-  }
+  });
 }
 //------------------------------------------------------------------------------
 void DemForce::calculateStress(const int id_i, const int i,
                                const int (&indexStress)[6]) {
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_i);
-  const int nConnections = PDconnections.size();
+  BondList &PDconnections = m_particles.pdConnections(id_i);
   double dr_ij[m_dim];
   const double vol_i = m_data(i, m_indexVolume);
 
-  for (int l_j = 0; l_j < nConnections; l_j++) {
+  m_particles.forEachConnectedBond(i, [&](const int l_j) {
     auto &con = PDconnections[l_j];
-    if (con.second[m_indexConnected] <= 0.5)
-      continue;
-
     const int id_j = con.first;
     const int j = m_idToCol_v[id_j];
 
@@ -104,7 +95,7 @@ void DemForce::calculateStress(const int id_i, const int i,
       m_data(i, indexStress[4]) += 0.5 * bond_ij * dr_ij[X] * dr_ij[Z];
       m_data(i, indexStress[5]) += 0.5 * bond_ij * dr_ij[Y] * dr_ij[Z];
     }
-  }
+  });
 }
 //------------------------------------------------------------------------------
 void DemForce::initialize(double E, double nu, double delta, int dim, double h,
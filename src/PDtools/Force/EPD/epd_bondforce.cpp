@@ -23,10 +23,8 @@ EPD_bondForce::EPD_bondForce(PD_Particles &particles)
 //------------------------------------------------------------------------------
 void EPD_bondForce::calculateForces(const int id_i, const int i) {
   const double c = m_data(i, m_indexMicromodulus);
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_i);
+  BondList &PDconnections = m_particles.pdConnections(id_i);
 
-  const int nConnections = PDconnections.size();
   double dr_ij[m_dim];
   double dr0_ij[m_dim];
 
@@ -34,11 +32,8 @@ void EPD_bondForce::calculateForces(const int id_i, const int i) {
   vec f_correction = zeros(m_dim);
   vec du_ij = zeros(m_dim);
 #endif
-  for (int l_j = 0; l_j < nConnections; l_j++) {
+  m_particles.forEachConnectedBond(i, [&](const int l_j) {
     auto &con = PDconnections[l_j];
-    if (con.second[m_iConnected] <= 0.5)
-      continue;
-
     const int polygon_id = con.first;
     const int polygon_i = m_idToElement.at(polygon_id);
 
@@ -96,7 +91,7 @@ void EPD_bondForce::calculateForces(const int id_i, const int i) {
         m_F(i, d) += Fd;
       }
     }
-  }
+  });
   for (int d = 0; d < m_dim; d++) {
     m_F(i, d) += f_correction(d);
   }
@@ -115,8 +110,7 @@ double EPD_bondForce::calculateStableMass(const int id_a, const int a,
     m[d] = 0;
   }
 
-  const vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_a);
+  const BondList &PDconnections = m_particles.pdConnections(id_a);
 
   double k[m_dim];
 
@@ -125,10 +119,8 @@ double EPD_bondForce::calculateStableMass(const int id_a, const int a,
       k[d] = 0;
     }
 
-    for (auto &con : PDconnections) {
-      if (con.second[m_iConnected] <= 0.5)
-        continue;
-
+    m_particles.forEachConnectedBond(a, [&](const int l_j) {
+      auto &con = PDconnections[l_j];
       const int polygon_id = con.first;
       const int polygon_i = m_idToElement.at(polygon_id);
 
@@ -169,7 +161,7 @@ double EPD_bondForce::calculateStableMass(const int id_a, const int a,
 
         k[i] += sum;
       }
-    }
+    });
     m[i] = k[i];
   }
 
@@ -231,8 +223,7 @@ void EPD_bondForce::computeMicromodulus() {
 
   for (unsigned int i = 0; i < m_particles.nParticles(); i++) {
     const int id_i = colToId(i);
-    vector<pair<int, vector<double>>> &PDconnections =
-        m_particles.pdConnections(id_i);
+    BondList &PDconnections = m_particles.pdConnections(id_i);
 
     const int nConnections = PDconnections.size();
     double m_i = 0;
@@ -14,7 +14,7 @@ EPD_LPS::EPD_LPS(PD_Particles &particles, bool planeStress)
   m_iVolume = m_particles.getParamId("volume");
   m_iDr0 = m_particles.getPdParamId("dr0");
   m_iOverlap = m_particles.getPdParamId("overlap");
-  m_iStretch = m_particles.registerPdParameter("stretch");
+  m_iStretch = m_particles.registerPdParameter("stretch", 0, BondData::Float);
   m_iConnected = m_particles.getPdParamId("connected");
   m_indexBrokenNow = m_particles.registerParameter("brokenNow", 0);
 
@@ -24,14 +24,14 @@ EPD_LPS::EPD_LPS(PD_Particles &particles, bool planeStress)
 
   m_initialGhostParameters = {"volume", "theta", "LPS_mass"};
   m_hasUpdateState = true;
+  m_hasLocalUpdateState = true;
 }
 //------------------------------------------------------------------------------
 void EPD_LPS::calculateForces(const int id, const int i) {
   //    const double theta_i = m_data(i, m_iTheta);
   const double m_i = m_data(i, m_iMass);
 
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id);
+  BondList &PDconnections = m_particles.pdConnections(id);
 
   const int nConnections = PDconnections.size();
   double dr_ij[m_dim];
@@ -40,11 +40,8 @@ void EPD_LPS::calculateForces(const int id, const int i) {
   double thetaNew = 0;
 
   // First looping over all polygons
-  for (int l_j = 0; l_j < nConnections; l_j++) {
+  m_particles.forEachConnectedBond(i, [&](const int l_j) {
     auto &con = PDconnections[l_j];
-    if (con.second[m_iConnected] <= 0.5)
-      continue;
-
     const int polygon_id = con.first;
     const int polygon_i = m_idToElement.at(polygon_id);
 
@@ -98,7 +95,7 @@ void EPD_LPS::calculateForces(const int id, const int i) {
 
     con.second[m_iStretch] = ds/dr0;
     */
-  }
+  });
 
   if (nConnections <= 3)
     m_data(i, m_iThetaNew) = 0;
@@ -119,17 +116,13 @@ double EPD_LPS::computeDilation(const int id_i, const int i) {
   const double m_i = m_data(i, m_iMass);
   double dr_ij[m_dim];
 
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_i);
+  BondList &PDconnections = m_particles.pdConnections(id_i);
   const int nConnections = PDconnections.size();
 
   double theta_i = 0;
 
-  for (int l_j = 0; l_j < nConnections; l_j++) {
+  m_particles.forEachConnectedBond(i, [&](const int l_j) {
     auto &con = PDconnections[l_j];
-    if (con.second[m_iConnected] <= 0.5)
-      continue;
-
     const int id_j = con.first;
     const int j = m_idToCol_v[id_j];
 
@@ -147,7 +140,7 @@ double EPD_LPS::computeDilation(const int id_i, const int i) {
     const double dr = sqrt(dr2);
     const double ds = dr - dr0;
     theta_i += w * dr0 * ds * vol_j * volumeScaling;
-  }
+  });
 
   if (nConnections <= 3) {
     theta_i = 0;
@@ -179,8 +172,7 @@ double EPD_LPS::calculateStableMass(const int id_a, const int a, double dt) {
     m[d] = 0;
   }
 
-  const vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_a);
+  const BondList &PDconnections = m_particles.pdConnections(id_a);
 
   double k[m_dim];
 
@@ -189,10 +181,8 @@ double EPD_LPS::calculateStableMass(const int id_a, const int a, double dt) {
       k[d] = 0;
     }
 
-    for (auto &con : PDconnections) {
-      if (con.second[m_iConnected] <= 0.5)
-        continue;
-
+    m_particles.forEachConnectedBond(a, [&](const int l_j) {
+      auto &con = PDconnections[l_j];
       const int id_b = con.first;
       const int b = m_idToCol_v[id_b];
 
@@ -220,7 +210,7 @@ double EPD_LPS::calculateStableMass(const int id_a, const int a, double dt) {
       }
 
       k[i] += fabs(dr0[i]) * C * sum;
-    }
+    });
     m[i] = k[i];
   }
 
@@ -279,8 +269,7 @@ void EPD_LPS::calculateWeightedVolume() {
   for (int i = 0; i < nParticles; i++) {
     const int id_i = m_colToId.at(i);
 
-    const vector<pair<int, vector<double>>> &PDconnections =
-        m_particles.pdConnections(id_i);
+    const BondList &PDconnections = m_particles.pdConnections(id_i);
     const int nConnections = PDconnections.size();
     double m = 0;
     for (int l_j = 0; l_j < nConnections; l_j++) {
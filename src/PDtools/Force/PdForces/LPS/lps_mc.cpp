@@ -1,4 +1,5 @@
 #include "lps_mc.h"
+#include "PDtools/PdFunctions/pdfunctions.h"
 
 #define USE_PRINCIPAL_STRESS 1
 
@@ -8,6 +9,7 @@ LPS_mc::LPS_mc(PD_Particles &particles, double c, double phi, double C,
                double T, bool planeStress, bool analyticalM)
     : PD_LPS(particles, planeStress, analyticalM), m_dampCoeff(c), m_T(T) {
   particles.setNeedGhostVelocity(true);
+  m_readsNeighbourVelocity = true;
   m_particles.setNeedGhostR0(true);
   m_hasStepTwoModifier = true;
 
@@ -113,8 +115,7 @@ void LPS_mc::calculateForces(const int id, const int i) {
   const double theta_i = m_data(i, m_iTheta);
   const double m_i = m_data(i, m_iMass);
 
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id);
+  BondList &PDconnections = m_particles.pdConnections(id);
 
   const int nConnections = PDconnections.size();
   double dr0_ij[m_dim];
@@ -124,12 +125,9 @@ void LPS_mc::calculateForces(const int id, const int i) {
   double thetaNew = 0;
   int nConnected = 0;
 
-  for (int l_j = 0; l_j < nConnections; l_j++) {
+  m_particles.forEachConnectedBond(i, [&](const int l_j) {
     auto &con = PDconnections[l_j];
 
-    if (con.second[m_iConnected] <= 0.5)
-      continue;
-
     const int id_j = con.first;
     const int j = m_idToCol_v[id_j];
 
@@ -168,7 +166,7 @@ void LPS_mc::calculateForces(const int id, const int i) {
     }
 
     nConnected++;
-  }
+  });
 
   if (nConnections <= 5) {
     m_data(i, m_iThetaNew) = 0;
@@ -185,24 +183,18 @@ void LPS_mc::calculateForces(const int id, const int i) {
 void LPS_mc::evaluateStepTwo(int id_i, int i) {
   if (m_data(i, m_indexUnbreakable) >= 1)
     return;
-#if CALCULATE_NUMMERICAL_PRINCIPAL_STRESS
-  arma::vec eigval(m_dim);
-#endif
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_i);
+  BondList &PDconnections = m_particles.pdConnections(id_i);
   const double shearCrit = m_C0 - m_ks * m_T;
 
   bool broken = false;
   if (m_dim == 2) {
-    for (auto &con : PDconnections) {
+    m_particles.forEachConnectedBond(i, [&](const int l_j) {
+      auto &con = PDconnections[l_j];
       const int id_j = con.first;
       const int j = m_idToCol_v[id_j];
 
       if (m_data(j, m_indexUnbreakable) >= 1)
-        continue;
-
-      if (con.second[m_indexConnected] <= 0.5)
-        continue;
+        return;
 
       const double sx =
           0.5 * (m_data(i, m_indexStress[0]) + m_data(j, m_indexStress[0]));
@@ -233,81 +225,37 @@ void LPS_mc::evaluateStepTwo(int id_i, int i) {
       if (MC_valid) {
         if (criticalShear) {
           m_data(i, m_indexBrokenNow) = 1;
-          con.second[m_indexConnected] = 0;
+          m_particles.breakBond(id_i, con);
           broken = true;
         }
       } else {
         if (criticalTensile) {
           m_data(i, m_indexBrokenNow) = 1;
-          con.second[m_indexConnected] = 0;
+          m_particles.breakBond(id_i, con);
           broken = true;
         }
       }
-    }
+    });
   } else if (m_dim == 3) {
-    arma::mat S(m_dim, m_dim);
+    double s[6];
 
-    for (auto &con : PDconnections) {
+    m_particles.forEachConnectedBond(i, [&](const int l_j) {
+      auto &con = PDconnections[l_j];
       const int id_j = con.first;
       const int j = m_idToCol_v[id_j];
 
       if (m_data(j, m_indexUnbreakable) >= 1)
-        continue;
-
-      if (con.second[m_indexConnected] <= 0.5)
-        continue;
+        return;
 
-      S(0, 0) =
-          0.5 * (m_data(i, m_indexStress[0]) + m_data(j, m_indexStress[0]));
-      S(1, 1) =
-          0.5 * (m_data(i, m_indexStress[1]) + m_data(j, m_indexStress[1]));
-      S(0, 1) =
-          0.5 * (m_data(i, m_indexStress[2]) + m_data(j, m_indexStress[2]));
-      S(1, 0) = S(0, 1);
-      S(2, 2) =
-          0.5 * (m_data(i, m_indexStress[3]) + m_data(j, m_indexStress[3]));
-      S(0, 2) =
-          0.5 * (m_data(i, m_indexStress[4]) + m_data(j, m_indexStress[4]));
-      S(2, 0) = S(0, 2);
-      S(1, 2) =
-          0.5 * (m_data(i, m_indexStress[5]) + m_data(j, m_indexStress[5]));
-      S(2, 1) = S(1, 2);
-
-#if CALCULATE_NUMMERICAL_PRINCIPAL_STRESS
-      arma::eig_sym(eigval, S);
-      const double p_1 = eigval(2);
-      const double p_2 = eigval(0);
-#else
-      const double I1 = S(0, 0) + S(1, 1) + S(2, 2);
-      const double I2 = S(0, 0) * S(1, 1) + S(1, 1) * S(2, 2) +
-                        S(3, 3) * S(0, 0) - pow(S(0, 1), 2) - pow(S(1, 2), 2) -
-                        pow(S(0, 2), 2);
-      const double I3 = S(0, 0) * S(1, 1) * S(2, 2) -
-                        S(0, 0) * pow(S(1, 2), 2) - S(1, 1) * pow(S(0, 2), 2) -
-                        S(2, 2) * pow(S(0, 1), 2) +
-                        2 * S(0, 1) * S(1, 2) * S(0, 2);
-      const double phi =
-          1. / 3. * acos(0.5 * (2 * pow(I1, 3) - 9 * I1 * I2 + 27 * I3) /
-                         pow(pow(I1, 2) - 3 * I2, 1.5));
-
-      const double core = 2. / 3. * (sqrt(I1 * I1 - 3 * I2));
-      const double s1 = I1 / 3. + core * cos(phi);
-      const double s2 = I1 / 3. + core * cos(phi - 2. * M_PI / 3.);
-      const double s3 = I1 / 3. + core * cos(phi - 4. * M_PI / 3.);
-
-      double p_1 = s1;
-      double p_2 = s2;
-
-      if (s2 > p_1) {
-        p_1 = s2;
-        p_2 = s1;
+      for (int k = 0; k < 6; k++) {
+        s[k] =
+            0.5 * (m_data(i, m_indexStress[k]) + m_data(j, m_indexStress[k]));
       }
-      if (s3 > p_1) {
-        p_1 = s3;
-      } else if (p_2 < s3) {
-        p_2 = s3;
-      }
-#endif
+
+      // The largest (p_1) and smallest (p_2) principal stress
+      double p_1, p_mid, p_2;
+      principalStresses3d(1, &s[0], &s[1], &s[3], &s[2], &s[4], &s[5], &p_1,
+                          &p_mid, &p_2);
       const int criticalShear = p_2 <= m_C0 - m_ks * p_1;
       const int MC_valid = p_2 < shearCrit;
       const int criticalTensile = p_1 >= m_T;
@@ -315,17 +263,17 @@ void LPS_mc::evaluateStepTwo(int id_i, int i) {
       if (MC_valid) {
         if (criticalShear) {
           m_data(i, m_indexBrokenNow) = 1;
-          con.second[m_indexConnected] = 0;
+          m_particles.breakBond(id_i, con);
           broken = true;
         }
       } else {
         if (criticalTensile) {
           m_data(i, m_indexBrokenNow) = 1;
-          con.second[m_indexConnected] = 0;
+          m_particles.breakBond(id_i, con);
           broken = true;
         }
       }
-    }
+    });
   }
 
   if (broken) {
@@ -439,12 +387,11 @@ void LPS_mc::computeStress(const int id, const int i, const int nConnected) {
 }
 //------------------------------------------------------------------------------
 void LPS_mc::computeK(int id, int i) {
-  const ivec &idToCol = m_particles.getIdToCol_v();
+  const IdToColMap &idToCol = m_particles.getIdToCol_v();
   const mat &r0 = m_particles.r0();
-  mat &data = m_particles.data();
+  ParticleData &data = m_particles.data();
   mat K = zeros(m_dim, m_dim);
-  vector<pair<int, vector<double>>> &PDconnections_i =
-      m_particles.pdConnections(id);
+  BondList &PDconnections_i = m_particles.pdConnections(id);
   const int nConnections = PDconnections_i.size();
   double dr0_ij[m_dim];
   double totalVolume = 0;
@@ -12,8 +12,14 @@ PD_LPS::PD_LPS(PD_Particles &particles, bool planeStress, bool analyticalM)
   m_iVolume = m_particles.getParamId("volume");
   m_iDr0 = m_particles.getPdParamId("dr0");
   m_iVolumeScaling = m_particles.getPdParamId("volumeScaling");
-  m_iStretch = m_particles.registerPdParameter("stretch");
+  m_iStretch = m_particles.registerPdParameter("stretch", 0, BondData::Float);
   m_iConnected = m_particles.getPdParamId("connected");
+  m_floatBonds =
+      m_particles.bondLayout().precision(m_iStretch) == BondData::Float;
+  if (m_floatBonds)
+    resolveBondFields(m_floatFields);
+  else
+    resolveBondFields(m_doubleFields);
   m_indexBrokenNow = m_particles.registerParameter("brokenNow", 0);
 
   //    m_iForceScalingDilation =
@@ -27,6 +33,8 @@ PD_LPS::PD_LPS(PD_Particles &particles, bool planeStress, bool analyticalM)
 
   m_initialGhostParameters = {"volume", "theta", "LPS_mass"};
   m_hasUpdateState = true;
+  m_hasLocalUpdateState = true;
+  m_particles.subscribeBondBreaks(this);
   m_analyticalM = analyticalM;
 
   //----------------------------------
@@ -36,8 +44,6 @@ PD_LPS::PD_LPS(PD_Particles &particles, bool planeStress, bool analyticalM)
     m_indexStress[1] = m_particles.registerParameter("s_yy");
     m_indexStress[2] = m_particles.registerParameter("s_xy");
 
-    for (int i = 0; i < 3; i++)
-      m_stress.push_back(m_data.colptr(m_indexStress[i]));
   } else if (m_dim == 3) {
     m_indexStress[0] = m_particles.registerParameter("s_xx");
     m_indexStress[1] = m_particles.registerParameter("s_yy");
@@ -46,10 +52,14 @@ PD_LPS::PD_LPS(PD_Particles &particles, bool planeStress, bool analyticalM)
     m_indexStress[4] = m_particles.registerParameter("s_xz");
     m_indexStress[5] = m_particles.registerParameter("s_yz");
 
-    for (int i = 0; i < 6; i++)
-      m_stress.push_back(m_data.colptr(m_indexStress[i]));
   }
   //----------------------------------
+  storageResized();
+  m_particles.subscribeStorage(this);
+}
+//------------------------------------------------------------------------------
+void PD_LPS::storageResized() {
+  // The cached column pointers
   m_mass = m_data.colptr(m_iMass);
   m_theta = m_data.colptr(m_iTheta);
   m_volume = m_data.colptr(m_iVolume);
@@ -61,15 +71,40 @@ PD_LPS::PD_LPS(PD_Particles &particles, bool planeStress, bool analyticalM)
   m_Fy = m_F.colptr(1);
   m_Fz = m_F.colptr(2);
   m_theta_new = m_data.colptr(m_iThetaNew);
+
+  const int nStress = m_dim == 3 ? 6 : m_dim == 2 ? 3 : 0;
+  m_stress.clear();
+  for (int k = 0; k < nStress; k++)
+    m_stress.push_back(m_data.colptr(m_indexStress[k]));
+}
+//------------------------------------------------------------------------------
+template <typename T>
+void PD_LPS::resolveBondFields(BondFields<T> &fields) const {
+  const BondLayout &layout = m_particles.bondLayout();
+  fields.dr0 = layout.field<double>(m_iDr0);
+  fields.volumeScaling = layout.field<T>(m_iVolumeScaling);
+  fields.stretch = layout.field<T>(m_iStretch);
+}
+//------------------------------------------------------------------------------
+PD_LPS::~PD_LPS() {
+  m_particles.unsubscribeBondBreaks(this);
+  m_particles.unsubscribeStorage(this);
 }
 //------------------------------------------------------------------------------
 void PD_LPS::calculateForces(const int id, const int i) {
+  if (m_floatBonds)
+    calculateForcesKernel(id, i, m_floatFields);
+  else
+    calculateForcesKernel(id, i, m_doubleFields);
+}
+//------------------------------------------------------------------------------
+template <typename T>
+void PD_LPS::calculateForcesKernel(const int id, const int i,
+                                   const BondFields<T> &fields) {
   const double theta_i = m_theta[i];
   const double m_i = m_mass[i];
 
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id);
-  const int nConnections = PDconnections.size();
+  BondList &PDconnections = m_particles.pdConnections(id);
   double dr_ij[m_dim];
 
   double thetaNew = 0;
@@ -81,22 +116,19 @@ void PD_LPS::calculateForces(const int id, const int i) {
     for (int k = 0; k < 6; k++)
       m_stress[k][i] = 0;
     //----------------------------------
-    for (int l_j = 0; l_j < nConnections; ++l_j) {
+    const vector<int> &neighbourCols = m_particles.neighbourColumns(i);
+    m_particles.forEachConnectedBond(i, [&](const int l_j) {
       auto &con = PDconnections[l_j];
-      const int id_j = con.first;
-      const int j = m_idToCol_v[id_j];
-
-      vector<double> &con_data = con.second;
-      if (con_data[m_iConnected] <= 0.5)
-        continue;
+      const int j = neighbourCols[l_j];
+      BondData &con_data = con.second;
 
       const double m_j = m_mass[j];
       const double theta_j = m_theta[j];
       const double vol_j = m_volume[j];
-      const double volumeScaling = con_data[m_iVolumeScaling];
+      const double volumeScaling = fields.volumeScaling(con_data);
       const double volume = vol_j * volumeScaling;
 
-      const double dr0 = con_data[m_iDr0];
+      const double dr0 = fields.dr0(con_data);
       const double w = weightFunction(dr0);
 
       dr_ij[0] = m_x[j] - m_x[i];
@@ -116,7 +148,7 @@ void PD_LPS::calculateForces(const int id, const int i) {
       m_Fy[i] += dr_ij[1] * bond;
       m_Fz[i] += dr_ij[2] * bond;
 
-      con_data[m_iStretch] = ds / dr0;
+      fields.stretch.set(con_data, ds / dr0);
       nConnected++;
 
       //----------------------------------
@@ -128,29 +160,26 @@ void PD_LPS::calculateForces(const int id, const int i) {
       m_stress[4][i] += 0.5 * dr_ij[0] * dr_ij[2] * bond;
       m_stress[5][i] += 0.5 * dr_ij[1] * dr_ij[2] * bond;
       //----------------------------------
-    }
+    });
   } else { // dim2
     //----------------------------------
     // TMP - standard stres calc from MD
     for (int k = 0; k < 3; k++)
       m_stress[k][i] = 0;
     //----------------------------------
-    for (int l_j = 0; l_j < nConnections; l_j++) {
+    const vector<int> &neighbourCols = m_particles.neighbourColumns(i);
+    m_particles.forEachConnectedBond(i, [&](const int l_j) {
       auto &con = PDconnections[l_j];
-      vector<double> &con_data = con.second;
-      if (con_data[m_iConnected] <= 0.5)
-        continue;
-
-      const int id_j = con.first;
-      const int j = m_idToCol_v(id_j);
+      BondData &con_data = con.second;
+      const int j = neighbourCols[l_j];
 
       const double m_j = m_mass[j];
       const double theta_j = m_theta[j];
       const double vol_j = m_volume[j];
-      const double volumeScaling = con_data[m_iVolumeScaling];
+      const double volumeScaling = fields.volumeScaling(con_data);
       const double volume = vol_j * volumeScaling;
 
-      const double dr0 = con_data[m_iDr0];
+      const double dr0 = fields.dr0(con_data);
       const double w = weightFunction(dr0);
 
       dr_ij[0] = m_x[j] - m_x[i];
@@ -167,14 +196,14 @@ void PD_LPS::calculateForces(const int id, const int i) {
       m_Fx[i] += dr_ij[0] * bond;
       m_Fy[i] += dr_ij[1] * bond;
 
-      con_data[m_iStretch] = ds / dr0;
+      fields.stretch.set(con_data, ds / dr0);
       ++nConnected;
       //----------------------------------
       // TMP - standard stres calc from MD
       m_stress[0][i] += 0.5 * dr_ij[0] * dr_ij[0] * bond;
       m_stress[1][i] += 0.5 * dr_ij[1] * dr_ij[1] * bond;
       m_stress[2][i] += 0.5 * dr_ij[0] * dr_ij[1] * bond;
-    }
+    });
   }
   if (nConnected <= 3)
     m_theta_new[i] = 0;
@@ -185,66 +214,60 @@ void PD_LPS::calculateForces(const int id, const int i) {
 }
 //------------------------------------------------------------------------------
 double PD_LPS::calculatePotentialEnergyDensity(const int id_i, const int i) {
-  const double theta_i = this->computeDilation(id_i, i);
-  double dr_ij[m_dim];
-
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_i);
+  BondList &PDconnections = m_particles.pdConnections(id_i);
   const int nConnections = PDconnections.size();
 
+  // The bond extensions of the dilation sweep are reused below
+  double *ds_ij = bondScratch(nConnections);
+  const double theta_i = computeDilation(id_i, i, ds_ij);
+
   double W_i = 0;
-  for (int l_j = 0; l_j < nConnections; l_j++) {
+  const vector<int> &neighbourCols = m_particles.neighbourColumns(i);
+  m_particles.forEachConnectedBond(i, [&](const int l_j) {
     auto &con = PDconnections[l_j];
-    if (con.second[m_iConnected] <= 0.5)
-      continue;
-
-    const int id_j = con.first;
-    const int j = m_idToCol_v[id_j];
+    const int j = neighbourCols[l_j];
 
     const double vol_j = m_data(j, m_iVolume);
     const double dr0 = con.second[m_iDr0];
     const double w = weightFunction(dr0);
     const double volumeScaling = con.second[m_iVolumeScaling];
-    double dr2 = 0;
-
-    for (int d = 0; d < m_dim; d++) {
-      dr_ij[d] = m_r(j, d) - m_r(i, d);
-      dr2 += dr_ij[d] * dr_ij[d];
-    }
-
-    const double dr = sqrt(dr2);
-    const double ds = dr - dr0;
+    const double ds = ds_ij[l_j];
     const double extension_term =
         m_alpha * w * (pow(ds - theta_i * dr0 / m_dim, 2));
 
     W_i += (extension_term)*vol_j * volumeScaling;
-  }
+  });
   W_i += m_k * (pow(theta_i, 2));
 
   return 0.5 * W_i;
 }
 //------------------------------------------------------------------------------
-double PD_LPS::computeDilation(const int id_i, const int i) {
+double PD_LPS::computeDilation(const int id_i, const int i, double *ds_ij) {
+  if (m_floatBonds)
+    return computeDilationKernel(id_i, i, ds_ij, m_floatFields);
+  return computeDilationKernel(id_i, i, ds_ij, m_doubleFields);
+}
+//------------------------------------------------------------------------------
+template <typename T>
+double PD_LPS::computeDilationKernel(const int id_i, const int i,
+                                     double *ds_ij,
+                                     const BondFields<T> &fields) {
   const double m_i = m_mass[i];
   double dr_ij[m_dim];
 
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_i);
+  BondList &PDconnections = m_particles.pdConnections(id_i);
   const int nConnections = PDconnections.size();
 
   double theta_i = 0;
 
-  for (int l_j = 0; l_j < nConnections; l_j++) {
+  const vector<int> &neighbourCols = m_particles.neighbourColumns(i);
+  m_particles.forEachConnectedBond(i, [&](const int l_j) {
     auto &con = PDconnections[l_j];
-    if (con.second[m_iConnected] <= 0.5)
-      continue;
-
-    const int id_j = con.first;
-    const int j = m_idToCol_v[id_j];
+    const int j = neighbourCols[l_j];
 
     const double vol_j = m_data(j, m_iVolume);
-    const double dr0 = con.second[m_iDr0];
-    const double volumeScaling = con.second[m_iVolumeScaling];
+    const double dr0 = fields.dr0(con.second);
+    const double volumeScaling = fields.volumeScaling(con.second);
     double dr2 = 0;
     const double w = weightFunction(dr0);
 
@@ -256,7 +279,10 @@ double PD_LPS::computeDilation(const int id_i, const int i) {
     const double dr = sqrt(dr2);
     const double ds = dr - dr0;
     theta_i += w * dr0 * ds * vol_j * volumeScaling;
-  }
+
+    if (ds_ij != nullptr)
+      ds_ij[l_j] = ds;
+  });
 
   if (nConnections <= 3) {
     theta_i = 0;
@@ -273,11 +299,36 @@ void PD_LPS::calculatePotentialEnergy(const int id_i, const int i,
 void PD_LPS::updateState(int id, int i) {
   (void)id;
   m_theta[i] = m_theta_new[i];
+}
+//------------------------------------------------------------------------------
+void PD_LPS::bondsBroken(const vector<BondBreak> &brokenBonds) {
+  // The weighted volume is only updated for particles that lost bonds
+  const int nParticles = m_particles.nParticles();
+  int id_prev = -1;
+
+  for (const BondBreak &bondBreak : brokenBonds) {
+    const int id_i = bondBreak.id_i;
+    if (id_i == id_prev)
+      continue;
+    id_prev = id_i;
+
+    const int i = m_idToCol_v[id_i];
+    if (i < 0 || i >= nParticles || m_colToId[i] != id_i)
+      continue;
+
+    updateWeightedVolume(id_i, i);
+  }
+}
+//------------------------------------------------------------------------------
+void PD_LPS::connectionsChanged(const vector<int> &ids) {
+  const int nParticles = m_particles.nParticles();
+
+  for (const int id_i : ids) {
+    const int i = m_idToCol_v[id_i];
+    if (i < 0 || i >= nParticles || m_colToId[i] != id_i)
+      continue;
 
-  if (m_data(i, m_indexBrokenNow)) {
-    //        cout << "updaing " << id << endl;
-    updateWeightedVolume(id, i);
-    m_data(i, m_indexBrokenNow) = 0;
+    updateWeightedVolume(id_i, i);
   }
 }
 //------------------------------------------------------------------------------
@@ -294,8 +345,7 @@ double PD_LPS::calculateStableMass(const int id_a, const int a, double dt) {
     m[d] = 0;
   }
 
-  const vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_a);
+  const BondList &PDconnections = m_particles.pdConnections(id_a);
 
   double k[m_dim];
 
@@ -304,10 +354,8 @@ double PD_LPS::calculateStableMass(const int id_a, const int a, double dt) {
       k[d] = 0;
     }
 
-    for (auto &con : PDconnections) {
-      if (con.second[m_iConnected] <= 0.5)
-        continue;
-
+    m_particles.forEachConnectedBond(a, [&](const int l_j) {
+      auto &con = PDconnections[l_j];
       const int id_b = con.first;
       const int b = m_idToCol_v(id_b);
 
@@ -339,7 +387,7 @@ double PD_LPS::calculateStableMass(const int id_a, const int a, double dt) {
       }
 
       k[i] += fabs(dr0[i]) * C * sum;
-    }
+    });
     m[i] = k[i];
   }
 
@@ -413,8 +461,7 @@ void PD_LPS::calculateWeightedVolume() {
     const int id_i = m_colToId.at(i);
     int nActiveConnections = 0;
 
-    const vector<pair<int, vector<double>>> &PDconnections =
-        m_particles.pdConnections(id_i);
+    const BondList &PDconnections = m_particles.pdConnections(id_i);
     const int nConnections = PDconnections.size();
     double m = 0;
     for (int l_j = 0; l_j < nConnections; l_j++) {
@@ -463,17 +510,12 @@ void PD_LPS::calculateWeightedVolume() {
 }
 //------------------------------------------------------------------------------
 void PD_LPS::updateWeightedVolume(int id_i, int i) {
-  const vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_i);
-  const int nConnections = PDconnections.size();
+  const BondList &PDconnections = m_particles.pdConnections(id_i);
 
   double m = 0;
   int nActiveConnections = 0;
-  for (int l_j = 0; l_j < nConnections; l_j++) {
+  m_particles.forEachConnectedBond(i, [&](const int l_j) {
     auto &con = PDconnections[l_j];
-    if (con.second[m_iConnected] <= 0.5)
-      continue;
-
     const int id_j = con.first;
     const int j = m_idToCol_v(id_j);
     const double volumeScaling = con.second[m_iVolumeScaling];
@@ -483,7 +525,7 @@ void PD_LPS::updateWeightedVolume(int id_i, int i) {
 
     m += w * dr0 * dr0 * vol_j * volumeScaling;
     nActiveConnections++;
-  }
+  });
 
   if (m_analyticalM) {
     if (m_dim == 3) {
@@ -511,18 +553,13 @@ void PD_LPS::calculateStress(const int id_i, const int i,
   //    const double theta_i = this->computeDilation(id, i);
   const double m_i = m_mass[i];
 
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_i);
+  BondList &PDconnections = m_particles.pdConnections(id_i);
 
-  const int nConnections = PDconnections.size();
   double dr_ij[m_dim];
   double dr0_ij[m_dim];
 
-  for (int l_j = 0; l_j < nConnections; l_j++) {
+  m_particles.forEachConnectedBond(i, [&](const int l_j) {
     auto &con = PDconnections[l_j];
-    if (con.second[m_iConnected] <= 0.5)
-      continue;
-
     const int id_j = con.first;
     const int j = m_idToCol_v[id_j];
 
@@ -556,7 +593,7 @@ void PD_LPS::calculateStress(const int id_i, const int i,
       m_data(i, indexStress[4]) += 0.5 * bond * dr_ij[X] * dr0_ij[Z];
       m_data(i, indexStress[5]) += 0.5 * bond * dr_ij[Y] * dr0_ij[Z];
     }
-  }
+  });
 }
 //------------------------------------------------------------------------------
 }
@@ -6,7 +6,8 @@
 namespace PDtools {
 
 //------------------------------------------------------------------------------
-class PD_LPS : public Force {
+class PD_LPS : public Force, public BondBreakSubscriber,
+               public ParticleStorageSubscriber {
 protected:
   bool m_planeStress;
   //    int m_dim = 3;
@@ -49,6 +50,18 @@ protected:
   int m_indexStress[6];
   vector<double *> m_stress;
 
+  // The bond parameters of the force loops. The reduced ones are floats with
+  // the mixed bond storage. Resolved once, the offsets of the bond parameters
+  // do not change.
+  template <typename T> struct BondFields {
+    BondField<double> dr0;
+    BondField<T> volumeScaling;
+    BondField<T> stretch;
+  };
+  bool m_floatBonds;
+  BondFields<float> m_floatFields;
+  BondFields<double> m_doubleFields;
+
   //       double weightFunction(const double dr0) const {return 1.;}
   //           double weightFunction(const double dr0) const {return 1.0/dr0;}
   double weightFunction(const double dr0) const { return m_delta / dr0; }
@@ -64,12 +77,16 @@ protected:
 public:
   PD_LPS(PD_Particles &particles, bool planeStress = false,
          bool analyticalM = false);
+  ~PD_LPS();
+
+  virtual void storageResized();
 
   virtual void calculateForces(const int id, const int i);
 
   virtual double calculatePotentialEnergyDensity(const int id_i, const int i);
 
-  double computeDilation(const int id_i, const int i);
+  double computeDilation(const int id_i, const int i,
+                         double *ds_ij = nullptr);
 
   virtual void calculatePotentialEnergy(const int id_i, const int i,
                                         int indexPotential);
@@ -77,6 +94,8 @@ public:
                                const int (&indexStress)[6]);
 
   virtual void updateState(int id, int i);
+  virtual void bondsBroken(const vector<BondBreak> &brokenBonds);
+  virtual void connectionsChanged(const vector<int> &ids);
 
   virtual double calculateStableMass(const int id_a, const int a, double dt);
   virtual void initialize(double E, double nu, double delta, int dim, double h,
@@ -85,6 +104,15 @@ public:
   void calculateWeightedVolume();
 
   void updateWeightedVolume(int id_i, int i);
+
+protected:
+  template <typename T> void resolveBondFields(BondFields<T> &fields) const;
+  template <typename T>
+  void calculateForcesKernel(const int id, const int i,
+                             const BondFields<T> &fields);
+  template <typename T>
+  double computeDilationKernel(const int id_i, const int i, double *ds_ij,
+                               const BondFields<T> &fields);
 };
 //------------------------------------------------------------------------------
 }
@@ -12,9 +12,7 @@ void PD_LPS2::calculateForces(const int id, const int i) {
   const double theta_i = m_theta[i];
   const double m_i = m_mass[i];
 
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id);
-  const int nConnections = PDconnections.size();
+  BondList &PDconnections = m_particles.pdConnections(id);
   double dr_ij[m_dim];
 
   if (m_dim == 3) {
@@ -27,14 +25,12 @@ void PD_LPS2::calculateForces(const int id, const int i) {
     for (int k = 0; k < 6; k++)
       d_stress[k][i] = 0;
     //----------------------------------
-    for (int l_j = 0; l_j < nConnections; l_j++) {
+    m_particles.forEachConnectedBond(i, [&](const int l_j) {
       auto &con = PDconnections[l_j];
       const int id_j = con.first;
       const int j = m_idToCol_v[id_j];
 
-      vector<double> &con_data = con.second;
-      if (con_data[m_iConnected] <= 0.5)
-        continue;
+      BondData &con_data = con.second;
 
       const double m_j = m_mass[j];
       const double theta_j = m_theta[j];
@@ -71,19 +67,16 @@ void PD_LPS2::calculateForces(const int id, const int i) {
       d_stress[4][i] += 0.5 * dr_ij[0] * dr_ij[2] * bond;
       d_stress[5][i] += 0.5 * dr_ij[1] * dr_ij[2] * bond;
       //----------------------------------
-    }
+    });
   } else { // dim2
     //----------------------------------
     // TMP - standard stres calc from MD
     for (int k = 0; k < 3; k++)
       m_data(i, m_indexStress[k]) = 0;
     //----------------------------------
-    for (int l_j = 0; l_j < nConnections; l_j++) {
+    m_particles.forEachConnectedBond(i, [&](const int l_j) {
       auto &con = PDconnections[l_j];
-      vector<double> &con_data = con.second;
-      if (con_data[m_iConnected] <= 0.5)
-        continue;
-
+      BondData &con_data = con.second;
       const int id_j = con.first;
       const int j = m_idToCol_v[id_j];
 
@@ -115,7 +108,7 @@ void PD_LPS2::calculateForces(const int id, const int i) {
       m_data(i, m_indexStress[0]) += 0.5 * dr_ij[0] * dr_ij[0] * bond;
       m_data(i, m_indexStress[1]) += 0.5 * dr_ij[1] * dr_ij[1] * bond;
       m_data(i, m_indexStress[2]) += 0.5 * dr_ij[0] * dr_ij[1] * bond;
-    }
+    });
   }
 
   m_continueState = false;
@@ -127,20 +120,15 @@ void PD_LPS2::evaluateStepOne() {
   for (int i = 0; i < nParticles; i++) {
     const int id_i = m_colToId.at(i);
 
-    const vector<pair<int, vector<double>>> &PDconnections =
-        m_particles.pdConnections(id_i);
-    const int nConnections = PDconnections.size();
+    const BondList &PDconnections = m_particles.pdConnections(id_i);
 
     const double m_i = m_mass[i];
     double theta = 0;
     int nConnected = 0;
 
-    for (int l_j = 0; l_j < nConnections; l_j++) {
+    m_particles.forEachConnectedBond(i, [&](const int l_j) {
       auto &con = PDconnections[l_j];
-      const vector<double> &con_data = con.second;
-      if (con_data[m_iConnected] <= 0.5)
-        continue;
-
+      const BondData &con_data = con.second;
       const int id_j = con.first;
       const int j = m_idToCol_v[id_j];
 
@@ -153,7 +141,7 @@ void PD_LPS2::evaluateStepOne() {
 
       theta += w * s * dr0 * dr0 * volume;
       nConnected++;
-    }
+    });
 
     if (nConnected <= 3) {
       m_theta[i] = 0;
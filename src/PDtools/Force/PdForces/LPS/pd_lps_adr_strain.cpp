@@ -12,20 +12,17 @@ void PD_LPS_ADR_STRAIN::evaluateStatic(int id_i, int i) {
   if (m_data(i, m_iUnbreakable) >= 1)
     return;
 
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_i);
+  BondList &PDconnections = m_particles.pdConnections(id_i);
   bool broken = false;
   const double theta_i = m_data(i, m_iTheta);
 
-  for (auto &con : PDconnections) {
+  m_particles.forEachConnectedBond(i, [&](const int l_j) {
+    auto &con = PDconnections[l_j];
     const int id_j = con.first;
     const int j = m_idToCol_v[id_j];
 
     if (m_data(j, m_iUnbreakable) >= 1)
-      continue;
-
-    if (con.second[m_iConnected] <= 0.5)
-      continue;
+      return;
 
     const double s = con.second[m_iStretch];
     const double theta_j = m_data(j, m_iTheta);
@@ -33,16 +30,16 @@ void PD_LPS_ADR_STRAIN::evaluateStatic(int id_i, int i) {
 
     if (s > m_stretchCrit) {
       m_data(i, m_indexBrokenNow) = 1;
-      con.second[m_iConnected] = 0;
+      m_particles.breakBond(id_i, con);
       m_continueState = true;
       broken = true;
     } else if (s_d > m_shearCrit) {
       m_data(i, m_indexBrokenNow) = 1;
-      con.second[m_iConnected] = 0;
+      m_particles.breakBond(id_i, con);
       m_continueState = true;
       broken = true;
     }
-  }
+  });
 
   if (broken) {
     updateWeightedVolume(id_i, i);
@@ -12,7 +12,7 @@ PD_LPS_K::PD_LPS_K(PD_Particles &particles, bool planeStress, bool analyticalM)
   m_iVolume = m_particles.getParamId("volume");
   m_iDr0 = m_particles.getPdParamId("dr0");
   m_iVolumeScaling = m_particles.getPdParamId("volumeScaling");
-  m_iStretch = m_particles.registerPdParameter("stretch");
+  m_iStretch = m_particles.registerPdParameter("stretch", 0, BondData::Float);
   m_iConnected = m_particles.getPdParamId("connected");
   m_indexBrokenNow = m_particles.registerParameter("brokenNow", 0);
 
@@ -27,6 +27,8 @@ PD_LPS_K::PD_LPS_K(PD_Particles &particles, bool planeStress, bool analyticalM)
 
   m_initialGhostParameters = {"volume", "theta", "LPS_mass"};
   m_hasUpdateState = true;
+  m_hasLocalUpdateState = true;
+  m_particles.subscribeBondBreaks(this);
   m_analyticalM = analyticalM;
 
   //----------------------------------
@@ -63,6 +65,12 @@ PD_LPS_K::PD_LPS_K(PD_Particles &particles, bool planeStress, bool analyticalM)
     m_ghostParameters.push_back("M_12");
   }
   //----------------------------------
+  storageResized();
+  m_particles.subscribeStorage(this);
+}
+//------------------------------------------------------------------------------
+void PD_LPS_K::storageResized() {
+  // The cached column pointers
   m_mass = m_data.colptr(m_iMass);
   m_theta = m_data.colptr(m_iTheta);
   m_volume = m_data.colptr(m_iVolume);
@@ -76,12 +84,15 @@ PD_LPS_K::PD_LPS_K(PD_Particles &particles, bool planeStress, bool analyticalM)
   m_theta_new = m_data.colptr(m_iThetaNew);
 }
 //------------------------------------------------------------------------------
+PD_LPS_K::~PD_LPS_K() {
+  m_particles.unsubscribeBondBreaks(this);
+  m_particles.unsubscribeStorage(this);
+}
+//------------------------------------------------------------------------------
 void PD_LPS_K::calculateForces(const int id, const int i) {
   const double theta_i = m_theta[i];
 
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id);
-  const int nConnections = PDconnections.size();
+  BondList &PDconnections = m_particles.pdConnections(id);
   double dr_ij[m_dim];
   mat K_i = zeros(m_dim, m_dim);
   mat K_j = zeros(m_dim, m_dim);
@@ -109,12 +120,9 @@ void PD_LPS_K::calculateForces(const int id, const int i) {
     for (int k = 0; k < 6; k++)
       d_stress[k][i] = 0;
     //----------------------------------
-    for (int l_j = 0; l_j < nConnections; l_j++) {
+    m_particles.forEachConnectedBond(i, [&](const int l_j) {
       auto &con = PDconnections[l_j];
-      vector<double> &con_data = con.second;
-      if (con_data[m_iConnected] <= 0.5)
-        continue;
-
+      BondData &con_data = con.second;
       const int id_j = con.first;
       const int j = m_idToCol_v[id_j];
 
@@ -170,7 +178,7 @@ void PD_LPS_K::calculateForces(const int id, const int i) {
       d_stress[4][i] += 0.25 * (dr_ij[0] * Fz + dr_ij[2] * Fx);
       d_stress[5][i] += 0.25 * (dr_ij[1] * Fz + dr_ij[2] * Fy);
       //----------------------------------
-    }
+    });
   } else { // dim2
     K_i(0, 0) = m_data(i, m_indexK[0]);
     K_i(1, 1) = m_data(i, m_indexK[1]);
@@ -181,12 +189,9 @@ void PD_LPS_K::calculateForces(const int id, const int i) {
     for (int k = 0; k < 3; k++)
       m_data(i, m_indexStress[k]) = 0;
     //----------------------------------
-    for (int l_j = 0; l_j < nConnections; l_j++) {
+    m_particles.forEachConnectedBond(i, [&](const int l_j) {
       auto &con = PDconnections[l_j];
-      vector<double> &con_data = con.second;
-      if (con_data[m_iConnected] <= 0.5)
-        continue;
-
+      BondData &con_data = con.second;
       const int id_j = con.first;
       const int j = m_idToCol_v[id_j];
 
@@ -226,7 +231,7 @@ void PD_LPS_K::calculateForces(const int id, const int i) {
       m_data(i, m_indexStress[0]) += 0.5 * dr_ij[0] * Fx;
       m_data(i, m_indexStress[1]) += 0.5 * dr_ij[1] * Fy;
       m_data(i, m_indexStress[2]) += 0.25 * (dr_ij[1] * Fx + dr_ij[0] * Fy);
-    }
+    });
   }
   if (nConnected <= 3)
     m_theta_new[i] = 0;
@@ -238,19 +243,16 @@ void PD_LPS_K::calculateForces(const int id, const int i) {
 }
 //------------------------------------------------------------------------------
 double PD_LPS_K::calculatePotentialEnergyDensity(const int id_i, const int i) {
-  const double theta_i = this->computeDilation(id_i, i);
-  double dr_ij[m_dim];
-
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_i);
+  BondList &PDconnections = m_particles.pdConnections(id_i);
   const int nConnections = PDconnections.size();
 
+  // The bond extensions of the dilation sweep are reused below
+  double *ds_ij = bondScratch(nConnections);
+  const double theta_i = computeDilation(id_i, i, ds_ij);
+
   double W_i = 0;
-  for (int l_j = 0; l_j < nConnections; l_j++) {
+  m_particles.forEachConnectedBond(i, [&](const int l_j) {
     auto &con = PDconnections[l_j];
-    if (con.second[m_iConnected] <= 0.5)
-      continue;
-
     const int id_j = con.first;
     const int j = m_idToCol_v[id_j];
 
@@ -258,39 +260,27 @@ double PD_LPS_K::calculatePotentialEnergyDensity(const int id_i, const int i) {
     const double dr0 = con.second[m_iDr0];
     const double w = weightFunction(dr0);
     const double volumeScaling = con.second[m_iVolumeScaling];
-    double dr2 = 0;
-
-    for (int d = 0; d < m_dim; d++) {
-      dr_ij[d] = m_r(j, d) - m_r(i, d);
-      dr2 += dr_ij[d] * dr_ij[d];
-    }
-
-    const double dr = sqrt(dr2);
-    const double ds = dr - dr0;
+    const double ds = ds_ij[l_j];
     const double extension_term =
         m_alpha * w * (pow(ds - theta_i * dr0 / m_dim, 2));
 
     W_i += (extension_term)*vol_j * volumeScaling;
-  }
+  });
   W_i += m_k * (pow(theta_i, 2));
 
   return 0.5 * W_i;
 }
 //------------------------------------------------------------------------------
-double PD_LPS_K::computeDilation(const int id_i, const int i) {
+double PD_LPS_K::computeDilation(const int id_i, const int i, double *ds_ij) {
   double dr_ij[m_dim];
 
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_i);
+  BondList &PDconnections = m_particles.pdConnections(id_i);
   const int nConnections = PDconnections.size();
 
   double theta_i = 0;
 
-  for (int l_j = 0; l_j < nConnections; l_j++) {
+  m_particles.forEachConnectedBond(i, [&](const int l_j) {
     auto &con = PDconnections[l_j];
-    if (con.second[m_iConnected] <= 0.5)
-      continue;
-
     const int id_j = con.first;
     const int j = m_idToCol_v[id_j];
 
@@ -308,7 +298,10 @@ double PD_LPS_K::computeDilation(const int id_i, const int i) {
     const double dr = sqrt(dr2);
     const double ds = dr - dr0;
     theta_i += w * dr0 * ds * vol_j * volumeScaling;
-  }
+
+    if (ds_ij != nullptr)
+      ds_ij[l_j] = ds;
+  });
 
   if (nConnections <= 3) {
     theta_i = 0;
@@ -325,10 +318,37 @@ void PD_LPS_K::calculatePotentialEnergy(const int id_i, const int i,
 void PD_LPS_K::updateState(int id, int i) {
   (void)id;
   m_theta[i] = m_theta_new[i];
+}
+//------------------------------------------------------------------------------
+void PD_LPS_K::bondsBroken(const vector<BondBreak> &brokenBonds) {
+  // The weighted volume and the shape tensor are only updated for
+  // particles that lost bonds
+  const int nParticles = m_particles.nParticles();
+  int id_prev = -1;
+
+  for (const BondBreak &bondBreak : brokenBonds) {
+    const int id_i = bondBreak.id_i;
+    if (id_i == id_prev)
+      continue;
+    id_prev = id_i;
+
+    const int i = m_idToCol_v[id_i];
+    if (i < 0 || i >= nParticles || m_colToId[i] != id_i)
+      continue;
 
-  if (m_data(i, m_indexBrokenNow)) {
-    updateWeightedVolume(id, i);
-    m_data(i, m_indexBrokenNow) = 0;
+    updateWeightedVolume(id_i, i);
+  }
+}
+//------------------------------------------------------------------------------
+void PD_LPS_K::connectionsChanged(const vector<int> &ids) {
+  const int nParticles = m_particles.nParticles();
+
+  for (const int id_i : ids) {
+    const int i = m_idToCol_v[id_i];
+    if (i < 0 || i >= nParticles || m_colToId[i] != id_i)
+      continue;
+
+    updateWeightedVolume(id_i, i);
   }
 }
 //------------------------------------------------------------------------------
@@ -345,8 +365,7 @@ double PD_LPS_K::calculateStableMass(const int id_a, const int a, double dt) {
     m[d] = 0;
   }
 
-  const vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_a);
+  const BondList &PDconnections = m_particles.pdConnections(id_a);
 
   double k[m_dim];
 
@@ -355,10 +374,8 @@ double PD_LPS_K::calculateStableMass(const int id_a, const int a, double dt) {
       k[d] = 0;
     }
 
-    for (auto &con : PDconnections) {
-      if (con.second[m_iConnected] <= 0.5)
-        continue;
-
+    m_particles.forEachConnectedBond(a, [&](const int l_j) {
+      auto &con = PDconnections[l_j];
       const int id_b = con.first;
       const int b = m_idToCol_v[id_b];
 
@@ -390,7 +407,7 @@ double PD_LPS_K::calculateStableMass(const int id_a, const int a, double dt) {
       }
 
       k[i] += fabs(dr0[i]) * C * sum;
-    }
+    });
     m[i] = k[i];
   }
 
@@ -455,8 +472,7 @@ void PD_LPS_K::calculateWeightedVolume() {
 //------------------------------------------------------------------------------
 void PD_LPS_K::updateWeightedVolume(int id_i, int i) {
   mat K = zeros(m_dim, m_dim);
-  const vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_i);
+  const BondList &PDconnections = m_particles.pdConnections(id_i);
   const int nConnections = PDconnections.size();
   double dr0_ij[m_dim];
 
@@ -537,7 +553,7 @@ void PD_LPS_K::calculateStress(const int id_i, const int i,
   ////    const double theta_i = this->computeDilation(id, i);
   //    const double m_i = m_data(i, m_iMass);
 
-  //    vector<pair<int, vector<double>>> & PDconnections =
+  //    BondList & PDconnections =
   //    m_particles.pdConnections(id_i);
 
   //    const int nConnections = PDconnections.size();
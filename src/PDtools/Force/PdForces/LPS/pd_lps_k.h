@@ -5,7 +5,8 @@
 
 namespace PDtools {
 //------------------------------------------------------------------------------
-class PD_LPS_K : public Force {
+class PD_LPS_K : public Force, public BondBreakSubscriber,
+                 public ParticleStorageSubscriber {
 protected:
   bool m_planeStress;
   int m_dim = 3;
@@ -62,12 +63,16 @@ protected:
 public:
   PD_LPS_K(PD_Particles &particles, bool planeStress = false,
            bool analyticalM = false);
+  ~PD_LPS_K();
+
+  virtual void storageResized();
 
   virtual void calculateForces(const int id, const int i);
 
   virtual double calculatePotentialEnergyDensity(const int id_i, const int i);
 
-  double computeDilation(const int id_i, const int i);
+  double computeDilation(const int id_i, const int i,
+                         double *ds_ij = nullptr);
 
   virtual void calculatePotentialEnergy(const int id_i, const int i,
                                         int indexPotential);
@@ -75,6 +80,8 @@ public:
                                const int (&indexStress)[6]);
 
   virtual void updateState(int id, int i);
+  virtual void bondsBroken(const vector<BondBreak> &brokenBonds);
+  virtual void connectionsChanged(const vector<int> &ids);
 
   virtual double calculateStableMass(const int id_a, const int a, double dt);
   virtual void initialize(double E, double nu, double delta, int dim, double h,
@@ -6,25 +6,22 @@ PD_lpsDampenedContact::PD_lpsDampenedContact(PD_Particles &particles, double c,
                                              bool planeStress)
     : PD_LPS(particles, planeStress), m_dampCoeff(c) {
   particles.setNeedGhostVelocity(true);
+  m_readsNeighbourVelocity = true;
 }
 //------------------------------------------------------------------------------
 void PD_lpsDampenedContact::calculateForces(const int id, const int i) {
   const double theta_i = m_data(i, m_iTheta);
   const double m_i = m_data(i, m_iMass);
 
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id);
+  BondList &PDconnections = m_particles.pdConnections(id);
 
   const int nConnections = PDconnections.size();
   double dr_ij[m_dim];
 
   double thetaNew = 0;
-  for (int l_j = 0; l_j < nConnections; l_j++) {
+  m_particles.forEachConnectedBond(i, [&](const int l_j) {
     auto &con = PDconnections[l_j];
 
-    if (con.second[m_iConnected] <= 0.5)
-      continue;
-
     const int id_j = con.first;
     const int j = m_idToCol_v[id_j];
 
@@ -57,7 +54,7 @@ void PD_lpsDampenedContact::calculateForces(const int id, const int i) {
     }
 
     con.second[m_iStretch] = ds / dr0;
-  }
+  });
 
   if (nConnections <= 3)
     m_data(i, m_iThetaNew) = 0;
@@ -70,16 +67,11 @@ double PD_lpsDampenedContact::calculatePotentialEnergyDensity(const int id_i,
   const double theta_i = this->computeDilation(id_i, i);
   double dr_ij[m_dim];
 
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_i);
-  const int nConnections = PDconnections.size();
+  BondList &PDconnections = m_particles.pdConnections(id_i);
 
   double W_i = 0;
-  for (int l_j = 0; l_j < nConnections; l_j++) {
+  m_particles.forEachConnectedBond(i, [&](const int l_j) {
     auto &con = PDconnections[l_j];
-    if (con.second[m_iConnected] <= 0.5)
-      continue;
-
     const int id_j = con.first;
     const int j = m_idToCol_v[id_j];
 
@@ -103,7 +95,7 @@ double PD_lpsDampenedContact::calculatePotentialEnergyDensity(const int id_i,
         m_alpha * w * (pow(ds - theta_i * dr0 / m_dim, 2));
 
     W_i += (extension_term)*vol_j * volumeScaling;
-  }
+  });
   W_i += m_k * (pow(theta_i, 2));
 
   return 0.5 * W_i;
@@ -21,7 +21,7 @@ PD_LPSS::PD_LPSS(PD_Particles &particles, bool planeStress)
   m_ghostParameters.push_back("theta");
   m_ghostParameters.push_back("LPS_mass");
   m_ghostParameters.push_back("micromodulus"); // For contact forces
-  m_iStretch = m_particles.registerPdParameter("stretch");
+  m_iStretch = m_particles.registerPdParameter("stretch", 0, BondData::Float);
 
   m_initialGhostParameters = {"volume", "theta", "LPS_mass"};
   m_hasUpdateState = false;
@@ -83,6 +83,14 @@ PD_LPSS::PD_LPSS(PD_Particles &particles, bool planeStress)
     m_iStress[5] = m_particles.registerParameter("s_yz");
   }
   //----------------------------------
+  storageResized();
+  m_particles.subscribeStorage(this);
+}
+//------------------------------------------------------------------------------
+PD_LPSS::~PD_LPSS() { m_particles.unsubscribeStorage(this); }
+//------------------------------------------------------------------------------
+void PD_LPSS::storageResized() {
+  // The cached column pointers
   m_mass = m_data.colptr(m_iMass);
   m_theta = m_data.colptr(m_iTheta);
   m_volume = m_data.colptr(m_iVolume);
@@ -102,9 +110,7 @@ void PD_LPSS::calculateForces(const int id, const int i) {
   const double theta_i = m_theta[i];
   const double m_i = m_mass[i];
 
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id);
-  const int nConnections = PDconnections.size();
+  BondList &PDconnections = m_particles.pdConnections(id);
 
   double dr_ij[m_dim];
   double dr0_ij[m_dim];
@@ -133,12 +139,9 @@ void PD_LPSS::calculateForces(const int id, const int i) {
       m_data(i, m_iStress[i]) = 0;
     }
     //----------------------------------
-    for (int l_j = 0; l_j < nConnections; l_j++) {
+    m_particles.forEachConnectedBond(i, [&](const int l_j) {
       auto &con = PDconnections[l_j];
-      vector<double> &con_data = con.second;
-      if (con_data[m_iConnected] <= 0.5)
-        continue;
-
+      BondData &con_data = con.second;
       const int id_j = con.first;
       const int j = m_idToCol_v[id_j];
 
@@ -200,7 +203,7 @@ void PD_LPSS::calculateForces(const int id, const int i) {
                         dr0;
       con_data[m_iStretch] = ds / dr0;
       nConnected++;
-    }
+    });
   }
   if (m_dim == 2) {             // dim2
     R1[0] = m_data(i, m_iR[0]); // 00
@@ -212,12 +215,9 @@ void PD_LPSS::calculateForces(const int id, const int i) {
       m_data(i, m_iStress[i]) = 0;
 
     //----------------------------------
-    for (int l_j = 0; l_j < nConnections; l_j++) {
+    m_particles.forEachConnectedBond(i, [&](const int l_j) {
       auto &con = PDconnections[l_j];
-      vector<double> &con_data = con.second;
-      if (con_data[m_iConnected] <= 0.5)
-        continue;
-
+      BondData &con_data = con.second;
       const int id_j = con.first;
       const int j = m_idToCol_v[id_j];
 
@@ -265,7 +265,7 @@ void PD_LPSS::calculateForces(const int id, const int i) {
       con_data[m_iStretch] = ds / dr0;
 
       nConnected++;
-    }
+    });
   }
 
   m_continueState = false;
@@ -313,9 +313,7 @@ for(int i=0; i<nParticles; i++) {
   for (int i = 0; i < nParticles; i++) {
     const int id = m_colToId.at(i);
 
-    const vector<pair<int, vector<double>>> &PDconnections =
-        m_particles.pdConnections(id);
-    const int nConnections = PDconnections.size();
+    const BondList &PDconnections = m_particles.pdConnections(id);
 
     if (m_dim == 2) {
       K(0, 0) = m_data(i, m_iK[0]);
@@ -340,12 +338,8 @@ for(int i=0; i<nParticles; i++) {
     // and the rotation matrix, R.
     //----------------------------------
     F.zeros();
-    for (int l_j = 0; l_j < nConnections; l_j++) {
+    m_particles.forEachConnectedBond(i, [&](const int l_j) {
       auto &con = PDconnections[l_j];
-      const vector<double> &con_data = con.second;
-
-      if (con_data[m_iConnected] <= 0.5)
-        continue;
 
       const int id_j = con.first;
       const int j = m_idToCol_v[id_j];
@@ -366,7 +360,7 @@ for(int i=0; i<nParticles; i++) {
           F(d, d2) += w * dr_ij[d] * dr0_ij[d2] * vol;
         }
       }
-    }
+    });
     F *= K;
 
     svd(U, s, V, F);
@@ -396,12 +390,8 @@ for(int i=0; i<nParticles; i++) {
     const double m_i = m_mass[i];
     double theta = 0;
 
-    for (int l_j = 0; l_j < nConnections; l_j++) {
+    m_particles.forEachConnectedBond(i, [&](const int l_j) {
       auto &con = PDconnections[l_j];
-      const vector<double> &con_data = con.second;
-
-      if (con_data[m_iConnected] <= 0.5)
-        continue;
 
       const int id_j = con.first;
       const int j = m_idToCol_v[id_j];
@@ -422,7 +412,7 @@ for(int i=0; i<nParticles; i++) {
         dudr0 += (dr_ij[d] - drr_ij[d]) * drr_ij[d];
       }
       theta += w * dudr0 * vol;
-    }
+    });
     theta *= m_dim / m_i;
     m_theta[i] = theta;
   }
@@ -444,8 +434,7 @@ double PD_LPSS::calculateStableMass(const int id_a, const int a, double dt) {
     m[d] = 0;
   }
 
-  const vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_a);
+  const BondList &PDconnections = m_particles.pdConnections(id_a);
 
   double k[m_dim];
 
@@ -454,10 +443,8 @@ double PD_LPSS::calculateStableMass(const int id_a, const int a, double dt) {
       k[d] = 0;
     }
 
-    for (auto &con : PDconnections) {
-      if (con.second[m_iConnected] <= 0.5)
-        continue;
-
+    m_particles.forEachConnectedBond(a, [&](const int l_j) {
+      auto &con = PDconnections[l_j];
       const int id_b = con.first;
       const int b = m_idToCol_v[id_b];
 
@@ -484,7 +471,7 @@ double PD_LPSS::calculateStableMass(const int id_a, const int a, double dt) {
       }
 
       k[i] += fabs(dr0[i]) * C * sum;
-    }
+    });
     m[i] = k[i];
   }
 
@@ -508,8 +495,7 @@ void PD_LPSS::calculateWeightedVolume() {
     const int id_i = m_colToId.at(i);
     int nActiveConnections = 0;
 
-    const vector<pair<int, vector<double>>> &PDconnections =
-        m_particles.pdConnections(id_i);
+    const BondList &PDconnections = m_particles.pdConnections(id_i);
     const int nConnections = PDconnections.size();
     double m = 0;
     K.zeros();
@@ -613,16 +599,11 @@ void PD_LPSS::computeMandK(int id_i, int i) {
 
   int nActiveConnections = 0;
 
-  const vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_i);
-  const int nConnections = PDconnections.size();
+  const BondList &PDconnections = m_particles.pdConnections(id_i);
   double m = 0;
 
-  for (int l_j = 0; l_j < nConnections; l_j++) {
+  m_particles.forEachConnectedBond(i, [&](const int l_j) {
     auto &con = PDconnections[l_j];
-    if (con.second[m_iConnected] <= 0.5)
-      continue;
-
     const int id_j = con.first;
     const int j = m_idToCol_v[id_j];
     const double volumeScaling = con.second[m_iVolumeScaling];
@@ -644,7 +625,7 @@ void PD_LPSS::computeMandK(int id_i, int i) {
     }
 
     nActiveConnections++;
-  }
+  });
 
   if (m_analyticalM) {
     // Remember to use the correct weightfunction
@@ -6,7 +6,8 @@
 namespace PDtools {
 
 //------------------------------------------------------------------------------
-class PD_LPSS : public Force {
+class PD_LPSS : public Force,
+                public ParticleStorageSubscriber {
 protected:
   bool m_planeStress;
   int m_iMicromodulus;
@@ -48,6 +49,9 @@ protected:
   //    double weightFunction(const double dr0) const {return m_delta/dr0;}
 public:
   PD_LPSS(PD_Particles &particles, bool planeStress = false);
+  ~PD_LPSS();
+
+  virtual void storageResized();
 
   virtual void calculateForces(const int id, const int i);
 
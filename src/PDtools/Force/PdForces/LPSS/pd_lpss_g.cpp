@@ -13,9 +13,7 @@ void PD_LPSS_G::calculateForces(const int id_i, const int i) {
   const double theta_i = m_theta[i];
   const double m_i = m_mass[i];
 
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_i);
-  const int nConnections = PDconnections.size();
+  BondList &PDconnections = m_particles.pdConnections(id_i);
 
   double dr_ij[m_dim];
   double dr0_ij[m_dim];
@@ -44,12 +42,9 @@ void PD_LPSS_G::calculateForces(const int id_i, const int i) {
       m_data(i, m_iStress[i]) = 0;
     }
     //----------------------------------
-    for (int l_j = 0; l_j < nConnections; l_j++) {
+    m_particles.forEachConnectedBond(i, [&](const int l_j) {
       auto &con = PDconnections[l_j];
-      vector<double> &con_data = con.second;
-      if (con_data[m_iConnected] <= 0.5)
-        continue;
-
+      BondData &con_data = con.second;
       const int id_j = con.first;
       const int j = m_idToCol_v[id_j];
 
@@ -113,7 +108,7 @@ void PD_LPSS_G::calculateForces(const int id_i, const int i) {
                           dud_ji[2] * dud_ji[2]);
       con.second[m_iStretch] = std::max(e_i, e_j) / (dr0 * dr0);
       nConnected++;
-    }
+    });
   }
   if (m_dim == 2) {             // dim2
     R1[0] = m_data(i, m_iR[0]); // 00
@@ -125,12 +120,9 @@ void PD_LPSS_G::calculateForces(const int id_i, const int i) {
       m_data(i, m_iStress[i]) = 0;
 
     //----------------------------------
-    for (int l_j = 0; l_j < nConnections; l_j++) {
+    m_particles.forEachConnectedBond(i, [&](const int l_j) {
       auto &con = PDconnections[l_j];
-      vector<double> &con_data = con.second;
-      if (con_data[m_iConnected] <= 0.5)
-        continue;
-
+      BondData &con_data = con.second;
       const int id_j = con.first;
       const int j = m_idToCol_v[id_j];
 
@@ -178,7 +170,7 @@ void PD_LPSS_G::calculateForces(const int id_i, const int i) {
       const double e_j = (dud_ji[0] * dud_ji[0] + dud_ji[1] * dud_ji[1]);
       con.second[m_iStretch] = std::max(e_i, e_j) / (dr0 * dr0);
       nConnected++;
-    }
+    });
   }
 
   m_continueState = false;
@@ -189,20 +181,17 @@ void PD_LPSS_G::evaluateStepTwo(const int id_i, const int i) {
   if (m_data(i, m_iUnbreakable) >= 1)
     return;
 
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_i);
+  BondList &PDconnections = m_particles.pdConnections(id_i);
   bool broken = false;
   const double theta_i = m_theta[i];
 
-  for (auto &con : PDconnections) {
+  m_particles.forEachConnectedBond(i, [&](const int l_j) {
+    auto &con = PDconnections[l_j];
     const int id_j = con.first;
     const int j = m_idToCol_v[id_j];
 
     if (m_data(j, m_iUnbreakable) >= 1)
-      continue;
-
-    if (con.second[m_iConnected] <= 0.5)
-      continue;
+      return;
 
     const double e_d = con.second[m_iStretch];
     const double theta_j = m_theta[j];
@@ -210,12 +199,12 @@ void PD_LPSS_G::evaluateStepTwo(const int id_i, const int i) {
     if (e_d > m_e_max) {
       if (theta_i > 0 || theta_j > 0) {
         m_data(i, m_iBrokenNow) = 1;
-        con.second[m_iConnected] = 0;
+        m_particles.breakBond(id_i, con);
         m_continueState = true;
         broken = true;
       }
     }
-  }
+  });
 
   if (broken) {
     computeMandK(id_i, i);
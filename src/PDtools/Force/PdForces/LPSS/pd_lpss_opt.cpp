@@ -30,9 +30,7 @@ void PD_LPSS_opt::calculateForces(const int id, const int i) {
   const double theta_i = m_theta[i];
   const double m_i = m_mass[i];
 
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id);
-  const int nConnections = PDconnections.size();
+  BondList &PDconnections = m_particles.pdConnections(id);
 
   double dr_ij[m_dim];
   double dr0_ij[m_dim];
@@ -75,12 +73,9 @@ void PD_LPSS_opt::calculateForces(const int id, const int i) {
       m_data(i, m_iStress[i]) = 0;
     }
     //----------------------------------
-    for (int l_j = 0; l_j < nConnections; l_j++) {
+    m_particles.forEachConnectedBond(i, [&](const int l_j) {
       auto &con = PDconnections[l_j];
-      vector<double> &con_data = con.second;
-      if (con_data[m_iConnected] <= 0.5)
-        continue;
-
+      BondData &con_data = con.second;
       const int id_j = con.first;
       const int j = m_idToCol_v[id_j];
 
@@ -157,7 +152,7 @@ void PD_LPSS_opt::calculateForces(const int id, const int i) {
       theta_new += w * dudr0 * vol;
 
       nConnected++;
-    }
+    });
   }
   if (m_dim == 2) {             // dim2
     R1[0] = m_data(i, m_iR[0]); // 00
@@ -174,12 +169,9 @@ void PD_LPSS_opt::calculateForces(const int id, const int i) {
       m_data(i, m_iStress[i]) = 0;
 
     //----------------------------------
-    for (int l_j = 0; l_j < nConnections; l_j++) {
+    m_particles.forEachConnectedBond(i, [&](const int l_j) {
       auto &con = PDconnections[l_j];
-      vector<double> &con_data = con.second;
-      if (con_data[m_iConnected] <= 0.5)
-        continue;
-
+      BondData &con_data = con.second;
       const int id_j = con.first;
       const int j = m_idToCol_v[id_j];
 
@@ -238,7 +230,7 @@ void PD_LPSS_opt::calculateForces(const int id, const int i) {
       //            theta_new += w*dudr0*vol;
 
       nConnected++;
-    }
+    });
   }
 
   //    theta_new = m_dim/m_i*theta_new;
@@ -336,9 +328,7 @@ for(int i=0; i<nParticles; i++) {
   for (int i = 0; i < nParticles; i++) {
     const int id = m_colToId.at(i);
 
-    const vector<pair<int, vector<double>>> &PDconnections =
-        m_particles.pdConnections(id);
-    const int nConnections = PDconnections.size();
+    const BondList &PDconnections = m_particles.pdConnections(id);
 
     if (m_dim == 2) {
       m_data(i, m_iR[0]) = m_data(i, m_iRn[0]); // 00
@@ -437,12 +427,8 @@ for(int i=0; i<nParticles; i++) {
     const double m_i = m_mass[i];
     double theta = 0;
 
-    for (int l_j = 0; l_j < nConnections; l_j++) {
+    m_particles.forEachConnectedBond(i, [&](const int l_j) {
       auto &con = PDconnections[l_j];
-      const vector<double> &con_data = con.second;
-
-      if (con_data[m_iConnected] <= 0.5)
-        continue;
 
       const int id_j = con.first;
       const int j = m_idToCol_v[id_j];
@@ -463,7 +449,7 @@ for(int i=0; i<nParticles; i++) {
         dudr0 += (dr_ij[d] - drr_ij[d]) * drr_ij[d];
       }
       theta += w * dudr0 * vol;
-    }
+    });
     theta *= m_dim / m_i;
     m_theta[i] = theta;
   }
@@ -15,7 +15,7 @@ PD_LPS_POROSITY::PD_LPS_POROSITY(PD_Particles &particles, double phi_c,
   m_iRho = m_particles.getParamId("rho");
   m_iDr0 = m_particles.getPdParamId("dr0");
   m_iVolumeScaling = m_particles.getPdParamId("volumeScaling");
-  m_iStretch = m_particles.registerPdParameter("stretch");
+  m_iStretch = m_particles.registerPdParameter("stretch", 0, BondData::Float);
   m_iConnected = m_particles.getPdParamId("connected");
   m_indexBrokenNow = m_particles.registerParameter("brokenNow", 0);
 
@@ -33,6 +33,8 @@ PD_LPS_POROSITY::PD_LPS_POROSITY(PD_Particles &particles, double phi_c,
 
   m_initialGhostParameters = {"volume", "theta", "LPS_mass", "LPS_a", "LPS_b"};
   m_hasUpdateState = true;
+  m_hasLocalUpdateState = true;
+  m_particles.subscribeBondBreaks(this);
   m_analyticalM = analyticalM;
 
   //----------------------------------
@@ -50,6 +52,17 @@ PD_LPS_POROSITY::PD_LPS_POROSITY(PD_Particles &particles, double phi_c,
     m_indexStress[5] = m_particles.registerParameter("s_yz");
   }
   //----------------------------------
+  storageResized();
+  m_particles.subscribeStorage(this);
+}
+//------------------------------------------------------------------------------
+PD_LPS_POROSITY::~PD_LPS_POROSITY() {
+  m_particles.unsubscribeBondBreaks(this);
+  m_particles.unsubscribeStorage(this);
+}
+//------------------------------------------------------------------------------
+void PD_LPS_POROSITY::storageResized() {
+  // The cached column pointers
   m_mass = m_data.colptr(m_iMass);
   m_theta = m_data.colptr(m_iTheta);
   m_volume = m_data.colptr(m_iVolume);
@@ -72,9 +85,7 @@ void PD_LPS_POROSITY::calculateForces(const int id, const int i) {
   const double theta_i = m_theta[i];
   const double m_i = m_mass[i];
 
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id);
-  const int nConnections = PDconnections.size();
+  BondList &PDconnections = m_particles.pdConnections(id);
   double dr_ij[m_dim];
 
   double thetaNew = 0;
@@ -90,12 +101,9 @@ void PD_LPS_POROSITY::calculateForces(const int id, const int i) {
     for (int k = 0; k < 6; k++)
       d_stress[k][i] = 0;
     //----------------------------------
-    for (int l_j = 0; l_j < nConnections; l_j++) {
+    m_particles.forEachConnectedBond(i, [&](const int l_j) {
       auto &con = PDconnections[l_j];
-      vector<double> &con_data = con.second;
-      if (con_data[m_iConnected] <= 0.5)
-        continue;
-
+      BondData &con_data = con.second;
       const int id_j = con.first;
       const int j = m_idToCol_v[id_j];
 
@@ -137,19 +145,16 @@ void PD_LPS_POROSITY::calculateForces(const int id, const int i) {
       d_stress[4][i] += 0.5 * dr_ij[0] * dr_ij[2] * bond;
       d_stress[5][i] += 0.5 * dr_ij[1] * dr_ij[2] * bond;
       //----------------------------------
-    }
+    });
   } else { // dim2
     //----------------------------------
     // TMP - standard stres calc from MD
     for (int k = 0; k < 3; k++)
       m_data(i, m_indexStress[k]) = 0;
     //----------------------------------
-    for (int l_j = 0; l_j < nConnections; l_j++) {
+    m_particles.forEachConnectedBond(i, [&](const int l_j) {
       auto &con = PDconnections[l_j];
-      vector<double> &con_data = con.second;
-      if (con_data[m_iConnected] <= 0.5)
-        continue;
-
+      BondData &con_data = con.second;
       const int id_j = con.first;
       const int j = m_idToCol_v[id_j];
 
@@ -183,7 +188,7 @@ void PD_LPS_POROSITY::calculateForces(const int id, const int i) {
       m_data(i, m_indexStress[0]) += 0.5 * dr_ij[0] * dr_ij[0] * bond;
       m_data(i, m_indexStress[1]) += 0.5 * dr_ij[1] * dr_ij[1] * bond;
       m_data(i, m_indexStress[2]) += 0.5 * dr_ij[0] * dr_ij[1] * bond;
-    }
+    });
   }
   if (nConnected <= 3)
     m_theta_new[i] = 0;
@@ -195,21 +200,19 @@ void PD_LPS_POROSITY::calculateForces(const int id, const int i) {
 //------------------------------------------------------------------------------
 double PD_LPS_POROSITY::calculatePotentialEnergyDensity(const int id_i,
                                                         const int i) {
-  const double theta_i = this->computeDilation(id_i, i);
-  double dr_ij[m_dim];
   const double a_i = m_data(i, m_iA);
   const double k_i = 1.; // TODO: TMP SOLUTION
 
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_i);
+  BondList &PDconnections = m_particles.pdConnections(id_i);
   const int nConnections = PDconnections.size();
 
+  // The bond extensions of the dilation sweep are reused below
+  double *ds_ij = bondScratch(nConnections);
+  const double theta_i = computeDilation(id_i, i, ds_ij);
+
   double W_i = 0;
-  for (int l_j = 0; l_j < nConnections; l_j++) {
+  m_particles.forEachConnectedBond(i, [&](const int l_j) {
     auto &con = PDconnections[l_j];
-    if (con.second[m_iConnected] <= 0.5)
-      continue;
-
     const int id_j = con.first;
     const int j = m_idToCol_v[id_j];
 
@@ -217,40 +220,29 @@ double PD_LPS_POROSITY::calculatePotentialEnergyDensity(const int id_i,
     const double dr0 = con.second[m_iDr0];
     const double w = weightFunction(dr0);
     const double volumeScaling = con.second[m_iVolumeScaling];
-    double dr2 = 0;
-
-    for (int d = 0; d < m_dim; d++) {
-      dr_ij[d] = m_r(j, d) - m_r(i, d);
-      dr2 += dr_ij[d] * dr_ij[d];
-    }
-
-    const double dr = sqrt(dr2);
-    const double ds = dr - dr0;
+    const double ds = ds_ij[l_j];
     const double extension_term =
         a_i * w * (pow(ds - theta_i * dr0 / m_dim, 2));
 
     W_i += (extension_term)*vol_j * volumeScaling;
-  }
+  });
   W_i += k_i * (pow(theta_i, 2));
 
   return 0.5 * W_i;
 }
 //------------------------------------------------------------------------------
-double PD_LPS_POROSITY::computeDilation(const int id_i, const int i) {
+double PD_LPS_POROSITY::computeDilation(const int id_i, const int i,
+                                        double *ds_ij) {
   const double m_i = m_data(i, m_iMass);
   double dr_ij[m_dim];
 
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_i);
+  BondList &PDconnections = m_particles.pdConnections(id_i);
   const int nConnections = PDconnections.size();
 
   double theta_i = 0;
 
-  for (int l_j = 0; l_j < nConnections; l_j++) {
+  m_particles.forEachConnectedBond(i, [&](const int l_j) {
     auto &con = PDconnections[l_j];
-    if (con.second[m_iConnected] <= 0.5)
-      continue;
-
     const int id_j = con.first;
     const int j = m_idToCol_v[id_j];
 
@@ -268,7 +260,10 @@ double PD_LPS_POROSITY::computeDilation(const int id_i, const int i) {
     const double dr = sqrt(dr2);
     const double ds = dr - dr0;
     theta_i += w * dr0 * ds * vol_j * volumeScaling;
-  }
+
+    if (ds_ij != nullptr)
+      ds_ij[l_j] = ds;
+  });
 
   if (nConnections <= 3) {
     theta_i = 0;
@@ -287,6 +282,37 @@ void PD_LPS_POROSITY::updateState(int id, int i) {
   m_data(i, m_iTheta) = m_data(i, m_iThetaNew);
 }
 //------------------------------------------------------------------------------
+void PD_LPS_POROSITY::bondsBroken(const vector<BondBreak> &brokenBonds) {
+  // The weighted volume is only updated for particles that lost bonds
+  const int nParticles = m_particles.nParticles();
+  int id_prev = -1;
+
+  for (const BondBreak &bondBreak : brokenBonds) {
+    const int id_i = bondBreak.id_i;
+    if (id_i == id_prev)
+      continue;
+    id_prev = id_i;
+
+    const int i = m_idToCol_v[id_i];
+    if (i < 0 || i >= nParticles || m_colToId[i] != id_i)
+      continue;
+
+    updateWeightedVolume(id_i, i);
+  }
+}
+//------------------------------------------------------------------------------
+void PD_LPS_POROSITY::connectionsChanged(const vector<int> &ids) {
+  const int nParticles = m_particles.nParticles();
+
+  for (const int id_i : ids) {
+    const int i = m_idToCol_v[id_i];
+    if (i < 0 || i >= nParticles || m_colToId[i] != id_i)
+      continue;
+
+    updateWeightedVolume(id_i, i);
+  }
+}
+//------------------------------------------------------------------------------
 double PD_LPS_POROSITY::calculateStableMass(const int id_a, const int a,
                                             double dt) {
   dt *= 1.1;
@@ -302,8 +328,7 @@ double PD_LPS_POROSITY::calculateStableMass(const int id_a, const int a,
     m[d] = 0;
   }
 
-  const vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_a);
+  const BondList &PDconnections = m_particles.pdConnections(id_a);
 
   double k[m_dim];
 
@@ -312,10 +337,8 @@ double PD_LPS_POROSITY::calculateStableMass(const int id_a, const int a,
       k[d] = 0;
     }
 
-    for (auto &con : PDconnections) {
-      if (con.second[m_iConnected] <= 0.5)
-        continue;
-
+    m_particles.forEachConnectedBond(a, [&](const int l_j) {
+      auto &con = PDconnections[l_j];
       const int id_b = con.first;
       const int b = m_idToCol_v[id_b];
 
@@ -348,7 +371,7 @@ double PD_LPS_POROSITY::calculateStableMass(const int id_a, const int a,
       }
 
       k[i] += fabs(dr0[i]) * C * sum;
-    }
+    });
     m[i] = k[i];
   }
 
@@ -436,8 +459,7 @@ void PD_LPS_POROSITY::calculateWeightedVolume() {
   for (int i = 0; i < nParticles; i++) {
     const int id_i = m_colToId.at(i);
 
-    const vector<pair<int, vector<double>>> &PDconnections =
-        m_particles.pdConnections(id_i);
+    const BondList &PDconnections = m_particles.pdConnections(id_i);
     const int nConnections = PDconnections.size();
     double m = 0;
     for (int l_j = 0; l_j < nConnections; l_j++) {
@@ -473,17 +495,12 @@ void PD_LPS_POROSITY::calculateWeightedVolume() {
 }
 //------------------------------------------------------------------------------
 void PD_LPS_POROSITY::updateWeightedVolume(int id_i, int i) {
-  const vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_i);
-  const int nConnections = PDconnections.size();
+  const BondList &PDconnections = m_particles.pdConnections(id_i);
 
   double m = 0;
   int nActiveConnections = 0;
-  for (int l_j = 0; l_j < nConnections; l_j++) {
+  m_particles.forEachConnectedBond(i, [&](const int l_j) {
     auto &con = PDconnections[l_j];
-    if (con.second[m_iConnected] <= 0.5)
-      continue;
-
     const int id_j = con.first;
     const int j = m_idToCol_v[id_j];
     const double volumeScaling = con.second[m_iVolumeScaling];
@@ -493,7 +510,7 @@ void PD_LPS_POROSITY::updateWeightedVolume(int id_i, int i) {
 
     m += w * dr0 * dr0 * vol_j * volumeScaling;
     nActiveConnections++;
-  }
+  });
 
   if (m_analyticalM) {
     if (m_dim == 3) {
@@ -524,18 +541,13 @@ void PD_LPS_POROSITY::calculateStress(const int id_i, const int i,
   const double a_i = m_data(i, m_iA);
   const double b_i = m_data(i, m_iB);
 
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_i);
+  BondList &PDconnections = m_particles.pdConnections(id_i);
 
-  const int nConnections = PDconnections.size();
   double dr_ij[m_dim];
   double dr0_ij[m_dim];
 
-  for (int l_j = 0; l_j < nConnections; l_j++) {
+  m_particles.forEachConnectedBond(i, [&](const int l_j) {
     auto &con = PDconnections[l_j];
-    if (con.second[m_iConnected] <= 0.5)
-      continue;
-
     const int id_j = con.first;
     const int j = m_idToCol_v[id_j];
 
@@ -571,7 +583,7 @@ void PD_LPS_POROSITY::calculateStress(const int id_i, const int i,
       m_data(i, indexStress[4]) += 0.5 * bond * dr_ij[X] * dr0_ij[Z];
       m_data(i, indexStress[5]) += 0.5 * bond * dr_ij[Y] * dr0_ij[Z];
     }
-  }
+  });
 }
 //------------------------------------------------------------------------------
 }
@@ -6,7 +6,8 @@
 namespace PDtools {
 
 //------------------------------------------------------------------------------
-class PD_LPS_POROSITY : public Force {
+class PD_LPS_POROSITY : public Force, public BondBreakSubscriber,
+                        public ParticleStorageSubscriber {
 protected:
   bool m_planeStress;
   int m_dim = 3;
@@ -69,12 +70,16 @@ protected:
 public:
   PD_LPS_POROSITY(PD_Particles &particles, double m, double b,
                   bool planeStress = false, bool analyticalM = false);
+  ~PD_LPS_POROSITY();
+
+  virtual void storageResized();
 
   virtual void calculateForces(const int id, const int i);
 
   virtual double calculatePotentialEnergyDensity(const int id_i, const int i);
 
-  double computeDilation(const int id_i, const int i);
+  double computeDilation(const int id_i, const int i,
+                         double *ds_ij = nullptr);
 
   virtual void calculatePotentialEnergy(const int id_i, const int i,
                                         int indexPotential);
@@ -82,6 +87,8 @@ public:
                                const int (&indexStress)[6]);
 
   virtual void updateState(int id, int i);
+  virtual void bondsBroken(const vector<BondBreak> &brokenBonds);
+  virtual void connectionsChanged(const vector<int> &ids);
 
   virtual double calculateStableMass(const int id_a, const int a, double dt);
   virtual void initialize(double E, double nu, double delta, int dim, double h,
@@ -6,6 +6,7 @@ PD_lpsDampenedContact_porosity::PD_lpsDampenedContact_porosity(
     PD_Particles &particles, double m, double b, double c, bool planeStress)
     : PD_LPS_POROSITY(particles, m, b, planeStress), m_dampCoeff(c) {
   particles.setNeedGhostVelocity(true);
+  m_readsNeighbourVelocity = true;
 }
 //------------------------------------------------------------------------------
 void PD_lpsDampenedContact_porosity::calculateForces(const int id,
@@ -15,19 +16,15 @@ void PD_lpsDampenedContact_porosity::calculateForces(const int id,
   const double a_i = m_data(i, m_iA);
   const double b_i = m_data(i, m_iA);
 
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id);
+  BondList &PDconnections = m_particles.pdConnections(id);
 
   const int nConnections = PDconnections.size();
   double dr_ij[m_dim];
 
   double thetaNew = 0;
-  for (int l_j = 0; l_j < nConnections; l_j++) {
+  m_particles.forEachConnectedBond(i, [&](const int l_j) {
     auto &con = PDconnections[l_j];
 
-    if (con.second[m_iConnected] <= 0.5)
-      continue;
-
     const int id_j = con.first;
     const int j = m_idToCol_v[id_j];
 
@@ -62,7 +59,7 @@ void PD_lpsDampenedContact_porosity::calculateForces(const int id,
     }
 
     con.second[m_iStretch] = ds / dr0;
-  }
+  });
 
   if (nConnections <= 3)
     m_data(i, m_iThetaNew) = 0;
@@ -78,16 +75,11 @@ PD_lpsDampenedContact_porosity::calculatePotentialEnergyDensity(const int id_i,
   const double a_i = m_data(i, m_iA);
   const double k_i = m_data(i, m_iK);
 
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_i);
-  const int nConnections = PDconnections.size();
+  BondList &PDconnections = m_particles.pdConnections(id_i);
 
   double W_i = 0;
-  for (int l_j = 0; l_j < nConnections; l_j++) {
+  m_particles.forEachConnectedBond(i, [&](const int l_j) {
     auto &con = PDconnections[l_j];
-    if (con.second[m_iConnected] <= 0.5)
-      continue;
-
     const int id_j = con.first;
     const int j = m_idToCol_v[id_j];
 
@@ -112,7 +104,7 @@ PD_lpsDampenedContact_porosity::calculatePotentialEnergyDensity(const int id_i,
         (a_i + a_j) * w * (pow(ds - theta_i * dr0 / m_dim, 2));
 
     W_i += (extension_term)*vol_j * volumeScaling;
-  }
+  });
   W_i += k_i * (pow(theta_i, 2));
 
   return 0.5 * W_i;
@@ -76,8 +76,7 @@ void ContactForce::calculateForces(const int id_i, const int i) {
       // Searching in the pd-connections
       bool hasBeenPdConnected = false;
       bool isPdConnected = false;
-      const vector<pair<int, vector<double>>> &PDconnections =
-          m_particles.pdConnections(id_i);
+      const BondList &PDconnections = m_particles.pdConnections(id_i);
 
       for (const auto &con : PDconnections) {
         if (con.first == id_j) {
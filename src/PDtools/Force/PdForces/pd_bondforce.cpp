@@ -8,9 +8,18 @@ PD_bondForce::PD_bondForce(PD_Particles &particles)
   m_indexVolume = m_particles.getParamId("volume");
   m_indexDr0 = m_particles.getPdParamId("dr0");
   m_indexVolumeScaling = m_particles.getPdParamId("volumeScaling");
-  m_indexForceScaling = m_particles.registerPdParameter("forceScalingBond", 1);
-  m_indexStretch = m_particles.registerPdParameter("stretch");
+  m_indexForceScaling = m_particles.registerPdParameter("forceScalingBond", 1,
+                                                        BondData::Float);
+  m_indexStretch = m_particles.registerPdParameter("stretch", 0,
+                                                   BondData::Float);
   m_indexConnected = m_particles.getPdParamId("connected");
+
+  const BondLayout &layout = m_particles.bondLayout();
+  m_floatStretch = layout.precision(m_indexStretch) == BondData::Float;
+  if (m_floatStretch)
+    m_stretchFloat = layout.field<float>(m_indexStretch);
+  else
+    m_stretchDouble = layout.field<double>(m_indexStretch);
 #if USE_N3L
   m_indexMyPdPosition = m_particles.getPdParamId("myPosistion");
 #endif
@@ -24,42 +33,46 @@ PD_bondForce::PD_bondForce(PD_Particles &particles)
 }
 //------------------------------------------------------------------------------
 void PD_bondForce::calculateForces(const int id_i, const int i) {
+  if (m_computeStress && m_floatStretch)
+    calculateForcesKernel<true>(id_i, i, m_stretchFloat);
+  else if (m_computeStress)
+    calculateForcesKernel<true>(id_i, i, m_stretchDouble);
+  else if (m_floatStretch)
+    calculateForcesKernel<false>(id_i, i, m_stretchFloat);
+  else
+    calculateForcesKernel<false>(id_i, i, m_stretchDouble);
+}
+//------------------------------------------------------------------------------
+template <bool STRESS, typename T>
+void PD_bondForce::calculateForcesKernel(const int id_i, const int i,
+                                         const BondField<T> &stretch) {
   const double c_i = m_data(i, m_indexMicromodulus);
 #if USE_N3L
-  const double vol_i = m_data(i, m_indexVolume);
   const int nParticles = m_particles.nParticles();
 #endif
-  vector<pair<int, vector<double>>> &PDconnections_i =
-      m_particles.pdConnections(id_i);
+  BondList &PDconnections_i = m_particles.pdConnections(id_i);
 
-  const int nConnections = PDconnections_i.size();
   double dr_ij[m_dim];
 
-  //----------------------------------
-  // TMP - standard stres calc from
-  m_data(i, m_indexStress[0]) = 0;
-  m_data(i, m_indexStress[1]) = 0;
-  m_data(i, m_indexStress[2]) = 0;
-  //----------------------------------
+  if (STRESS) {
+    m_data(i, m_indexStress[0]) = 0;
+    m_data(i, m_indexStress[1]) = 0;
+    m_data(i, m_indexStress[2]) = 0;
+  }
 
-  for (int l_j = 0; l_j < nConnections; l_j++) {
+  const bool cached = bondCacheValid();
+  const vector<int> &neighbourCols = m_particles.neighbourColumns(i);
+  m_particles.forEachConnectedBond(i, [&](const int l_j) {
     auto &con_i = PDconnections_i[l_j];
-    if (con_i.second[m_indexConnected] <= 0.5)
-      continue;
-
-    const int id_j = con_i.first;
-    const int j = m_idToCol_v[id_j];
+    const int j = neighbourCols[l_j];
 
 #if USE_N3L
     if (j < i)
-      continue;
+      return;
 #endif
-    const double c_j = m_data(j, m_indexMicromodulus);
-    const double vol_j = m_data(j, m_indexVolume);
-    const double dr0 = con_i.second[m_indexDr0];
-    const double volumeScaling_ij = con_i.second[m_indexVolumeScaling];
-    const double g_ij = con_i.second[m_indexForceScaling];
-    const double c_ij = 0.5 * (c_i + c_j) * g_ij;
+    double k_ij;
+    double dr0Inv;
+    bondCoefficients(cached, c_i, i, l_j, j, con_i.second, k_ij, dr0Inv);
 
     double dr2 = 0;
     for (int d = 0; d < m_dim; d++) {
@@ -68,37 +81,37 @@ void PD_bondForce::calculateForces(const int id_i, const int i) {
     }
 
     const double dr = sqrt(dr2);
-    const double ds = dr - dr0;
-    const double s = ds / dr0;
-    const double fbond_ij = c_ij * s * vol_j * volumeScaling_ij / dr;
+    const double s = dr * dr0Inv - 1.;
+    const double fbond_ij = k_ij * s / dr;
 
     for (int d = 0; d < m_dim; d++) {
       m_F(i, d) += dr_ij[d] * fbond_ij;
     }
 
-    //----------------------------------
-    // TMP - standard stres calc from
-    m_data(i, m_indexStress[0]) += 0.5 * dr_ij[0] * dr_ij[0] * fbond_ij;
-    m_data(i, m_indexStress[1]) += 0.5 * dr_ij[1] * dr_ij[1] * fbond_ij;
-    m_data(i, m_indexStress[2]) += 0.5 * dr_ij[0] * dr_ij[1] * fbond_ij;
-    //----------------------------------
+    if (STRESS) {
+      m_data(i, m_indexStress[0]) += 0.5 * dr_ij[0] * dr_ij[0] * fbond_ij;
+      m_data(i, m_indexStress[1]) += 0.5 * dr_ij[1] * dr_ij[1] * fbond_ij;
+      m_data(i, m_indexStress[2]) += 0.5 * dr_ij[0] * dr_ij[1] * fbond_ij;
+    }
 
-    con_i.second[m_indexStretch] = s;
+    stretch.set(con_i.second, s);
 #if USE_N3L
     if (j > i && j < nParticles) {
       const int myPos_j = con_i.second[m_indexMyPdPosition];
-      vector<pair<int, vector<double>>> &PDconnections_j =
-          m_particles.pdConnections(id_j);
+      BondList &PDconnections_j = m_particles.pdConnections(id_j);
       auto &con_j = PDconnections_j[myPos_j];
-      const double volumeScaling_ji = con_j.second[m_indexVolumeScaling];
-      const double fbond_ji = -c_ij * s * vol_i * volumeScaling_ji / dr;
+      double k_ji;
+      double dr0Inv_ji;
+      bondCoefficients(cached, m_data(j, m_indexMicromodulus), j, myPos_j, i,
+                       con_j.second, k_ji, dr0Inv_ji);
+      const double fbond_ji = -k_ji * s / dr;
       for (int d = 0; d < m_dim; d++) {
         m_F(j, d) += dr_ij[d] * fbond_ji;
       }
-      con_j.second[m_indexStretch] = s;
+      stretch.set(con_j.second, s);
     }
 #endif
-  }
+  });
 }
 //------------------------------------------------------------------------------
 void PD_bondForce::calculateLinearForces(const int id_i, const int i) {
@@ -110,23 +123,18 @@ double PD_bondForce::calculatePotentialEnergyDensity(const int id_i,
                                                      const int i) {
   const double c_i = m_data(i, m_indexMicromodulus);
   double dr_ij[m_dim];
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_i);
+  BondList &PDconnections = m_particles.pdConnections(id_i);
 
   double energy = 0;
-  for (auto &con : PDconnections) {
-    if (con.second[m_indexConnected] <= 0.5)
-      continue;
+  const bool cached = bondCacheValid();
+  const vector<int> &neighbourCols = m_particles.neighbourColumns(i);
+  m_particles.forEachConnectedBond(i, [&](const int l_j) {
+    const auto &con = PDconnections[l_j];
+    const int j = neighbourCols[l_j];
 
-    const int id_j = con.first;
-    const int j = m_idToCol_v[id_j];
-
-    const double vol_j = m_data(j, m_indexVolume);
-    const double dr0 = con.second[m_indexDr0];
-    const double volumeScaling = con.second[m_indexVolumeScaling];
-    const double c_j = m_data(j, m_indexMicromodulus);
-    const double g_ij = con.second[m_indexForceScaling];
-    const double c_ij = 0.5 * (c_i + c_j) * g_ij;
+    double k_ij;
+    double dr0Inv;
+    bondCoefficients(cached, c_i, i, l_j, j, con.second, k_ij, dr0Inv);
 
     double dr2 = 0;
 
@@ -136,9 +144,9 @@ double PD_bondForce::calculatePotentialEnergyDensity(const int id_i,
     }
 
     const double dr = sqrt(dr2);
-    const double s = (dr - dr0) / dr0;
-    energy += c_ij * (s * s) * dr0 * vol_j * volumeScaling;
-  }
+    const double s = dr * dr0Inv - 1.;
+    energy += k_ij * (s * s) / dr0Inv;
+  });
 
   return 0.25 * energy;
 }
@@ -153,33 +161,25 @@ void PD_bondForce::calculateStress(const int id_i, const int i,
                                    const int (&indexStress)[6]) {
   const double c_i = m_data(i, m_indexMicromodulus);
 #if USE_N3L
-  const double vol_i = m_data(i, m_indexVolume);
   const int nParticles = m_particles.nParticles();
 #endif
 
-  const vector<pair<int, vector<double>>> &PDconnections_i =
-      m_particles.pdConnections(id_i);
+  const BondList &PDconnections_i = m_particles.pdConnections(id_i);
 
   double dr_ij[m_dim];
-  const int nConnections = PDconnections_i.size();
 
-  for (int l_j = 0; l_j < nConnections; l_j++) {
+  const bool cached = bondCacheValid();
+  const vector<int> &neighbourCols = m_particles.neighbourColumns(i);
+  m_particles.forEachConnectedBond(i, [&](const int l_j) {
     const auto &con_i = PDconnections_i[l_j];
-    if (con_i.second[m_indexConnected] <= 0.5)
-      continue;
-
-    const int id_j = con_i.first;
-    const int j = m_idToCol_v[id_j];
+    const int j = neighbourCols[l_j];
 #if USE_N3L // Already computed
     if (j < i)
-      continue;
+      return;
 #endif
-    const double c_j = m_data(j, m_indexMicromodulus);
-    const double vol_j = m_data(j, m_indexVolume);
-    const double dr0 = con_i.second[m_indexDr0];
-    const double volumeScaling = con_i.second[m_indexVolumeScaling];
-    const double g_ij = con_i.second[m_indexForceScaling];
-    const double c_ij = 0.5 * (c_i + c_j) * g_ij;
+    double k_ij;
+    double dr0Inv;
+    bondCoefficients(cached, c_i, i, l_j, j, con_i.second, k_ij, dr0Inv);
 
     double dr2 = 0;
 
@@ -189,8 +189,8 @@ void PD_bondForce::calculateStress(const int id_i, const int i,
     }
 
     const double dr = sqrt(dr2);
-    const double s = (dr - dr0) / dr0;
-    const double bond_ij = c_ij * s * vol_j * volumeScaling / dr;
+    const double s = dr * dr0Inv - 1.;
+    const double bond_ij = k_ij * s / dr;
 
     m_data(i, indexStress[0]) += 0.5 * bond_ij * dr_ij[X] * dr_ij[X];
     m_data(i, indexStress[1]) += 0.5 * bond_ij * dr_ij[Y] * dr_ij[Y];
@@ -204,11 +204,13 @@ void PD_bondForce::calculateStress(const int id_i, const int i,
 #if USE_N3L
     if (j > i && j < nParticles) {
       const int myPos_j = con_i.second[m_indexMyPdPosition];
-      const vector<pair<int, vector<double>>> &PDconnections_j =
-          m_particles.pdConnections(id_j);
+      const BondList &PDconnections_j = m_particles.pdConnections(id_j);
       const auto &con_j = PDconnections_j[myPos_j];
-      const double volumeScaling_ji = con_j.second[m_indexVolumeScaling];
-      const double bond_ji = c_ij * s * vol_i * volumeScaling_ji / dr;
+      double k_ji;
+      double dr0Inv_ji;
+      bondCoefficients(cached, m_data(j, m_indexMicromodulus), j, myPos_j, i,
+                       con_j.second, k_ji, dr0Inv_ji);
+      const double bond_ji = k_ji * s / dr;
       m_data(j, indexStress[0]) += 0.5 * bond_ji * dr_ij[X] * dr_ij[X];
       m_data(j, indexStress[1]) += 0.5 * bond_ji * dr_ij[Y] * dr_ij[Y];
       m_data(j, indexStress[2]) += 0.5 * bond_ji * dr_ij[X] * dr_ij[Y];
@@ -220,7 +222,7 @@ void PD_bondForce::calculateStress(const int id_i, const int i,
       }
     }
 #endif
-  }
+  });
 }
 //------------------------------------------------------------------------------
 double PD_bondForce::calculateStableMass(const int id_a, const int a,
@@ -237,8 +239,7 @@ double PD_bondForce::calculateStableMass(const int id_a, const int a,
     m[d] = 0;
   }
 
-  const vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_a);
+  const BondList &PDconnections = m_particles.pdConnections(id_a);
 
   double k[m_dim];
 
@@ -246,10 +247,8 @@ double PD_bondForce::calculateStableMass(const int id_a, const int a,
     for (int d = 0; d < m_dim; d++) {
       k[d] = 0;
     }
-    for (auto &con : PDconnections) {
-      if (con.second[m_indexConnected] <= 0.5)
-        continue;
-
+    m_particles.forEachConnectedBond(a, [&](const int l_j) {
+      auto &con = PDconnections[l_j];
       const int id_b = con.first;
       const int b = m_idToCol_v[id_b];
 
@@ -275,7 +274,7 @@ double PD_bondForce::calculateStableMass(const int id_a, const int a,
       sum *= fabs(dr0[i]) * coeff;
 
       k[i] += sum;
-    }
+    });
 
     m[i] = k[i];
   }
@@ -291,6 +290,52 @@ double PD_bondForce::calculateStableMass(const int id_a, const int a,
   return 4. * 0.25 * pow(dt, 2) * stiffness;
 }
 //------------------------------------------------------------------------------
+void PD_bondForce::updateState() {
+  updateBondCache();
+  Force::updateState();
+}
+//------------------------------------------------------------------------------
+void PD_bondForce::updateBondCache() {
+  // Only changed by the surface correction, the micromodulus, the volumes or
+  // the connection lists, not by broken bonds.
+  if (bondCacheValid())
+    return;
+
+  const int nParticles = m_particles.nParticles();
+  m_bondCacheOffsets.resize(nParticles + 1);
+  m_bondCacheOffsets[0] = 0;
+  for (int i = 0; i < nParticles; i++) {
+    m_bondCacheOffsets[i + 1] =
+        m_bondCacheOffsets[i] + m_particles.neighbourColumns(i).size();
+  }
+  m_bondCoefficients.resize(m_bondCacheOffsets[nParticles]);
+  m_bondDr0Inv.resize(m_bondCacheOffsets[nParticles]);
+
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+  for (int i = 0; i < nParticles; i++) {
+    const int id_i = m_colToId(i);
+    const double c_i = m_data(i, m_indexMicromodulus);
+    const BondList &PDconnections = m_particles.pdConnections(id_i);
+    const vector<int> &neighbourCols = m_particles.neighbourColumns(i);
+    const size_t offset = m_bondCacheOffsets[i];
+    const int nConnections = neighbourCols.size();
+
+    for (int l_j = 0; l_j < nConnections; l_j++) {
+      double k_ij;
+      double dr0Inv;
+      bondCoefficients(false, c_i, i, l_j, neighbourCols[l_j],
+                       PDconnections[l_j].second, k_ij, dr0Inv);
+      m_bondCoefficients[offset + l_j] = k_ij;
+      m_bondDr0Inv[offset + l_j] = dr0Inv;
+    }
+  }
+
+  m_bondCacheStamp = m_particles.bondCacheStamp();
+  m_bondCacheValid = true;
+}
+//------------------------------------------------------------------------------
 void PD_bondForce::initialize(double E, double nu, double delta, int dim,
                               double h, double lc) {
   Force::initialize(E, nu, delta, dim, h, lc);
@@ -334,8 +379,7 @@ void PD_bondForce::initialize(double E, double nu, double delta, int dim,
       double dRvolume = 0;
       double v = 0;
 
-      vector<pair<int, vector<double>>> & PDconnections =
-m_particles.pdConnections(pId);
+      BondList & PDconnections = m_particles.pdConnections(pId);
       for(auto &con:PDconnections) {
           const int id_j = con.first;
           const int j = m_idToCol_v[id_j];
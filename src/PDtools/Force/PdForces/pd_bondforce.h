@@ -19,6 +19,12 @@ protected:
   int m_indexMyPdPosition;
   int m_indexStress[6];
 
+  // The stretch written by the force loop, a float with the mixed bond
+  // storage. Resolved once, the offsets of the bond parameters do not change.
+  bool m_floatStretch;
+  BondField<float> m_stretchFloat;
+  BondField<double> m_stretchDouble;
+
   enum PD_bondForceErrorMessages { MicrmodulusNotSet };
 
 public:
@@ -34,7 +40,40 @@ public:
   virtual double calculateStableMass(const int id_a, const int a, double dt);
   virtual void initialize(double E, double nu, double delta, int dim, double h,
                           double lc);
+  virtual void updateState();
+  virtual void updateBondCache();
+
+protected:
+  // The force, and with STRESS the stress s_xx, s_yy and s_xy of the bonds.
+  // T is the type the stretch is stored as.
+  template <bool STRESS, typename T>
+  void calculateForcesKernel(const int id_i, const int i,
+                             const BondField<T> &stretch);
+  void bondCoefficients(const bool cached, const double c_i, const int i,
+                        const int l_j, const int j, const BondData &bond,
+                        double &k_ij, double &dr0Inv) const;
 };
 //------------------------------------------------------------------------------
+// Inline functions
+//------------------------------------------------------------------------------
+inline void PD_bondForce::bondCoefficients(const bool cached, const double c_i,
+                                           const int i, const int l_j,
+                                           const int j, const BondData &bond,
+                                           double &k_ij,
+                                           double &dr0Inv) const {
+  // k_ij = 0.5 (c_i + c_j) g_ij V_j volumeScaling_ij of bond l_j of column i,
+  // from the cache when it is valid (bondCacheValid()).
+  if (cached) {
+    k_ij = cachedBondCoefficient(i, l_j);
+    dr0Inv = cachedDr0Inv(i, l_j);
+    return;
+  }
+  const double c_j = m_data(j, m_indexMicromodulus);
+  const double vol_j = m_data(j, m_indexVolume);
+  k_ij = 0.5 * (c_i + c_j) * bond[m_indexForceScaling] * vol_j *
+         bond[m_indexVolumeScaling];
+  dr0Inv = 1. / bond[m_indexDr0];
+}
+//------------------------------------------------------------------------------
 }
 #endif // PD_BONDFORCE_H
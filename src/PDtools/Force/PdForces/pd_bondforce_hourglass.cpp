@@ -31,7 +31,7 @@ void PD_bondForce_hourglass::calculateForces(const int id_i, const int i) {
     (void) id_i;
     (void) i;
   //    const double c_i = m_data(i, m_indexMicromodulus);
-  //    vector<pair<int, vector<double>>> & PDconnections_i =
+  //    BondList & PDconnections_i =
   //    m_particles.pdConnections(id_i);
 
   //    _F.zeros();
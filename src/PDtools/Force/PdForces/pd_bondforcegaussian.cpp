@@ -9,8 +9,10 @@ PD_bondforceGaussian::PD_bondforceGaussian(PD_Particles &particles,
   m_indexVolume = m_particles.getParamId("volume");
   m_indexDr0 = m_particles.getPdParamId("dr0");
   m_indexVolumeScaling = m_particles.getPdParamId("volumeScaling");
-  m_indexForceScaling = m_particles.registerPdParameter("forceScalingBond", 1);
-  m_indexStretch = m_particles.registerPdParameter("stretch");
+  m_indexForceScaling = m_particles.registerPdParameter("forceScalingBond", 1,
+                                                        BondData::Float);
+  m_indexStretch = m_particles.registerPdParameter("stretch", 0,
+                                                   BondData::Float);
   m_indexConnected = m_particles.getPdParamId("connected");
   m_indexWeightFunction = m_particles.registerPdParameter("weightFunction", 1);
 
@@ -28,21 +30,18 @@ void PD_bondforceGaussian::calculateForces(const int id, const int i) {
   const double vol_i = m_data(i, m_indexVolume);
   const int nParticles = m_particles.nParticles();
 #endif
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id);
+  BondList &PDconnections = m_particles.pdConnections(id);
 
   double dr_ij[m_dim];
 
-  for (auto &con : PDconnections) {
-    if (con.second[m_indexConnected] <= 0.5)
-      continue;
-
+  m_particles.forEachConnectedBond(i, [&](const int l_j) {
+    auto &con = PDconnections[l_j];
     const int id_j = con.first;
     const int j = m_idToCol_v[id_j];
 
 #if USE_N3L
     if (j < i)
-      continue;
+      return;
 #endif
     const double c_j = m_data(j, m_indexMicromodulus);
     const double vol_j = m_data(j, m_indexVolume);
@@ -81,7 +80,7 @@ void PD_bondforceGaussian::calculateForces(const int id, const int i) {
       }
     }
 #endif
-  }
+  });
 }
 //------------------------------------------------------------------------------
 double PD_bondforceGaussian::calculatePotentialEnergyDensity(const int id_i,
@@ -89,14 +88,11 @@ double PD_bondforceGaussian::calculatePotentialEnergyDensity(const int id_i,
   // PD_bond
   const double c_i = m_data(i, m_indexMicromodulus);
   double dr_ij[m_dim];
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_i);
+  BondList &PDconnections = m_particles.pdConnections(id_i);
 
   double energy = 0;
-  for (auto &con : PDconnections) {
-    if (con.second[m_indexConnected] <= 0.5)
-      continue;
-
+  m_particles.forEachConnectedBond(i, [&](const int l_j) {
+    auto &con = PDconnections[l_j];
     const int id_j = con.first;
     const int j = m_idToCol_v[id_j];
 
@@ -117,7 +113,7 @@ double PD_bondforceGaussian::calculatePotentialEnergyDensity(const int id_i,
     const double dr = sqrt(dr2);
     double s = (dr - dr0) / dr0;
     energy += c_ij * (s * s) * dr0 * vol_j * volumeScaling;
-  }
+  });
 
   return 0.25 * energy;
 }
@@ -131,7 +127,7 @@ void PD_bondforceGaussian::calculatePotentialEnergy(const int id_i, const int i,
 //------------------------------------------------------------------------------
 double
 PD_bondforceGaussian::calculateBondEnergy(const int id_i, const int i,
-                                          pair<int, vector<double>> &con) {
+                                          pair<int, BondData> &con) {
   // PD_bond
   (void)id_i;
   const double c_i = m_data(i, m_indexMicromodulus);
@@ -175,15 +171,12 @@ void PD_bondforceGaussian::calculateStress(const int id_i, const int i,
   const int nParticles = m_particles.nParticles();
 #endif
 
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_i);
+  BondList &PDconnections = m_particles.pdConnections(id_i);
   double dr_ij[m_dim];
   double f[m_dim];
 
-  for (auto &con : PDconnections) {
-    if (con.second[m_indexConnected] <= 0.5)
-      continue;
-
+  m_particles.forEachConnectedBond(i, [&](const int l_j) {
+    auto &con = PDconnections[l_j];
     const int id_j = con.first;
     const int j = m_idToCol_v[id_j];
 
@@ -239,7 +232,7 @@ void PD_bondforceGaussian::calculateStress(const int id_i, const int i,
       }
     }
 #endif
-  }
+  });
 }
 //------------------------------------------------------------------------------
 double PD_bondforceGaussian::calculateStableMass(const int id_a, const int a,
@@ -256,8 +249,7 @@ double PD_bondforceGaussian::calculateStableMass(const int id_a, const int a,
     m[d] = 0;
   }
 
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_a);
+  BondList &PDconnections = m_particles.pdConnections(id_a);
 
   double k[m_dim];
 
@@ -266,10 +258,8 @@ double PD_bondforceGaussian::calculateStableMass(const int id_a, const int a,
       k[d] = 0;
     }
 
-    for (auto &con : PDconnections) {
-      if (con.second[m_indexConnected] <= 0.5)
-        continue;
-
+    m_particles.forEachConnectedBond(a, [&](const int l_j) {
+      auto &con = PDconnections[l_j];
       const int id_b = con.first;
       const int b = m_idToCol_v[id_b];
 
@@ -290,7 +280,7 @@ double PD_bondforceGaussian::calculateStableMass(const int id_a, const int a,
 
       const double coeff = c_ab * volumeScaling * vol_b / dr0_3;
       k[i] += coeff * fabs(dR0[i]) * sum;
-    }
+    });
 
     m[i] = k[i];
   }
@@ -377,8 +367,7 @@ void PD_bondforceGaussian::initializeLinear() {
   for (unsigned int i = 0; i < m_particles.nParticles(); i++) {
     const int pId = colToId(i);
 
-    vector<pair<int, vector<double>>> &PDconnections =
-        m_particles.pdConnections(pId);
+    BondList &PDconnections = m_particles.pdConnections(pId);
 
     for (auto &con : PDconnections) {
       const double dr0 = con.second[m_indexDr0];
@@ -417,8 +406,7 @@ void PD_bondforceGaussian::initializeGaussian() {
   for (unsigned int i = 0; i < m_particles.nParticles(); i++) {
     const int pId = colToId(i);
 
-    vector<pair<int, vector<double>>> &PDconnections =
-        m_particles.pdConnections(pId);
+    BondList &PDconnections = m_particles.pdConnections(pId);
     for (auto &con : PDconnections) {
       const double dr0Len = con.second[m_indexDr0];
       const double e_drl = exp(-dr0Len / m_l);
@@ -460,8 +448,7 @@ void PD_bondforceGaussian::initializeSigmoid() {
   for (unsigned int i = 0; i < m_particles.nParticles(); i++) {
     const int pId = colToId(i);
 
-    vector<pair<int, vector<double>>> &PDconnections =
-        m_particles.pdConnections(pId);
+    BondList &PDconnections = m_particles.pdConnections(pId);
     for (auto &con : PDconnections) {
       const double dr0 = con.second[m_indexDr0];
       const double e_drl = 1. / (1. + exp((dr0 - alpha) / beta));
@@ -35,7 +35,7 @@ public:
                                         int indexPotential);
 
   virtual double calculateBondEnergy(const int id_i, const int i,
-                                     std::pair<int, std::vector<double>> &con);
+                                     std::pair<int, BondData> &con);
 
   virtual void calculateStress(const int id_i, const int i,
                                const int (&indexStress)[6]);
@@ -5,6 +5,7 @@ namespace PDtools {
 PD_dampenedBondForce::PD_dampenedBondForce(PD_Particles &particles, double c)
     : PD_bondForce(particles), m_c(c) {
   particles.setNeedGhostVelocity(true);
+  m_readsNeighbourVelocity = true;
 }
 //------------------------------------------------------------------------------
 void PD_dampenedBondForce::calculateForces(const int id_i, const int i) {
@@ -13,23 +14,18 @@ void PD_dampenedBondForce::calculateForces(const int id_i, const int i) {
   const double vol_i = m_data(i, m_indexVolume);
   const int nParticles = m_particles.nParticles();
 #endif
-  vector<pair<int, vector<double>>> &PDconnections_i =
-      m_particles.pdConnections(id_i);
+  BondList &PDconnections_i = m_particles.pdConnections(id_i);
 
-  const int nConnections = PDconnections_i.size();
   double dr_ij[m_dim];
 
-  for (int l_j = 0; l_j < nConnections; l_j++) {
+  m_particles.forEachConnectedBond(i, [&](const int l_j) {
     auto &con_i = PDconnections_i[l_j];
-    if (con_i.second[m_indexConnected] <= 0.5)
-      continue;
-
     const int id_j = con_i.first;
     const int j = m_idToCol_v[id_j];
 
 #if USE_N3L
     if (j < i)
-      continue;
+      return;
 #endif
     const double c_j = m_data(j, m_indexMicromodulus);
     const double vol_j = m_data(j, m_indexVolume);
@@ -61,8 +57,7 @@ void PD_dampenedBondForce::calculateForces(const int id_i, const int i) {
 #if USE_N3L
     if (j > i && j < nParticles) {
       const int myPos_j = con_i.second[m_indexMyPdPosition];
-      vector<pair<int, vector<double>>> &PDconnections_j =
-          m_particles.pdConnections(id_j);
+      BondList &PDconnections_j = m_particles.pdConnections(id_j);
       auto &con_j = PDconnections_j[myPos_j];
       const double volumeScaling_ji = con_j.second[m_indexVolumeScaling];
       const double fbond_ji = -c_ij * s * vol_i * volumeScaling_ji / dr;
@@ -72,7 +67,7 @@ void PD_dampenedBondForce::calculateForces(const int id_i, const int i) {
       con_j.second[m_indexStretch] = s;
     }
 #endif
-  }
+  });
 }
 //------------------------------------------------------------------------------
 void PD_dampenedBondForce::calculateStress(const int id_i, const int i,
@@ -83,22 +78,17 @@ void PD_dampenedBondForce::calculateStress(const int id_i, const int i,
   const int nParticles = m_particles.nParticles();
 #endif
 
-  const vector<pair<int, vector<double>>> &PDconnections_i =
-      m_particles.pdConnections(id_i);
+  const BondList &PDconnections_i = m_particles.pdConnections(id_i);
 
   double dr_ij[m_dim];
-  const int nConnections = PDconnections_i.size();
 
-  for (int l_j = 0; l_j < nConnections; l_j++) {
+  m_particles.forEachConnectedBond(i, [&](const int l_j) {
     const auto &con_i = PDconnections_i[l_j];
-    if (con_i.second[m_indexConnected] <= 0.5)
-      continue;
-
     const int id_j = con_i.first;
     const int j = m_idToCol_v[id_j];
 #if USE_N3L // Already computed
     if (j < i)
-      continue;
+      return;
 #endif
     const double c_j = m_data(j, m_indexMicromodulus);
     const double vol_j = m_data(j, m_indexVolume);
@@ -136,8 +126,7 @@ void PD_dampenedBondForce::calculateStress(const int id_i, const int i,
 #if USE_N3L
     if (j > i && j < nParticles) {
       const int myPos_j = con_i.second[m_indexMyPdPosition];
-      const vector<pair<int, vector<double>>> &PDconnections_j =
-          m_particles.pdConnections(id_j);
+      const BondList &PDconnections_j = m_particles.pdConnections(id_j);
       const auto &con_j = PDconnections_j[myPos_j];
       const double volumeScaling_ji = con_j.second[m_indexVolumeScaling];
       const double bond_ji = c_ij * s * vol_i * volumeScaling_ji / dr;
@@ -152,7 +141,7 @@ void PD_dampenedBondForce::calculateStress(const int id_i, const int i,
       }
     }
 #endif
-  }
+  });
 }
 //------------------------------------------------------------------------------
 }
@@ -18,9 +18,12 @@ PD_NOPD::PD_NOPD(PD_Particles &particles, double phi, double C, double T,
 
   m_greenStrain = true;
   m_hasUpdateState = true;
+  m_particles.subscribeBondBreaks(this);
   m_delta = 1.;
 }
 //------------------------------------------------------------------------------
+PD_NOPD::~PD_NOPD() { m_particles.unsubscribeBondBreaks(this); }
+//------------------------------------------------------------------------------
 void PD_NOPD::initialize(double E, double nu, double delta, int dim, double h,
                          double lc) {
   Force::initialize(E, nu, delta, dim, h, lc);
@@ -141,10 +144,8 @@ void PD_NOPD::initialize(double E, double nu, double delta, int dim, double h,
 }
 //------------------------------------------------------------------------------
 void PD_NOPD::updateState(int id, int i) {
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id);
+  BondList &PDconnections = m_particles.pdConnections(id);
 
-  const int nConnections = PDconnections.size();
   double dr0_ij[m_dim];
   double dr_ij[m_dim];
 
@@ -157,12 +158,9 @@ void PD_NOPD::updateState(int id, int i) {
   int nConnected = 0;
 
   // Calculating the deformation gradient tensor F
-  for (int l_j = 0; l_j < nConnections; l_j++) {
+  m_particles.forEachConnectedBond(i, [&](const int l_j) {
     auto &con = PDconnections[l_j];
 
-    if (con.second[m_iConnected] <= 0.5)
-      continue;
-
     const int id_j = con.first;
     const int j = m_idToCol_v[id_j];
 
@@ -183,12 +181,7 @@ void PD_NOPD::updateState(int id, int i) {
       }
     }
     nConnected++;
-  }
-
-  if (m_data(i, m_iBrokenNow)) {
-    computeK(id, i);
-    m_data(i, m_iBrokenNow) = 0;
-  }
+  });
 
   K(0, 0) = m_data(i, m_indexK[0]);
   K(1, 1) = m_data(i, m_indexK[1]);
@@ -252,10 +245,39 @@ void PD_NOPD::updateState(int id, int i) {
   }
 }
 //------------------------------------------------------------------------------
+void PD_NOPD::bondsBroken(const vector<BondBreak> &brokenBonds) {
+  // The shape tensor is only updated for particles that lost bonds
+  const int nParticles = m_particles.nParticles();
+  int id_prev = -1;
+
+  for (const BondBreak &bondBreak : brokenBonds) {
+    const int id_i = bondBreak.id_i;
+    if (id_i == id_prev)
+      continue;
+    id_prev = id_i;
+
+    const int i = m_idToCol_v[id_i];
+    if (i < 0 || i >= nParticles || m_colToId[i] != id_i)
+      continue;
+
+    computeK(id_i, i);
+  }
+}
+//------------------------------------------------------------------------------
+void PD_NOPD::connectionsChanged(const vector<int> &ids) {
+  const int nParticles = m_particles.nParticles();
+
+  for (const int id_i : ids) {
+    const int i = m_idToCol_v[id_i];
+    if (i < 0 || i >= nParticles || m_colToId[i] != id_i)
+      continue;
+
+    computeK(id_i, i);
+  }
+}
+//------------------------------------------------------------------------------
 void PD_NOPD::calculateForces(const int id, const int i) {
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id);
-  const int nConnections = PDconnections.size();
+  BondList &PDconnections = m_particles.pdConnections(id);
 
   m_PK_i(0, 0) = m_data(i, m_indexPK[0]);
   m_PK_i(1, 1) = m_data(i, m_indexPK[1]);
@@ -271,12 +293,9 @@ void PD_NOPD::calculateForces(const int id, const int i) {
   vec dr_ij = zeros(m_dim);
   vec dr0_ij = zeros(m_dim);
 
-  for (int l_j = 0; l_j < nConnections; l_j++) {
+  m_particles.forEachConnectedBond(i, [&](const int l_j) {
     auto &con = PDconnections[l_j];
 
-    if (con.second[m_iConnected] <= 0.5)
-      continue;
-
     const int id_j = con.first;
     const int j = m_idToCol_v[id_j];
     const double volum_j = m_data(j, m_iVolume);
@@ -308,7 +327,7 @@ void PD_NOPD::calculateForces(const int id, const int i) {
     for (int d = 0; d < m_dim; d++) {
       m_F(i, d) += f(d);
     }
-  }
+  });
 }
 //------------------------------------------------------------------------------
 void PD_NOPD::evaluateStepTwo(int id, int i) {
@@ -318,8 +337,7 @@ void PD_NOPD::evaluateStepTwo(int id, int i) {
   if(m_data(i, m_iUnbreakable) >= 1)
       return;
 
-  vector<pair<int, vector<double>>> & PDconnections =
-  m_particles.pdConnections(id);
+  BondList & PDconnections = m_particles.pdConnections(id);
 
   if(m_dim == 2)
   {
@@ -356,12 +374,12 @@ void PD_NOPD::evaluateStepTwo(int id, int i) {
           if(criticalShear >= 0  && normal < 0)
           {
               m_data(i, m_iBrokenNow) = 1;
-              con.second[m_iConnected] = 0;
+              m_particles.breakBond(id, con);
           }
           else if(criticalTensile >= 0)
           {
               m_data(i, m_iBrokenNow) = 1;
-              con.second[m_iConnected] = 0;
+              m_particles.breakBond(id, con);
           }
       }
   }
@@ -370,8 +388,7 @@ void PD_NOPD::evaluateStepTwo(int id, int i) {
 //------------------------------------------------------------------------------
 void PD_NOPD::computeK(int id, int i) {
   mat K = zeros(m_dim, m_dim);
-  vector<pair<int, vector<double>>> &PDconnections_i =
-      m_particles.pdConnections(id);
+  BondList &PDconnections_i = m_particles.pdConnections(id);
   const int nConnections = PDconnections_i.size();
   double dr0_ij[m_dim];
 
@@ -459,13 +476,10 @@ double PD_NOPD::calculateStableMass(const int id_a, const int a, double dt) {
   }
 
   double m_a = 0;
-  const vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_a);
-
-  for (auto &con : PDconnections) {
-    if (con.second[m_iConnected] <= 0.5)
-      continue;
+  const BondList &PDconnections = m_particles.pdConnections(id_a);
 
+  m_particles.forEachConnectedBond(a, [&](const int l_j) {
+    auto &con = PDconnections[l_j];
     const int id_b = con.first;
     const int b = m_idToCol_v[id_b];
 
@@ -482,7 +496,7 @@ double PD_NOPD::calculateStableMass(const int id_a, const int a, double dt) {
     const double V = vol_b * volumeScaling;
     const double w = weightFunction(dr0Len);
     m_a += dr0Len * w * V;
-  }
+  });
 
   c = 2. * k_ * pow(m_dim, 2.) / m_a;
   //--------------------------------------------------------------------------
@@ -495,10 +509,8 @@ double PD_NOPD::calculateStableMass(const int id_a, const int a, double dt) {
     for (int d = 0; d < m_dim; d++) {
       k[d] = 0;
     }
-    for (auto &con : PDconnections) {
-      if (con.second[m_iConnected] <= 0.5)
-        continue;
-
+    m_particles.forEachConnectedBond(a, [&](const int l_j) {
+      auto &con = PDconnections[l_j];
       const int id_b = con.first;
       const int b = m_idToCol_v[id_b];
 
@@ -526,7 +538,7 @@ double PD_NOPD::calculateStableMass(const int id_a, const int a, double dt) {
       sum *= fabs(dr0[i]) * coeff;
 
       k[i] += sum;
-    }
+    });
 
     m[i] = k[i];
   }
@@ -5,10 +5,11 @@
 
 namespace PDtools {
 //------------------------------------------------------------------------------
-class PD_NOPD : public Force {
+class PD_NOPD : public Force, public BondBreakSubscriber {
 public:
   PD_NOPD(PD_Particles &particles, double phi, double C, double T,
           bool planeStress = true);
+  ~PD_NOPD();
 
   virtual void initialize(double E, double nu, double delta, int dim, double h,
                           double lc);
@@ -17,6 +18,9 @@ public:
 
   virtual void updateState(int id, int i);
 
+  virtual void bondsBroken(const vector<BondBreak> &brokenBonds);
+  virtual void connectionsChanged(const vector<int> &ids);
+
   virtual void evaluateStepTwo(int id, int i);
 
   void computeK(int id, int i);
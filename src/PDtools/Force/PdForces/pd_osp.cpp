@@ -13,15 +13,18 @@ PD_OSP::PD_OSP(PD_Particles &particles) : Force(particles) {
   m_indexVolume = m_particles.getParamId("volume");
   m_indexDr0 = m_particles.getPdParamId("dr0");
   m_indexVolumeScaling = m_particles.getPdParamId("volumeScaling");
-  m_indexStretch = m_particles.registerPdParameter("stretch");
+  m_indexStretch = m_particles.registerPdParameter("stretch", 0,
+                                                   BondData::Float);
   m_indexConnected = m_particles.getPdParamId("connected");
 
   m_indexForceScalingDilation =
-      m_particles.registerPdParameter("forceScalingDilation", 1.);
+      m_particles.registerPdParameter("forceScalingDilation", 1.,
+                                      BondData::Float);
   m_indexForceScalingBond =
-      m_particles.registerPdParameter("forceScalingBond", 1.);
+      m_particles.registerPdParameter("forceScalingBond", 1., BondData::Float);
 
   m_hasUpdateState = true;
+  m_hasLocalUpdateState = true;
 }
 //------------------------------------------------------------------------------
 PD_OSP::~PD_OSP() {}
@@ -32,23 +35,18 @@ void PD_OSP::calculateForces(const int id, const int i) {
   const double d_i = m_data(i, m_indexD);
   const double theta_i = m_data(i, m_indexTheta);
 
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id);
+  BondList &PDconnections = m_particles.pdConnections(id);
 
   double f_i[3];
   for (int d = 0; d < m_dim; d++) {
     f_i[d] = 0;
   }
 
-  const int nConnections = PDconnections.size();
   double dr_ij[3];
 
   double thetaNew = 0;
-  for (int l_j = 0; l_j < nConnections; l_j++) {
+  m_particles.forEachConnectedBond(i, [&](const int l_j) {
     auto &con = PDconnections[l_j];
-    if (con.second[m_indexConnected] <= 0.5)
-      continue;
-
     const int id_j = con.first;
     const int j = m_idToCol_v[id_j];
 
@@ -93,7 +91,7 @@ void PD_OSP::calculateForces(const int id, const int i) {
 
     thetaNew += d_ij * s * A_ij * vol_j * volumeScaling;
     con.second[m_indexStretch] = s;
-  }
+  });
 
   for (int d = 0; d < m_dim; d++) {
     m_F(i, d) += m_delta * f_i[d];
@@ -108,19 +106,14 @@ double PD_OSP::calculatePotentialEnergyDensity(const int id_i, const int i) {
   const double d_i = m_data(i, m_indexD);
   //    const double theta_i = m_data(i, m_indexTheta);
 
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_i);
+  BondList &PDconnections = m_particles.pdConnections(id_i);
 
-  const int nConnections = PDconnections.size();
   double dr_ij[3];
 
   double theta_sum = 0;
   double W_i = 0;
-  for (int l_j = 0; l_j < nConnections; l_j++) {
+  m_particles.forEachConnectedBond(i, [&](const int l_j) {
     auto &con = PDconnections[l_j];
-    if (con.second[m_indexConnected] <= 0.5)
-      continue;
-
     const int id_j = con.first;
     const int j = m_idToCol_v[id_j];
 
@@ -154,7 +147,7 @@ double PD_OSP::calculatePotentialEnergyDensity(const int id_i, const int i) {
     const double s = ds / dr0;
     theta_sum += d_ij * Gd_ij * A_ij * s * vol_j * volumeScaling;
     W_i += b_ij * Gb_ij * s * s * dr * vol_j * volumeScaling;
-  }
+  });
 
   return m_delta * (a_i * theta_sum * theta_sum + W_i);
 }
@@ -172,18 +165,13 @@ void PD_OSP::calculateStress(const int id_i, const int i,
   const double d_i = m_data(i, m_indexD);
   const double theta_i = m_data(i, m_indexTheta);
 
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_i);
+  BondList &PDconnections = m_particles.pdConnections(id_i);
 
-  const int nConnections = PDconnections.size();
   double dr_ij[3];
   double f[3];
 
-  for (int l_j = 0; l_j < nConnections; l_j++) {
+  m_particles.forEachConnectedBond(i, [&](const int l_j) {
     auto &con = PDconnections[l_j];
-    if (con.second[m_indexConnected] <= 0.5)
-      continue;
-
     const int id_j = con.first;
     const int j = m_idToCol_v[id_j];
 
@@ -236,7 +224,7 @@ void PD_OSP::calculateStress(const int id_i, const int i,
       m_data(i, indexStress[4]) += 0.5 * f[X] * dr_ij[Z];
       m_data(i, indexStress[5]) += 0.5 * f[Y] * dr_ij[Z];
     }
-  }
+  });
 }
 //------------------------------------------------------------------------------
 void PD_OSP::updateState(int id, int i) {
@@ -300,8 +288,7 @@ void PD_OSP::applySurfaceCorrectionStep1(double mu, double nu, int dim,
 double PD_OSP::calculateDilationTerm(const int id_i, const int i) {
   const double d_i = m_data(i, m_indexD);
 
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_i);
+  BondList &PDconnections = m_particles.pdConnections(id_i);
   const int nConnections = PDconnections.size();
   double dr_ij[3];
 
@@ -346,8 +333,7 @@ double PD_OSP::calculateDilationTerm(const int id_i, const int i) {
 //------------------------------------------------------------------------------
 double PD_OSP::calculateBondPotential(const int id_i, const int i) {
   const double b_i = m_data(i, m_indexB);
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_i);
+  BondList &PDconnections = m_particles.pdConnections(id_i);
 
   const int nConnections = PDconnections.size();
   double dr_ij[3];
@@ -6,7 +6,7 @@ PD_PMB::PD_PMB(PD_Particles &particles, double lc, double delta, double alpha)
     : Force(particles) {
   m_indexMicromodulus = m_particles.registerParameter("micromodulus", 1);
   m_indexS0 = m_particles.getParamId("s0");
-  m_indexS00 = m_particles.registerPdParameter("s00");
+  m_indexS00 = m_particles.registerPdParameter("s00", 0, BondData::Float);
   m_indexConnected = m_particles.getPdParamId("connected");
   m_indexS_new = m_particles.registerParameter("s_new");
   m_indexUnbreakable = m_particles.registerParameter("unbreakable");
@@ -19,8 +19,10 @@ PD_PMB::PD_PMB(PD_Particles &particles, double lc, double delta, double alpha)
   m_indexVolume = m_particles.getParamId("volume");
   m_indexDr0 = m_particles.getPdParamId("dr0");
   m_indexVolumeScaling = m_particles.getPdParamId("volumeScaling");
-  m_indexForceScaling = m_particles.registerPdParameter("forceScalingBond", 1.);
-  m_indexStretch = m_particles.registerPdParameter("stretch");
+  m_indexForceScaling = m_particles.registerPdParameter("forceScalingBond", 1.,
+                                                        BondData::Float);
+  m_indexStretch = m_particles.registerPdParameter("stretch", 0,
+                                                   BondData::Float);
 
   int nParticles = particles.nParticles();
   f = new double *[nParticles];
@@ -44,16 +46,13 @@ PD_PMB::~PD_PMB() {}
 void PD_PMB::calculateForces(const int id_i, const int i) {
   const double c_i = m_data(i, m_indexMicromodulus);
 
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_i);
-  //    vector<pair<int, vector<double>> *> removeParticles;
+  BondList &PDconnections = m_particles.pdConnections(id_i);
+  //    vector<pair<int, BondData> *> removeParticles;
 
-  int jnum;
   double xtmp, ytmp, ztmp, delx, dely, delz;
   double rsq, r, dr, rk, fbond;
   double delta, stretch, s0_new;
 
-  jnum = PDconnections.size();
   const double lc = m_lc;
   delta = m_delta;
   const double half_lc = 0.5 * lc;
@@ -74,13 +73,11 @@ void PD_PMB::calculateForces(const int id_i, const int i) {
   s0_new = std::numeric_limits<double>::max();
   //    first = true;
 
-  for (int jj = 0; jj < jnum; jj++) {
+  const vector<int> &neighbourCols = m_particles.neighbourColumns(i);
+  m_particles.forEachConnectedBond(i, [&](const int jj) {
     auto &con = PDconnections[jj];
-    if (con.second[m_indexConnected] <= 0.5)
-      continue;
-
     const int id_j = con.first;
-    const int j = m_idToCol_v[id_j];
+    const int j = neighbourCols[jj];
     const double dr0 = con.second[m_indexDr0];
 
     // compute force density, add to PD equation of motion
@@ -137,7 +134,7 @@ void PD_PMB::calculateForces(const int id_i, const int i) {
       } else {
         cout << "broken:" << id_i << " " << id_j << " s:" << stretch
              << " s0_i:" << s0_i << " s0_j:" << s0_i << endl;
-        con.second[m_indexConnected] = 0;
+        m_particles.breakBond(id_i, con);
       }
     }
     //            removeParticles.push_back(&con);
@@ -152,7 +149,7 @@ void PD_PMB::calculateForces(const int id_i, const int i) {
        s0_new = max(s0_new, s00 - m_alpha * stretch);
     first = false;
     */
-  }
+  });
 
   m_data(i, m_indexS_new) = s0_new;
 }
@@ -167,13 +164,10 @@ double PD_PMB::calculatePotentialEnergyDensity(const int id_i, const int i) {
 
   double energy = 0;
 
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_i);
-
-  for (auto &con : PDconnections) {
-    if (con.second[m_indexConnected] <= 0.5)
-      continue;
+  BondList &PDconnections = m_particles.pdConnections(id_i);
 
+  m_particles.forEachConnectedBond(i, [&](const int l_j) {
+    auto &con = PDconnections[l_j];
     const int id_j = con.first;
     const int j = m_idToCol_v[id_j];
 
@@ -199,7 +193,7 @@ double PD_PMB::calculatePotentialEnergyDensity(const int id_i, const int i) {
       ds = 0.0;
 
     energy += c_ij * (ds * ds) / dr0Len * vol_j * volumeScaling;
-  }
+  });
 
   return 0.25 * energy;
 }
@@ -214,21 +208,18 @@ void PD_PMB::calculateStress(const int id_i, const int i,
                              const int (&indexStress)[6]) {
   const double c_i = m_data(i, m_indexMicromodulus);
 
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_i);
-  vector<pair<int, vector<double>> *> removeParticles;
+  BondList &PDconnections = m_particles.pdConnections(id_i);
+  vector<pair<int, BondData> *> removeParticles;
 
   // loop over my particles and their partners
   // partner list contains all bond partners, so I-J appears twice
   // if bond already broken, skip this partner
   // first = true if this is first neighbor of particle i
-  int jnum;
   double xtmp, ytmp, ztmp, delx, dely, delz;
   double rsq, r, dr, rk, fbond;
   double delta, stretch;
   //    double s0_new;
 
-  jnum = PDconnections.size();
   double lc = m_lc;
   delta = m_delta;
   const double half_lc = 0.5 * lc;
@@ -249,10 +240,8 @@ void PD_PMB::calculateStress(const int id_i, const int i,
   //    s0_new = numeric_limits<double>::max();
   //    first = true;
 
-  for (int jj = 0; jj < jnum; jj++) {
+  m_particles.forEachConnectedBond(i, [&](const int jj) {
     auto &con = PDconnections[jj];
-    if (con.second[m_indexConnected] <= 0.5)
-      continue;
     const int id_j = con.first;
     const int j = m_idToCol_v[id_j];
     const double dr0 = con.second[m_indexDr0];
@@ -305,7 +294,7 @@ void PD_PMB::calculateStress(const int id_i, const int i,
       m_data(i, indexStress[4]) += 0.5 * f_tmp[X] * delz;
       m_data(i, indexStress[5]) += 0.5 * f_tmp[Y] * delz;
     }
-  }
+  });
 }
 //------------------------------------------------------------------------------
 double PD_PMB::calculateStableMass(const int id_a, const int a, double dt) {
@@ -324,8 +313,7 @@ double PD_PMB::calculateStableMass(const int id_a, const int a, double dt) {
   const double y_a = matR0(a, Y);
   const double z_a = matR0(a, Z);
 
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_a);
+  BondList &PDconnections = m_particles.pdConnections(id_a);
 
   double k_one[3];
   double k_two[3];
@@ -394,8 +382,7 @@ void PD_PMB::initialize(double E, double nu, double delta, int dim, double h,
     const int pId = colToId(i);
     const double s0_i = m_data(i, m_indexS0);
 
-    vector<pair<int, vector<double>>> &PDconnections =
-        m_particles.pdConnections(pId);
+    BondList &PDconnections = m_particles.pdConnections(pId);
     for (auto &con : PDconnections) {
       const int id_j = con.first;
       const int col_j = m_idToCol_v[id_j];
@@ -444,8 +431,7 @@ void PD_PMB::initialize(double E, double nu, double delta, int dim, double h,
     const int pId = colToId(i);
     double dRvolume = 0;
 
-    vector<pair<int, vector<double>>> &PDconnections =
-        m_particles.pdConnections(pId);
+    BondList &PDconnections = m_particles.pdConnections(pId);
     for (auto &con : PDconnections) {
       const int id_j = con.first;
     const int j = m_idToCol_v[id_j];
@@ -9,21 +9,16 @@ PD_PMB_LINEAR_INTEGRATOR::PD_PMB_LINEAR_INTEGRATOR(PD_Particles &particles,
 //------------------------------------------------------------------------------
 void PD_PMB_LINEAR_INTEGRATOR::calculateForces(const int id, const int i) {
   const double c_i = m_data(i, m_indexMicromodulus);
-  vector<pair<int, vector<double>>> &PDconnections_i =
-      m_particles.pdConnections(id);
+  BondList &PDconnections_i = m_particles.pdConnections(id);
   const double lc_half = 0.5 * m_lc;
   const double lc_c = 2. / 6. * m_lc;
 
-  const int nConnections = PDconnections_i.size();
   double dr_ij[m_dim];
   //    double dr0_ij[m_dim];
   //    double weights[m_dim];
 
-  for (int l_j = 0; l_j < nConnections; l_j++) {
+  m_particles.forEachConnectedBond(i, [&](const int l_j) {
     auto &con_i = PDconnections_i[l_j];
-    if (con_i.second[m_indexConnected] <= 0.5)
-      continue;
-
     const int id_j = con_i.first;
     const int j = m_idToCol_v[id_j];
 
@@ -74,7 +69,7 @@ void PD_PMB_LINEAR_INTEGRATOR::calculateForces(const int id, const int i) {
     }
 
     con_i.second[m_indexStretch] = s;
-  }
+  });
 }
 //------------------------------------------------------------------------------
 }
@@ -2,6 +2,9 @@
 
 #include "Particles/pd_particles.h"
 #include <stdio.h>
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif
 
 namespace PDtools {
 //------------------------------------------------------------------------------
@@ -11,6 +14,12 @@ vector<pair<string, int>> Force::getNeededProperties() const {
 //------------------------------------------------------------------------------
 int Force::getCalulateStress() const { return m_calulateStress; }
 //------------------------------------------------------------------------------
+void Force::setComputeStress(const bool computeStress) {
+  m_computeStress = computeStress;
+}
+//------------------------------------------------------------------------------
+bool Force::getComputeStress() const { return m_computeStress; }
+//------------------------------------------------------------------------------
 void Force::evaluateStepOne() {}
 //------------------------------------------------------------------------------
 bool Force::getHasStepOneModifier() const { return m_hasStepOneModifier; }
@@ -38,6 +47,12 @@ bool Force::getHasStaticModifier() const { return m_hasStaticModifier; }
 //------------------------------------------------------------------------------
 bool Force::getHasUpdateState() const { return m_hasUpdateState; }
 //------------------------------------------------------------------------------
+bool Force::getHasLocalUpdateState() const { return m_hasLocalUpdateState; }
+//------------------------------------------------------------------------------
+bool Force::getReadsNeighbourVelocity() const {
+  return m_readsNeighbourVelocity;
+}
+//------------------------------------------------------------------------------
 Force::Force(PD_Particles &particles, string _type)
     : m_particles(particles), m_r(m_particles.r()), m_v(m_particles.v()),
       m_r0(m_particles.r0()), m_F(m_particles.F()), m_data(m_particles.data()),
@@ -46,10 +61,29 @@ Force::Force(PD_Particles &particles, string _type)
       m_idToElement(m_particles.getIdToElement()),
       m_triElements(m_particles.getTriElements()),
       m_quadElements(m_particles.getQuadElements()), m_dim(m_particles.dim()),
-      name(_type) {}
+      name(_type) {
+#ifdef USE_OPENMP
+  m_bondScratch.resize(omp_get_max_threads());
+#else
+  m_bondScratch.resize(1);
+#endif
+}
 //------------------------------------------------------------------------------
 Force::~Force() {}
 //------------------------------------------------------------------------------
+double *Force::bondScratch(const size_t nBonds) {
+  // A buffer per thread, grown to the longest connection list and reused, so
+  // the bond loops in a parallel particle loop do not allocate
+#ifdef USE_OPENMP
+  vector<double> &scratch = m_bondScratch[omp_get_thread_num()];
+#else
+  vector<double> &scratch = m_bondScratch[0];
+#endif
+  if (scratch.size() < nBonds)
+    scratch.resize(nBonds);
+  return scratch.data();
+}
+//------------------------------------------------------------------------------
 void Force::initialize(double E, double nu, double delta, int dim, double h,
                        double lc) {
   m_E = E;
@@ -76,7 +110,7 @@ void Force::calculatePotentialEnergy(const int id_i, const int i,
 }
 //------------------------------------------------------------------------------
 double Force::calculateBondEnergy(const pair<int, int> &idCol,
-                                  pair<int, vector<double>> &con) {
+                                  pair<int, BondData> &con) {
   (void)idCol;
   (void)con;
 
@@ -98,6 +132,10 @@ void Force::updateState(int id, int i) {
   (void)i;
 }
 //------------------------------------------------------------------------------
+void Force::updateBondCache() {}
+//------------------------------------------------------------------------------
+void Force::invalidateBondCache() { m_bondCacheValid = false; }
+//------------------------------------------------------------------------------
 double Force::calculateStableMass(const int id_i, const int i, double dt) {
   (void)id_i;
   (void)i;
@@ -123,6 +161,9 @@ int Force::initializeSurfaceCorrection() {
 }
 //------------------------------------------------------------------------------
 void Force::applySurfaceCorrectionStep1(double strain) {
+  // Runs before the solver, which builds the bond cache the energy densities
+  // loop over
+  m_particles.buildBondCache();
   applyStrainCorrection(strain);
   //    applyShearCorrection(strain);
 }
@@ -202,8 +243,7 @@ void Force::applySurfaceCorrectionStep2() {
 #endif
   for (int i = 0; i < nParticles; i++) {
     const int id_i = colToId(i);
-    vector<pair<int, vector<double>>> &PDconnections =
-        m_particles.pdConnections(id_i);
+    BondList &PDconnections = m_particles.pdConnections(id_i);
 
     for (auto &con : PDconnections) {
       const int id_j = con.first;
@@ -224,6 +264,7 @@ void Force::applySurfaceCorrectionStep2() {
       con.second[iForceScaling] *= G;
     }
   }
+  invalidateBondCache();
 }
 //------------------------------------------------------------------------------
 void Force::applyShearCorrection(double shear) {
@@ -28,8 +28,8 @@ protected:
   arma::mat &m_v;
   arma::mat &m_r0;
   arma::mat &m_F;
-  arma::mat &m_data;
-  const ivec & m_idToCol_v;
+  ParticleData &m_data;
+  const IdToColMap & m_idToCol_v;
   arma::ivec &m_colToId;
   int m_calulateStress = false;
 
@@ -57,6 +57,31 @@ protected:
   bool m_hasStepOneModifier = false;
   bool m_hasStepTwoModifier = false;
   bool m_hasUpdateState = false;
+  // The per-particle state update only reads the particle and its bonds, so
+  // it can run before the ghost exchange of the force evaluation.
+  bool m_hasLocalUpdateState = false;
+  // The forces read the velocities of the neighbours, e.g. to dampen the
+  // bonds, and need those of the same step for all particles.
+  bool m_readsNeighbourVelocity = false;
+
+  // Per-bond coefficients derived from the particle and bond parameters, by
+  // column and bond l_j: the bonds of column i start at m_bondCacheOffsets[i].
+  // Kept out of the bond parameters so that they are not communicated or
+  // saved, and rebuilt when PD_Particles::bondCacheStamp() changes.
+  bool m_bondCacheValid = false;
+  unsigned long m_bondCacheStamp = 0;
+  vector<size_t> m_bondCacheOffsets;
+  vector<double> m_bondCoefficients;
+  vector<double> m_bondDr0Inv;
+
+  // Per-thread scratch space for the bond loops, see bondScratch()
+  vector<vector<double>> m_bondScratch;
+
+  // Forces that accumulate the stress in calculateForces() only do it when a
+  // consumer reads it that step, see Solver::requestStress()
+  bool m_computeStress = true;
+
+  double *bondScratch(const size_t nBonds);
 
 public:
   const string name;
@@ -70,11 +95,16 @@ public:
   virtual void calculatePotentialEnergy(const int id_i, const int i,
                                         int indexPotential);
   virtual double calculateBondEnergy(const std::pair<int, int> &idCol,
-                                     std::pair<int, std::vector<double>> &con);
+                                     std::pair<int, BondData> &con);
   virtual void calculateStress(const int id_i, const int i,
                                const int (&indexStress)[6]);
   virtual void updateState();
   virtual void updateState(int id, int i);
+  virtual void updateBondCache();
+  void invalidateBondCache();
+  bool bondCacheValid() const;
+  double cachedBondCoefficient(const int i, const int l_j) const;
+  double cachedDr0Inv(const int i, const int l_j) const;
 
   virtual double calculateStableMass(const int id_i, const int i, double dt);
   void numericalInitialization(bool ni);
@@ -90,6 +120,8 @@ public:
   virtual std::vector<string> getSurfaceCorrectionGhostParameters();
   vector<pair<string, int>> getNeededProperties() const;
   int getCalulateStress() const;
+  void setComputeStress(const bool computeStress);
+  bool getComputeStress() const;
 
   // Modifiers
   virtual void evaluateStepOne();
@@ -102,7 +134,24 @@ public:
   bool getContinueState() const;
   bool getHasStaticModifier() const;
   bool getHasUpdateState() const;
+  bool getHasLocalUpdateState() const;
+  bool getReadsNeighbourVelocity() const;
 };
 //------------------------------------------------------------------------------
+// Inline functions
+//------------------------------------------------------------------------------
+inline bool Force::bondCacheValid() const {
+  return m_bondCacheValid &&
+         m_bondCacheStamp == m_particles.bondCacheStamp();
+}
+
+inline double Force::cachedBondCoefficient(const int i, const int l_j) const {
+  return m_bondCoefficients[m_bondCacheOffsets[i] + l_j];
+}
+
+inline double Force::cachedDr0Inv(const int i, const int l_j) const {
+  return m_bondDr0Inv[m_bondCacheOffsets[i] + l_j];
+}
+//------------------------------------------------------------------------------
 } // namespace PDtools
 #endif // FORCE_H
@@ -2,10 +2,13 @@
 
 #include "PDtools/PdFunctions/pdfunctions.h"
 #include "Particles/pd_particles.h"
+#include "PdFunctions/memorytracker.h"
 #include "Utilities/geometryfunctions.h"
 #include "Elements/pd_element.h"
 #include "Utilities/gaussianquadrature.h"
 
+#include <limits>
+
 namespace PDtools {
 //------------------------------------------------------------------------------
 vector<int> Grid::nCpuGrid() const { return m_nCpuGrid; }
@@ -525,6 +528,56 @@ const vector<pair<double, double>> &Grid::boundary() const {
   return m_boundary;
 }
 //------------------------------------------------------------------------------
+vector<pair<double, double>> Grid::myBounds() const {
+  // The box of the grid points owned by this rank. Towards the outside of the
+  // grid it is open, the outermost grid points own everything beyond them.
+  const double infinity = std::numeric_limits<double>::infinity();
+  int iMin[M_DIM];
+  int iMax[M_DIM];
+  for (int d = 0; d < M_DIM; d++) {
+    iMin[d] = m_nGrid[d];
+    iMax[d] = -1;
+  }
+
+  for (const int gId : m_myGridPoints) {
+    const vec3 &center = m_gridpoints.at(gId).center();
+    for (int d = 0; d < M_DIM; d++) {
+      int i = int((center(d) - m_boundary2[d][0]) / m_gridSpacing(d));
+      i = std::max(0, std::min(i, m_nGrid[d] - 1));
+      iMin[d] = std::min(iMin[d], i);
+      iMax[d] = std::max(iMax[d], i);
+    }
+  }
+
+  vector<pair<double, double>> bounds(M_DIM);
+  for (int d = 0; d < M_DIM; d++) {
+    if (iMax[d] < 0) {
+      bounds[d] = pair<double, double>(infinity, -infinity);
+      continue;
+    }
+    bounds[d].first = iMin[d] == 0
+                          ? -infinity
+                          : m_boundary2[d][0] + iMin[d] * m_gridSpacing(d);
+    bounds[d].second = iMax[d] == m_nGrid[d] - 1
+                           ? infinity
+                           : m_boundary2[d][0] + (iMax[d] + 1) * m_gridSpacing(d);
+  }
+  return bounds;
+}
+//------------------------------------------------------------------------------
+size_t Grid::allocatedBytes() const {
+  size_t nBytes = MemoryTracker::mapBytes(m_gridpoints) +
+                  MemoryTracker::vectorBytes(m_myGridPoints) +
+                  MemoryTracker::vectorBytes(m_ghostGridIds) +
+                  MemoryTracker::vectorBytes(m_periodicSendGridIds) +
+                  MemoryTracker::vectorBytes(m_periodicReceiveGridIds) +
+                  MemoryTracker::vectorBytes(m_boundaryGridPoints);
+  for (const auto &id_gridPoint : m_gridpoints) {
+    nBytes += id_gridPoint.second.allocatedBytes();
+  }
+  return nBytes;
+}
+//------------------------------------------------------------------------------
 Grid::~Grid() {
   //    m_gridpoints.clear();
 }
@@ -562,6 +615,15 @@ void GridPoint::setPeriodicNeighbourRank(const int periodicNeighbourRank) {
 //------------------------------------------------------------------------------
 vector<array<size_t, 2>> GridPoint::elements() const { return m_elements; }
 //------------------------------------------------------------------------------
+size_t GridPoint::allocatedBytes() const {
+  return MemoryTracker::vectorBytes(m_nGridId) +
+         MemoryTracker::vectorBytes(m_particles) +
+         MemoryTracker::vectorBytes(m_elements) +
+         MemoryTracker::vectorBytes(m_neighbours) +
+         MemoryTracker::vectorBytes(m_neighbourRanks) +
+         MemoryTracker::vectorBytes(m_periodicShift);
+}
+//------------------------------------------------------------------------------
 // Other grid dependent functions
 //------------------------------------------------------------------------------
 
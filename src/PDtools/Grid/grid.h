@@ -60,6 +60,7 @@ public:
   void setPeriodicNeighbourRank(const int periodicNeighbourRank);
 
   vector<array<size_t, 2>> elements() const;
+  size_t allocatedBytes() const;
 
 private:
   int m_id;
@@ -143,6 +144,8 @@ public:
   double initialPositionScaling() const;
   const arma::ivec3 &nGrid() const;
   const vector<pair<double, double>> &boundary() const;
+  vector<pair<double, double>> myBounds() const;
+  size_t allocatedBytes() const;
   vector<int> nCpuGrid() const;
   void setBoundaryGrid();
   std::vector<int> periodicSendGridIds() const;
@@ -87,11 +87,11 @@ PD_Particles convertMshToPdParticles(int dim, int interpolationDegree,
   particles.initializeMatrices();
   particles.dim(dim);
 
-  ivec &idToCol = particles.getIdToCol_v();
+  IdToColMap &idToCol = particles.getIdToCol_v();
   arma::ivec &get_id = particles.colToId();
   arma::mat &r0 = particles.r0();
   arma::mat &r = particles.r();
-  arma::mat &data = particles.data();
+  ParticleData &data = particles.data();
   const int i_volume = particles.registerParameter("volume");
   //--------------------------------------------------------------------------
 
@@ -232,6 +232,7 @@ PD_Particles convertMshToPdParticles(int dim, int interpolationDegree,
   }
 
   particles.nParticles(pd_col);
+  particles.shrinkToFit();
   cout << pd_col << " " << nParticles << endl;
   //    particles.totParticles(pd_col);
 
@@ -34,7 +34,7 @@ void boundaryForce::registerParticleParameters() {
 }
 //------------------------------------------------------------------------------
 void boundaryForce::evaluateStepOne() {
-  const ivec &idToCol = m_particles->getIdToCol_v();
+  const IdToColMap &idToCol = m_particles->getIdToCol_v();
   arma::mat &F = m_particles->F();
 
   for (const int &id : m_localParticleIds) {
@@ -48,7 +48,7 @@ void boundaryForce::initialize() {
   const ivec &colToId = m_particles->colToId();
   m_indexRadius = m_particles->registerParameter("radius");
   const arma::mat &r = m_particles->r();
-  arma::mat &data = m_particles->data();
+  ParticleData &data = m_particles->data();
 
   m_indexVolume = m_particles->getParamId("volume");
   double volume = 0;
@@ -99,7 +99,7 @@ void boundaryForce::evaluateStepTwo() {
 }
 //------------------------------------------------------------------------------
 void boundaryForce::staticEvaluation() {
-  const ivec &idToCol = m_particles->getIdToCol_v();
+  const IdToColMap &idToCol = m_particles->getIdToCol_v();
   arma::mat &F = m_particles->F();
 
   for (const int &id : m_localParticleIds) {
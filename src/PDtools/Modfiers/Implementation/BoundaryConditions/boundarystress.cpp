@@ -21,9 +21,9 @@ BoundaryStress::BoundaryStress(double appliedStress, double stressOrientation,
 }
 //------------------------------------------------------------------------------
 void BoundaryStress::evaluateStepOne() {
-  const ivec &idToCol = m_particles->getIdToCol_v();
+  const IdToColMap &idToCol = m_particles->getIdToCol_v();
   arma::mat &F = m_particles->F();
-  arma::mat &data = m_particles->data();
+  ParticleData &data = m_particles->data();
 
   for (const int &id : m_localParticleIds) {
     const int i = idToCol[id];
@@ -45,9 +45,9 @@ void BoundaryStress::evaluateStepTwo() {
 }
 //------------------------------------------------------------------------------
 void BoundaryStress::staticEvaluation() {
-    const ivec &idToCol = m_particles->getIdToCol_v();
+    const IdToColMap &idToCol = m_particles->getIdToCol_v();
   arma::mat &F = m_particles->F();
-  arma::mat &data = m_particles->data();
+  ParticleData &data = m_particles->data();
 
   for (const int &id : m_localParticleIds) {
     const int i = idToCol[id];
@@ -63,7 +63,7 @@ void BoundaryStress::initialize() {
   const ivec &colToId = m_particles->colToId();
   m_indexRadius = m_particles->registerParameter("radius");
   const arma::mat &r = m_particles->r();
-  arma::mat &data = m_particles->data();
+  ParticleData &data = m_particles->data();
 
   m_indexVolume = m_particles->getParamId("volume");
   double volume = 0;
@@ -26,7 +26,7 @@ void MoveParticles::registerParticleParameters() {
 }
 //------------------------------------------------------------------------------
 void MoveParticles::evaluateStepOne() {
-  const ivec &idToCol = m_particles->getIdToCol_v();
+  const IdToColMap &idToCol = m_particles->getIdToCol_v();
   mat &r = m_particles->r();
   const double dr = m_time * m_velAmplitude;
   arma::mat &v = m_particles->v();
@@ -46,7 +46,7 @@ void MoveParticles::initialize() {
   // Selecting particles
   const ivec &colToId = m_particles->colToId();
   const arma::mat &r = m_particles->r();
-  arma::mat &data = m_particles->data();
+  ParticleData &data = m_particles->data();
   arma::imat &isStatic = m_particles->isStatic();
   const int unbreakablePos = m_particles->registerParameter("unbreakable");
 
@@ -75,7 +75,7 @@ void MoveParticles::initialize() {
 }
 //------------------------------------------------------------------------------
 void MoveParticles::staticEvaluation() {
-  const ivec &idToCol = m_particles->getIdToCol_v();
+  const IdToColMap &idToCol = m_particles->getIdToCol_v();
   arma::mat &v = m_particles->v();
   arma::mat &F = m_particles->F();
   arma::mat &Fold = m_particles->Fold();
@@ -88,4 +88,9 @@ void MoveParticles::staticEvaluation() {
   }
 }
 //------------------------------------------------------------------------------
+void MoveParticles::setDt(double dt) {
+  m_dt = dt;
+  m_time = dt;
+}
+//------------------------------------------------------------------------------
 }
@@ -17,7 +17,7 @@ void MoveParticlesZone::registerParticleParameters() {
 }
 //------------------------------------------------------------------------------
 void MoveParticlesZone::evaluateStepOne() {
-  const ivec &idToCol = m_particles->getIdToCol_v();
+  const IdToColMap &idToCol = m_particles->getIdToCol_v();
   //  mat &r = m_particles->r();
   const double v_amp = m_time * m_velAmplitude;
   const vec dr = v_amp * m_velocityDirection;
@@ -38,7 +38,7 @@ void MoveParticlesZone::evaluateStepOne() {
 }
 //------------------------------------------------------------------------------
 void MoveParticlesZone::staticEvaluation() {
-  const ivec &idToCol = m_particles->getIdToCol_v();
+  const IdToColMap &idToCol = m_particles->getIdToCol_v();
   arma::mat &v = m_particles->v();
   arma::mat &F = m_particles->F();
   arma::mat &Fold = m_particles->Fold();
@@ -60,7 +60,7 @@ void MoveParticlesZone::initialize() {
   // Selecting particles
   const ivec &colToId = m_particles->colToId();
   const arma::mat &r = m_particles->r();
-  arma::mat &data = m_particles->data();
+  ParticleData &data = m_particles->data();
   arma::imat &isStatic = m_particles->isStatic();
   const int unbreakablePos = m_particles->registerParameter("unbreakable");
 
@@ -108,4 +108,9 @@ void MoveParticlesZone::initialize() {
   //    cout << "done: " << m_velAmplitude  << endl;
 }
 //------------------------------------------------------------------------------
+void MoveParticlesZone::setDt(double dt) {
+  m_dt = dt;
+  m_time = dt;
+}
+//------------------------------------------------------------------------------
 }
@@ -16,7 +16,7 @@ void MoveParticleGroup::registerParticleParameters() {
 }
 //------------------------------------------------------------------------------
 void MoveParticleGroup::evaluateStepOne() {
-  const ivec &idToCol = m_particles->getIdToCol_v();
+  const IdToColMap &idToCol = m_particles->getIdToCol_v();
   mat &r = m_particles->r();
   const vec dr = m_time * m_velAmplitude * m_velocityDirection;
   arma::mat &v = m_particles->v();
@@ -35,7 +35,7 @@ void MoveParticleGroup::evaluateStepOne() {
 }
 //------------------------------------------------------------------------------
 void MoveParticleGroup::staticEvaluation() {
-  const ivec &idToCol = m_particles->getIdToCol_v();
+  const IdToColMap &idToCol = m_particles->getIdToCol_v();
   arma::mat &v = m_particles->v();
   arma::mat &F = m_particles->F();
   arma::mat &Fold = m_particles->Fold();
@@ -56,7 +56,7 @@ void MoveParticleGroup::initialize() {
 
   // Selecting particles
   const ivec &colToId = m_particles->colToId();
-  arma::mat &data = m_particles->data();
+  ParticleData &data = m_particles->data();
   arma::imat &isStatic = m_particles->isStatic();
   const int iType = m_particles->getParamId("groupId");
   const int iUnbreakable = m_particles->registerParameter("unbreakable");
@@ -75,4 +75,9 @@ void MoveParticleGroup::initialize() {
   }
 }
 //------------------------------------------------------------------------------
+void MoveParticleGroup::setDt(double dt) {
+  m_dt = dt;
+  m_time = dt;
+}
+//------------------------------------------------------------------------------
 }
@@ -14,6 +14,7 @@ public:
   virtual void evaluateStepOne();
   virtual void staticEvaluation();
   virtual void initialize();
+  virtual void setDt(double dt);
 
 private:
   int m_groupId;
@@ -85,7 +85,7 @@ void StrainBoundary::initialize() {
   // Selecting particles
   const arma::mat &r = m_particles->r();
   const ivec &colToId = m_particles->colToId();
-  arma::mat &data = m_particles->data();
+  ParticleData &data = m_particles->data();
   arma::imat &isStatic = m_particles->isStatic();
   const int unbreakablePos = m_particles->registerParameter("unbreakable");
 
@@ -123,7 +123,7 @@ void StrainBoundary::initialize() {
 }
 //------------------------------------------------------------------------------
 void StrainBoundary::staticEvaluation() {
-  const ivec &idToCol = m_particles->getIdToCol_v();
+  const IdToColMap &idToCol = m_particles->getIdToCol_v();
   arma::mat &v = m_particles->v();
   arma::mat &F = m_particles->F();
   arma::mat &Fold = m_particles->Fold();
@@ -141,4 +141,6 @@ void StrainBoundary::staticEvaluation() {
   }
 }
 //------------------------------------------------------------------------------
+void StrainBoundary::setDt(double dt) { m_dt = dt; }
+//------------------------------------------------------------------------------
 }
@@ -15,6 +15,7 @@ public:
   virtual void evaluateStepOne();
   virtual void initialize();
   virtual void staticEvaluation();
+  virtual void setDt(double dt);
 
 private:
   double m_strainrate;
@@ -14,6 +14,7 @@ VelocityBoundary::VelocityBoundary(double velAmplitude, double velOrientation,
   m_dv = velAmplitude / steps;
   m_v = 0;
   m_dt = dt;
+  m_dt0 = dt;
   m_isStatic = isStatic;
 
   if (m_velOritentation == 0) {
@@ -35,10 +36,13 @@ void VelocityBoundary::registerParticleParameters() {
 }
 //------------------------------------------------------------------------------
 void VelocityBoundary::evaluateStepOne() {
+  // The ramp is defined per step of the initial dt
   if (fabs(m_v) < fabs(m_velAmplitude)) {
-    m_v += m_dv;
+    m_v += m_dv * m_dt / m_dt0;
+    if (fabs(m_v) > fabs(m_velAmplitude))
+      m_v = m_velAmplitude;
   }
-  const ivec &idToCol = m_particles->getIdToCol_v();
+  const IdToColMap &idToCol = m_particles->getIdToCol_v();
   arma::mat &v = m_particles->v();
   arma::mat &r = m_particles->r();
   arma::mat &F = m_particles->F();
@@ -57,7 +61,7 @@ void VelocityBoundary::evaluateStepOne() {
 }
 //------------------------------------------------------------------------------
 void VelocityBoundary::evaluateStepTwo() {
-  const ivec &idToCol = m_particles->getIdToCol_v();
+  const IdToColMap &idToCol = m_particles->getIdToCol_v();
   arma::mat &v = m_particles->v();
   arma::mat &F = m_particles->F();
   arma::imat &isStatic = m_particles->isStatic();
@@ -80,7 +84,7 @@ void VelocityBoundary::initialize() {
   // Selecting particles
   const arma::mat &r = m_particles->r();
   const ivec &colToId = m_particles->colToId();
-  arma::mat &data = m_particles->data();
+  ParticleData &data = m_particles->data();
   arma::imat &isStatic = m_particles->isStatic();
   const int unbreakablePos = m_particles->registerParameter("unbreakable");
 
@@ -118,4 +122,6 @@ void VelocityBoundary::initialize() {
   }
 }
 //------------------------------------------------------------------------------
+void VelocityBoundary::setDt(double dt) { m_dt = dt; }
+//------------------------------------------------------------------------------
 }
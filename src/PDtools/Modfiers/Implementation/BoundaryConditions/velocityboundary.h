@@ -16,6 +16,7 @@ public:
   virtual void evaluateStepOne();
   virtual void evaluateStepTwo();
   virtual void initialize();
+  virtual void setDt(double dt);
 
 private:
   double m_velAmplitude;
@@ -26,6 +27,7 @@ private:
   double m_dv;
   double m_v;
   double m_dt;
+  double m_dt0;
   bool m_isStatic;
   bool m_usingUnbreakableBorder = false;
 };
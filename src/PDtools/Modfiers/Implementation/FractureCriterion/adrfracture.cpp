@@ -16,8 +16,9 @@ void ADRfracture::registerParticleParameters() {
   m_indexS0 = m_particles->registerParameter("s0");
   m_indexUnbreakable = m_particles->registerParameter("unbreakable");
   m_indexStretch = m_particles->getPdParamId("stretch");
-  m_indexS00 = m_particles->registerPdParameter("s00");
-  m_indexConnected = m_particles->registerPdParameter("connected");
+  m_indexS00 = m_particles->registerPdParameter("s00", 0, BondData::Float);
+  m_indexConnected = m_particles->registerPdParameter("connected", 0,
+                                                      BondData::Flag);
   m_indexS_tmp = m_particles->registerParameter("s_tmp");
   m_idToCol = &m_particles->getIdToCol_v();
   m_data = &m_particles->data();
@@ -35,8 +36,7 @@ void ADRfracture::initialize() {
     const int id = colToId(i);
     const double s0_i = (*m_data)(i, m_indexS0);
 
-    vector<pair<int, vector<double>>> &PDconnections =
-        m_particles->pdConnections(id);
+    BondList &PDconnections = m_particles->pdConnections(id);
     for (auto &con : PDconnections) {
       const int id_j = con.first;
       const int j = (*m_idToCol)[id_j];
@@ -48,6 +48,13 @@ void ADRfracture::initialize() {
   m_maxPId = pair<int, int>(-1, -1);
   m_maxStretch = std::numeric_limits<double>::min();
   m_state = false;
+  evaluateStepOne();
+}
+//------------------------------------------------------------------------------
+void ADRfracture::evaluateStepOne() {
+  m_threadMax.assign(nThreads(),
+                     std::make_tuple(std::numeric_limits<double>::min(), -1,
+                                     -1));
 }
 //------------------------------------------------------------------------------
 void ADRfracture::evaluateStepOne(const int id_i, const int i) {
@@ -55,20 +62,17 @@ void ADRfracture::evaluateStepOne(const int id_i, const int i) {
     return;
 
   const double s0_i = (*m_data)(i, m_indexS0);
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles->pdConnections(id_i);
+  BondList &PDconnections = m_particles->pdConnections(id_i);
 
+  std::tuple<double, int, int> &threadMax = m_threadMax[threadId()];
   double s0_new = std::numeric_limits<double>::min();
-  int counter = 0;
-  for (auto &con : PDconnections) {
+  m_particles->forEachConnectedBond(i, [&](const int l_j) {
+    auto &con = PDconnections[l_j];
     const int id_j = con.first;
     const int j = (*m_idToCol)[id_j];
 
     if ((*m_data)(j, m_indexUnbreakable) >= 1)
-      continue;
-
-    if (con.second[m_indexConnected] <= 0.5)
-      continue;
+      return;
 
     const double s = con.second[m_indexStretch];
     const double s00 = con.second[m_indexS00];
@@ -76,10 +80,11 @@ void ADRfracture::evaluateStepOne(const int id_i, const int i) {
     const double s0 = std::min(s0_i, s0_j);
 
     if (s > s0) {
-      con.second[m_indexConnected] = 0;
-      if (s > m_maxStretch) {
-        m_maxPId = pair<int, int>(id_i, counter);
-        m_maxStretch = s;
+      m_particles->breakBond(id_i, con);
+      // The first maximum in the column order, as in a serial loop
+      if (s > std::get<0>(threadMax) ||
+          (s == std::get<0>(threadMax) && i < std::get<1>(threadMax))) {
+        threadMax = std::make_tuple(s, i, l_j);
       }
     }
 
@@ -88,12 +93,34 @@ void ADRfracture::evaluateStepOne(const int id_i, const int i) {
       s0_tmp -= m_alpha * s;
     }
     s0_new = std::max(s0_new, s0_tmp);
-    counter++;
-  }
+  });
 
   (*m_data)(i, m_indexS_tmp) = s0_new;
 }
 //------------------------------------------------------------------------------
+void ADRfracture::evaluateStepOnePost() {
+  // Merging the per-thread maxima
+  const ivec &colToId = m_particles->colToId();
+  int maxCol = -1;
+  int maxBond = -1;
+
+  for (const auto &threadMax : m_threadMax) {
+    const double s = std::get<0>(threadMax);
+    const int col = std::get<1>(threadMax);
+    if (col < 0)
+      continue;
+
+    if (s > m_maxStretch || (s == m_maxStretch && col < maxCol)) {
+      m_maxStretch = s;
+      maxCol = col;
+      maxBond = std::get<2>(threadMax);
+    }
+  }
+
+  if (maxCol >= 0)
+    m_maxPId = pair<int, int>(colToId(maxCol), maxBond);
+}
+//------------------------------------------------------------------------------
 void ADRfracture::evaluateStepTwo(const int id_i, const int i) {
   (void)id_i;
   (*m_data)(i, m_indexS0) = (*m_data)(i, m_indexS_tmp);
@@ -104,9 +131,8 @@ void ADRfracture::evaluateStepTwo() {
     const int id_i = m_maxPId.first;
     const int remove = m_maxPId.second;
     m_state = true;
-    vector<pair<int, vector<double>>> &PDconnections =
-        m_particles->pdConnections(id_i);
-    PDconnections[remove].second[m_indexConnected] = 0;
+    BondList &PDconnections = m_particles->pdConnections(id_i);
+    m_particles->breakBond(id_i, PDconnections[remove]);
   } else {
     m_state = false;
   }
@@ -3,6 +3,8 @@
 
 #include "PDtools/Modfiers/modifier.h"
 
+#include <tuple>
+
 namespace PDtools {
 
 //------------------------------------------------------------------------------
@@ -13,15 +15,23 @@ public:
 
   virtual void registerParticleParameters();
   virtual void initialize();
+  virtual void evaluateStepOne();
   virtual void evaluateStepOne(const int id, const int i);
+  virtual void evaluateStepOnePost();
   virtual void evaluateStepTwo(const int id_i, const int i);
 
   virtual void evaluateStepTwo();
 
+  // The particle id and bond of the largest stretch broken in step one, the
+  // bond broken in step two, (-1, -1) if none
+  const pair<int, int> &maxStretchBond() const;
+
 private:
   double m_alpha;
   pair<int, int> m_maxPId;
   double m_maxStretch;
+  // Per-thread maximum stretch of the broken bonds: (stretch, column, bond)
+  vector<std::tuple<double, int, int>> m_threadMax;
   int m_indexS0;
   int m_indexStretch;
   int m_indexUnbreakable;
@@ -29,9 +39,14 @@ private:
   int m_indexConnected;
   int m_indexS_tmp;
   int m_indexBrokenNow;
-  arma::mat *m_data;
-  ivec *m_idToCol;
+  ParticleData *m_data;
+  const IdToColMap *m_idToCol;
 };
 //------------------------------------------------------------------------------
+// Inline functions
+inline const pair<int, int> &ADRfracture::maxStretchBond() const {
+  return m_maxPId;
+}
+//------------------------------------------------------------------------------
 }
 #endif // ADRFRACTURE_H
@@ -13,7 +13,7 @@ void ADRfractureAverage::initialize() {
   m_indexS0 = m_particles->getParamId("s0");
   m_indexUnbreakable = m_particles->getParamId("unbreakable");
   m_indexStretch = m_particles->getPdParamId("stretch");
-  m_indexS00 = m_particles->registerPdParameter("s00");
+  m_indexS00 = m_particles->registerPdParameter("s00", 0, BondData::Float);
   m_indexS_avg = m_particles->registerParameter("s_avg");
   m_idToCol = &m_particles->getIdToCol_v();
   m_data = &m_particles->data();
@@ -24,8 +24,7 @@ void ADRfractureAverage::initialize() {
     const int pId = colToId(i);
     const double s0_i = (*m_data)(i, m_indexS0);
 
-    vector<pair<int, vector<double>>> &PDconnections =
-        m_particles->pdConnections(pId);
+    BondList &PDconnections = m_particles->pdConnections(pId);
     for (auto &con : PDconnections) {
       const int id_j = con.first;
       const int col_j = (*m_idToCol)[id_j];
@@ -34,7 +33,7 @@ void ADRfractureAverage::initialize() {
     }
   }
 
-  m_maxPId = pair<int, pair<int, vector<double>> *>(-1, nullptr);
+  m_maxPId = pair<int, pair<int, BondData> *>(-1, nullptr);
   m_maxStretch = std::numeric_limits<double>::min();
   m_state = false;
 }
@@ -45,8 +44,7 @@ void ADRfractureAverage::evaluateStepOne(const int id_i, const int i) {
 
   const double s0_i = (*m_data)(i, m_indexS0);
   const double s_i = (*m_data)(i, m_indexS_avg);
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles->pdConnections(id_i);
+  BondList &PDconnections = m_particles->pdConnections(id_i);
 
   for (auto &con : PDconnections) {
     const int id_j = con.first;
@@ -61,7 +59,7 @@ void ADRfractureAverage::evaluateStepOne(const int id_i, const int i) {
 
     if (s > s0) {
       if (s > m_maxStretch) {
-        m_maxPId = pair<int, pair<int, vector<double>> *>(id_i, &con);
+        m_maxPId = pair<int, pair<int, BondData> *>(id_i, &con);
         m_maxStretch = s;
       }
     }
@@ -75,8 +73,7 @@ void ADRfractureAverage::evaluateStepTwo(const pair<int, int> &pIdcol) {
   if ((*m_data)(col_i, m_indexUnbreakable) >= 1)
     return;
 
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles->pdConnections(pId);
+  BondList &PDconnections = m_particles->pdConnections(pId);
 
   double s_avg = 0;
   for (auto &con : PDconnections) {
@@ -90,16 +87,14 @@ void ADRfractureAverage::evaluateStepTwo() {
   if (m_maxPId.first != -1) {
     m_state = true;
     int pId = m_maxPId.first;
-    vector<pair<int, vector<double>>> &PDconnections =
-        m_particles->pdConnections(pId);
-    PDconnections.erase(
-        remove(begin(PDconnections), end(PDconnections), *m_maxPId.second),
-        end(PDconnections));
+    BondList &PDconnections = m_particles->pdConnections(pId);
+    PDconnections.erase(PDconnections.begin() +
+                        (m_maxPId.second - PDconnections.data()));
   } else {
     m_state = false;
   }
 
-  m_maxPId = pair<int, pair<int, vector<double>> *>(-1, nullptr);
+  m_maxPId = pair<int, pair<int, BondData> *>(-1, nullptr);
   m_maxStretch = std::numeric_limits<double>::min();
 }
 //------------------------------------------------------------------------------
@@ -17,15 +17,15 @@ public:
 
 private:
   double m_alpha;
-  pair<int, pair<int, vector<double>> *> m_maxPId;
+  pair<int, pair<int, BondData> *> m_maxPId;
   double m_maxStretch;
   int m_indexS0;
   int m_indexStretch;
   int m_indexUnbreakable;
   int m_indexS00;
   int m_indexS_avg;
-  arma::mat *m_data;
-  ivec *m_idToCol;
+  ParticleData *m_data;
+  const IdToColMap *m_idToCol;
 };
 //------------------------------------------------------------------------------
 }
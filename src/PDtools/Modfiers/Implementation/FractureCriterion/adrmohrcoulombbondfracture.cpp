@@ -54,23 +54,20 @@ void AdrMohrCoulombBondFracture::evaluateStepTwo(const int id_i, const int i) {
   // stress at each material point.
   if ((*m_data)(i, m_indexUnbreakable) >= 1)
     return;
-  mat &data = *m_data;
+  ParticleData &data = *m_data;
   const mat &R = m_particles->r();
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles->pdConnections(id_i);
+  BondList &PDconnections = m_particles->pdConnections(id_i);
   double dr_ij[m_dim];
 
   if (m_dim == 2) {
     int counter = 0;
-    for (auto &con : PDconnections) {
+    m_particles->forEachConnectedBond(i, [&](const int l_j) {
+      auto &con = PDconnections[l_j];
       const int id_j = con.first;
       const int j = (*m_idToCol).at(id_j);
 
       if (data(j, m_indexUnbreakable) >= 1)
-        continue;
-
-      if (con.second[m_indexConnected] <= 0.5)
-        continue;
+        return;
 
       double r_len = 0;
       for (int d = 0; d < m_dim; d++) {
@@ -118,12 +115,12 @@ void AdrMohrCoulombBondFracture::evaluateStepTwo(const int id_i, const int i) {
       //            }
 
       if (s_n >= m_T) {
-        con.second[m_indexConnected] = 0;
+        m_particles->breakBond(id_i, con);
         m_maxPId = pair<int, int>(id_i, counter);
         data(i, m_indexBrokenNow) = 1;
       }
       counter++;
-    }
+    });
   }
 }
 //------------------------------------------------------------------------------
@@ -16,8 +16,8 @@ private:
   double m_C;
   double m_T;
   double m_d;
-  arma::mat *m_data;
-  ivec *m_idToCol;
+  ParticleData *m_data;
+  const IdToColMap *m_idToCol;
 
   int m_indexStress[6];
   int m_indexUnbreakable;
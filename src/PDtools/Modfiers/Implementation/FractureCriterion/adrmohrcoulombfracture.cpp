@@ -28,6 +28,7 @@ void ADRmohrCoulombFracture::initialize() {
   m_state = false;
   m_maxPId = pair<int, int>(-1, -1);
   m_maxStress = std::numeric_limits<double>::min();
+  m_threadLast.assign(nThreads(), pair<int, int>(-1, -1));
 
   switch (m_dim) {
   case 1:
@@ -62,9 +63,8 @@ void ADRmohrCoulombFracture::evaluateStepTwo(const int id_i, const int i) {
   // stress at each material point.
   if ((*m_data)(i, m_indexUnbreakable) >= 1)
     return;
-  mat &data = *m_data;
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles->pdConnections(id_i);
+  ParticleData &data = *m_data;
+  BondList &PDconnections = m_particles->pdConnections(id_i);
 
   //    arma::vec eigval(m_dim);
   //    arma::mat S_i(m_dim, m_dim);
@@ -75,16 +75,14 @@ void ADRmohrCoulombFracture::evaluateStepTwo(const int id_i, const int i) {
     //        S_i(1, 1) = data(i, m_indexStress[1]);
     //        S_i(0, 1) = data(i, m_indexStress[2]);
     //        S_i(1, 0) = S_i(0, 1);
-    int counter = 0;
-    for (auto &con : PDconnections) {
+    pair<int, int> &threadLast = m_threadLast[threadId()];
+    m_particles->forEachConnectedBond(i, [&](const int l_j) {
+      auto &con = PDconnections[l_j];
       const int id_j = con.first;
       const int j = (*m_idToCol)[id_j];
 
       if ((*m_data)(j, m_indexUnbreakable) >= 1)
-        continue;
-
-      if (con.second[m_indexConnected] <= 0.5)
-        continue;
+        return;
 
       const double sx =
           0.5 * (data(i, m_indexStress[0]) + data(j, m_indexStress[0]));
@@ -107,14 +105,10 @@ void ADRmohrCoulombFracture::evaluateStepTwo(const int id_i, const int i) {
       const double criticalTensile = p_1 - m_T;
 
       //                if(criticalShear >= 0  && normal < 0)
-      if (criticalShear >= 0) {
-        con.second[m_indexConnected] = 0;
-        data(i, m_indexBrokenNow) = 1;
-        m_maxPId = pair<int, int>(id_i, counter);
-      } else if (criticalTensile >= 0) {
-        con.second[m_indexConnected] = 0;
+      if (criticalShear >= 0 || criticalTensile >= 0) {
+        m_particles->breakBond(id_i, con);
         data(i, m_indexBrokenNow) = 1;
-        m_maxPId = pair<int, int>(id_i, counter);
+        threadLast = std::max(threadLast, pair<int, int>(i, l_j));
       }
 
       //            const int id_j = con.first;
@@ -168,8 +162,7 @@ void ADRmohrCoulombFracture::evaluateStepTwo(const int id_i, const int i) {
       //                    con.second[m_indexConnected] = 0;
       //                }
       //            }
-      counter++;
-    }
+    });
   } else if (m_dim == 3) {
     /*
     S_i(0, 0) = data(i, m_indexStress[0]);
@@ -240,12 +233,12 @@ S(1, 1)*pow(S(0, 2), 2) - S(2, 2)*pow(S(0, 1), 2) + 2*S(0, 1)*S(1, 2)*S(0, 2);
 #endif
         if(m_d*p_1 - p_2 - m_C > 0)
         {
-            con.second[m_indexConnected] = 0;
+            m_particles->breakBond(id_i, con);
             m_maxPId = pair<int, int>(id_i, counter);
         }
         else if(p_1 > m_T)
         {
-            con.second[m_indexConnected] = 0;
+            m_particles->breakBond(id_i, con);
             m_maxPId = pair<int, int>(id_i, counter);
         }
         counter++;
@@ -256,11 +249,20 @@ S(1, 1)*pow(S(0, 2), 2) - S(2, 2)*pow(S(0, 1), 2) + 2*S(0, 1)*S(1, 2)*S(0, 2);
 }
 //------------------------------------------------------------------------------
 void ADRmohrCoulombFracture::evaluateStepTwo() {
+  // Merging the per-thread results, the last broken bond as in a serial loop
+  pair<int, int> last(-1, -1);
+  for (pair<int, int> &threadLast : m_threadLast) {
+    last = std::max(last, threadLast);
+    threadLast = pair<int, int>(-1, -1);
+  }
+  if (last.first != -1)
+    m_maxPId = pair<int, int>(m_particles->colToId()(last.first), last.second);
+
   if (m_maxPId.first != -1) {
     const int id_i = m_maxPId.first;
     const int remove = m_maxPId.second;
     m_state = true;
-    //        vector<pair<int, vector<double>>> & PDconnections =
+    //        BondList & PDconnections =
     //        m_particles->pdConnections(id_i);
     //        PDconnections[remove].second[m_indexConnected] = 0;
   } else {
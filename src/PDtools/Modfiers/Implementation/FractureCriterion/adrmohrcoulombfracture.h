@@ -22,14 +22,16 @@ private:
   double m_tan_theta;
   double m_tan2_theta;
 
-  arma::mat *m_data;
-  ivec *m_idToCol;
+  ParticleData *m_data;
+  const IdToColMap *m_idToCol;
 
   int m_indexStress[6];
   int m_indexUnbreakable;
   int m_indexConnected;
   int m_indexBrokenNow;
   pair<int, int> m_maxPId;
+  // Per-thread last broken bond in the column order: (column, bond)
+  vector<pair<int, int>> m_threadLast;
   double m_maxStress;
   int m_nStressElements;
 };
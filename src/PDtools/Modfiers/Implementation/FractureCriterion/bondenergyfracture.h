@@ -29,8 +29,8 @@ protected:
   int m_indexBrokenNow;
   double m_G;
   double m_h;
-  arma::mat *m_data;
-  ivec *m_idToCol;
+  ParticleData *m_data;
+  const IdToColMap *m_idToCol;
 };
 //------------------------------------------------------------------------------
 }
@@ -0,0 +1,145 @@
+#include "bondfracturecriterion.h"
+
+#include "PDtools/Particles/pd_particles.h"
+#include "PDtools/PdFunctions/pdfunctions.h"
+
+namespace PDtools {
+//------------------------------------------------------------------------------
+BondFractureCriterion::BondFractureCriterion() {
+  m_neededProperties = {pair<string, int>("stress", 1)};
+  m_hasStepOne = true;
+}
+//------------------------------------------------------------------------------
+void BondFractureCriterion::registerParticleParameters() {
+  m_data = &m_particles->data();
+  m_indexUnbreakable = m_particles->registerParameter("unbreakable");
+  m_indexConnected = m_particles->registerPdParameter("connected", 0,
+                                                      BondData::Flag);
+  m_indexBrokenNow = m_particles->registerParameter("brokenNow", 0);
+
+  switch (m_dim) {
+  case 1:
+    m_ghostParameters = {"s_xx"};
+    m_indexStress[0] = m_particles->registerParameter("s_xx");
+    break;
+  case 2:
+    m_ghostParameters = {"s_xx", "s_yy", "s_xy"};
+    m_indexStress[0] = m_particles->registerParameter("s_xx");
+    m_indexStress[1] = m_particles->registerParameter("s_yy");
+    m_indexStress[2] = m_particles->registerParameter("s_xy");
+    break;
+  case 3:
+    m_ghostParameters = {"s_xx", "s_yy", "s_zz", "s_xy", "s_xz", "s_yz"};
+    m_indexStress[0] = m_particles->registerParameter("s_xx");
+    m_indexStress[1] = m_particles->registerParameter("s_yy");
+    m_indexStress[2] = m_particles->registerParameter("s_xy");
+    m_indexStress[3] = m_particles->registerParameter("s_zz");
+    m_indexStress[4] = m_particles->registerParameter("s_xz");
+    m_indexStress[5] = m_particles->registerParameter("s_yz");
+    break;
+  }
+}
+//------------------------------------------------------------------------------
+void BondFractureCriterion::initialize() {
+  m_threadBatch.resize(nThreads());
+}
+//------------------------------------------------------------------------------
+void BondFractureCriterion::evaluateStepOne(const int id_i, const int i) {
+  ParticleData &data = *m_data;
+  if (data(i, m_indexUnbreakable) >= 1)
+    return;
+
+  BondList &PDconnections = m_particles->pdConnections(id_i);
+  const int nStress = m_dim == 3 ? 6 : m_dim == 2 ? 3 : 1;
+
+  // Collecting the unique bonds, the bond is evaluated from its lowest id
+  BondBatch &batch = m_threadBatch[threadId()];
+  batch.l_j.clear();
+  batch.j.clear();
+
+  const vector<int> &neighbourCols = m_particles->neighbourColumns(i);
+  m_particles->forEachConnectedBond(i, [&](const int l_j) {
+    const int id_j = PDconnections[l_j].first;
+    if (id_j < id_i)
+      return;
+
+    const int j = neighbourCols[l_j];
+    if (data(j, m_indexUnbreakable) >= 1)
+      return;
+    if (!mayBreak(i, j))
+      return;
+
+    batch.l_j.push_back(l_j);
+    batch.j.push_back(j);
+  });
+
+  const int nBonds = batch.j.size();
+  if (nBonds == 0)
+    return;
+
+  for (int d = 0; d < nStress; d++) {
+    vector<double> &s = batch.s[d];
+    s.resize(nBonds);
+    const double s_i = data(i, m_indexStress[d]);
+    for (int b = 0; b < nBonds; b++) {
+      s[b] = 0.5 * (s_i + data(batch.j[b], m_indexStress[d]));
+    }
+  }
+  batch.p_max.resize(nBonds);
+  batch.p_mid.resize(nBonds);
+  batch.p_min.resize(nBonds);
+
+  switch (m_dim) {
+  case 1:
+    for (int b = 0; b < nBonds; b++) {
+      batch.p_max[b] = batch.s[0][b];
+      batch.p_mid[b] = batch.s[0][b];
+      batch.p_min[b] = batch.s[0][b];
+    }
+    break;
+  case 2:
+    principalStresses2d(nBonds, batch.s[0].data(), batch.s[1].data(),
+                        batch.s[2].data(), batch.p_max.data(),
+                        batch.p_min.data());
+    batch.p_mid = batch.p_min;
+    break;
+  case 3:
+    principalStresses3d(nBonds, batch.s[0].data(), batch.s[1].data(),
+                        batch.s[3].data(), batch.s[2].data(),
+                        batch.s[4].data(), batch.s[5].data(),
+                        batch.p_max.data(), batch.p_mid.data(),
+                        batch.p_min.data());
+    break;
+  }
+
+  BondStress bondStress;
+  for (int b = 0; b < nBonds; b++) {
+    for (int d = 0; d < nStress; d++) {
+      bondStress.s[d] = batch.s[d][b];
+    }
+    bondStress.p_max = batch.p_max[b];
+    bondStress.p_mid = batch.p_mid[b];
+    bondStress.p_min = batch.p_min[b];
+
+    if (!evaluateBond(i, batch.j[b], bondStress))
+      continue;
+
+    auto &con = PDconnections[batch.l_j[b]];
+    m_particles->breakBond(id_i, con);
+    data(i, m_indexBrokenNow) = 1;
+    requestBondBreak(con.first, id_i);
+  }
+}
+//------------------------------------------------------------------------------
+bool BondFractureCriterion::mayBreak(const int i, const int j) {
+  (void)i;
+  (void)j;
+  return true;
+}
+//------------------------------------------------------------------------------
+void BondFractureCriterion::evaluateStepOnePost() {
+  // The other end of the broken bonds
+  applyBondBreakRequests(m_indexBrokenNow);
+}
+//------------------------------------------------------------------------------
+}
@@ -0,0 +1,62 @@
+#ifndef BONDFRACTURECRITERION_H
+#define BONDFRACTURECRITERION_H
+
+#include "PDtools/Modfiers/modifier.h"
+
+namespace PDtools {
+//------------------------------------------------------------------------------
+// The stress state of a bond: the mean of the stress at the two material
+// points and its principal values. The components are ordered as the
+// stress parameters, (xx, yy, xy) in 2D and (xx, yy, xy, zz, xz, yz) in 3D.
+struct BondStress {
+  double s[6];
+  double p_max;
+  double p_mid;
+  double p_min;
+};
+//------------------------------------------------------------------------------
+// Base for stress based fracture criteria that only depend on the bond
+// averaged stress. The criterion is evaluated once for each bond, from the
+// particle with the lowest id, and a broken bond is broken at both ends.
+// The principal stresses of all the bonds of a particle are computed in one
+// batch before the criterion is evaluated.
+class BondFractureCriterion : public Modifier {
+public:
+  BondFractureCriterion();
+
+  virtual void registerParticleParameters();
+  virtual void initialize();
+  virtual void evaluateStepOne(const int id_i, const int i);
+  virtual void evaluateStepOnePost();
+
+  // Returns true if the bond between the columns i and j breaks
+  virtual bool evaluateBond(const int i, const int j,
+                            const BondStress &bondStress) = 0;
+
+  // Cheap test on the particle states, returns false if the bond can not
+  // break. Used to skip the bond stress of most bonds, e.g. with bounds from
+  // the principal stresses of the two particles.
+  virtual bool mayBreak(const int i, const int j);
+
+protected:
+  ParticleData *m_data;
+
+  int m_indexStress[6];
+  int m_indexUnbreakable;
+  int m_indexConnected;
+  int m_indexBrokenNow;
+
+  // Per-thread buffers over the bonds of one particle
+  struct BondBatch {
+    vector<int> l_j;
+    vector<int> j;
+    vector<double> s[6];
+    vector<double> p_max;
+    vector<double> p_mid;
+    vector<double> p_min;
+  };
+  vector<BondBatch> m_threadBatch;
+};
+//------------------------------------------------------------------------------
+}
+#endif // BONDFRACTURECRITERION_H
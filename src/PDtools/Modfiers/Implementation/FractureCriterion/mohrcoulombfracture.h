@@ -1,16 +1,17 @@
 #ifndef MOHRCOULOMBFRACTURE_H
 #define MOHRCOULOMBFRACTURE_H
 
-#include "PDtools/Modfiers/modifier.h"
+#include "bondfracturecriterion.h"
 
 namespace PDtools {
 //------------------------------------------------------------------------------
-class MohrCoulombFracture : public Modifier {
+class MohrCoulombFracture : public BondFractureCriterion {
 public:
   MohrCoulombFracture(double mu, double C, double T);
   virtual void registerParticleParameters();
-  virtual void initialize();
-  virtual void evaluateStepOne(const int id_i, const int i);
+  virtual bool evaluateBond(const int i, const int j,
+                            const BondStress &bondStress);
+  virtual bool mayBreak(const int i, const int j);
 
 private:
   double m_S0;
@@ -23,14 +24,7 @@ private:
   double m_tan2_theta;
   double m_k;
   double m_C0;
-
-  arma::mat *m_data;
-  ivec *m_idToCol;
-
-  int m_indexStress[6];
-  int m_indexUnbreakable;
-  int m_indexConnected;
-  int m_indexBrokenNow;
+  int m_indexStressMax;
 };
 //------------------------------------------------------------------------------
 }
@@ -6,7 +6,8 @@ namespace PDtools {
 MohrCoulombMax::MohrCoulombMax(double mu, double C, double T) : m_C(C), m_T(T) {
   m_phi = mu * M_PI / 180.;
   m_d = tan(m_phi);
-  m_neededProperties = {pair<string, int>("stress", 1)};
+  m_neededProperties = {pair<string, int>("stress", 1),
+                        pair<string, int>("principalStress", 1)};
 
   m_weight1 = 0.95;
   m_weight2 = 1. - m_weight1;
@@ -18,8 +19,10 @@ MohrCoulombMax::MohrCoulombMax(double mu, double C, double T) : m_C(C), m_T(T) {
 void MohrCoulombMax::registerParticleParameters() {
   m_data = &m_particles->data();
   m_indexUnbreakable = m_particles->registerParameter("unbreakable");
-  m_indexConnected = m_particles->registerPdParameter("connected");
-  m_indexCompute = m_particles->registerPdParameter("compute");
+  m_indexConnected = m_particles->registerPdParameter("connected", 0,
+                                                      BondData::Flag);
+  m_indexCompute = m_particles->registerPdParameter("compute", 0,
+                                                    BondData::Flag);
   //    m_indexStressCenter = m_particles->registerPdParameter("stressIndex");
   m_indexBroken = m_particles->registerParameter("broken", 0);
   m_idToCol = &m_particles->getIdToCol_v();
@@ -48,6 +51,8 @@ void MohrCoulombMax::registerParticleParameters() {
     break;
   }
   m_ghostParameters.push_back("broken");
+  m_indexStressMax = m_particles->registerParameter("s_max");
+  m_indexStressMin = m_particles->registerParameter("s_min");
 }
 //------------------------------------------------------------------------------
 void MohrCoulombMax::initialize() { }
@@ -55,13 +60,12 @@ void MohrCoulombMax::initialize() { }
 void MohrCoulombMax::evaluateStepOne(const int id_i, const int i) {
   if ((*m_data)(i, m_indexUnbreakable) >= 1)
     return;
-  const mat &data = *m_data;
+  const ParticleData &data = *m_data;
 
 #if CALCULATE_NUMMERICAL_PRINCIPAL_STRESS
   arma::vec eigval(m_dim);
 #endif
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles->pdConnections(id_i);
+  BondList &PDconnections = m_particles->pdConnections(id_i);
   double cos_theta = cos(M_PI / 2. + m_phi);
   double sin_theta = sin(M_PI / 2. + m_phi);
 
@@ -72,26 +76,24 @@ void MohrCoulombMax::evaluateStepOne(const int id_i, const int i) {
   double w_i, w_j;
 
   if (m_dim == 2) {
-    for (auto &con : PDconnections) {
+    m_particles->forEachConnectedBond(i, [&](const int l_j) {
+      auto &con = PDconnections[l_j];
       const int id_j = con.first;
       const int j = (*m_idToCol)[id_j];
 
       if ((*m_data)(j, m_indexUnbreakable) >= 1)
-        continue;
-
-      if (con.second[m_indexConnected] <= 0.5)
-        continue;
+        return;
 
       const int broken_j = data(j, m_indexBroken);
 
       if (broken_i == 0 && broken_j == 0) {
-        continue;
+        return;
       }
 
       // Both are broken in the same type of fracture
       if (broken_i == broken_j) {
-        con.second[m_indexConnected] = 0;
-        continue;
+        m_particles->breakBond(id_i, con);
+        return;
       }
 
       // Adjusting the weight
@@ -120,11 +122,11 @@ void MohrCoulombMax::evaluateStepOne(const int id_i, const int i) {
       const double normal = 0.5 * (p_1 + p_2) + 0.5 * (p_1 - p_2) * cos_theta;
 
       if (shear >= std::fabs(m_C - m_d * normal) && normal < 0) {
-        con.second[m_indexConnected] = 0;
+        m_particles->breakBond(id_i, con);
       } else if (p_2 >= m_T && normal > 0) {
-        con.second[m_indexConnected] = 0;
+        m_particles->breakBond(id_i, con);
       }
-    }
+    });
   }
 }
 //------------------------------------------------------------------------------
@@ -137,23 +139,15 @@ void MohrCoulombMax::evaluateStepTwo(const int id_i, const int i) {
 
   if ((*m_data)(i, m_indexUnbreakable) >= 1)
     return;
-  mat &data = *m_data;
+  ParticleData &data = *m_data;
   data(i, m_indexBroken) = 0;
 
   double cos_theta = cos(M_PI / 2. + m_phi);
   double sin_theta = sin(M_PI / 2. + m_phi);
 
   if (m_dim == 2) {
-    double sx, sy, sxy;
-    sx = data(i, m_indexStress[0]);
-    sy = data(i, m_indexStress[1]);
-    sxy = data(i, m_indexStress[2]);
-
-    const double first = 0.5 * (sx + sy);
-    const double second = sqrt(0.25 * (sx - sy) * (sx - sy) + sxy * sxy);
-
-    const double p_2 = first + second;
-    const double p_1 = first - second;
+    const double p_2 = data(i, m_indexStressMax);
+    const double p_1 = data(i, m_indexStressMin);
 
     const double shear = fabs(0.5 * (p_1 - p_2) * sin_theta);
     const double normal = 0.5 * (p_1 + p_2) + 0.5 * (p_1 - p_2) * cos_theta;
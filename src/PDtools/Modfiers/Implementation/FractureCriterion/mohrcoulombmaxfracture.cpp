@@ -3,10 +3,6 @@
 #include "PDtools/Particles/pd_particles.h"
 #include <stdlib.h>
 
-#ifdef USE_MPI
-#include <mpi.h>
-#endif
-
 namespace PDtools {
 //------------------------------------------------------------------------------
 MohrCoulombMaxFracture::MohrCoulombMaxFracture(double mu, double C, double T)
@@ -14,6 +10,7 @@ MohrCoulombMaxFracture::MohrCoulombMaxFracture(double mu, double C, double T)
   m_phi = mu * M_PI / 180.;
   m_d = tan(m_phi);
   m_neededProperties = {pair<string, int>("stress", 1),
+                        pair<string, int>("principalStress", 1),
                         pair<string, int>("damage", 1)};
 
   m_hasStepOne = true;
@@ -23,9 +20,11 @@ MohrCoulombMaxFracture::MohrCoulombMaxFracture(double mu, double C, double T)
 void MohrCoulombMaxFracture::registerParticleParameters() {
   m_data = &m_particles->data();
   m_indexUnbreakable = m_particles->registerParameter("unbreakable");
-  m_indexConnected = m_particles->registerPdParameter("connected");
+  m_indexConnected = m_particles->registerPdParameter("connected", 0,
+                                                      BondData::Flag);
   m_indexRadius = m_particles->registerParameter("radius");
-  m_indexCompute = m_particles->registerPdParameter("compute");
+  m_indexCompute = m_particles->registerPdParameter("compute", 0,
+                                                    BondData::Flag);
   m_indexBroken = m_particles->registerParameter("broken", 0);
   m_indexDamage = m_particles->registerParameter("damage");
   m_indexBrokenNow = m_particles->registerParameter("brokenNow", 0);
@@ -60,18 +59,19 @@ void MohrCoulombMaxFracture::registerParticleParameters() {
   }
   m_ghostParameters.push_back("broken");
   m_ghostParameters.push_back("damage");
+  m_indexStressMax = m_particles->registerParameter("s_max");
+  m_indexStressMin = m_particles->registerParameter("s_min");
 }
 //------------------------------------------------------------------------------
 void MohrCoulombMaxFracture::initialize() {
   srand(time(NULL));
-  m_broken = false;
+  m_threadBroken.assign(nThreads(), 0);
   m_cosTheta = cos(M_PI / 2. + m_phi);
   m_sinTheta = sin(M_PI / 2. + m_phi);
-  m_brokenParticles.clear();
 }
 //------------------------------------------------------------------------------
 void MohrCoulombMaxFracture::evaluateStepOne(const int id_i, const int i) {
-  mat &data = *m_data;
+  ParticleData &data = *m_data;
   const mat &r = m_particles->r();
 
   if (data(i, m_indexUnbreakable) >= 1)
@@ -88,18 +88,15 @@ void MohrCoulombMaxFracture::evaluateStepOne(const int id_i, const int i) {
     }
   }
 
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles->pdConnections(id_i);
+  BondList &PDconnections = m_particles->pdConnections(id_i);
 
-  for (auto &con : PDconnections) {
+  m_particles->forEachConnectedBond(i, [&](const int l_j) {
+    auto &con = PDconnections[l_j];
     const int id_j = con.first;
     const int j = (*m_idToCol)[id_j];
 
     if (data(j, m_indexUnbreakable) >= 1)
-      continue;
-
-    if (con.second[m_indexConnected] <= 0.5)
-      continue;
+      return;
 
     if (broken_i) {
       double dotproduct = 0;
@@ -109,10 +106,10 @@ void MohrCoulombMaxFracture::evaluateStepOne(const int id_i, const int i) {
       }
 
       if (dotproduct > 0) {
-        con.second[m_indexConnected] = 0;
+        m_particles->breakBond(id_i, con);
         data(i, m_indexBrokenNow) = 1;
       }
-      continue;
+      return;
     }
 
     const int broken_j = data(j, m_indexBroken);
@@ -125,7 +122,7 @@ void MohrCoulombMaxFracture::evaluateStepOne(const int id_i, const int i) {
       }
 
       if (dotproduct > 0) {
-        con.second[m_indexConnected] = 0;
+        m_particles->breakBond(id_i, con);
         data(i, m_indexBrokenNow) = 1;
       }
 
@@ -149,8 +146,7 @@ void MohrCoulombMaxFracture::evaluateStepOne(const int id_i, const int i) {
       x3 = r(i, 0);
       y3 = r(i, 1);
 
-      vector<pair<int, vector<double>>> &PDconnections2 =
-          m_particles->pdConnections(id_i);
+      BondList &PDconnections2 = m_particles->pdConnections(id_i);
       for (auto &con2 : PDconnections2) {
         if (con2.first == id_j) {
           continue;
@@ -187,54 +183,26 @@ void MohrCoulombMaxFracture::evaluateStepOne(const int id_i, const int i) {
           double dotproduct = (px - r(i, 0)) * (px - r(k, 0));
           dotproduct += (py - r(i, 1)) * (py - r(k, 1));
           if (dotproduct < 0) {
-            con2.second[m_indexConnected] = 0;
+            m_particles->breakBond(id_i, con2);
             data(i, m_indexBrokenNow) = 1;
-            m_brokenParticles[id_k].push_back(id_i);
+            requestBondBreak(id_k, id_i);
           }
         }
       }
     }
-  }
+  });
 }
 //------------------------------------------------------------------------------
 void MohrCoulombMaxFracture::evaluateStepOnePost() {
-#if USE_MPI
-  exchangeBrokenParticlesMPI();
-#endif
-  const ivec &idToCol = m_particles->getIdToCol_v();
-  const int nParticles = m_particles->nParticles();
-
-  for (auto broken_idList : m_brokenParticles) {
-    const int id_i = broken_idList.first;
-    const vector<int> &broken = broken_idList.second;
-
-#if USE_MPI
-    // Check if the particle is a ghost particle
-    if (idToCol.at(id_i) >= nParticles) {
-      continue;
-    }
-#endif
-    vector<pair<int, vector<double>>> &PDconnections =
-        m_particles->pdConnections(id_i);
-
-    for (auto &con : PDconnections) {
-      for (int id : broken) {
-        if (id == id_i) {
-          con.second[m_indexConnected] = 0;
-          const int j = idToCol[id];
-          (*m_data)(j, m_indexBrokenNow) = 1;
-        }
-      }
-    }
-  }
-  m_brokenParticles.clear();
+  // The bonds of the neighbours are broken here, outside the particle loop
+  applyBondBreakRequests(m_indexBrokenNow);
 }
 //------------------------------------------------------------------------------
 void MohrCoulombMaxFracture::evaluateStepTwo(const int id_i, const int i) {
   if ((*m_data)(i, m_indexUnbreakable) >= 1)
     return;
 
-  mat &data = *m_data;
+  ParticleData &data = *m_data;
   mat &r = m_particles->r();
 
   if (m_dim == 2) {
@@ -243,11 +211,8 @@ void MohrCoulombMaxFracture::evaluateStepTwo(const int id_i, const int i) {
     sy = data(i, m_indexStress[1]);
     sxy = data(i, m_indexStress[2]);
 
-    double first = 0.5 * (sx + sy);
-    double second = sqrt(0.25 * (sx - sy) * (sx - sy) + sxy * sxy);
-
-    double p_2 = first + second; // max
-    double p_1 = first - second; // min
+    const double p_2 = data(i, m_indexStressMax);
+    const double p_1 = data(i, m_indexStressMin);
 
     const double shear = 0.5 * (p_1 - p_2) * m_sinTheta;
     const double normal = 0.5 * (p_1 + p_2) + 0.5 * (p_1 - p_2) * m_cosTheta;
@@ -264,14 +229,14 @@ void MohrCoulombMaxFracture::evaluateStepTwo(const int id_i, const int i) {
     //        if(fabs(shear) >= fabs(m_C - m_d*normal))
     if (criticalShear >= 0 && normal < 0) {
       data(i, m_indexBroken) = 2;
-      m_broken = true;
+      m_threadBroken[threadId()] = 1;
       broken = 2;
       //            theta = -theta; // Changing the rotation to the front
     }
     //        else if(p_2 >= m_T)
     else if (criticalTensile >= 0) {
       data(i, m_indexBroken) = 1;
-      m_broken = true;
+      m_threadBroken[threadId()] = 1;
       broken = 1;
     } else {
       data(i, m_indexBroken) = 0;
@@ -295,8 +260,7 @@ void MohrCoulombMaxFracture::evaluateStepTwo(const int id_i, const int i) {
       ////                cout << "HAHAHAHAHAHAH" << endl;
       ////            }
 
-      vector<pair<int, vector<double>>> &PDconnections =
-          m_particles->pdConnections(id_i);
+      BondList &PDconnections = m_particles->pdConnections(id_i);
       //------------------------------------------------------------------
       // Choosing the least damaged side for tensile fracture
       if (broken == 1) {
@@ -459,56 +423,12 @@ void MohrCoulombMaxFracture::evaluateStepTwo(const int id_i, const int i) {
 }
 //------------------------------------------------------------------------------
 void MohrCoulombMaxFracture::evaluateStepTwo() {
-  if (m_broken) {
-    m_state = true;
-  } else {
-    m_state = false;
-  }
-
-  m_broken = false;
-}
-//------------------------------------------------------------------------------
-void MohrCoulombMaxFracture::exchangeBrokenParticlesMPI() {
-#if USE_MPI
-  vector<int> sendData;
-  const vector<int> &neighbouringCores = m_grid->neighbouringCores();
-
-  // Collecting all the send data
-  for (auto broken_idList : m_brokenParticles) {
-    const int id_i = broken_idList.first;
-    const vector<int> &broken = broken_idList.second;
-
-    sendData.push_back(id_i);
-    sendData.push_back(broken.size());
-
-    for (int b : broken)
-      sendData.push_back(b);
-  }
-  const int myRank = MPI::COMM_WORLD.Get_rank();
-
-  for (int toCore : neighbouringCores) {
-    int nSendElements = sendData.size();
-    int nRecieveElements;
-    MPI_Status status;
-
-    MPI_Sendrecv(&nSendElements, 1, MPI_INT, toCore, myRank, &nRecieveElements,
-                 1, MPI_INT, toCore, toCore, MPI_COMM_WORLD, &status);
-
-    int recieveData[nRecieveElements];
-
-    MPI_Sendrecv(&sendData[0], nSendElements, MPI_INT, toCore, 1, &recieveData,
-                 nRecieveElements, MPI_INT, toCore, 1, MPI_COMM_WORLD, &status);
-
-    int i = 0;
-    while (i < nRecieveElements) {
-      const int id = recieveData[i++];
-      int nBrokenBonds = recieveData[i++];
-      for (int j = 0; j < nBrokenBonds; j++) {
-        m_brokenParticles[id].push_back(recieveData[i++]);
-      }
-    }
+  bool broken = false;
+  for (char &threadBroken : m_threadBroken) {
+    broken = broken || threadBroken;
+    threadBroken = 0;
   }
-#endif
+  m_state = broken;
 }
 //------------------------------------------------------------------------------
 }
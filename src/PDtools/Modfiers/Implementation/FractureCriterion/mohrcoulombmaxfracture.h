@@ -22,13 +22,14 @@ private:
   double m_T;
   double m_d;
   double m_phi;
-  arma::mat *m_data;
-  ivec *m_idToCol;
-  unordered_map<int, vector<int>> m_brokenParticles;
+  ParticleData *m_data;
+  const IdToColMap *m_idToCol;
 
   int m_indexStress[6];
   int m_indexNormal[3];
   int m_indexUnbreakable;
+  int m_indexStressMax;
+  int m_indexStressMin;
   int m_indexConnected;
   int m_indexCompute;
   int m_indexStressCenter;
@@ -36,11 +37,10 @@ private:
   int m_indexBroken;
   int m_indexRadius;
   int m_indexDamage;
-  bool m_broken;
+  // Set by the particle loops, one flag per thread
+  vector<char> m_threadBroken;
   double m_cosTheta;
   double m_sinTheta;
-
-  void exchangeBrokenParticlesMPI();
 };
 //------------------------------------------------------------------------------
 }
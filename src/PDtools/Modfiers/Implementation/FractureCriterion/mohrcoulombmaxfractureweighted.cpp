@@ -3,9 +3,6 @@
 #include "PDtools/Particles/pd_particles.h"
 
 #include <stdlib.h>
-#ifdef USE_MPI
-#include <mpi.h>
-#endif
 
 namespace PDtools {
 //------------------------------------------------------------------------------
@@ -14,7 +11,8 @@ MohrCoulombMaxFractureWeighted::MohrCoulombMaxFractureWeighted(
     : m_C(C), m_T(T) {
   m_phi = mu * M_PI / 180.;
   m_d = tan(m_phi);
-  m_neededProperties = {pair<string, int>("stress", 1)};
+  m_neededProperties = {pair<string, int>("stress", 1),
+                        pair<string, int>("principalStress", 1)};
 
   m_Wc = Wc;
   m_Bc = Bc;
@@ -31,16 +29,17 @@ MohrCoulombMaxFractureWeighted::MohrCoulombMaxFractureWeighted(
 //------------------------------------------------------------------------------
 void MohrCoulombMaxFractureWeighted::initialize() {
   srand(time(NULL));
-  m_broken = false;
-  m_brokenParticles.clear();
+  m_threadBroken.assign(nThreads(), 0);
 }
 //------------------------------------------------------------------------------
 void MohrCoulombMaxFractureWeighted::registerParticleParameters() {
   m_data = &m_particles->data();
   m_indexUnbreakable = m_particles->registerParameter("unbreakable");
-  m_indexConnected = m_particles->registerPdParameter("connected");
+  m_indexConnected = m_particles->registerPdParameter("connected", 0,
+                                                      BondData::Flag);
   m_indexRadius = m_particles->registerParameter("radius");
-  m_indexCompute = m_particles->registerPdParameter("compute");
+  m_indexCompute = m_particles->registerPdParameter("compute", 0,
+                                                    BondData::Flag);
   m_indexBroken = m_particles->registerParameter("broken", 0);
   m_indexBrokenNow = m_particles->registerParameter("brokenNow", 0);
   m_particles->registerParameter("damage");
@@ -68,11 +67,13 @@ void MohrCoulombMaxFractureWeighted::registerParticleParameters() {
     break;
   }
   m_ghostParameters.push_back("broken");
+  m_indexStressMax = m_particles->registerParameter("s_max");
+  m_indexStressMin = m_particles->registerParameter("s_min");
 }
 //------------------------------------------------------------------------------
 void MohrCoulombMaxFractureWeighted::evaluateStepOne(const int id_i,
                                                      const int i) {
-  mat &data = *m_data;
+  ParticleData &data = *m_data;
 
   if (data(i, m_indexUnbreakable) >= 1)
     return;
@@ -80,21 +81,18 @@ void MohrCoulombMaxFractureWeighted::evaluateStepOne(const int id_i,
   const int broken_i = data(i, m_indexBroken);
   vector<int> broken_nodes;
 
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles->pdConnections(id_i);
+  BondList &PDconnections = m_particles->pdConnections(id_i);
 
-  for (auto &con : PDconnections) {
+  m_particles->forEachConnectedBond(i, [&](const int l_j) {
+    auto &con = PDconnections[l_j];
     const int id_j = con.first;
     const int j = (*m_idToCol)[id_j];
 
     if (data(j, m_indexUnbreakable) >= 1)
-      continue;
+      return;
 
     const int broken_j = data(j, m_indexBroken);
 
-    if (con.second[m_indexConnected] <= 0.5)
-      continue;
-
     if (broken_i > 0) {
       double sx, sy, sxy;
       sx = m_Wn * data(j, m_indexStress[0]) + m_Wc * data(i, m_indexStress[0]);
@@ -114,16 +112,16 @@ void MohrCoulombMaxFractureWeighted::evaluateStepOne(const int id_i,
       const double criticalTensile = p_2 - m_T;
 
       if (criticalShear >= 0 && normal < 0) {
-        con.second[m_indexConnected] = 0;
+        m_particles->breakBond(id_i, con);
         data(i, m_indexBrokenNow) = 1;
-        m_broken = true;
+        m_threadBroken[threadId()] = 1;
       } else if (criticalTensile >= 0) {
-        con.second[m_indexConnected] = 0;
+        m_particles->breakBond(id_i, con);
         data(i, m_indexBrokenNow) = 1;
-        m_broken = true;
+        m_threadBroken[threadId()] = 1;
       }
 
-      continue;
+      return;
     }
 
     if (broken_j > 0) {
@@ -146,18 +144,18 @@ void MohrCoulombMaxFractureWeighted::evaluateStepOne(const int id_i,
       const double criticalTensile = p_2 - m_T;
 
       if (criticalShear >= 0 && normal < 0) {
-        con.second[m_indexConnected] = 0;
+        m_particles->breakBond(id_i, con);
         data(i, m_indexBrokenNow) = 1;
-        m_broken = true;
+        m_threadBroken[threadId()] = 1;
       } else if (criticalTensile >= 0) {
-        con.second[m_indexConnected] = 0;
+        m_particles->breakBond(id_i, con);
         data(i, m_indexBrokenNow) = 1;
-        m_broken = true;
+        m_threadBroken[threadId()] = 1;
       }
 
-      continue;
+      return;
     }
-  }
+  });
 
   if (!broken_nodes.empty()) {
     const mat &r = m_particles->r();
@@ -165,15 +163,13 @@ void MohrCoulombMaxFractureWeighted::evaluateStepOne(const int id_i,
     double ij[m_dim];
     double p[m_dim];
 
-    for (auto &con : PDconnections) {
+    m_particles->forEachConnectedBond(i, [&](const int l_j) {
+      auto &con = PDconnections[l_j];
       const int id_j = con.first;
       const int j = (*m_idToCol)[id_j];
 
       if (data(j, m_indexUnbreakable) >= 1)
-        continue;
-
-      if (con.second[m_indexConnected] <= 0.5)
-        continue;
+        return;
 
       ij[0] = r(j, 0) - r(i, 0);
       ij[1] = r(j, 1) - r(i, 1);
@@ -233,50 +229,24 @@ void MohrCoulombMaxFractureWeighted::evaluateStepOne(const int id_i,
           const double criticalTensile = p_2 - m_T;
           int br = 0;
           if (criticalShear >= 0 && normal < 0) {
-            con.second[m_indexConnected] = 0;
+            m_particles->breakBond(id_i, con);
             data(i, m_indexBrokenNow) = 1;
-            m_broken = true;
+            m_threadBroken[threadId()] = 1;
             br = 1;
           } else if (criticalTensile >= 0) {
-            con.second[m_indexConnected] = 0;
+            m_particles->breakBond(id_i, con);
             data(i, m_indexBrokenNow) = 1;
-            m_broken = true;
+            m_threadBroken[threadId()] = 1;
             br = 1;
           }
         }
       }
-    }
+    });
   }
 }
 //------------------------------------------------------------------------------
 void MohrCoulombMaxFractureWeighted::evaluateStepOnePost() {
-#if USE_MPI
-  exchangeBrokenParticlesMPI();
-#endif
-  const ivec &idToCol = m_particles->getIdToCol_v();
-  const int nParticles = m_particles->nParticles();
-  for (auto broken_idList : m_brokenParticles) {
-    const int id_i = broken_idList.first;
-    const vector<int> &broken = broken_idList.second;
-
-#if USE_MPI
-    // Check if the particle is a ghost particle
-    if (idToCol[id_i] >= nParticles) {
-      continue;
-    }
-#endif
-    vector<pair<int, vector<double>>> &PDconnections =
-        m_particles->pdConnections(id_i);
-
-    for (auto &con : PDconnections) {
-      for (int id : broken) {
-        if (id == id_i) {
-          con.second[m_indexConnected] = 0;
-        }
-      }
-    }
-  }
-  m_brokenParticles.clear();
+  applyBondBreakRequests(m_indexBrokenNow);
 }
 //------------------------------------------------------------------------------
 // void MohrCoulombMaxFractureWeighted::evaluateStepOne(const int id_i, const
@@ -286,20 +256,12 @@ void MohrCoulombMaxFractureWeighted::evaluateStepTwo(const int id_i,
   if ((*m_data)(i, m_indexUnbreakable) >= 1)
     return;
 
-  mat &data = *m_data;
+  ParticleData &data = *m_data;
   mat &r = m_particles->r();
 
   if (m_dim == 2) {
-    double sx, sy, sxy;
-    sx = data(i, m_indexStress[0]);
-    sy = data(i, m_indexStress[1]);
-    sxy = data(i, m_indexStress[2]);
-
-    const double first = 0.5 * (sx + sy);
-    const double second = sqrt(0.25 * (sx - sy) * (sx - sy) + sxy * sxy);
-
-    const double p_2 = first + second; // max
-    const double p_1 = first - second; // min
+    const double p_2 = data(i, m_indexStressMax);
+    const double p_1 = data(i, m_indexStressMin);
 
     const double shear = 0.5 * (p_1 - p_2) * m_sinTheta;
     const double normal = 0.5 * (p_1 + p_2) + 0.5 * (p_1 - p_2) * m_cosTheta;
@@ -310,10 +272,10 @@ void MohrCoulombMaxFractureWeighted::evaluateStepTwo(const int id_i,
     //        if(criticalShear >= 0  && normal < 0)
     if (criticalShear >= 0) {
       data(i, m_indexBroken) = 2;
-      m_broken = true;
+      m_threadBroken[threadId()] = 1;
     } else if (criticalTensile >= 0) {
       data(i, m_indexBroken) = 1;
-      m_broken = true;
+      m_threadBroken[threadId()] = 1;
     } else {
       data(i, m_indexBroken) = 0;
     }
@@ -324,56 +286,17 @@ void MohrCoulombMaxFractureWeighted::evaluateStepTwo(const int id_i,
 //------------------------------------------------------------------------------
 // void MohrCoulombMaxFractureWeighted::evaluateStepOne()
 void MohrCoulombMaxFractureWeighted::evaluateStepTwo() {
-  if (m_broken) {
-    m_state = true;
-  } else {
-    m_state = false;
-  }
-
-  m_broken = false;
+  m_state = collectBroken();
 }
 //------------------------------------------------------------------------------
-void MohrCoulombMaxFractureWeighted::exchangeBrokenParticlesMPI() {
-#if USE_MPI
-  vector<int> sendData;
-  const vector<int> &neighbouringCores = m_grid->neighbouringCores();
-
-  // Collecting all the send data
-  for (auto broken_idList : m_brokenParticles) {
-    const int id_i = broken_idList.first;
-    const vector<int> &broken = broken_idList.second;
-
-    sendData.push_back(id_i);
-    sendData.push_back(broken.size());
-
-    for (int b : broken)
-      sendData.push_back(b);
-  }
-  const int myRank = MPI::COMM_WORLD.Get_rank();
-
-  for (int toCore : neighbouringCores) {
-    int nSendElements = sendData.size();
-    int nRecieveElements;
-    MPI_Status status;
-
-    MPI_Sendrecv(&nSendElements, 1, MPI_INT, toCore, myRank, &nRecieveElements,
-                 1, MPI_INT, toCore, toCore, MPI_COMM_WORLD, &status);
-
-    int recieveData[nRecieveElements];
-
-    MPI_Sendrecv(&sendData[0], nSendElements, MPI_INT, toCore, 1, &recieveData,
-                 nRecieveElements, MPI_INT, toCore, 1, MPI_COMM_WORLD, &status);
-
-    int i = 0;
-    while (i < nRecieveElements) {
-      const int id = recieveData[i++];
-      int nBrokenBonds = recieveData[i++];
-      for (int j = 0; j < nBrokenBonds; j++) {
-        m_brokenParticles[id].push_back(recieveData[i++]);
-      }
-    }
+bool MohrCoulombMaxFractureWeighted::collectBroken() {
+  // Merges and resets the per-thread flags of the particle loops
+  bool broken = false;
+  for (char &threadBroken : m_threadBroken) {
+    broken = broken || threadBroken;
+    threadBroken = 0;
   }
-#endif
+  return broken;
 }
 //------------------------------------------------------------------------------
 }
@@ -23,9 +23,8 @@ protected:
   double m_T;
   double m_d;
   double m_phi;
-  arma::mat *m_data;
-  ivec *m_idToCol;
-  unordered_map<int, vector<int>> m_brokenParticles;
+  ParticleData *m_data;
+  const IdToColMap *m_idToCol;
   double m_Wn;
   double m_Wc;
   double m_Bn;
@@ -33,6 +32,8 @@ protected:
 
   int m_indexStress[6];
   int m_indexUnbreakable;
+  int m_indexStressMax;
+  int m_indexStressMin;
   int m_indexConnected;
   int m_indexCompute;
   int m_indexStressCenter;
@@ -40,12 +41,13 @@ protected:
   int m_indexBrokenNow;
   int m_indexRadius;
   int m_indexDamage;
-  bool m_broken;
+  // Set by the particle loops, one flag per thread
+  vector<char> m_threadBroken;
   double m_cosTheta;
   double m_sinTheta;
   double m_radiusScale;
 
-  void exchangeBrokenParticlesMPI();
+  bool collectBroken();
 };
 //------------------------------------------------------------------------------
 }
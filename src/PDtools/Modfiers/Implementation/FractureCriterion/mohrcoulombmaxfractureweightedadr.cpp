@@ -8,13 +8,7 @@ MohrCoulombMaxFractureWeightedAdr::MohrCoulombMaxFractureWeightedAdr(
     : MohrCoulombMaxFractureWeighted(mu, C, T, Wc, Bc) {}
 //------------------------------------------------------------------------------
 void MohrCoulombMaxFractureWeightedAdr::evaluateStepOne() {
-  if (m_broken) {
-    m_state = true;
-  } else {
-    m_state = false;
-  }
-
-  m_broken = false;
+  m_state = collectBroken();
 }
 //------------------------------------------------------------------------------
 void MohrCoulombMaxFractureWeightedAdr::evaluateStepOne(const int id_i,
@@ -22,20 +16,12 @@ void MohrCoulombMaxFractureWeightedAdr::evaluateStepOne(const int id_i,
   if ((*m_data)(i, m_indexUnbreakable) >= 1)
     return;
 
-  mat &data = *m_data;
+  ParticleData &data = *m_data;
   mat &r = m_particles->r();
 
   if (m_dim == 2) {
-    double sx, sy, sxy;
-    sx = data(i, m_indexStress[0]);
-    sy = data(i, m_indexStress[1]);
-    sxy = data(i, m_indexStress[2]);
-
-    const double first = 0.5 * (sx + sy);
-    const double second = sqrt(0.25 * (sx - sy) * (sx - sy) + sxy * sxy);
-
-    const double p_2 = first + second; // max
-    const double p_1 = first - second; // min
+    const double p_2 = data(i, m_indexStressMax);
+    const double p_1 = data(i, m_indexStressMin);
 
     const double shear = 0.5 * (p_1 - p_2) * m_sinTheta;
     const double normal = 0.5 * (p_1 + p_2) + 0.5 * (p_1 - p_2) * m_cosTheta;
@@ -45,10 +31,10 @@ void MohrCoulombMaxFractureWeightedAdr::evaluateStepOne(const int id_i,
 
     if (criticalShear >= 0) {
       data(i, m_indexBroken) = 2;
-      m_broken = true;
+      m_threadBroken[threadId()] = 1;
     } else if (criticalTensile >= 0) {
       data(i, m_indexBroken) = 1;
-      m_broken = true;
+      m_threadBroken[threadId()] = 1;
     } else {
       data(i, m_indexBroken) = 0;
     }
@@ -59,7 +45,7 @@ void MohrCoulombMaxFractureWeightedAdr::evaluateStepOne(const int id_i,
 //------------------------------------------------------------------------------
 void MohrCoulombMaxFractureWeightedAdr::evaluateStepTwo(const int id_i,
                                                         const int i) {
-  mat &data = *m_data;
+  ParticleData &data = *m_data;
 
   if (data(i, m_indexUnbreakable) >= 1)
     return;
@@ -67,21 +53,18 @@ void MohrCoulombMaxFractureWeightedAdr::evaluateStepTwo(const int id_i,
   const int broken_i = data(i, m_indexBroken);
   vector<int> broken_nodes;
 
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles->pdConnections(id_i);
+  BondList &PDconnections = m_particles->pdConnections(id_i);
 
-  for (auto &con : PDconnections) {
+  m_particles->forEachConnectedBond(i, [&](const int l_j) {
+    auto &con = PDconnections[l_j];
     const int id_j = con.first;
     const int j = (*m_idToCol)[id_j];
 
     if (data(j, m_indexUnbreakable) >= 1)
-      continue;
+      return;
 
     const int broken_j = data(j, m_indexBroken);
 
-    if (con.second[m_indexConnected] <= 0.5)
-      continue;
-
     if (broken_i > 0) {
       double sx, sy, sxy;
       sx = m_Wn * data(j, m_indexStress[0]) + m_Wc * data(i, m_indexStress[0]);
@@ -101,16 +84,16 @@ void MohrCoulombMaxFractureWeightedAdr::evaluateStepTwo(const int id_i,
       const double criticalTensile = p_2 - m_T;
 
       if (criticalShear >= 0 && normal < 0) {
-        con.second[m_indexConnected] = 0;
+        m_particles->breakBond(id_i, con);
         data(i, m_indexBrokenNow) = 1;
-        m_broken = true;
+        m_threadBroken[threadId()] = 1;
       } else if (criticalTensile >= 0) {
-        con.second[m_indexConnected] = 0;
+        m_particles->breakBond(id_i, con);
         data(i, m_indexBrokenNow) = 1;
-        m_broken = true;
+        m_threadBroken[threadId()] = 1;
       }
 
-      continue;
+      return;
     }
 
     if (broken_j > 0) {
@@ -133,18 +116,18 @@ void MohrCoulombMaxFractureWeightedAdr::evaluateStepTwo(const int id_i,
       const double criticalTensile = p_2 - m_T;
 
       if (criticalShear >= 0 && normal < 0) {
-        con.second[m_indexConnected] = 0;
+        m_particles->breakBond(id_i, con);
         data(i, m_indexBrokenNow) = 1;
-        m_broken = true;
+        m_threadBroken[threadId()] = 1;
       } else if (criticalTensile >= 0) {
-        con.second[m_indexConnected] = 0;
+        m_particles->breakBond(id_i, con);
         data(i, m_indexBrokenNow) = 1;
-        m_broken = true;
+        m_threadBroken[threadId()] = 1;
       }
 
-      continue;
+      return;
     }
-  }
+  });
 
   if (!broken_nodes.empty()) {
     const mat &r = m_particles->r();
@@ -152,15 +135,13 @@ void MohrCoulombMaxFractureWeightedAdr::evaluateStepTwo(const int id_i,
     double ij[m_dim];
     double p[m_dim];
 
-    for (auto &con : PDconnections) {
+    m_particles->forEachConnectedBond(i, [&](const int l_j) {
+      auto &con = PDconnections[l_j];
       const int id_j = con.first;
       const int j = (*m_idToCol)[id_j];
 
       if (data(j, m_indexUnbreakable) >= 1)
-        continue;
-
-      if (con.second[m_indexConnected] <= 0.5)
-        continue;
+        return;
 
       ij[0] = r(j, 0) - r(i, 0);
       ij[1] = r(j, 1) - r(i, 1);
@@ -220,53 +201,24 @@ void MohrCoulombMaxFractureWeightedAdr::evaluateStepTwo(const int id_i,
           const double criticalTensile = p_2 - m_T;
           int br = 0;
           if (criticalShear >= 0 && normal < 0) {
-            con.second[m_indexConnected] = 0;
+            m_particles->breakBond(id_i, con);
             data(i, m_indexBrokenNow) = 1;
-            m_broken = true;
+            m_threadBroken[threadId()] = 1;
             br = 1;
           } else if (criticalTensile >= 0) {
-            con.second[m_indexConnected] = 0;
+            m_particles->breakBond(id_i, con);
             data(i, m_indexBrokenNow) = 1;
-            m_broken = true;
+            m_threadBroken[threadId()] = 1;
             br = 1;
           }
         }
       }
-    }
+    });
   }
 }
 //------------------------------------------------------------------------------
 void MohrCoulombMaxFractureWeightedAdr::evaluateStepTwoPost() {
-#if USE_MPI
-  exchangeBrokenParticlesMPI();
-#endif
-  const ivec &idToCol = m_particles->getIdToCol_v();
-  const int nParticles = m_particles->nParticles();
-#if USE_MPI
-//    const int myRank = MPI::COMM_WORLD.Get_rank( );
-#endif
-  for (auto broken_idList : m_brokenParticles) {
-    const int id_i = broken_idList.first;
-    const vector<int> &broken = broken_idList.second;
-
-#if USE_MPI
-    // Check if the particle is a ghost particle
-    if (idToCol[id_i] >= nParticles) {
-      continue;
-    }
-#endif
-    vector<pair<int, vector<double>>> &PDconnections =
-        m_particles->pdConnections(id_i);
-
-    for (auto &con : PDconnections) {
-      for (int id : broken) {
-        if (id == id_i) {
-          con.second[m_indexConnected] = 0;
-        }
-      }
-    }
-  }
-  m_brokenParticles.clear();
+  applyBondBreakRequests(m_indexBrokenNow);
 }
 //------------------------------------------------------------------------------
 }
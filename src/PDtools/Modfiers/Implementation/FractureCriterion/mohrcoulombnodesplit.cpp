@@ -22,8 +22,10 @@ void MohrCoulombNodeSplit::registerParticleParameters() {
   m_indexRadius = m_particles->registerParameter("radius");
   m_indexVolume = m_particles->registerParameter("volume");
   m_indexDr0 = m_particles->getPdParamId("dr0");
-  m_indexConnected = m_particles->registerPdParameter("connected");
-  m_indexCompute = m_particles->registerPdParameter("compute");
+  m_indexConnected = m_particles->registerPdParameter("connected", 0,
+                                                      BondData::Flag);
+  m_indexCompute = m_particles->registerPdParameter("compute", 0,
+                                                    BondData::Flag);
   m_indexNewConnectionId_1 = m_particles->registerParameter("newConnectionId1");
   m_indexNewConnectionId_2 = m_particles->registerParameter("newConnectionId2");
   m_indexBroken = m_particles->registerParameter("broken", 0);
@@ -70,7 +72,7 @@ void MohrCoulombNodeSplit::initialize() {}
 void MohrCoulombNodeSplit::evaluateStepOne() {
   const ivec &colToId = m_particles->colToId();
   int nParticles = m_particles->nParticles();
-  mat &data = m_particles->data();
+  ParticleData &data = m_particles->data();
   mat &r = m_particles->r();
   mat &r0 = m_particles->r0();
   mat &v = m_particles->v();
@@ -78,6 +80,10 @@ void MohrCoulombNodeSplit::evaluateStepOne() {
   int newCol = nParticles;
   m_toBeDeleted.clear();
 
+  // The pending bond-break events refer to the current columns and
+  // connection lists, which are changed by the splits
+  m_particles->publishBondBreaks();
+
   for (int i = 0; i < nParticles; i++) {
     const int id_i = colToId(i);
     data(i, m_indexBroken) = 0;
@@ -151,10 +157,9 @@ void MohrCoulombNodeSplit::evaluateStepOne() {
         data(i, m_indexNewConnectionId_2) = id2;
 
         // Setting the new connections for the two particles
-        vector<pair<int, vector<double>>> &PDconnections_i =
-            m_particles->pdConnections(id_i);
-        vector<pair<int, vector<double>>> connectionsVector1;
-        vector<pair<int, vector<double>>> connectionsVector2;
+        BondList &PDconnections_i = m_particles->pdConnections(id_i);
+        BondList connectionsVector1(m_particles->bondLayout());
+        BondList connectionsVector2(m_particles->bondLayout());
 
         double dr_ij[m_dim];
         for (auto &con : PDconnections_i) {
@@ -184,19 +189,33 @@ void MohrCoulombNodeSplit::evaluateStepOne() {
           }
           r_len = sqrt(r_len);
 
-          vector<double> newCon = con.second;
+          BondData newCon = con.second;
           newCon[m_indexDr0] = r_len;
 
+          // The bond of the neighbour goes to the new particle on its side.
+          // The neighbour may itself be a particle split earlier this step.
+          if (j < newCol && colToId(j) == id_j) {
+            for (auto &con_j : m_particles->pdConnections(id_j)) {
+              if (con_j.first != id_i)
+                continue;
+              con_j.first = nId;
+              con_j.second[m_indexDr0] = r_len;
+            }
+            m_particles->markConnectionsChanged(id_j);
+          }
+
           if (nId == id1)
             connectionsVector1.push_back(
-                pair<int, vector<double>>(id_j, newCon));
+                pair<int, BondData>(id_j, newCon));
           else
             connectionsVector2.push_back(
-                pair<int, vector<double>>(id_j, newCon));
+                pair<int, BondData>(id_j, newCon));
         }
 
-        m_particles->setPdConnections(id1, connectionsVector1);
-        m_particles->setPdConnections(id2, connectionsVector2);
+        m_particles->setPdConnections(id1, std::move(connectionsVector1));
+        m_particles->setPdConnections(id2, std::move(connectionsVector2));
+        m_particles->markConnectionsChanged(id1);
+        m_particles->markConnectionsChanged(id2);
         data(col1, m_indexBroken) = 0;
         data(col2, m_indexBroken) = 0;
         data(i, m_indexNormal[0]) = normal[0];
@@ -218,8 +237,7 @@ void MohrCoulombNodeSplit::evaluateStepOne() {
     if (data(i, m_indexBroken) >= 1)
       continue;
 
-    vector<pair<int, vector<double>>> &PDconnections =
-        m_particles->pdConnections(id_i);
+    BondList &PDconnections = m_particles->pdConnections(id_i);
 
     for (auto &con : PDconnections) {
       const int id_j = con.first;
@@ -278,8 +296,7 @@ void MohrCoulombNodeSplit::evaluateStepOne() {
         double center_x = r(j, 0) + 0.5 * radius_j * n_j[0];
         double center_y = r(j, 1) + 0.5 * radius_j * n_j[1];
 
-        vector<pair<int, vector<double>>> &PDconnections2 =
-            m_particles->pdConnections(id_i);
+        BondList &PDconnections2 = m_particles->pdConnections(id_i);
         for (auto &con2 : PDconnections2) {
           if (con2.first == newId)
             continue;
@@ -320,12 +337,11 @@ void MohrCoulombNodeSplit::evaluateStepOne() {
               //                            << y2 << "\nx3 = " << x3 << "\ny3 =
               //                            " << y3 << "\nx4 = " << x4 << "\ny4
               //                            = " << y4 << endl;
-              con2.second[m_indexConnected] = 0;
-              vector<pair<int, vector<double>>> &PDconnections_k =
-                  m_particles->pdConnections(id_k);
+              m_particles->breakBond(id_i, con2);
+              BondList &PDconnections_k = m_particles->pdConnections(id_k);
               for (auto &con_k : PDconnections_k) {
                 if (con_k.first == id_i) {
-                  con_k.second[m_indexConnected] = 0;
+                  m_particles->breakBond(id_k, con_k);
                 }
               }
             }
@@ -344,8 +360,7 @@ void MohrCoulombNodeSplit::evaluateStepOne() {
   //--------------------------------------------------------------------------
   for (int i = 0; i < nParticles; i++) {
     const int id_i = colToId(i);
-    vector<pair<int, vector<double>>> &PDconnections =
-        m_particles->pdConnections(id_i);
+    BondList &PDconnections = m_particles->pdConnections(id_i);
 
     if (data(i, m_indexBroken) >= 1)
       continue;
@@ -366,8 +381,7 @@ void MohrCoulombNodeSplit::evaluateStepOne() {
   nParticles = m_particles->nParticles();
   for (int i = 0; i < nParticles; i++) {
     const int id_i = colToId(i);
-    vector<pair<int, vector<double>>> &PDconnections =
-        m_particles->pdConnections(id_i);
+    BondList &PDconnections = m_particles->pdConnections(id_i);
 
     if (data(i, m_indexBroken) >= 1)
       continue;
@@ -376,8 +390,7 @@ void MohrCoulombNodeSplit::evaluateStepOne() {
       const int id_j = con_i.first;
       const int j = (*m_idToCol).at(id_j);
 
-      vector<pair<int, vector<double>>> &PDconnections_j =
-          m_particles->pdConnections(id_j);
+      BondList &PDconnections_j = m_particles->pdConnections(id_j);
 
       bool found = false;
       for (auto &con_j : PDconnections_j) {
@@ -411,6 +424,8 @@ void MohrCoulombNodeSplit::evaluateStepOne() {
   }
 
   m_particles->totParticles(np);
+  m_particles->buildBondCache();
+  m_particles->publishBondBreaks();
   //    int nDel = m_toBeDeleted.size();
   //    if( nDel > 0)
   //        cout << "Deleted" << endl;
@@ -438,8 +453,7 @@ void MohrCoulombNodeSplit::evaluateStepOne(const int id_i, const int i) {
 //        }
 //    }
 
-  vector<pair<int, vector<double>>> & PDconnections =
-m_particles->pdConnections(id_i);
+  BondList & PDconnections = m_particles->pdConnections(id_i);
 
   for(auto &con:PDconnections)
   {
@@ -454,7 +468,7 @@ m_particles->pdConnections(id_i);
 
       if(broken_i>0)
       {
-          con.second[m_indexConnected] = 0;
+          m_particles->breakBond(id_i, con);
           continue;
       }
 
@@ -516,14 +530,17 @@ m_particles->pdConnections(id_i);
 }
 //------------------------------------------------------------------------------
 void MohrCoulombNodeSplit::copyParticleTo(int id_to, int old_col, int new_col) {
+  m_particles->ensureCapacity(new_col + 1);
+  m_particles->ensureIdCapacity(id_to);
+
   ivec &colToId = m_particles->colToId();
-  ivec &idToCol = m_particles->getIdToCol_v();
+  IdToColMap &idToCol = m_particles->getIdToCol_v();
   mat &r = m_particles->r();
   mat &r0 = m_particles->r0();
   mat &v = m_particles->v();
   mat &F = m_particles->F();
   ivec &isStatic = m_particles->isStatic();
-  mat &data = m_particles->data();
+  ParticleData &data = m_particles->data();
   const unordered_map<string, int> &parameters = m_particles->parameters();
   idToCol[id_to] = new_col;
   colToId[new_col] = id_to;
@@ -542,12 +559,12 @@ void MohrCoulombNodeSplit::copyParticleTo(int id_to, int old_col, int new_col) {
   }
   for (auto &param : parameters) {
     const int p = param.second;
-    data(new_col, p) = data(old_col, p);
+    data.setValue(new_col, p, data.value(old_col, p));
   }
   isStatic(new_col) = isStatic(old_col);
   /*
   const int nPdConnections = recieveData[j++];
-  vector<pair<int, vector<double>>> connectionsVector;
+  BondList connectionsVector;
 
   for(int i=0;i<nPdConnections; i++)
   {
@@ -559,7 +576,7 @@ void MohrCoulombNodeSplit::copyParticleTo(int id_to, int old_col, int new_col) {
           connectionData.push_back(recieveData[j++]);
       }
 
-      connectionsVector.push_back(pair<int, vector<double>>(con_id,
+      connectionsVector.push_back(pair<int, BondData>(con_id,
   connectionData));
   }
   // Verlet lists
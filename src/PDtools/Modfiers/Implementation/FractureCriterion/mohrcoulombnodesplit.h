@@ -23,8 +23,8 @@ private:
   double m_phi;
   double m_weight1;
   double m_weight2;
-  arma::mat *m_data;
-  ivec *m_idToCol;
+  ParticleData *m_data;
+  const IdToColMap *m_idToCol;
 
   int m_indexStress[6];
   int m_indexUnbreakable;
@@ -22,7 +22,8 @@ MohrCoulombWeightedAverage::MohrCoulombWeightedAverage(double mu, double C,
 void MohrCoulombWeightedAverage::registerParticleParameters() {
   m_data = &m_particles->data();
   m_indexUnbreakable = m_particles->registerParameter("unbreakable");
-  m_indexConnected = m_particles->registerPdParameter("connected");
+  m_indexConnected = m_particles->registerPdParameter("connected", 0,
+                                                      BondData::Flag);
   m_idToCol = &m_particles->getIdToCol_v();
 
   switch (m_dim) {
@@ -57,10 +58,9 @@ void MohrCoulombWeightedAverage::evaluateStepOne(const int id_i, const int i) {
 
   if ((*m_data)(i, m_indexUnbreakable) >= 1)
     return;
-  const mat &data = *m_data;
+  const ParticleData &data = *m_data;
 
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles->pdConnections(id_i);
+  BondList &PDconnections = m_particles->pdConnections(id_i);
   double cos_theta = cos(M_PI / 2. + m_phi);
   double sin_theta = sin(M_PI / 2. + m_phi);
   double tan_theta = tan(0.5 * (M_PI + m_phi));
@@ -72,15 +72,13 @@ void MohrCoulombWeightedAverage::evaluateStepOne(const int id_i, const int i) {
     const double sxy_i = data(i, m_indexStress[2]);
     const double tr1 = fabs(sx_i) + fabs(sy_i);
 
-    for (auto &con : PDconnections) {
+    m_particles->forEachConnectedBond(i, [&](const int l_j) {
+      auto &con = PDconnections[l_j];
       const int id_j = con.first;
       const int j = (*m_idToCol)[id_j];
 
       if ((*m_data)(j, m_indexUnbreakable) >= 1)
-        continue;
-
-      if (con.second[m_indexConnected] <= 0.5)
-        continue;
+        return;
 
       const double sx_j = data(j, m_indexStress[0]);
       const double sy_j = data(j, m_indexStress[1]);
@@ -107,11 +105,11 @@ void MohrCoulombWeightedAverage::evaluateStepOne(const int id_i, const int i) {
       const double normal = 0.5 * (p_1 + p_2) + 0.5 * (p_1 - p_2) * cos_theta;
 
       if (shear >= fabs(m_C - m_d * normal) && normal < 0) {
-        con.second[m_indexConnected] = 0;
+        m_particles->breakBond(id_i, con);
       } else if (p_2 >= m_T && normal > 0) {
-        con.second[m_indexConnected] = 0;
+        m_particles->breakBond(id_i, con);
       }
-    }
+    });
   }
 }
 //------------------------------------------------------------------------------
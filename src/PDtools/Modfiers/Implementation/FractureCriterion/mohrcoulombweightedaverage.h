@@ -18,8 +18,8 @@ private:
   double m_T;
   double m_d;
   double m_phi;
-  arma::mat *m_data;
-  ivec *m_idToCol;
+  ParticleData *m_data;
+  const IdToColMap *m_idToCol;
   double m_weights[2];
 
   int m_indexStress[6];
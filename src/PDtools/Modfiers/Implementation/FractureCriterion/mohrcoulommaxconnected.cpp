@@ -8,7 +8,8 @@ MohrCoulomMaxConnected::MohrCoulomMaxConnected(double mu, double C, double T)
   m_phi = mu * M_PI / 180.;
 
   m_d = tan(m_phi);
-  m_neededProperties = {pair<string, int>("stress", 1)};
+  m_neededProperties = {pair<string, int>("stress", 1),
+                        pair<string, int>("principalStress", 1)};
 
   m_hasStepOne = true;
   m_hasStepTwo = true;
@@ -17,8 +18,10 @@ MohrCoulomMaxConnected::MohrCoulomMaxConnected(double mu, double C, double T)
 void MohrCoulomMaxConnected::registerParticleParameters() {
   m_data = &m_particles->data();
   m_indexUnbreakable = m_particles->registerParameter("unbreakable");
-  m_indexConnected = m_particles->registerPdParameter("connected");
-  m_indexCompute = m_particles->registerPdParameter("compute");
+  m_indexConnected = m_particles->registerPdParameter("connected", 0,
+                                                      BondData::Flag);
+  m_indexCompute = m_particles->registerPdParameter("compute", 0,
+                                                    BondData::Flag);
   m_indexBroken = m_particles->registerParameter("broken", 0);
   m_indexBrokenId = m_particles->registerParameter("brokendId", 0);
   m_indexBrokenNow = m_particles->registerParameter("brokenNow", 0);
@@ -52,16 +55,18 @@ void MohrCoulomMaxConnected::registerParticleParameters() {
     break;
   }
   m_ghostParameters.push_back("brokendId");
+  m_ghostParameters.push_back("s_max");
+  m_indexStressMax = m_particles->registerParameter("s_max");
+  m_indexStressMin = m_particles->registerParameter("s_min");
 }
 //------------------------------------------------------------------------------
 void MohrCoulomMaxConnected::initialize() {
-  m_broken = false;
   m_cosTheta = cos(M_PI / 2. + m_phi);
   m_sinTheta = sin(M_PI / 2. + m_phi);
 }
 //------------------------------------------------------------------------------
 void MohrCoulomMaxConnected::evaluateStepOne(const int id_i, const int i) {
-  mat &data = *m_data;
+  ParticleData &data = *m_data;
   const mat &r = m_particles->r();
 
   if (data(i, m_indexUnbreakable) >= 1)
@@ -78,18 +83,15 @@ void MohrCoulomMaxConnected::evaluateStepOne(const int id_i, const int i) {
     }
   }
 
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles->pdConnections(id_i);
+  BondList &PDconnections = m_particles->pdConnections(id_i);
 
-  for (auto &con : PDconnections) {
+  m_particles->forEachConnectedBond(i, [&](const int l_j) {
+    auto &con = PDconnections[l_j];
     const int id_j = con.first;
     const int j = (*m_idToCol)[id_j];
 
     if (data(j, m_indexUnbreakable) >= 1)
-      continue;
-
-    if (con.second[m_indexConnected] <= 0.5)
-      continue;
+      return;
 
     if (broken_i) {
 
@@ -100,16 +102,16 @@ void MohrCoulomMaxConnected::evaluateStepOne(const int id_i, const int i) {
       }
 
       if (dotproduct > 0) {
-        con.second[m_indexConnected] = 0;
+        m_particles->breakBond(id_i, con);
         data(i, m_indexBrokenNow) = 1;
       }
       const int bId = data(i, m_indexBrokenId);
       if (bId == id_j) {
-        con.second[m_indexConnected] = 0;
+        m_particles->breakBond(id_i, con);
         data(i, m_indexBrokenNow) = 1;
       }
 
-      continue;
+      return;
     }
 
     const int broken_j = data(j, m_indexBroken);
@@ -117,7 +119,7 @@ void MohrCoulomMaxConnected::evaluateStepOne(const int id_i, const int i) {
       const int bId = data(i, m_indexBrokenId);
 
       if (bId == id_i) {
-        con.second[m_indexConnected] = 0;
+        m_particles->breakBond(id_i, con);
         data(i, m_indexBrokenNow) = 1;
       }
 
@@ -129,7 +131,7 @@ void MohrCoulomMaxConnected::evaluateStepOne(const int id_i, const int i) {
       }
 
       if (dotproduct > 0) {
-        con.second[m_indexConnected] = 0;
+        m_particles->breakBond(id_i, con);
         data(i, m_indexBrokenNow) = 1;
       }
 
@@ -151,8 +153,7 @@ void MohrCoulomMaxConnected::evaluateStepOne(const int id_i, const int i) {
       const double center_y = r(j, 1) + 0.5 * n_j[1];
       const double r2 = (x2 - x1) * (x2 - x1) + (y2 - y1) * (y2 - y1);
 
-      vector<pair<int, vector<double>>> &PDconnections2 =
-          m_particles->pdConnections(id_i);
+      BondList &PDconnections2 = m_particles->pdConnections(id_i);
       for (auto &con2 : PDconnections2) {
         if (con2.first == id_j) {
           continue;
@@ -183,40 +184,30 @@ void MohrCoulomMaxConnected::evaluateStepOne(const int id_i, const int i) {
           double dotproduct = (px - r(i, 0)) * (px - r(k, 0));
           dotproduct += (py - r(i, 1)) * (py - r(k, 1));
           if (dotproduct < 0) {
-            con2.second[m_indexConnected] = 0;
-            vector<pair<int, vector<double>>> &PDconnections_k =
-                m_particles->pdConnections(id_k);
-            for (auto &con_k : PDconnections_k) {
-              if (con_k.first == id_i) {
-                con_k.second[m_indexConnected] = 0;
-                data(i, m_indexBrokenNow) = 1;
-              }
-            }
+            m_particles->breakBond(id_i, con2);
+            requestBondBreak(id_k, id_i);
           }
         }
       }
     }
-  }
+  });
+}
+//------------------------------------------------------------------------------
+void MohrCoulomMaxConnected::evaluateStepOnePost() {
+  // The bonds of the neighbours are broken here, outside the particle loop
+  applyBondBreakRequests(m_indexBrokenNow);
 }
 //------------------------------------------------------------------------------
 void MohrCoulomMaxConnected::evaluateStepTwo(const int id_i, const int i) {
   (void)id_i;
   if ((*m_data)(i, m_indexUnbreakable) >= 1)
     return;
-  mat &data = *m_data;
+  ParticleData &data = *m_data;
   const mat &r = m_particles->r();
 
   if (m_dim == 2) {
-    double sx, sy, sxy;
-    sx = data(i, m_indexStress[0]);
-    sy = data(i, m_indexStress[1]);
-    sxy = data(i, m_indexStress[2]);
-
-    const double first = 0.5 * (sx + sy);
-    const double second = sqrt(0.25 * (sx - sy) * (sx - sy) + sxy * sxy);
-
-    const double p_2 = first + second; // max
-    const double p_1 = first - second; // min
+    const double p_2 = data(i, m_indexStressMax);
+    const double p_1 = data(i, m_indexStressMin);
 
     const double shear = 0.5 * (p_1 - p_2) * m_sinTheta;
     const double normal = 0.5 * (p_1 + p_2) + 0.5 * (p_1 - p_2) * m_cosTheta;
@@ -225,11 +216,9 @@ void MohrCoulomMaxConnected::evaluateStepTwo(const int id_i, const int i) {
 
     if (fabs(shear) >= fabs(m_C - m_d * normal) && normal <= 0) {
       data(i, m_indexBroken) = 2;
-      m_broken = true;
       broken = 2;
     } else if (p_2 >= m_T && normal > 0) {
       data(i, m_indexBroken) = 1;
-      m_broken = true;
       broken = 1;
     } else {
       data(i, m_indexBroken) = 0;
@@ -237,30 +226,19 @@ void MohrCoulomMaxConnected::evaluateStepTwo(const int id_i, const int i) {
 
     double closest = std::numeric_limits<double>::max();
     if (broken > 0) {
-      vector<pair<int, vector<double>>> &PDconnections =
-          m_particles->pdConnections(id_i);
+      BondList &PDconnections = m_particles->pdConnections(id_i);
       int indexMax = -1;
       int colMax = -1;
 
-      for (auto &con : PDconnections) {
+      m_particles->forEachConnectedBond(i, [&](const int l_j) {
+        auto &con = PDconnections[l_j];
         const int id_j = con.first;
         const int j = (*m_idToCol)[id_j];
 
         if (data(j, m_indexUnbreakable) >= 1)
-          continue;
-
-        if (con.second[m_indexConnected] <= 0.5)
-          continue;
+          return;
 
-        sx = data(j, m_indexStress[0]);
-        sy = data(j, m_indexStress[1]);
-        sxy = data(j, m_indexStress[2]);
-
-        const double first_j = 0.5 * (sx + sy);
-        const double second_j = sqrt(0.25 * (sx - sy) * (sx - sy) + sxy * sxy);
-
-        const double pj_2 = first_j + second_j; // max
-        const double pj_1 = first_j - second_j; // min
+        const double pj_2 = data(j, m_indexStressMax);
 
         //                const double shear_j = 0.5*(pj_1 - pj_2)*m_sinTheta;
         //                const double normal_j = 0.5*(pj_1 + pj_2) + 0.5*(pj_1
@@ -274,7 +252,7 @@ void MohrCoulomMaxConnected::evaluateStepTwo(const int id_i, const int i) {
             colMax = j;
           }
         }
-      }
+      });
 
       //            if(indexMax == -1)
       //                continue;
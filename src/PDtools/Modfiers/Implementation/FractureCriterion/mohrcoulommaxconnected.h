@@ -11,6 +11,7 @@ public:
   virtual void registerParticleParameters();
   virtual void initialize();
   virtual void evaluateStepOne(const int id_i, const int i);
+  virtual void evaluateStepOnePost();
   virtual void evaluateStepTwo(const int id_i, const int i);
 
 private:
@@ -18,16 +19,17 @@ private:
   double m_T;
   double m_d;
   double m_phi;
-  arma::mat *m_data;
-  ivec *m_idToCol;
+  ParticleData *m_data;
+  const IdToColMap *m_idToCol;
 
   int m_indexStress[6];
   int m_indexNormal[3];
   int m_indexUnbreakable;
+  int m_indexStressMax;
+  int m_indexStressMin;
   int m_indexConnected;
   int m_indexCompute;
   int m_indexBrokenNow;
-  bool m_broken;
   int m_indexBroken;
   int m_indexBrokenId;
   double m_cosTheta;
@@ -15,16 +15,14 @@ void PmbFracture::registerParticleParameters() {
   m_indexS_tmp = m_particles->registerParameter("s_tmp");
   m_indexUnbreakable = m_particles->registerParameter("unbreakable");
   m_indexStretch = m_particles->getPdParamId("stretch");
-  m_indexS00 = m_particles->registerPdParameter("s00");
-  m_indexConnected = m_particles->registerPdParameter("connected");
+  m_indexS00 = m_particles->registerPdParameter("s00", 0, BondData::Float);
+  m_indexConnected = m_particles->registerPdParameter("connected", 0,
+                                                      BondData::Flag);
   m_indexBrokenNow = m_particles->registerParameter("brokenNow", 0);
   m_data = &m_particles->data();
   m_initialGhostParameters = {"s0"};
   m_ghostParameters = {"s0"};
   m_idToCol = &m_particles->getIdToCol_v();
-
-  m_broken = m_particles->data().colptr(m_indexBrokenNow);
-  m_s_tmp = m_particles->data().colptr(m_indexS_tmp);
 }
 //------------------------------------------------------------------------------
 void PmbFracture::initialize() {
@@ -35,8 +33,7 @@ void PmbFracture::initialize() {
     const int id_i = colToId(i);
     const double s0_i = (*m_data)(i, m_indexS0);
 
-    vector<pair<int, vector<double>>> &PDconnections =
-        m_particles->pdConnections(id_i);
+    BondList &PDconnections = m_particles->pdConnections(id_i);
     for (auto &con : PDconnections) {
       const int id_j = con.first;
       const int col_j = (*m_idToCol)[id_j];
@@ -52,19 +49,16 @@ void PmbFracture::evaluateStepOne(const int id_i, const int i) {
     return;
 
   const double s0_i = (*m_data)(i, m_indexS0);
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles->pdConnections(id_i);
+  BondList &PDconnections = m_particles->pdConnections(id_i);
   double s0_new = std::numeric_limits<double>::min();
 
-  for (auto &con : PDconnections) {
+  m_particles->forEachConnectedBond(i, [&](const int l_j) {
+    auto &con = PDconnections[l_j];
     const int id_j = con.first;
     const int j = (*m_idToCol)[id_j];
 
     if ((*m_data)(j, m_indexUnbreakable) >= 1)
-      continue;
-
-    if (con.second[m_indexConnected] <= 0.5)
-      continue;
+      return;
 
     //        const double stretch = con.second[m_indexStretch];
     const double stretch = con.second[m_indexStretch];
@@ -73,19 +67,17 @@ void PmbFracture::evaluateStepOne(const int id_i, const int i) {
     const double s0 = std::min(s0_i, s0_j);
 
     if (stretch > s0) {
-      con.second[m_indexConnected] = 0;
-      m_broken[i] = 1;
+      m_particles->breakBond(id_i, con);
+      (*m_data)(i, m_indexBrokenNow) = 1;
       //             cout << "broken:" << id_i << " " << id_j << " s:" <<
       //             stretch
       //                  << " s0_i:" << s0_i  << " s0_j:" << s0_i << endl;
-      //             (*m_data)(i, m_indexBrokenNow) = 1;
     }
 
     double s0_tmp = s00 - m_alpha * stretch;
     s0_new = std::max(s0_new, s0_tmp);
-  }
-  m_s_tmp[i] = s0_new;
-  //    (*m_data)(i, m_indexS_tmp) = s0_new;
+  });
+  (*m_data)(i, m_indexS_tmp) = s0_new;
 }
 //------------------------------------------------------------------------------
 void PmbFracture::updateStepOne(const int id_i, const int i) {
@@ -24,10 +24,8 @@ private:
   int m_indexS_tmp;
   int m_indexBrokenNow;
   double m_s00;
-  arma::mat *m_data;
-  double *m_broken;
-  double *m_s_tmp;
-  ivec *m_idToCol;
+  ParticleData *m_data;
+  const IdToColMap *m_idToCol;
 };
 //------------------------------------------------------------------------------
 }
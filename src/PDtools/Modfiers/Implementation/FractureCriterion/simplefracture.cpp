@@ -28,18 +28,15 @@ void SimpleFracture::evaluateStepOne(const int id_i, const int i) {
   const double vol_i = (*m_data)(i, m_indexVolume);
   const double c_i = (*m_data)(i, m_indexMicromodulus);
 
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles->pdConnections(id_i);
+  BondList &PDconnections = m_particles->pdConnections(id_i);
 
-  for (auto &con : PDconnections) {
+  m_particles->forEachConnectedBond(i, [&](const int l_j) {
+    auto &con = PDconnections[l_j];
     const int id_j = con.first;
     const int j = (*m_idToCol)[id_j];
 
     if ((*m_data)(j, m_indexUnbreakable) >= 1)
-      continue;
-
-    if (con.second[m_indexConnected] <= 0.5)
-      continue;
+      return;
 
     const double c_j = (*m_data)(j, m_indexMicromodulus);
     const double g_ij = con.second[m_indexForceScaling];
@@ -52,11 +49,11 @@ void SimpleFracture::evaluateStepOne(const int id_i, const int i) {
     const double sc = sqrt(m_alpha / (c_ij * dr0 * vol));
 
     if (s > sc) {
-      con.second[m_indexConnected] = 0;
+      m_particles->breakBond(id_i, con);
       (*m_data)(i, m_indexBrokenNow) = 1;
       m_broken = true;
     }
-  }
+  });
 }
 //------------------------------------------------------------------------------
 void SimpleFracture::evaluateStepTwo() {
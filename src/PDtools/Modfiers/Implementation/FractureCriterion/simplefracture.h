@@ -24,8 +24,8 @@ private:
   int m_indexMicromodulus;
   int m_indexBrokenNow;
   bool m_broken;
-  arma::mat *m_data;
-  ivec *m_idToCol;
+  ParticleData *m_data;
+  const IdToColMap *m_idToCol;
 };
 //------------------------------------------------------------------------------
 }
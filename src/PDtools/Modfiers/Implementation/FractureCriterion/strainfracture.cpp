@@ -12,8 +12,10 @@ StrainFracture::StrainFracture(double Eeq, double Evol, int dim)
 void StrainFracture::registerParticleParameters() {
   m_data = &m_particles->data();
   m_indexUnbreakable = m_particles->registerParameter("unbreakable");
-  m_indexConnected = m_particles->registerPdParameter("connected");
-  m_indexCompute = m_particles->registerPdParameter("compute");
+  m_indexConnected = m_particles->registerPdParameter("connected", 0,
+                                                      BondData::Flag);
+  m_indexCompute = m_particles->registerPdParameter("compute", 0,
+                                                    BondData::Flag);
   m_indexBrokenNow = m_particles->registerParameter("brokenNow", 0);
   m_particles->registerParameter("damage");
   m_idToCol = &m_particles->getIdToCol_v();
@@ -44,21 +46,18 @@ void StrainFracture::registerParticleParameters() {
 void StrainFracture::evaluateStepOne(const int id_i, const int i) {
   if ((*m_data)(i, m_indexUnbreakable) >= 1)
     return;
-  mat &data = *m_data;
+  ParticleData &data = *m_data;
 
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles->pdConnections(id_i);
+  BondList &PDconnections = m_particles->pdConnections(id_i);
 
   if (m_dim == 2) {
-    for (auto &con : PDconnections) {
+    m_particles->forEachConnectedBond(i, [&](const int l_j) {
+      auto &con = PDconnections[l_j];
       const int id_j = con.first;
       const int j = (*m_idToCol)[id_j];
 
       if ((*m_data)(j, m_indexUnbreakable) >= 1)
-        continue;
-
-      if (con.second[m_indexConnected] <= 0.5)
-        continue;
+        return;
 
       const double ex =
           0.5 * (data(i, m_indexStrain[0]) + data(j, m_indexStrain[0]));
@@ -72,13 +71,13 @@ void StrainFracture::evaluateStepOne(const int id_i, const int i) {
       const double Evol = ex + ey + ex * ey;
 
       if (Eeq >= m_Eeq) {
-        con.second[m_indexConnected] = 0;
+        m_particles->breakBond(id_i, con);
         data(i, m_indexBrokenNow) = 1;
       } else if (Evol >= m_Evol) {
-        con.second[m_indexConnected] = 0;
+        m_particles->breakBond(id_i, con);
         data(i, m_indexBrokenNow) = 1;
       }
-    }
+    });
   } else if (m_dim == 3) {
   }
 }
@@ -18,8 +18,8 @@ protected:
   double m_Eeq;
   double m_Evol;
   int m_dim;
-  arma::mat *m_data;
-  ivec *m_idToCol;
+  ParticleData *m_data;
+  const IdToColMap *m_idToCol;
 
   int m_indexUnbreakable;
   int m_indexConnected;
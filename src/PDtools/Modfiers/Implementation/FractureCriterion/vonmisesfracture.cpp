@@ -5,76 +5,49 @@ namespace PDtools {
 //------------------------------------------------------------------------------
 VonMisesFracture::VonMisesFracture(double sigma_y)
     : m_sigma_y(sigma_y), m_sigma_y2(sigma_y * sigma_y) {
-  m_hasStepOne = true;
   m_hasStepTwo = true;
+  m_neededProperties.push_back(pair<string, int>("principalStress", 1));
 }
 //------------------------------------------------------------------------------
 void VonMisesFracture::registerParticleParameters() {
-  m_data = &m_particles->data();
-  m_indexUnbreakable = m_particles->registerParameter("unbreakable");
-  m_indexConnected = m_particles->registerPdParameter("connected");
-  m_indexCompute = m_particles->registerPdParameter("compute");
-  m_indexBrokenNow = m_particles->registerParameter("brokenNow", 0);
+  BondFractureCriterion::registerParticleParameters();
+  m_indexCompute = m_particles->registerPdParameter("compute", 0,
+                                                    BondData::Flag);
   m_particles->registerParameter("damage");
-  m_idToCol = &m_particles->getIdToCol_v();
-
-  switch (m_dim) {
-  case 1:
-    m_ghostParameters = {"s_xx"};
-    m_indexStress[0] = m_particles->registerParameter("s_xx");
-    break;
-  case 2:
-    m_ghostParameters = {"s_xx", "s_yy", "s_xy"};
-    m_indexStress[0] = m_particles->registerParameter("s_xx");
-    m_indexStress[1] = m_particles->registerParameter("s_yy");
-    m_indexStress[2] = m_particles->registerParameter("s_xy");
-    break;
-  case 3:
-    m_ghostParameters = {"s_xx", "s_yy", "s_zz", "s_xy", "s_xz", "s_yz"};
-    m_indexStress[0] = m_particles->registerParameter("s_xx");
-    m_indexStress[1] = m_particles->registerParameter("s_yy");
-    m_indexStress[2] = m_particles->registerParameter("s_xy");
-    m_indexStress[3] = m_particles->registerParameter("s_zz");
-    m_indexStress[4] = m_particles->registerParameter("s_xz");
-    m_indexStress[5] = m_particles->registerParameter("s_yz");
-    break;
-  }
+  m_indexVonMises = m_particles->registerParameter("s_vm");
+  m_ghostParameters.push_back("s_vm");
 }
 //------------------------------------------------------------------------------
-void VonMisesFracture::evaluateStepOne(const int id_i, const int i) {
-  if ((*m_data)(i, m_indexUnbreakable) >= 1)
-    return;
-  mat &data = *m_data;
-
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles->pdConnections(id_i);
+bool VonMisesFracture::mayBreak(const int i, const int j) {
+  // The von Mises stress is a seminorm of the stress, by the triangle
+  // inequality the bond stress is bounded by the mean of the particles'.
+  const ParticleData &data = *m_data;
+  const double bound =
+      0.5 * (data(i, m_indexVonMises) + data(j, m_indexVonMises));
+  return bound + 1e-10 * bound >= m_sigma_y;
+}
+//------------------------------------------------------------------------------
+bool VonMisesFracture::evaluateBond(const int i, const int j,
+                                    const BondStress &bondStress) {
+  (void)i;
+  (void)j;
+  double s;
 
   if (m_dim == 2) {
-    for (auto &con : PDconnections) {
-      const int id_j = con.first;
-      const int j = (*m_idToCol)[id_j];
-
-      if ((*m_data)(j, m_indexUnbreakable) >= 1)
-        continue;
-
-      if (con.second[m_indexConnected] <= 0.5)
-        continue;
-
-      const double sx =
-          0.5 * (data(i, m_indexStress[0]) + data(j, m_indexStress[0]));
-      const double sy =
-          0.5 * (data(i, m_indexStress[1]) + data(j, m_indexStress[1]));
-      const double sxy =
-          0.5 * (data(i, m_indexStress[2]) + data(j, m_indexStress[2]));
-
-      const double s = sx * sx - sx * sy + sy * sy + 3 * sxy * sxy;
-
-      if (s >= m_sigma_y2) {
-        con.second[m_indexConnected] = 0;
-        data(i, m_indexBrokenNow) = 1;
-      }
-    }
+    const double sx = bondStress.s[0];
+    const double sy = bondStress.s[1];
+    const double sxy = bondStress.s[2];
+    s = sx * sx - sx * sy + sy * sy + 3 * sxy * sxy;
+  } else if (m_dim == 3) {
+    const double d12 = bondStress.p_max - bondStress.p_mid;
+    const double d23 = bondStress.p_mid - bondStress.p_min;
+    const double d31 = bondStress.p_min - bondStress.p_max;
+    s = 0.5 * (d12 * d12 + d23 * d23 + d31 * d31);
+  } else {
+    return false;
   }
+
+  return s >= m_sigma_y2;
 }
 //------------------------------------------------------------------------------
 }
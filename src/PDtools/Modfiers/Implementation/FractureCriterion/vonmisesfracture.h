@@ -1,30 +1,25 @@
 #ifndef VONMISESFRACTURE_H
 #define VONMISESFRACTURE_H
 
-#include "PDtools/Modfiers/modifier.h"
+#include "bondfracturecriterion.h"
 
 //------------------------------------------------------------------------------
 namespace PDtools {
 //------------------------------------------------------------------------------
-class VonMisesFracture : public Modifier {
+class VonMisesFracture : public BondFractureCriterion {
 public:
   VonMisesFracture(double sigma_y);
 
   virtual void registerParticleParameters();
-
-  virtual void evaluateStepOne(const int id_i, const int i);
+  virtual bool evaluateBond(const int i, const int j,
+                            const BondStress &bondStress);
+  virtual bool mayBreak(const int i, const int j);
 
 protected:
   double m_sigma_y;
   double m_sigma_y2;
-  arma::mat *m_data;
-  ivec *m_idToCol;
-
-  int m_indexUnbreakable;
-  int m_indexConnected;
   int m_indexCompute;
-  int m_indexBrokenNow;
-  int m_indexStress[6];
+  int m_indexVonMises;
 };
 //------------------------------------------------------------------------------
 }
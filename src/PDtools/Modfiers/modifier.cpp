@@ -1,5 +1,19 @@
 #include "modifier.h"
 
+#include "PDtools/Grid/grid.h"
+#include "PDtools/Particles/pd_particles.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cxxabi.h>
+#include <typeinfo>
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif
+#if USE_MPI
+#include <mpi.h>
+#endif
+
 namespace PDtools {
 //------------------------------------------------------------------------------
 std::vector<pair<string, int>> Modifier::neededProperties() const {
@@ -50,7 +64,142 @@ void Modifier::evaluateStepTwo() {}
 void Modifier::staticEvaluation() { return; }
 //------------------------------------------------------------------------------
 void Modifier::initialize() { return; }
+//------------------------------------------------------------------------------
+void Modifier::setDt(double dt) { (void)dt; }
+//------------------------------------------------------------------------------
+string Modifier::name() const {
+  // The class name, without the namespace
+  const char *mangled = typeid(*this).name();
+  int status = 0;
+  char *demangled = abi::__cxa_demangle(mangled, nullptr, nullptr, &status);
+  string name = (status == 0) ? demangled : mangled;
+  free(demangled);
+
+  const size_t scope = name.rfind("::");
+  if (scope != string::npos)
+    name = name.substr(scope + 2);
+  return name;
+}
+//------------------------------------------------------------------------------
+int Modifier::nThreads() {
+#ifdef USE_OPENMP
+  return omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
+//------------------------------------------------------------------------------
+int Modifier::threadId() {
+#ifdef USE_OPENMP
+  return omp_get_thread_num();
+#else
+  return 0;
+#endif
+}
+//------------------------------------------------------------------------------
+void Modifier::requestBondBreak(const int id_i, const int id_j) {
+  // Breaking a bond in the connection list of another particle is not safe
+  // in a parallel particle loop, the break is instead requested and applied
+  // in applyBondBreakRequests().
+#ifdef USE_OPENMP
+#pragma omp critical(modifierBondBreakRequest)
+#endif
+  m_bondBreakRequests.push_back(pair<int, int>(id_i, id_j));
+}
+//------------------------------------------------------------------------------
+int Modifier::applyBondBreakRequests(const int indexBrokenNow) {
+  // Must be called on all ranks, the requests for ghost particles are sent
+  // to their owners. The requests are applied in a sorted order, the result
+  // is independent of the threads that made them.
+  const IdToColMap &idToCol = m_particles->getIdToCol_v();
+  const ivec &colToId = m_particles->colToId();
+  const int nParticles = m_particles->nParticles();
+#if USE_MPI
+  // The owner of a ghost is the owner of the ghost grid point it was placed
+  // in. Requests whose owner id is neither local nor a ghost are dropped.
+  const vector<int> &neighbouringCores = m_grid->neighbouringCores();
+  const int nLocalAndGhosts = nParticles + m_particles->nGhostParticles();
+  const mat &r = m_particles->r();
+  map<int, vector<int>> sendData;
+  vector<pair<int, int>> localRequests;
+
+  for (const auto &request : m_bondBreakRequests) {
+    const int id_i = request.first;
+    const int i = idToCol[id_i];
+    if (i < 0 || i >= nLocalAndGhosts || colToId(i) != id_i)
+      continue;
+
+    if (i < nParticles) {
+      localRequests.push_back(request);
+      continue;
+    }
+
+    double r_i[M_DIM];
+    for (int d = 0; d < M_DIM; d++) {
+      r_i[d] = r(i, d);
+    }
+    const int owner = m_grid->belongsTo(m_grid->gridId(r_i));
+    if (std::find(neighbouringCores.begin(), neighbouringCores.end(),
+                  owner) == neighbouringCores.end())
+      continue;
 
+    vector<int> &toOwner = sendData[owner];
+    toOwner.push_back(id_i);
+    toOwner.push_back(request.second);
+  }
+
+  int myRank;
+  MPI_Comm_rank(MPI_COMM_WORLD, &myRank);
+  for (const int toCore : neighbouringCores) {
+    const vector<int> &toCoreData = sendData[toCore];
+    int nSendElements = toCoreData.size();
+    int nRecieveElements;
+    MPI_Status status;
+
+    MPI_Sendrecv(&nSendElements, 1, MPI_INT, toCore, myRank, &nRecieveElements,
+                 1, MPI_INT, toCore, toCore, MPI_COMM_WORLD, &status);
+
+    vector<int> recieveData(nRecieveElements);
+    MPI_Sendrecv(toCoreData.data(), nSendElements, MPI_INT, toCore, 1,
+                 recieveData.data(), nRecieveElements, MPI_INT, toCore, 1,
+                 MPI_COMM_WORLD, &status);
+
+    for (int k = 0; k + 1 < nRecieveElements; k += 2) {
+      localRequests.push_back(
+          pair<int, int>(recieveData[k], recieveData[k + 1]));
+    }
+  }
+  m_bondBreakRequests.swap(localRequests);
+#endif
+  std::sort(m_bondBreakRequests.begin(), m_bondBreakRequests.end());
+  m_bondBreakRequests.erase(
+      std::unique(m_bondBreakRequests.begin(), m_bondBreakRequests.end()),
+      m_bondBreakRequests.end());
+
+  ParticleData &data = m_particles->data();
+  int nBroken = 0;
+
+  for (const auto &request : m_bondBreakRequests) {
+    const int id_i = request.first;
+    const int i = idToCol[id_i];
+    if (i < 0 || i >= nParticles || colToId(i) != id_i)
+      continue;
+
+    for (auto &con : m_particles->pdConnections(id_i)) {
+      // Requested by both ends, or broken by the owner in the same step
+      if (con.first != request.second || !m_particles->breakBond(id_i, con))
+        continue;
+
+      if (indexBrokenNow >= 0)
+        data(i, indexBrokenNow) = 1;
+      nBroken++;
+    }
+  }
+  m_bondBreakRequests.clear();
+
+  return nBroken;
+}
+//------------------------------------------------------------------------------
 void Modifier::setParticles(PD_Particles &particles) {
   m_particles = &particles;
 }
@@ -85,4 +234,8 @@ bool Modifier::removeFromList(const int id) {
   return found;
 }
 //------------------------------------------------------------------------------
+const vector<int> &Modifier::localParticleIds() const {
+  return m_localParticleIds;
+}
+//------------------------------------------------------------------------------
 }
@@ -5,6 +5,9 @@
 
 namespace PDtools {
 class PD_Particles;
+class ParticleData;
+class BondData;
+class IdToColMap;
 class Grid;
 
 //------------------------------------------------------------------------------
@@ -26,6 +29,14 @@ protected:
   bool m_hasUpdateOne = false;
   bool m_hasStepTwo = false;
 
+  // Bonds (owner id, neighbour id) to break after a parallel particle loop
+  vector<pair<int, int>> m_bondBreakRequests;
+
+  static int nThreads();
+  static int threadId();
+  void requestBondBreak(const int id_i, const int id_j);
+  int applyBondBreakRequests(const int indexBrokenNow = -1);
+
 public:
   Modifier();
   virtual ~Modifier();
@@ -39,6 +50,8 @@ public:
   virtual void evaluateStepTwo();
   virtual void staticEvaluation();
   virtual void initialize();
+  virtual void setDt(double dt);
+  virtual string name() const;
   void setParticles(PD_Particles &particles);
   bool state();
 
@@ -50,6 +63,8 @@ public:
 
   bool removeFromList(const int id);
 
+  const vector<int> &localParticleIds() const;
+
   std::vector<std::pair<std::string, int>> neededProperties() const;
   int dim() const;
   void setDim(int dim);
@@ -18,6 +18,7 @@
 #include <PDtools/Modfiers/Implementation/FractureCriterion/adrmohrcoulombbondfracture.h>
 #include <PDtools/Modfiers/Implementation/FractureCriterion/adrmohrcoulombfracture.h>
 #include <PDtools/Modfiers/Implementation/FractureCriterion/bondenergyfracture.h>
+#include <PDtools/Modfiers/Implementation/FractureCriterion/bondfracturecriterion.h>
 #include <PDtools/Modfiers/Implementation/FractureCriterion/mohrcoulombbondfracture.h>
 #include <PDtools/Modfiers/Implementation/FractureCriterion/mohrcoulombfracture.h>
 #include <PDtools/Modfiers/Implementation/FractureCriterion/mohrcoulombmax.h>
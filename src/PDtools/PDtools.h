@@ -2,6 +2,7 @@
 #define PDTOOLS_H
 
 #include "Particles/loadparticles.h"
+#include "Particles/latticegenerator.h"
 #include "Particles/loadpdparticles.h"
 #include "Particles/particles.h"
 #include "Particles/pd_particles.h"
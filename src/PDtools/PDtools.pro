@@ -10,15 +10,23 @@ HEADERS += \
     PDtools.h \
     Particles/particles.h \
     Particles/pd_particles.h \
+    Particles/particledata.h \
+    Particles/idtocolmap.h \
+    Particles/bonddata.h \
     Grid/grid.h \
     Domain/domain.h \
     Solver/solver.h \
+    Solver/profiler.h \
+    Solver/perfcounters.h \
     Particles/saveparticles.h \
     Particles/loadparticles.h \
     Particles/loadpdparticles.h \
+    Particles/latticegenerator.h \
     PdFunctions/pdfunctions.h \
     Solver/timeintegrator.h \
     Solver/TimeIntegrators/velocityverletintegrator.h \
+    Solver/TimeIntegrators/multirateverletintegrator.h \
+    Solver/TimeIntegrators/ensembleverletintegrator.h \
     Solver/solvers.h \
     Force/force.h \
     Force/forces.h \
@@ -51,9 +59,12 @@ HEADERS += \
     Solver/staticsolver.h \
     Solver/TimeIntegrators/eulercromerintegrator.h \
     PdFunctions/pdfunctionsmpi.h \
+    PdFunctions/commtracer.h \
+    PdFunctions/memorytracker.h \
     SavePdData/Implementations/computegridid.h \
     Force/PdForces/viscousdamper.h \
     CalculateProperties/calculateproperty.h \
+    CalculateProperties/propertyscheduler.h \
     CalculateProperties/Implementation/calculatepdangles.h \
     CalculateProperties/calculateproperties.h \
     Force/DemForces/demforce.h \
@@ -73,7 +84,9 @@ HEADERS += \
     Modfiers/Implementation/FractureCriterion/mohrcoulombmaxfractureweighted.h \
     Modfiers/Implementation/FractureCriterion/strainfracture.h \
     Modfiers/Implementation/FractureCriterion/vonmisesfracture.h \
+    Modfiers/Implementation/FractureCriterion/bondfracturecriterion.h \
     CalculateProperties/Implementation/calculatestressstrain.h \
+    CalculateProperties/Implementation/calculateprincipalstress.h \
     Force/PdForces/LPS/pd_lpsdampenedcontact.h \
     Modfiers/Implementation/BoundaryConditions/strainboundary.h \
     Force/PdForces/LPS/lps_mc.h \
@@ -115,16 +128,23 @@ SOURCES += \
     Grid/grid.cpp \
     Domain/domain.cpp \
     Solver/solver.cpp \
+    Solver/profiler.cpp \
+    Solver/perfcounters.cpp \
     Solver/adr.cpp \
     Solver/ADRsolvers/dynamicadr.cpp \
     Solver/staticsolver.cpp \
     Solver/timeintegrator.cpp \
     Solver/TimeIntegrators/velocityverletintegrator.cpp \
+    Solver/TimeIntegrators/multirateverletintegrator.cpp \
+    Solver/TimeIntegrators/ensembleverletintegrator.cpp \
     Particles/saveparticles.cpp \
     Particles/loadparticles.cpp \
     Particles/loadpdparticles.cpp \
+    Particles/latticegenerator.cpp \
     PdFunctions/pdfunctions.cpp \
     PdFunctions/pdfunctionsmpi.cpp \
+    PdFunctions/commtracer.cpp \
+    PdFunctions/memorytracker.cpp \
     Force/force.cpp \
     Force/PdForces/pd_bondforce.cpp \
     Modfiers/modifier.cpp \
@@ -137,6 +157,9 @@ SOURCES += \
     Force/PdForces/contactforce.cpp \
     Particles/particles.cpp \
     Particles/pd_particles.cpp \
+    Particles/particledata.cpp \
+    Particles/idtocolmap.cpp \
+    Particles/bonddata.cpp \
     Solver/TimeIntegrators/eulercromerintegrator.cpp \
     Force/PdForces/pd_bondforcegaussian.cpp \
     Force/PdForces/pd_pmb.cpp \
@@ -148,11 +171,13 @@ SOURCES += \
     Force/DemForces/demforce.cpp \
     SavePdData/Implementations/computegridid.cpp \
     CalculateProperties/calculateproperty.cpp \
+    CalculateProperties/propertyscheduler.cpp \
     CalculateProperties/Implementation/calculatepdangles.cpp \
     CalculateProperties/Implementation/calculatestress.cpp \
     CalculateProperties/Implementation/calculatestrain.cpp \
     CalculateProperties/Implementation/calculatedamage.cpp \
     CalculateProperties/Implementation/calculatestressstrain.cpp \
+    CalculateProperties/Implementation/calculateprincipalstress.cpp \
     Modfiers/Implementation/dumpstate.cpp \
     Modfiers/Implementation/rigidwall.cpp \
     Modfiers/Implementation/BoundaryConditions/boundaryforce.cpp \
@@ -173,6 +198,7 @@ SOURCES += \
     Modfiers/Implementation/FractureCriterion/mohrcoulombmaxfractureweighted.cpp \
     Modfiers/Implementation/FractureCriterion/strainfracture.cpp \
     Modfiers/Implementation/FractureCriterion/vonmisesfracture.cpp \
+    Modfiers/Implementation/FractureCriterion/bondfracturecriterion.cpp \
     Modfiers/Implementation/FractureCriterion/adrfractureaverage.cpp \
     Modfiers/Implementation/FractureCriterion/adrmohrcoulombfracture.cpp \
     Modfiers/Implementation/BoundaryConditions/strainboundary.cpp \
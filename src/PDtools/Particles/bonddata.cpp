@@ -0,0 +1,273 @@
+#include "bonddata.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+
+namespace PDtools {
+//------------------------------------------------------------------------------
+BondData::BondData() {}
+//------------------------------------------------------------------------------
+BondData::BondData(const BondLayout &layout, const vector<double> &values)
+    : m_layout(&layout), m_owned(true) {
+  const size_t nBytes = layout.nBytes();
+  if (nBytes > 0)
+    m_bytes = static_cast<unsigned char *>(calloc(nBytes, 1));
+
+  const int nValues = std::min<int>(values.size(), layout.size());
+  for (int k = 0; k < nValues; k++) {
+    write(m_bytes + layout.offset(k), layout.precision(k), values[k]);
+  }
+}
+//------------------------------------------------------------------------------
+BondData::BondData(const BondData &other)
+    : m_layout(other.m_layout), m_owned(true) {
+  if (other.m_bytes != nullptr) {
+    const size_t nBytes = m_layout->nBytes();
+    m_bytes = static_cast<unsigned char *>(malloc(nBytes));
+    memcpy(m_bytes, other.m_bytes, nBytes);
+  }
+}
+//------------------------------------------------------------------------------
+BondData::BondData(BondData &&other) : BondData() {
+  if (other.m_owned || other.m_bytes == nullptr) {
+    std::swap(m_bytes, other.m_bytes);
+    std::swap(m_layout, other.m_layout);
+    m_owned = true;
+  } else {
+    // A bond of a list stays in its list
+    *this = static_cast<const BondData &>(other);
+  }
+}
+//------------------------------------------------------------------------------
+BondData &BondData::operator=(const BondData &other) {
+  if (this == &other)
+    return *this;
+
+  if (m_bytes != nullptr &&
+      (m_layout == other.m_layout || !m_owned)) {
+    copyValues(other);
+    return *this;
+  }
+
+  BondData copy(other);
+  std::swap(m_bytes, copy.m_bytes);
+  std::swap(m_layout, copy.m_layout);
+  m_owned = true;
+  return *this;
+}
+//------------------------------------------------------------------------------
+BondData &BondData::operator=(BondData &&other) {
+  if (this == &other)
+    return *this;
+
+  if ((m_owned || m_bytes == nullptr) && other.m_owned) {
+    std::swap(m_bytes, other.m_bytes);
+    std::swap(m_layout, other.m_layout);
+    m_owned = true;
+    return *this;
+  }
+  return *this = static_cast<const BondData &>(other);
+}
+//------------------------------------------------------------------------------
+BondData::~BondData() {
+  if (m_owned)
+    free(m_bytes);
+}
+//------------------------------------------------------------------------------
+void BondData::copyValues(const BondData &other) {
+  if (other.m_bytes == nullptr)
+    return;
+
+  if (m_layout == other.m_layout) {
+    memcpy(m_bytes, other.m_bytes, m_layout->nBytes());
+    return;
+  }
+
+  // From a bond of another layout, e.g. of a copied particle set
+  const int nValues = std::min(size(), other.size());
+  for (int k = 0; k < nValues; k++) {
+    (*this)[k] = other[k];
+  }
+}
+//------------------------------------------------------------------------------
+double BondData::reduced(const double value, const Precision precision) {
+  // The value as it would be stored with the given precision
+  unsigned char bytes[sizeof(double)];
+  write(bytes, precision, value);
+  return read(bytes, precision);
+}
+//------------------------------------------------------------------------------
+size_t BondData::precisionBytes(const Precision precision) {
+  switch (precision) {
+  case Double:
+    return sizeof(double);
+  case Float:
+    return sizeof(float);
+  default:
+    return sizeof(uint8_t);
+  }
+}
+//------------------------------------------------------------------------------
+BondLayout::BondLayout() {}
+//------------------------------------------------------------------------------
+int BondLayout::addParameter(const BondData::Precision precision) {
+  Field field;
+  field.registeredPrecision = precision;
+  field.precision = m_storage == BondData::Mixed ? precision : BondData::Double;
+
+  // Aligned to its own size
+  const size_t fieldBytes = BondData::precisionBytes(field.precision);
+  const size_t nBytes = m_fields.empty() ? 0 : m_fields.back().offset +
+      BondData::precisionBytes(m_fields.back().precision);
+  field.offset = (nBytes + fieldBytes - 1) / fieldBytes * fieldBytes;
+
+  m_alignment = std::max(m_alignment, fieldBytes);
+  const size_t end = field.offset + fieldBytes;
+  m_nBytes = (end + m_alignment - 1) / m_alignment * m_alignment;
+  m_fields.push_back(field);
+  return m_fields.size() - 1;
+}
+//------------------------------------------------------------------------------
+void BondLayout::storage(const BondData::Storage storage) {
+  if (!m_fields.empty() && storage != m_storage) {
+    cerr << "ERROR: the bond storage must be set before the first bond "
+            "parameter is registered"
+         << endl;
+    throw StorageAfterRegistration;
+  }
+  m_storage = storage;
+}
+//------------------------------------------------------------------------------
+BondList::BondList() {}
+//------------------------------------------------------------------------------
+BondList::BondList(const BondLayout &layout)
+    : m_layout(&layout), m_stride(layout.nBytes()),
+      m_nFields(layout.size()) {}
+//------------------------------------------------------------------------------
+BondList::BondList(const BondList &other)
+    : m_layout(other.m_layout), m_stride(other.m_stride),
+      m_nFields(other.m_nFields) {
+  const size_t nBonds = other.size();
+  reallocate(nBonds, m_stride);
+  if (nBonds > 0)
+    memcpy(m_storage.data(), other.m_storage.data(), nBonds * m_stride);
+  for (const value_type &bond : other.m_bonds) {
+    m_bonds.push_back(value_type(bond.first, BondData()));
+    refer(m_bonds.back().second, m_bonds.size() - 1);
+  }
+}
+//------------------------------------------------------------------------------
+BondList::BondList(BondList &&other) { swap(other); }
+//------------------------------------------------------------------------------
+BondList &BondList::operator=(BondList other) {
+  swap(other);
+  return *this;
+}
+//------------------------------------------------------------------------------
+void BondList::swap(BondList &other) {
+  // The bonds keep referring to the storage they moved with
+  std::swap(m_layout, other.m_layout);
+  std::swap(m_stride, other.m_stride);
+  std::swap(m_nFields, other.m_nFields);
+  std::swap(m_capacity, other.m_capacity);
+  m_storage.swap(other.m_storage);
+  m_bonds.swap(other.m_bonds);
+}
+//------------------------------------------------------------------------------
+void BondList::reserve(const size_t nBonds) {
+  if (nBonds > m_capacity)
+    reallocate(nBonds, m_stride);
+}
+//------------------------------------------------------------------------------
+void BondList::push_back(const value_type &bond) {
+  if (m_layout == nullptr && bond.second.layout() != nullptr) {
+    m_layout = bond.second.layout();
+    m_stride = m_layout->nBytes();
+    m_nFields = m_layout->size();
+  }
+  value_type &added = append(bond.first);
+  added.second = bond.second;
+}
+//------------------------------------------------------------------------------
+void BondList::push_back(const int id, const vector<double> &values) {
+  value_type &added = append(id);
+  const int nValues = std::min<int>(values.size(), m_nFields);
+  for (int k = 0; k < nValues; k++) {
+    added.second[k] = values[k];
+  }
+}
+//------------------------------------------------------------------------------
+void BondList::addParameters(const BondLayout &layout, const double value) {
+  // The offsets of the fields already stored are the same in the layout
+  const size_t stride = layout.nBytes();
+  const size_t nBonds = size();
+  const int nFields = m_nFields;
+  const size_t oldStride = m_stride;
+  const vector<uint64_t> oldStorage = m_storage;
+  m_layout = &layout;
+  m_nFields = layout.size();
+  reallocate(nBonds, stride);
+
+  const unsigned char *oldBytes =
+      reinterpret_cast<const unsigned char *>(oldStorage.data());
+  for (size_t l = 0; l < nBonds; l++) {
+    unsigned char *bytes = slot(l);
+    if (oldStride > 0)
+      memcpy(bytes, oldBytes + l * oldStride, oldStride);
+    for (int k = nFields; k < m_nFields; k++) {
+      BondData::write(bytes + layout.offset(k), layout.precision(k), value);
+    }
+  }
+}
+//------------------------------------------------------------------------------
+size_t BondList::allocatedBytes() const {
+  return m_storage.capacity() * sizeof(uint64_t) +
+         m_bonds.capacity() * sizeof(value_type);
+}
+//------------------------------------------------------------------------------
+void BondList::reallocate(const size_t capacity, const size_t stride) {
+  // One allocation for the parameters of all the bonds. The bonds refer to
+  // it, so they are created again instead of moved by the vector.
+  const size_t nWords = (capacity * stride + sizeof(uint64_t) - 1) /
+                        sizeof(uint64_t);
+  vector<uint64_t> storage(nWords, 0);
+  const size_t nBonds = m_bonds.size();
+  if (nBonds > 0 && m_stride == stride)
+    memcpy(storage.data(), m_storage.data(), nBonds * stride);
+  m_storage.swap(storage);
+  m_stride = stride;
+  m_capacity = capacity;
+
+  vector<value_type> bonds;
+  bonds.reserve(capacity);
+  for (size_t l = 0; l < nBonds; l++) {
+    bonds.push_back(value_type(m_bonds[l].first, BondData()));
+  }
+  m_bonds.swap(bonds);
+  for (size_t l = 0; l < nBonds; l++) {
+    refer(m_bonds[l].second, l);
+  }
+}
+//------------------------------------------------------------------------------
+void BondList::refer(BondData &bond, const size_t l) {
+  bond.m_bytes = slot(l);
+  bond.m_layout = m_layout;
+  bond.m_owned = false;
+}
+//------------------------------------------------------------------------------
+BondList::value_type &BondList::append(const int id) {
+  if (m_bonds.size() == m_capacity)
+    reallocate(std::max<size_t>(4, 2 * m_capacity), m_stride);
+
+  // Within the capacity, the vector does not move the bonds. The slot may
+  // hold the values of an erased bond.
+  const size_t l = m_bonds.size();
+  if (m_stride > 0)
+    memset(slot(l), 0, m_stride);
+  m_bonds.push_back(value_type(id, BondData()));
+  refer(m_bonds.back().second, l);
+  return m_bonds.back();
+}
+//------------------------------------------------------------------------------
+}
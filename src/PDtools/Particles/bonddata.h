@@ -0,0 +1,384 @@
+#ifndef BONDDATA_H
+#define BONDDATA_H
+
+#include "config.h"
+
+#include <cstdint>
+#include <cstring>
+
+namespace PDtools {
+class BondLayout;
+class BondList;
+
+//------------------------------------------------------------------------------
+// The parameters of one bond, indexed like a vector<double>.
+//
+// Each bond parameter is stored with the precision given when it is
+// registered (PD_Particles::registerPdParameter): as a double, a float or an
+// 8-bit flag. Flags store value > 0.5, which keeps every "connected" test
+// unchanged. The offsets and precisions are kept in the BondLayout of the
+// particles, and operator[] converts to double on access. The force loops
+// read through a BondField instead, resolved once for the parameter.
+//
+// The bonds in a BondList refer to the storage of the list. A bond copied out
+// of a list, or created from values, owns its storage. Assigning to a bond
+// copies the values, so a bond in a list stays in its list.
+//
+// The storage mode, set before the first parameter is registered, may force
+// all parameters to be stored as doubles. The validation mode does so and
+// keeps the registered precisions, to report the error the reduced
+// precision would have given.
+//------------------------------------------------------------------------------
+class BondData {
+public:
+  enum Precision { Double, Float, Flag };
+  enum Storage { Mixed, AllDouble, Validate };
+
+  // Reference to one parameter of a bond
+  class Value {
+  public:
+    Value(unsigned char *bytes, const Precision precision);
+    operator double() const;
+    Value &operator=(const double value);
+    Value &operator=(const Value &other);
+    Value &operator+=(const double value);
+    Value &operator-=(const double value);
+    Value &operator*=(const double value);
+    Value &operator/=(const double value);
+
+  protected:
+    unsigned char *m_bytes;
+    Precision m_precision;
+  };
+
+  BondData();
+  BondData(const BondLayout &layout, const vector<double> &values);
+  BondData(const BondData &other);
+  BondData(BondData &&other);
+  BondData &operator=(const BondData &other);
+  BondData &operator=(BondData &&other);
+  ~BondData();
+
+  int size() const;
+  double operator[](const int k) const;
+  Value operator[](const int k);
+  const BondLayout *layout() const;
+  const unsigned char *bytes() const;
+  unsigned char *bytes();
+
+  static double reduced(const double value, const Precision precision);
+  static size_t precisionBytes(const Precision precision);
+  static double read(const unsigned char *bytes, const Precision precision);
+  static void write(unsigned char *bytes, const Precision precision,
+                    const double value);
+
+protected:
+  friend class BondList;
+
+  unsigned char *m_bytes = nullptr;
+  const BondLayout *m_layout = nullptr;
+  // False for the bonds referring to the storage of a BondList
+  bool m_owned = false;
+
+  void copyValues(const BondData &other);
+};
+//------------------------------------------------------------------------------
+// Reads and writes one bond parameter as the type it is stored as, T is
+// double, float or uint8_t for the flags. Holds only the offset, so the
+// precision is resolved once outside of the loops over the bonds, see
+// BondLayout::field().
+//------------------------------------------------------------------------------
+template <typename T> class BondField {
+public:
+  BondField();
+  explicit BondField(const size_t offset);
+  T operator()(const BondData &bond) const;
+  void set(BondData &bond, const T value) const;
+
+protected:
+  size_t m_offset;
+};
+//------------------------------------------------------------------------------
+// The offsets and the precisions of the bond parameters of one particle set.
+// Parameters are only appended, so the offset and the precision of a
+// registered parameter never change.
+//------------------------------------------------------------------------------
+class BondLayout {
+public:
+  BondLayout();
+
+  int addParameter(const BondData::Precision precision);
+  void storage(const BondData::Storage storage);
+  BondData::Storage storage() const;
+  int size() const;
+  BondData::Precision precision(const int k) const;
+  BondData::Precision registeredPrecision(const int k) const;
+  size_t offset(const int k) const;
+  // The bytes of one bond, a multiple of the largest field so that the bonds
+  // of a list stay aligned
+  size_t nBytes() const;
+  template <typename T> BondField<T> field(const int k) const;
+
+protected:
+  struct Field {
+    BondData::Precision precision;
+    BondData::Precision registeredPrecision;
+    size_t offset;
+  };
+  vector<Field> m_fields;
+  size_t m_nBytes = 0;
+  size_t m_alignment = 1;
+  BondData::Storage m_storage = BondData::Mixed;
+
+  enum ErrorCodes { StorageAfterRegistration, FieldTypeMismatch };
+};
+//------------------------------------------------------------------------------
+// The bonds of one particle, with the parameters of all of them in one
+// allocation. Used like the vector<pair<int, BondData>> it replaces: the id
+// of the particle at the other end and the parameters of the bond.
+//------------------------------------------------------------------------------
+class BondList {
+public:
+  typedef pair<int, BondData> value_type;
+  typedef vector<value_type>::iterator iterator;
+  typedef vector<value_type>::const_iterator const_iterator;
+
+  BondList();
+  explicit BondList(const BondLayout &layout);
+  BondList(const BondList &other);
+  BondList(BondList &&other);
+  BondList &operator=(BondList other);
+  void swap(BondList &other);
+
+  size_t size() const;
+  bool empty() const;
+  value_type &operator[](const size_t l);
+  const value_type &operator[](const size_t l) const;
+  value_type &at(const size_t l);
+  const value_type &at(const size_t l) const;
+  value_type &back();
+  value_type *data();
+  const value_type *data() const;
+  iterator begin();
+  iterator end();
+  const_iterator begin() const;
+  const_iterator end() const;
+
+  void reserve(const size_t nBonds);
+  void push_back(const value_type &bond);
+  void push_back(const int id, const vector<double> &values);
+  iterator erase(iterator position);
+  iterator erase(iterator first, iterator last);
+  void clear();
+
+  const BondLayout *layout() const;
+  // Repacks the bonds after parameters were appended to the layout, they are
+  // set to value
+  void addParameters(const BondLayout &layout, const double value);
+  size_t allocatedBytes() const;
+
+protected:
+  const BondLayout *m_layout = nullptr;
+  // The bytes per bond and the parameters when the storage was packed
+  size_t m_stride = 0;
+  int m_nFields = 0;
+  size_t m_capacity = 0;
+  // 8-byte words, so that the double parameters are aligned
+  vector<uint64_t> m_storage;
+  vector<value_type> m_bonds;
+
+  unsigned char *slot(const size_t l);
+  void refer(BondData &bond, const size_t l);
+  void reallocate(const size_t capacity, const size_t stride);
+  value_type &append(const int id);
+};
+//------------------------------------------------------------------------------
+// Inline functions
+inline double BondData::read(const unsigned char *bytes,
+                             const Precision precision) {
+  switch (precision) {
+  case Double: {
+    double value;
+    memcpy(&value, bytes, sizeof(double));
+    return value;
+  }
+  case Float: {
+    float value;
+    memcpy(&value, bytes, sizeof(float));
+    return value;
+  }
+  default:
+    return *bytes;
+  }
+}
+
+inline void BondData::write(unsigned char *bytes, const Precision precision,
+                            const double value) {
+  switch (precision) {
+  case Double:
+    memcpy(bytes, &value, sizeof(double));
+    break;
+  case Float: {
+    const float f = value;
+    memcpy(bytes, &f, sizeof(float));
+    break;
+  }
+  default:
+    *bytes = value > 0.5;
+  }
+}
+
+inline BondData::Value::Value(unsigned char *bytes, const Precision precision)
+    : m_bytes(bytes), m_precision(precision) {}
+
+inline BondData::Value::operator double() const {
+  return read(m_bytes, m_precision);
+}
+
+inline BondData::Value &BondData::Value::operator=(const double value) {
+  write(m_bytes, m_precision, value);
+  return *this;
+}
+
+inline BondData::Value &BondData::Value::operator=(const Value &other) {
+  return *this = double(other);
+}
+
+inline BondData::Value &BondData::Value::operator+=(const double value) {
+  return *this = double(*this) + value;
+}
+
+inline BondData::Value &BondData::Value::operator-=(const double value) {
+  return *this = double(*this) - value;
+}
+
+inline BondData::Value &BondData::Value::operator*=(const double value) {
+  return *this = double(*this) * value;
+}
+
+inline BondData::Value &BondData::Value::operator/=(const double value) {
+  return *this = double(*this) / value;
+}
+
+inline int BondData::size() const {
+  return m_layout == nullptr ? 0 : m_layout->size();
+}
+
+inline double BondData::operator[](const int k) const {
+  return read(m_bytes + m_layout->offset(k), m_layout->precision(k));
+}
+
+inline BondData::Value BondData::operator[](const int k) {
+  return Value(m_bytes + m_layout->offset(k), m_layout->precision(k));
+}
+
+inline const BondLayout *BondData::layout() const { return m_layout; }
+
+inline const unsigned char *BondData::bytes() const { return m_bytes; }
+
+inline unsigned char *BondData::bytes() { return m_bytes; }
+
+template <typename T> inline BondField<T>::BondField() : m_offset(0) {}
+
+template <typename T>
+inline BondField<T>::BondField(const size_t offset) : m_offset(offset) {}
+
+template <typename T>
+inline T BondField<T>::operator()(const BondData &bond) const {
+  T value;
+  memcpy(&value, bond.bytes() + m_offset, sizeof(T));
+  return value;
+}
+
+template <typename T>
+inline void BondField<T>::set(BondData &bond, const T value) const {
+  memcpy(bond.bytes() + m_offset, &value, sizeof(T));
+}
+
+inline BondData::Storage BondLayout::storage() const { return m_storage; }
+
+inline int BondLayout::size() const { return m_fields.size(); }
+
+inline BondData::Precision BondLayout::precision(const int k) const {
+  return m_fields[k].precision;
+}
+
+inline BondData::Precision BondLayout::registeredPrecision(const int k) const {
+  return m_fields[k].registeredPrecision;
+}
+
+inline size_t BondLayout::offset(const int k) const {
+  return m_fields[k].offset;
+}
+
+inline size_t BondLayout::nBytes() const { return m_nBytes; }
+
+template <typename T>
+BondField<T> BondLayout::field(const int k) const {
+  const size_t fieldBytes = BondData::precisionBytes(m_fields[k].precision);
+  if (fieldBytes != sizeof(T)) {
+    cerr << "ERROR: bond parameter " << k << " is stored in " << fieldBytes
+         << " bytes, accessed as " << sizeof(T) << endl;
+    throw FieldTypeMismatch;
+  }
+  return BondField<T>(m_fields[k].offset);
+}
+
+inline size_t BondList::size() const { return m_bonds.size(); }
+
+inline bool BondList::empty() const { return m_bonds.empty(); }
+
+inline BondList::value_type &BondList::operator[](const size_t l) {
+  return m_bonds[l];
+}
+
+inline const BondList::value_type &BondList::
+operator[](const size_t l) const {
+  return m_bonds[l];
+}
+
+inline BondList::value_type &BondList::at(const size_t l) {
+  return m_bonds.at(l);
+}
+
+inline const BondList::value_type &BondList::at(const size_t l) const {
+  return m_bonds.at(l);
+}
+
+inline BondList::value_type &BondList::back() { return m_bonds.back(); }
+
+inline BondList::value_type *BondList::data() { return m_bonds.data(); }
+
+inline const BondList::value_type *BondList::data() const {
+  return m_bonds.data();
+}
+
+inline BondList::iterator BondList::begin() { return m_bonds.begin(); }
+
+inline BondList::iterator BondList::end() { return m_bonds.end(); }
+
+inline BondList::const_iterator BondList::begin() const {
+  return m_bonds.begin();
+}
+
+inline BondList::const_iterator BondList::end() const { return m_bonds.end(); }
+
+inline BondList::iterator BondList::erase(iterator position) {
+  // The values are moved down, each bond keeps its slot
+  return m_bonds.erase(position);
+}
+
+inline BondList::iterator BondList::erase(iterator first, iterator last) {
+  return m_bonds.erase(first, last);
+}
+
+inline void BondList::clear() { m_bonds.clear(); }
+
+inline const BondLayout *BondList::layout() const { return m_layout; }
+
+inline unsigned char *BondList::slot(const size_t l) {
+  return reinterpret_cast<unsigned char *>(m_storage.data()) + l * m_stride;
+}
+//------------------------------------------------------------------------------
+}
+#endif // BONDDATA_H
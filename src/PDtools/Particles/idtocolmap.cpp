@@ -0,0 +1,136 @@
+#include "idtocolmap.h"
+
+namespace PDtools {
+//------------------------------------------------------------------------------
+const int IdToColMap::EMPTY;
+//------------------------------------------------------------------------------
+void IdToColMap::initialize(const unsigned int nIds, const Mode mode) {
+  m_mode = mode;
+  m_dense.clear();
+  m_keys.clear();
+  m_cols.clear();
+  m_nHashed = 0;
+
+  if (mode == Dense) {
+    m_dense.assign(nIds, -1);
+    return;
+  }
+
+  // At most half full
+  unsigned int nSlots = 16;
+  while (nSlots < 2 * nIds)
+    nSlots *= 2;
+  rehash(nSlots);
+}
+//------------------------------------------------------------------------------
+void IdToColMap::resizeDense(const unsigned int nIds) {
+  m_dense.resize(nIds, -1);
+}
+//------------------------------------------------------------------------------
+void IdToColMap::setMode(const Mode mode) {
+  // Converts the map, keeping the mapped ids
+  if (mode == m_mode)
+    return;
+
+  vector<pair<int, int>> entries;
+  if (m_mode == Dense) {
+    const int nIds = m_dense.size();
+    for (int id = 0; id < nIds; id++) {
+      if (m_dense[id] >= 0)
+        entries.push_back(pair<int, int>(id, m_dense[id]));
+    }
+  } else {
+    const unsigned int nSlots = m_keys.size();
+    for (unsigned int s = 0; s < nSlots; s++) {
+      if (m_keys[s] != EMPTY)
+        entries.push_back(pair<int, int>(m_keys[s], m_cols[s]));
+    }
+  }
+
+  unsigned int nIds = entries.size();
+  if (mode == Dense) {
+    for (const auto &entry : entries)
+      nIds = std::max<unsigned int>(nIds, entry.first + 1);
+  }
+  initialize(nIds, mode);
+  for (const auto &entry : entries) {
+    (*this)[entry.first] = entry.second;
+  }
+}
+//------------------------------------------------------------------------------
+size_t IdToColMap::allocatedBytes() const {
+  return (m_dense.capacity() + m_keys.capacity() + m_cols.capacity()) *
+         sizeof(int);
+}
+//------------------------------------------------------------------------------
+void IdToColMap::erase(const int id) {
+  if (m_mode == Dense) {
+    if ((unsigned int)id < m_dense.size())
+      m_dense[id] = -1;
+    return;
+  }
+
+  unsigned int s = slot(id);
+  while (m_keys[s] != id) {
+    if (m_keys[s] == EMPTY)
+      return;
+    s = (s + 1) & m_mask;
+  }
+
+  // Backward shift deletion, moves the following entries of the probe
+  // sequence into the hole so that no tombstones are needed
+  unsigned int hole = s;
+  unsigned int next = (s + 1) & m_mask;
+  while (m_keys[next] != EMPTY) {
+    const unsigned int home = slot(m_keys[next]);
+    const unsigned int distNext = (next - home) & m_mask;
+    const unsigned int distHole = (hole - home) & m_mask;
+    if (distHole < distNext) {
+      m_keys[hole] = m_keys[next];
+      m_cols[hole] = m_cols[next];
+      hole = next;
+    }
+    next = (next + 1) & m_mask;
+  }
+  m_keys[hole] = EMPTY;
+  m_nHashed--;
+}
+//------------------------------------------------------------------------------
+int &IdToColMap::insert(const int id) {
+  if (2 * (m_nHashed + 1) > m_keys.size())
+    rehash(2 * m_keys.size());
+
+  unsigned int s = slot(id);
+  while (m_keys[s] != EMPTY)
+    s = (s + 1) & m_mask;
+
+  m_keys[s] = id;
+  m_cols[s] = -1;
+  m_nHashed++;
+  return m_cols[s];
+}
+//------------------------------------------------------------------------------
+void IdToColMap::rehash(const unsigned int nSlots) {
+  vector<int> keys(nSlots, EMPTY);
+  vector<int> cols(nSlots, -1);
+  keys.swap(m_keys);
+  cols.swap(m_cols);
+
+  m_mask = nSlots - 1;
+  m_shift = 32;
+  for (unsigned int n = nSlots; n > 1; n /= 2)
+    m_shift--;
+
+  const unsigned int nOld = keys.size();
+  for (unsigned int s = 0; s < nOld; s++) {
+    if (keys[s] == EMPTY)
+      continue;
+    unsigned int t = slot(keys[s]);
+    while (m_keys[t] != EMPTY)
+      t = (t + 1) & m_mask;
+    m_keys[t] = keys[s];
+    m_cols[t] = cols[s];
+  }
+}
+//------------------------------------------------------------------------------
+}
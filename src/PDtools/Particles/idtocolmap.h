@@ -0,0 +1,105 @@
+#ifndef IDTOCOLMAP_H
+#define IDTOCOLMAP_H
+
+#include "config.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace PDtools {
+//------------------------------------------------------------------------------
+// Maps the global id of a particle to its local column.
+//
+// The dense mode is a vector indexed by id, the fastest lookup when the ids on
+// this rank are compact. Node splitting hands out ids above the initial range
+// and an MPI rank only holds a slice of the global ids. For such sparse ids
+// the hashed mode, an open-addressing table with linear probing, keeps the
+// memory proportional to the number of mapped ids instead of the largest id.
+//
+// Unmapped ids read as -1. Lookups through at(), operator() or a const
+// reference never modify the map and are safe in parallel regions. The
+// non-const operator[] is for writing, it inserts a missing id and must only
+// be used outside of parallel regions.
+//------------------------------------------------------------------------------
+class IdToColMap {
+public:
+  enum Mode { Dense, Hashed };
+
+  void initialize(const unsigned int nIds, const Mode mode = Dense);
+  void resizeDense(const unsigned int nIds);
+  void setMode(const Mode mode);
+  Mode mode() const;
+  unsigned int denseSize() const;
+  size_t allocatedBytes() const;
+
+  int &operator[](const int id);
+  int operator[](const int id) const;
+  int operator()(const int id) const;
+  int at(const int id) const;
+  void erase(const int id);
+
+protected:
+  Mode m_mode = Dense;
+  vector<int> m_dense;
+
+  // The hashed table, its size is a power of two
+  vector<int> m_keys;
+  vector<int> m_cols;
+  unsigned int m_mask = 0;
+  int m_shift = 32;
+  unsigned int m_nHashed = 0;
+
+  static const int EMPTY = -1;
+
+  unsigned int slot(const int id) const;
+  int &insert(const int id);
+  void rehash(const unsigned int nSlots);
+};
+//------------------------------------------------------------------------------
+// Inline functions
+inline IdToColMap::Mode IdToColMap::mode() const { return m_mode; }
+
+inline unsigned int IdToColMap::denseSize() const { return m_dense.size(); }
+
+inline unsigned int IdToColMap::slot(const int id) const {
+  // Fibonacci hashing, the high bits are the best mixed
+  return (uint32_t(id) * 2654435769u) >> m_shift;
+}
+
+inline int IdToColMap::operator[](const int id) const {
+  if (m_mode == Dense)
+    return (unsigned int)id < m_dense.size() ? m_dense[id] : -1;
+
+  unsigned int s = slot(id);
+  while (m_keys[s] != EMPTY) {
+    if (m_keys[s] == id)
+      return m_cols[s];
+    s = (s + 1) & m_mask;
+  }
+  return -1;
+}
+
+inline int &IdToColMap::operator[](const int id) {
+  if (m_mode == Dense) {
+    if ((unsigned int)id >= m_dense.size())
+      resizeDense(std::max<size_t>(id + 1, 1.5 * m_dense.size()));
+    return m_dense[id];
+  }
+
+  unsigned int s = slot(id);
+  while (m_keys[s] != EMPTY) {
+    if (m_keys[s] == id)
+      return m_cols[s];
+    s = (s + 1) & m_mask;
+  }
+  return insert(id);
+}
+
+inline int IdToColMap::operator()(const int id) const {
+  return (*this)[id];
+}
+
+inline int IdToColMap::at(const int id) const { return (*this)[id]; }
+//------------------------------------------------------------------------------
+}
+#endif // IDTOCOLMAP_H
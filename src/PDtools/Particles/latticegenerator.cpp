@@ -0,0 +1,247 @@
+#include "latticegenerator.h"
+
+#include "PDtools/Elements/pd_element.h"
+#include "PDtools/Grid/grid.h"
+#include "PDtools/Particles/pd_particles.h"
+
+#include <boost/algorithm/string.hpp>
+#include <climits>
+#include <cmath>
+
+#if USE_MPI
+#include <mpi.h>
+#endif
+
+namespace PDtools {
+//------------------------------------------------------------------------------
+LatticeGenerator::LatticeGenerator(const LatticeType type, const double spacing,
+                                   const vector<pair<double, double>> &box)
+    : m_type(type), m_spacing(spacing), m_box(box) {
+  if (m_spacing <= 0 || m_box.size() != M_DIM) {
+    cerr << "ERROR: a lattice needs a positive spacing and a box "
+         << "[x0, x1, y0, y1, z0, z1]" << endl;
+    throw InvalidLattice;
+  }
+
+  const double a = m_spacing;
+  const double thickness = m_box[2].second - m_box[2].first;
+  switch (m_type) {
+  case Square:
+    m_cell = {a, a, thickness > 0 ? thickness : a};
+    m_basis = {{0.5, 0.5, 0.5}};
+    break;
+  case Hexagonal:
+    m_cell = {a, sqrt(3.) * a, thickness > 0 ? thickness : a};
+    m_basis = {{0.25, 0.25, 0.5}, {0.75, 0.75, 0.5}};
+    break;
+  case Cubic:
+    m_cell = {a, a, a};
+    m_basis = {{0.5, 0.5, 0.5}};
+    break;
+  case FCC:
+    m_cell = {a, a, a};
+    m_basis = {{0.25, 0.25, 0.25},
+               {0.75, 0.75, 0.25},
+               {0.75, 0.25, 0.75},
+               {0.25, 0.75, 0.75}};
+    break;
+  }
+
+  long nSites = m_basis.size();
+  for (int d = 0; d < M_DIM; d++) {
+    const double length = m_box[d].second - m_box[d].first;
+    m_nCells[d] = d < dim() ? long(length / m_cell(d) + 1e-9) : 1;
+    if (m_nCells[d] <= 0) {
+      cerr << "ERROR: the lattice box is smaller than a unit cell" << endl;
+      throw InvalidLattice;
+    }
+    nSites *= m_nCells[d];
+    if (nSites > INT_MAX) {
+      cerr << "ERROR: the lattice has more sites than there are particle ids"
+           << endl;
+      throw TooManySites;
+    }
+  }
+}
+//------------------------------------------------------------------------------
+LatticeGenerator::LatticeType LatticeGenerator::type(const string &name) {
+  if (boost::iequals(name, "square"))
+    return Square;
+  if (boost::iequals(name, "hexagonal"))
+    return Hexagonal;
+  if (boost::iequals(name, "cubic"))
+    return Cubic;
+  if (boost::iequals(name, "fcc"))
+    return FCC;
+
+  cerr << "ERROR: unknown lattice '" << name
+       << "', use 'square', 'hexagonal', 'cubic' or 'fcc'" << endl;
+  throw UnknownLattice;
+}
+//------------------------------------------------------------------------------
+int LatticeGenerator::dim() const {
+  return (m_type == Square || m_type == Hexagonal) ? 2 : 3;
+}
+//------------------------------------------------------------------------------
+void LatticeGenerator::addHole(const vec3 &center, const double radius) {
+  m_holes.push_back(pair<vec3, double>(center, radius));
+}
+//------------------------------------------------------------------------------
+void LatticeGenerator::addNotch(const vector<pair<double, double>> &box) {
+  m_notches.push_back(box);
+}
+//------------------------------------------------------------------------------
+void LatticeGenerator::addGroup(const int groupId,
+                                const vector<pair<double, double>> &box) {
+  m_groups.push_back(pair<int, vector<pair<double, double>>>(groupId, box));
+}
+//------------------------------------------------------------------------------
+PD_Particles LatticeGenerator::generate() { return generate(nullptr); }
+//------------------------------------------------------------------------------
+PD_Particles LatticeGenerator::generate(Grid &grid) { return generate(&grid); }
+//------------------------------------------------------------------------------
+bool LatticeGenerator::removed(const vec3 &r) const {
+  for (const pair<vec3, double> &hole : m_holes) {
+    const double dx = r(0) - hole.first(0);
+    const double dy = r(1) - hole.first(1);
+    if (dx * dx + dy * dy < hole.second * hole.second)
+      return true;
+  }
+
+  for (const vector<pair<double, double>> &notch : m_notches) {
+    bool inside = true;
+    for (int d = 0; d < dim(); d++) {
+      inside = inside && r(d) >= notch[d].first && r(d) <= notch[d].second;
+    }
+    if (inside)
+      return true;
+  }
+  return false;
+}
+//------------------------------------------------------------------------------
+int LatticeGenerator::groupId(const vec3 &r) const {
+  int id = 0;
+  for (const auto &group : m_groups) {
+    const vector<pair<double, double>> &box = group.second;
+    bool inside = true;
+    for (int d = 0; d < dim(); d++) {
+      inside = inside && r(d) >= box[d].first && r(d) <= box[d].second;
+    }
+    if (inside)
+      id = group.first;
+  }
+  return id;
+}
+//------------------------------------------------------------------------------
+PD_Particles LatticeGenerator::generate(Grid *grid) {
+  const int dim = this->dim();
+  const int nBasis = m_basis.size();
+
+  // The cells that may hold particles of this rank, the grid is in scaled
+  // units
+  long cMin[M_DIM];
+  long cMax[M_DIM];
+  double L0 = 1;
+  int myRank = 0;
+  vector<pair<double, double>> bounds;
+  if (grid != nullptr) {
+    L0 = grid->initialPositionScaling();
+    myRank = grid->myRank();
+    bounds = grid->myBounds();
+  }
+
+  for (int d = 0; d < M_DIM; d++) {
+    cMin[d] = 0;
+    cMax[d] = m_nCells[d] - 1;
+    if (grid == nullptr || d >= dim)
+      continue;
+
+    auto clampCell = [&](const double c) {
+      return c < 0 ? 0 : c > cMax[d] ? cMax[d] : long(c);
+    };
+    const double lower = bounds[d].first * L0 - m_box[d].first;
+    const double upper = bounds[d].second * L0 - m_box[d].first;
+    const long c0 = clampCell(std::floor(lower / m_cell(d)) - 1);
+    const long c1 = clampCell(std::floor(upper / m_cell(d)) + 1);
+    cMin[d] = c0;
+    cMax[d] = c1;
+  }
+
+  vector<int> ids;
+  vector<double> positions;
+  vector<int> groupIds;
+  vec3 r;
+  for (long k = cMin[2]; k <= cMax[2]; k++) {
+    for (long j = cMin[1]; j <= cMax[1]; j++) {
+      for (long i = cMin[0]; i <= cMax[0]; i++) {
+        const long cell[M_DIM] = {i, j, k};
+        const long cellId = i + m_nCells[0] * (j + m_nCells[1] * k);
+
+        for (int b = 0; b < nBasis; b++) {
+          for (int d = 0; d < M_DIM; d++) {
+            if (d < dim)
+              r(d) = m_box[d].first + (cell[d] + m_basis[b](d)) * m_cell(d);
+            else
+              r(d) = 0.5 * (m_box[d].first + m_box[d].second);
+          }
+
+          if (removed(r))
+            continue;
+          if (grid != nullptr && grid->particlesBelongsTo(r / L0) != myRank)
+            continue;
+
+          ids.push_back(nBasis * cellId + b);
+          for (int d = 0; d < M_DIM; d++) {
+            positions.push_back(r(d));
+          }
+          groupIds.push_back(groupId(r));
+        }
+      }
+    }
+  }
+
+  // Collective with a grid
+  const int nParticles = ids.size();
+  int nTotal = nParticles;
+#if USE_MPI
+  if (grid != nullptr)
+    MPI_Allreduce(MPI_IN_PLACE, &nTotal, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+#endif
+
+  // The ids are the lattice sites, new ids start above all of them
+  long nSites = nBasis;
+  for (int d = 0; d < M_DIM; d++) {
+    nSites *= m_nCells[d];
+  }
+
+  PD_Particles particles;
+  particles.maxParticles(nSites);
+  particles.nParticles(nParticles);
+  particles.totParticles(nTotal);
+  particles.dim(dim);
+  particles.initializeMatrices();
+
+  IdToColMap &idToCol = particles.getIdToCol_v();
+  ivec &colToId = particles.colToId();
+  mat &R = particles.r();
+  for (int col = 0; col < nParticles; col++) {
+    idToCol[ids[col]] = col;
+    colToId(col) = ids[col];
+    for (int d = 0; d < M_DIM; d++) {
+      R(col, d) = positions[M_DIM * col + d];
+    }
+  }
+
+  const double volume = m_cell(0) * m_cell(1) * m_cell(2) / nBasis;
+  particles.registerParameter("volume", volume);
+  const int indexGroupId = particles.registerParameter("groupId");
+  ParticleData &data = particles.data();
+  for (int col = 0; col < nParticles; col++) {
+    data(col, indexGroupId) = groupIds[col];
+  }
+
+  particles.type("xyz");
+  return particles;
+}
+//------------------------------------------------------------------------------
+}
@@ -0,0 +1,67 @@
+#ifndef LATTICEGENERATOR_H
+#define LATTICEGENERATOR_H
+
+#include "config.h"
+
+namespace PDtools {
+class PD_Particles;
+class Grid;
+
+//------------------------------------------------------------------------------
+// Generates the particles of a regular lattice filling a box, in place of
+// loading a geometry file. With a grid, each rank only generates the
+// particles of its own subdomain.
+//
+// The lattice sites are those of whole unit cells from the lower corner of
+// the box, the ids number the sites of the full lattice and do not depend on
+// the decomposition. Holes, circles around the z-axis through the whole
+// thickness, and notches, boxes, remove sites. Each site gets the "volume"
+// of its share of the unit cell, in 2d with the thickness of the box or
+// else the spacing, and the "groupId" of the last group box it is in, or 0.
+//
+//   Square     2d, square cells of the spacing
+//   Hexagonal  2d, nearest neighbours at the spacing
+//   Cubic      3d, cubic cells of the spacing
+//   FCC        3d, face centred cubic cells of edge spacing
+//------------------------------------------------------------------------------
+class LatticeGenerator {
+public:
+  enum LatticeType { Square, Hexagonal, Cubic, FCC };
+
+  LatticeGenerator(const LatticeType type, const double spacing,
+                   const vector<pair<double, double>> &box);
+
+  static LatticeType type(const string &name);
+  int dim() const;
+
+  void addHole(const vec3 &center, const double radius);
+  void addNotch(const vector<pair<double, double>> &box);
+  void addGroup(const int groupId, const vector<pair<double, double>> &box);
+
+  PD_Particles generate();
+  PD_Particles generate(Grid &grid);
+
+protected:
+  LatticeType m_type;
+  double m_spacing;
+  vector<pair<double, double>> m_box;
+
+  vector<pair<vec3, double>> m_holes;
+  vector<vector<pair<double, double>>> m_notches;
+  vector<pair<int, vector<pair<double, double>>>> m_groups;
+
+  // The unit cell, the sites of a cell in its fractional coordinates and the
+  // number of cells along each axis
+  vec3 m_cell;
+  vector<vec3> m_basis;
+  long m_nCells[M_DIM];
+
+  bool removed(const vec3 &r) const;
+  int groupId(const vec3 &r) const;
+  PD_Particles generate(Grid *grid);
+
+  enum LatticeErrorMessages { UnknownLattice, InvalidLattice, TooManySites };
+};
+//------------------------------------------------------------------------------
+}
+#endif // LATTICEGENERATOR_H
@@ -312,10 +312,10 @@ void LoadParticles::loadBody(Particles &particles, std::fstream &rawData,
   //--------------------------------------------------------------------------
   // Creating the data matrix
   particles.initializeMatrices();
-  ivec &idToCol = particles.getIdToCol_v();
+  IdToColMap &idToCol = particles.getIdToCol_v();
   arma::ivec &colToId = particles.colToId();
   arma::mat &r = particles.r();
-  arma::mat &data = particles.data();
+  ParticleData &data = particles.data();
 
   // Reading all the data from file
   for (unsigned int i = 0; i < particles.nParticles(); i++) {
@@ -396,10 +396,10 @@ void LoadParticles::loadBinaryBody(Particles &particles, FILE *rawData,
   particles.initializeMatrices();
 
   int nColumns = m_nColumns;
-  ivec &idToCol = particles.getIdToCol_v();
+  IdToColMap &idToCol = particles.getIdToCol_v();
   arma::ivec &colToId = particles.colToId();
   arma::mat &r = particles.r();
-  arma::mat &data = particles.data();
+  ParticleData &data = particles.data();
 
   // Reading all the data from file
   for (unsigned int i = 0; i < particles.nParticles(); i++) {
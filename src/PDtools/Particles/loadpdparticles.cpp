@@ -122,11 +122,11 @@ void LoadPdParticles::loadBody(PD_Particles &particles, std::fstream &rawData,
   // Creating the data matrix
   particles.initializeMatrices();
 
-  ivec &idToCol = particles.getIdToCol_v();
+  IdToColMap &idToCol = particles.getIdToCol_v();
   arma::ivec &get_id = particles.colToId();
   arma::mat &r = particles.r();
   arma::mat &v = particles.v();
-  arma::mat &data = particles.data();
+  ParticleData &data = particles.data();
 
   bool useGrid = false;
   int myRank = 0;
@@ -181,6 +181,10 @@ void LoadPdParticles::loadBody(PD_Particles &particles, std::fstream &rawData,
     j++;
   }
   particles.nParticles(j);
+
+  // Only the particles of this rank are kept
+  if (useGrid)
+    particles.shrinkToFit();
 }
 //------------------------------------------------------------------------------
 void LoadPdParticles::loadBinaryBody(PD_Particles &particles, FILE *rawData,
@@ -245,11 +249,11 @@ void LoadPdParticles::loadBinaryBody(PD_Particles &particles, FILE *rawData,
   // Creating the data matrix
   particles.initializeMatrices();
 
-  ivec &idToCol = particles.getIdToCol_v();
+  IdToColMap &idToCol = particles.getIdToCol_v();
   arma::ivec &get_id = particles.colToId();
   arma::mat &r = particles.r();
   arma::mat &v = particles.v();
-  arma::mat &data = particles.data();
+  ParticleData &data = particles.data();
 
   int nColumns = m_nColumns;
 
@@ -0,0 +1,172 @@
+#include "particledata.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+namespace PDtools {
+//------------------------------------------------------------------------------
+namespace {
+const size_t COLUMN_ALIGNMENT = 64;
+
+// Column length rounded up to a whole number of aligned blocks
+size_t paddedBytes(const unsigned int nRows, const size_t valueSize) {
+  const size_t nBytes = nRows * valueSize;
+  return (nBytes + COLUMN_ALIGNMENT - 1) / COLUMN_ALIGNMENT * COLUMN_ALIGNMENT;
+}
+}
+//------------------------------------------------------------------------------
+ParticleData::ParticleData() {}
+//------------------------------------------------------------------------------
+ParticleData::ParticleData(const ParticleData &other) {
+  initialize(other.m_nRows, other.m_nHotColumns);
+  copyColumns(other);
+}
+//------------------------------------------------------------------------------
+ParticleData::ParticleData(ParticleData &&other) { swap(other); }
+//------------------------------------------------------------------------------
+ParticleData &ParticleData::operator=(ParticleData other) {
+  swap(other);
+  return *this;
+}
+//------------------------------------------------------------------------------
+void ParticleData::swap(ParticleData &other) {
+  std::swap(m_nRows, other.m_nRows);
+  m_columns.swap(other.m_columns);
+  m_floatColumns.swap(other.m_floatColumns);
+  m_blocks.swap(other.m_blocks);
+  std::swap(m_hotBlock, other.m_hotBlock);
+  std::swap(m_nHotColumns, other.m_nHotColumns);
+  std::swap(m_nHotUsed, other.m_nHotUsed);
+}
+//------------------------------------------------------------------------------
+ParticleData::~ParticleData() { release(); }
+//------------------------------------------------------------------------------
+void ParticleData::initialize(const unsigned int nRows,
+                              const int nHotColumns) {
+  release();
+  m_nRows = nRows;
+  m_nHotColumns = nHotColumns;
+}
+//------------------------------------------------------------------------------
+void ParticleData::resizeRows(const unsigned int nRows) {
+  // Moves every column to a new allocation of nRows rows. The column
+  // addresses change, the first min(nRows, nRows()) values are kept.
+  if (nRows == m_nRows)
+    return;
+
+  ParticleData resized;
+  resized.initialize(nRows, m_nHotColumns);
+  resized.copyColumns(*this);
+  swap(resized);
+}
+//------------------------------------------------------------------------------
+void ParticleData::allocateColumn(const int k, const FieldType type,
+                                  const bool hot) {
+  if (k >= (int)m_columns.size()) {
+    m_columns.resize(k + 1, nullptr);
+    m_floatColumns.resize(k + 1, nullptr);
+  }
+  if (hasColumn(k))
+    return;
+
+  if (type == FloatField) {
+    m_floatColumns[k] =
+        static_cast<float *>(allocateBlock(paddedBytes(m_nRows, sizeof(float))));
+    return;
+  }
+
+  const size_t columnBytes = paddedBytes(m_nRows, sizeof(double));
+
+  if (hot && m_nHotUsed < m_nHotColumns) {
+    // The hot block is allocated with the first hot column
+    if (m_hotBlock == nullptr) {
+      m_hotBlock =
+          static_cast<double *>(allocateBlock(m_nHotColumns * columnBytes));
+    }
+    const size_t stride = columnBytes / sizeof(double);
+    m_columns[k] = m_hotBlock + m_nHotUsed * stride;
+    m_nHotUsed++;
+    return;
+  }
+
+  m_columns[k] = static_cast<double *>(allocateBlock(columnBytes));
+}
+//------------------------------------------------------------------------------
+void ParticleData::release() {
+  for (void *block : m_blocks) {
+    free(block);
+  }
+  m_blocks.clear();
+  m_columns.clear();
+  m_floatColumns.clear();
+  m_hotBlock = nullptr;
+  m_nHotUsed = 0;
+}
+//------------------------------------------------------------------------------
+size_t ParticleData::allocatedBytes() const {
+  size_t nBytes = 0;
+  for (const double *column : m_columns) {
+    if (column != nullptr)
+      nBytes += paddedBytes(m_nRows, sizeof(double));
+  }
+  for (const float *column : m_floatColumns) {
+    if (column != nullptr)
+      nBytes += paddedBytes(m_nRows, sizeof(float));
+  }
+  // The unused part of the hot block
+  if (m_hotBlock != nullptr)
+    nBytes += (m_nHotColumns - m_nHotUsed) * paddedBytes(m_nRows, sizeof(double));
+  return nBytes;
+}
+//------------------------------------------------------------------------------
+bool ParticleData::isHotColumn(const int k) const {
+  if (m_hotBlock == nullptr || m_columns[k] == nullptr)
+    return false;
+  const size_t stride = paddedBytes(m_nRows, sizeof(double)) / sizeof(double);
+  return m_columns[k] >= m_hotBlock &&
+         m_columns[k] < m_hotBlock + m_nHotColumns * stride;
+}
+//------------------------------------------------------------------------------
+void ParticleData::copyColumns(const ParticleData &other) {
+  // Allocates the columns of other, with the same type and placement, and
+  // copies the rows that fit
+  const unsigned int nCopy = std::min(m_nRows, other.m_nRows);
+  const int nColumns = other.m_columns.size();
+
+  for (int k = 0; k < nColumns; k++) {
+    if (!other.hasColumn(k))
+      continue;
+
+    if (other.type(k) == FloatField) {
+      allocateColumn(k, FloatField);
+      memcpy(m_floatColumns[k], other.m_floatColumns[k], nCopy * sizeof(float));
+      continue;
+    }
+    allocateColumn(k, DoubleField, other.isHotColumn(k));
+    memcpy(m_columns[k], other.m_columns[k], nCopy * sizeof(double));
+  }
+}
+//------------------------------------------------------------------------------
+void *ParticleData::allocateBlock(const size_t nBytes) {
+  void *block = nullptr;
+  if (posix_memalign(&block, COLUMN_ALIGNMENT, nBytes > 0 ? nBytes : 1) != 0) {
+    cerr << "ERROR: could not allocate " << nBytes
+         << " bytes for a particle parameter" << endl;
+    throw AllocationFailed;
+  }
+  memset(block, 0, nBytes);
+  m_blocks.push_back(block);
+  return block;
+}
+//------------------------------------------------------------------------------
+void ParticleData::checkDoubleColumn(const int k) const {
+  if (k >= 0 && k < (int)m_floatColumns.size() && m_floatColumns[k] != nullptr) {
+    cerr << "ERROR: the particle parameter " << k
+         << " is stored as floats, read it with value()" << endl;
+    throw NotADoubleColumn;
+  }
+}
+//------------------------------------------------------------------------------
+}
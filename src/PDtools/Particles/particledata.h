@@ -0,0 +1,136 @@
+#ifndef PARTICLEDATA_H
+#define PARTICLEDATA_H
+
+#include "config.h"
+
+namespace PDtools {
+//------------------------------------------------------------------------------
+// Storage for the per-particle parameters, one column per parameter.
+//
+// Every column is allocated separately, aligned to 64 bytes and only when the
+// parameter is registered, so there is no upper limit on the number of
+// parameters and the column addresses (colptr) stay valid when more
+// parameters are registered. Hot columns, the ones read for the neighbours in
+// the force loops, are allocated side by side in one block. A column may be
+// stored as floats instead, it is then only reachable through floatColptr()
+// and value(). In debug builds reading a float column as doubles throws.
+//------------------------------------------------------------------------------
+class ParticleData {
+public:
+  enum FieldType { DoubleField, FloatField };
+
+  ParticleData();
+  ~ParticleData();
+  ParticleData(const ParticleData &other);
+  ParticleData(ParticleData &&other);
+  ParticleData &operator=(ParticleData other);
+  void swap(ParticleData &other);
+
+  void initialize(const unsigned int nRows, const int nHotColumns);
+  void resizeRows(const unsigned int nRows);
+  void allocateColumn(const int k, const FieldType type = DoubleField,
+                      const bool hot = false);
+  void release();
+
+  bool hasColumn(const int k) const;
+  FieldType type(const int k) const;
+  unsigned int nRows() const;
+  int nColumns() const;
+  size_t allocatedBytes() const;
+
+  double &operator()(const unsigned int i, const int k);
+  const double &operator()(const unsigned int i, const int k) const;
+  double *colptr(const int k);
+  const double *colptr(const int k) const;
+  float *floatColptr(const int k);
+  const float *floatColptr(const int k) const;
+
+  // Value of any column as a double, e.g. for output and MPI transfers
+  double value(const unsigned int i, const int k) const;
+  void setValue(const unsigned int i, const int k, const double value);
+
+protected:
+  unsigned int m_nRows = 0;
+  vector<double *> m_columns;
+  vector<float *> m_floatColumns;
+  vector<void *> m_blocks;
+
+  // Block of adjacent hot columns
+  double *m_hotBlock = nullptr;
+  int m_nHotColumns = 0;
+  int m_nHotUsed = 0;
+
+  enum ErrorCodes { AllocationFailed, NotADoubleColumn };
+
+  void *allocateBlock(const size_t nBytes);
+  void checkDoubleColumn(const int k) const;
+  bool isHotColumn(const int k) const;
+  void copyColumns(const ParticleData &other);
+};
+//------------------------------------------------------------------------------
+// Inline functions
+inline bool ParticleData::hasColumn(const int k) const {
+  return k >= 0 && k < (int)m_columns.size() &&
+         (m_columns[k] != nullptr || m_floatColumns[k] != nullptr);
+}
+
+inline ParticleData::FieldType ParticleData::type(const int k) const {
+  return m_floatColumns[k] != nullptr ? FloatField : DoubleField;
+}
+
+inline unsigned int ParticleData::nRows() const { return m_nRows; }
+
+inline int ParticleData::nColumns() const { return m_columns.size(); }
+
+inline double &ParticleData::operator()(const unsigned int i, const int k) {
+#ifdef DEBUG_MODE
+  checkDoubleColumn(k);
+#endif
+  return m_columns[k][i];
+}
+
+inline const double &ParticleData::operator()(const unsigned int i,
+                                               const int k) const {
+#ifdef DEBUG_MODE
+  checkDoubleColumn(k);
+#endif
+  return m_columns[k][i];
+}
+
+inline double *ParticleData::colptr(const int k) {
+#ifdef DEBUG_MODE
+  checkDoubleColumn(k);
+#endif
+  return m_columns[k];
+}
+
+inline const double *ParticleData::colptr(const int k) const {
+#ifdef DEBUG_MODE
+  checkDoubleColumn(k);
+#endif
+  return m_columns[k];
+}
+
+inline float *ParticleData::floatColptr(const int k) {
+  return m_floatColumns[k];
+}
+
+inline const float *ParticleData::floatColptr(const int k) const {
+  return m_floatColumns[k];
+}
+
+inline double ParticleData::value(const unsigned int i, const int k) const {
+  return m_floatColumns[k] != nullptr ? m_floatColumns[k][i]
+                                      : m_columns[k][i];
+}
+
+inline void ParticleData::setValue(const unsigned int i, const int k,
+                                   const double value) {
+  if (m_floatColumns[k] != nullptr)
+    m_floatColumns[k][i] = value;
+  else
+    m_columns[k][i] = value;
+}
+//------------------------------------------------------------------------------
+}
+#endif // PARTICLEDATA_H
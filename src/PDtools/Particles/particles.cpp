@@ -1,8 +1,23 @@
 #include "particles.h"
 
+#include "PdFunctions/memorytracker.h"
+
+#include <algorithm>
+
 //------------------------------------------------------------------------------
 namespace PDtools {
 //------------------------------------------------------------------------------
+namespace {
+// The id-to-column map stays dense while the id range is at most this many
+// ids per particle row, and always for small id ranges
+const unsigned int DENSE_IDS_PER_ROW = 4;
+const unsigned int MIN_DENSE_IDS = 1 << 16;
+
+unsigned int denseIdLimit(const unsigned int nRows) {
+  return std::max(MIN_DENSE_IDS, DENSE_IDS_PER_ROW * nRows);
+}
+}
+//------------------------------------------------------------------------------
 int Particles::verletUpdateFreq() const { return m_verletUpdateFreq; }
 //------------------------------------------------------------------------------
 void Particles::setVerletUpdateFreq(int verletUpdateFreq) {
@@ -39,7 +54,7 @@ int Particles::getNeedGhostR0() const { return m_needGhostR0; }
 //------------------------------------------------------------------------------
 void Particles::setNeedGhostR0(int needGhostR0) { m_needGhostR0 = needGhostR0; }
 //------------------------------------------------------------------------------
-ivec &Particles::getIdToCol_v() { return m_idToCol_v; }
+IdToColMap &Particles::getIdToCol_v() { return m_idToCol_v; }
 //------------------------------------------------------------------------------
 Particles::Particles() {}
 //------------------------------------------------------------------------------
@@ -51,13 +66,119 @@ void Particles::initializeMatrices() {
          << endl;
     throw ZeroParticles;
   }
-  m_r = mat(PARTICLE_BUFFER * m_maxParticles, M_DIM);
-  m_v = mat(m_maxParticles * PARTICLE_BUFFER, M_DIM);
-  m_data = mat(PARTICLE_BUFFER * m_maxParticles, PARAMETER_BUFFER);
-  m_colToId = ivec(PARTICLE_BUFFER * m_maxParticles);
-  m_isStatic = zeros<ivec>(PARTICLE_BUFFER * m_maxParticles);
+  // Sized to the loaded particles, ghosts and new particles grow the storage
+  // on demand
+  m_capacity = m_nParticles;
+  m_r = mat(m_capacity, M_DIM);
+  m_v = mat(m_capacity, M_DIM);
+  m_data.initialize(m_capacity, m_hotParameters.size());
+  // The parameters given in the input files
+  for (const auto &param : m_parameters) {
+    allocateParameter(param.first, param.second);
+  }
+  m_colToId = ivec(m_capacity);
+  m_isStatic = zeros<ivec>(m_capacity);
   m_newId = m_maxParticles;
-  m_idToCol_v = zeros<ivec>(PARTICLE_BUFFER * m_maxParticles);
+
+  // Dense over the id range, unless this rank holds a small slice of it
+  IdToColMap::Mode mode = IdToColMap::Dense;
+  if (m_idToColModeFixed)
+    mode = m_idToCol_v.mode();
+  else if (m_maxParticles > denseIdLimit(m_nParticles))
+    mode = IdToColMap::Hashed;
+  m_idToCol_v.initialize(
+      mode == IdToColMap::Dense ? m_maxParticles : m_nParticles, mode);
+}
+//------------------------------------------------------------------------------
+void Particles::reserve(const unsigned int nRows) {
+  if (nRows <= m_capacity)
+    return;
+
+  resizeStorage(nRows);
+  for (ParticleStorageSubscriber *subscriber : m_storageSubscribers) {
+    subscriber->storageResized();
+  }
+}
+//------------------------------------------------------------------------------
+void Particles::growStorage(const unsigned int nRows) {
+  // Geometric growth, amortized constant cost per added particle
+  const unsigned int grown = 1.5 * m_capacity + 1;
+  reserve(std::max(nRows, grown));
+}
+//------------------------------------------------------------------------------
+void Particles::shrinkToFit() {
+  const unsigned int nRows = std::max(1u, m_nParticles + m_nGhostParticles);
+
+  // A rank holding a small slice of the global ids
+  if (!m_idToColModeFixed && m_idToCol_v.mode() == IdToColMap::Dense &&
+      m_idToCol_v.denseSize() > denseIdLimit(nRows)) {
+    m_idToCol_v.setMode(IdToColMap::Hashed);
+  }
+
+  if (nRows >= m_capacity)
+    return;
+
+  resizeStorage(nRows);
+  for (ParticleStorageSubscriber *subscriber : m_storageSubscribers) {
+    subscriber->storageResized();
+  }
+}
+//------------------------------------------------------------------------------
+void Particles::growIdToCol(const int id) {
+  // Ids beyond the dense range, e.g. from node splitting, switch the map to
+  // hashed unless the mode is set explicitly
+  if (m_idToColModeFixed || (unsigned int)id < denseIdLimit(m_capacity)) {
+    m_idToCol_v.resizeDense(
+        std::max<size_t>(id + 1, 1.5 * m_idToCol_v.denseSize()));
+    return;
+  }
+  m_idToCol_v.setMode(IdToColMap::Hashed);
+}
+//------------------------------------------------------------------------------
+void Particles::idToColMode(const IdToColMap::Mode mode) {
+  m_idToColModeFixed = true;
+  m_idToCol_v.setMode(mode);
+}
+//------------------------------------------------------------------------------
+void Particles::resizeStorage(const unsigned int capacity) {
+  // Resized in place, so references to the matrices stay valid
+  m_r.resize(capacity, M_DIM);
+  m_v.resize(capacity, M_DIM);
+  m_data.resizeRows(capacity);
+  m_colToId.resize(capacity);
+  m_isStatic.resize(capacity);
+  m_capacity = capacity;
+}
+//------------------------------------------------------------------------------
+void Particles::subscribeStorage(ParticleStorageSubscriber *subscriber) {
+  if (std::find(m_storageSubscribers.begin(), m_storageSubscribers.end(),
+                subscriber) == m_storageSubscribers.end()) {
+    m_storageSubscribers.push_back(subscriber);
+  }
+}
+//------------------------------------------------------------------------------
+void Particles::unsubscribeStorage(ParticleStorageSubscriber *subscriber) {
+  m_storageSubscribers.erase(std::remove(m_storageSubscribers.begin(),
+                                         m_storageSubscribers.end(),
+                                         subscriber),
+                             m_storageSubscribers.end());
+}
+//------------------------------------------------------------------------------
+size_t Particles::matrixBytes() const {
+  return MemoryTracker::matBytes(m_r) + MemoryTracker::matBytes(m_v) +
+         MemoryTracker::matBytes(m_colToId) +
+         MemoryTracker::matBytes(m_isStatic) + m_idToCol_v.allocatedBytes();
+}
+//------------------------------------------------------------------------------
+size_t Particles::verletListBytes() const {
+  size_t nBytes = MemoryTracker::vectorBytes(m_verletLists);
+  for (const unordered_map<int, vector<int>> &verletList : m_verletLists) {
+    nBytes += MemoryTracker::mapBytes(verletList);
+    for (const auto &id_list : verletList) {
+      nBytes += MemoryTracker::vectorBytes(id_list.second);
+    }
+  }
+  return nBytes;
 }
 //------------------------------------------------------------------------------
 const string &Particles::type() const { return m_type; }
@@ -75,7 +196,7 @@ int Particles::nGhostParticles() { return m_nGhostParticles; }
 void Particles::nGhostParticles(int ngp) { m_nGhostParticles = ngp; }
 //------------------------------------------------------------------------------
 void Particles::deleteParticleById(const int deleteId) {
-  const int deleteCol = m_idToCol_v[deleteId];
+  const int deleteCol = m_idToCol_v.at(deleteId);
   const int moveCol = m_nParticles - 1;
   const int moveId = m_colToId.at(moveCol);
 
@@ -86,10 +207,11 @@ void Particles::deleteParticleById(const int deleteId) {
 
   for (const auto &param : m_parameters) {
     const int pos = param.second;
-    m_data(deleteCol, pos) = m_data(moveCol, pos);
+    m_data.setValue(deleteCol, pos, m_data.value(moveCol, pos));
   }
 
   m_colToId[deleteCol] = moveId;
+  m_idToCol_v.erase(deleteId);
   m_idToCol_v[moveId] = deleteCol;
   m_nParticles--;
   //    cout << "delete: " << deleteId << " col:" << deleteCol;
@@ -151,7 +273,7 @@ void Particles::setParameter(string paramId, double value) {
   int param_pos = m_parameters.at(paramId);
 
   for (unsigned int p = 0; p < m_nParticles; p++) {
-    m_data(p, param_pos) = value;
+    m_data.setValue(p, param_pos, value);
   }
 }
 //------------------------------------------------------------------------------
@@ -165,14 +287,11 @@ int Particles::registerParameter(string paramId, double value) {
     return m_parameters.at(paramId);
   }
 
-  m_parameters[paramId] = m_parameters.size();
-  int param_pos = m_parameters[paramId];
-
-  if (param_pos >= PARAMETER_BUFFER) {
-    cerr << "The number of parameters per particle is limited to"
-         << PARAMETER_BUFFER << endl;
-    throw OutOfBounds;
-  }
+  const int param_pos = m_parameters.size();
+  m_parameters[paramId] = param_pos;
+  allocateParameter(paramId, param_pos);
+  if (!m_data.hasColumn(param_pos))
+    return param_pos;
 
   for (unsigned int p = 0; p < m_nParticles; p++) {
     m_data(p, param_pos) = value;
@@ -181,25 +300,29 @@ int Particles::registerParameter(string paramId, double value) {
   return param_pos;
 }
 //------------------------------------------------------------------------------
+void Particles::allocateParameter(const string &paramId, const int param_pos) {
+  // Parameters registered before initializeMatrices() are allocated there
+  if (m_data.nRows() == 0)
+    return;
+
+  const bool hot = std::find(m_hotParameters.begin(), m_hotParameters.end(),
+                             paramId) != m_hotParameters.end();
+  m_data.allocateColumn(param_pos, ParticleData::DoubleField, hot);
+}
+//------------------------------------------------------------------------------
 void Particles::scaleParameter(const string &paramId, double value) {
   //    m_parameters[paramId] = m_parameters.size();
-  int param_pos = m_parameters[paramId];
-
-  if (param_pos >= PARAMETER_BUFFER) {
-    cerr << "The number of parameters per particle is limited to"
-         << PARAMETER_BUFFER << endl;
-    throw OutOfBounds;
-  }
+  int param_pos = m_parameters.at(paramId);
 
   for (unsigned int p = 0; p < m_nParticles; p++) {
-    m_data(p, param_pos) *= value;
+    m_data.setValue(p, param_pos, m_data.value(p, param_pos) * value);
   }
 }
 //------------------------------------------------------------------------------
 mat &Particles::r() { return m_r; }
 mat &Particles::v() { return m_v; }
 ivec &Particles::colToId() { return m_colToId; }
-mat &Particles::data() { return m_data; }
+ParticleData &Particles::data() { return m_data; }
 ivec &Particles::isStatic() { return m_isStatic; }
 }
 //------------------------------------------------------------------------------
@@ -2,7 +2,22 @@
 #define PARTICLES_H
 
 #include "config.h"
+#include "idtocolmap.h"
+#include "particledata.h"
+
+#include <algorithm>
+
 namespace PDtools {
+//------------------------------------------------------------------------------
+// Notified after the particle storage has been reallocated, to refresh
+// cached column pointers (colptr). References to the matrices and to data()
+// stay valid.
+class ParticleStorageSubscriber {
+public:
+  virtual ~ParticleStorageSubscriber() {}
+  virtual void storageResized() = 0;
+};
+
 //------------------------------------------------------------------------------
 // Storing all particle data
 //------------------------------------------------------------------------------
@@ -13,18 +28,25 @@ protected:
   unsigned int m_nParticles = 0;
   unsigned int m_totParticles = 0;
   unsigned int m_maxParticles = 1e8;
+  // Rows allocated for local and ghost particles
+  unsigned int m_capacity = 0;
+  vector<ParticleStorageSubscriber *> m_storageSubscribers;
   int m_dim = 0;
 
   // All particles
   mat m_r;
   mat m_v;
-  mat m_data;
+  ParticleData m_data;
   ivec m_colToId;
   ivec m_isStatic;
-  ivec m_idToCol_v;
+  IdToColMap m_idToCol_v;
+  bool m_idToColModeFixed = false;
 
   // General properties
   unordered_map<string, int> m_parameters;
+  // Read for the neighbours in the force loops, stored side by side
+  vector<string> m_hotParameters = {"volume", "micromodulus", "theta",
+                                    "LPS_mass"};
   int m_verletUpdateFreq = 30;
   unordered_map<string, int> m_verletListIds;
   vector<unordered_map<int, vector<int>>> m_verletLists;
@@ -42,6 +64,11 @@ protected:
     ParameterDoesNotExist
   };
 
+  void allocateParameter(const string &paramId, const int param_pos);
+  virtual void resizeStorage(const unsigned int capacity);
+  void growStorage(const unsigned int nRows);
+  void growIdToCol(const int id);
+
 public:
   Particles();
   virtual ~Particles();
@@ -59,16 +86,31 @@ public:
   int nGhostParticles();
   mat &r();
   mat &v();
-  ivec &getIdToCol_v();
+  IdToColMap &getIdToCol_v();
+  void idToColMode(const IdToColMap::Mode mode);
 
   ivec &colToId();
 
-  mat &data();
+  ParticleData &data();
 
   ivec &isStatic();
 
   virtual void deleteParticleById(const int deleteId);
 
+  // Storage for local and ghost particles. Grows geometrically, and must only
+  // be resized outside of parallel regions.
+  unsigned int capacity() const;
+  void reserve(const unsigned int nRows);
+  void ensureCapacity(const unsigned int nRows);
+  void ensureIdCapacity(const int id);
+  void shrinkToFit();
+  void subscribeStorage(ParticleStorageSubscriber *subscriber);
+  void unsubscribeStorage(ParticleStorageSubscriber *subscriber);
+
+  // The heap of the per-particle matrices and of the verlet lists
+  virtual size_t matrixBytes() const;
+  size_t verletListBytes() const;
+
   unordered_map<string, int> &parameters();
 
   int parameters(const string &id);
@@ -111,5 +153,18 @@ inline void Particles::maxParticles(int mp) { m_maxParticles = mp; }
 inline void Particles::totParticles(int mp) { m_totParticles = mp; }
 
 inline unsigned int Particles::totParticles() const { return m_totParticles; }
+
+inline unsigned int Particles::capacity() const { return m_capacity; }
+
+inline void Particles::ensureCapacity(const unsigned int nRows) {
+  if (nRows > m_capacity)
+    growStorage(nRows);
+}
+
+inline void Particles::ensureIdCapacity(const int id) {
+  if (m_idToCol_v.mode() == IdToColMap::Dense &&
+      (unsigned int)id >= m_idToCol_v.denseSize())
+    growIdToCol(id);
+}
 }
 #endif // PARTICLES_H
@@ -1,5 +1,8 @@
 #include "pd_particles.h"
 #include "PDtools/Elements/pd_element.h"
+#include "PdFunctions/memorytracker.h"
+
+#include <algorithm>
 
 //------------------------------------------------------------------------------
 namespace PDtools {
@@ -60,7 +63,7 @@ void PD_Particles::uppdateR_prev() {
   }
 }
 //------------------------------------------------------------------------------
-PD_Particles::PD_Particles() {}
+PD_Particles::PD_Particles() : m_bondLayout(std::make_shared<BondLayout>()) {}
 //------------------------------------------------------------------------------
 void PD_Particles::initializeElements(const size_t nTriangles,
                                       const size_t nQuads,
@@ -78,11 +81,21 @@ void PD_Particles::initializeElements(const size_t nTriangles,
 void PD_Particles::initializeMatrices() {
   Particles::initializeMatrices();
 
-  m_r0 = mat(m_maxParticles * PARTICLE_BUFFER, M_DIM);
-  m_r_prev = mat(m_maxParticles * PARTICLE_BUFFER, M_DIM);
-  m_F = mat(m_maxParticles * PARTICLE_BUFFER, M_DIM);
-  m_stableMass = vec(m_maxParticles * PARTICLE_BUFFER);
-  m_Fold = mat(m_maxParticles * PARTICLE_BUFFER, M_DIM);
+  m_r0 = mat(m_capacity, M_DIM);
+  m_r_prev = mat(m_capacity, M_DIM);
+  m_F = mat(m_capacity, M_DIM);
+  m_stableMass = vec(m_capacity);
+  m_Fold = mat(m_capacity, M_DIM);
+}
+//------------------------------------------------------------------------------
+void PD_Particles::resizeStorage(const unsigned int capacity) {
+  Particles::resizeStorage(capacity);
+
+  m_r0.resize(capacity, M_DIM);
+  m_r_prev.resize(capacity, M_DIM);
+  m_F.resize(capacity, M_DIM);
+  m_stableMass.resize(capacity);
+  m_Fold.resize(capacity, M_DIM);
 }
 //------------------------------------------------------------------------------
 void PD_Particles::initializeBodyForces() {
@@ -91,7 +104,7 @@ void PD_Particles::initializeBodyForces() {
 }
 //------------------------------------------------------------------------------
 void PD_Particles::deleteParticleById(const int deleteId) {
-  const int deleteCol = m_idToCol_v[deleteId];
+  const int deleteCol = m_idToCol_v.at(deleteId);
   const int moveCol = m_nParticles - 1;
   const int moveId = m_colToId.at(moveCol);
 
@@ -109,22 +122,289 @@ void PD_Particles::deleteParticleById(const int deleteId) {
 
   for (const auto &param : m_parameters) {
     const int pos = param.second;
-    m_data(deleteCol, pos) = m_data(moveCol, pos);
+    m_data.setValue(deleteCol, pos, m_data.value(moveCol, pos));
   }
   m_PdConnections[deleteId].clear();
   m_PdConnections[deleteId] = m_PdConnections[moveId];
+  if (moveCol < (int)m_connectedBits.size()) {
+    m_connectedBits[deleteCol] = m_connectedBits[moveCol];
+    m_neighbourCols[deleteCol] = m_neighbourCols[moveCol];
+  }
   m_colToId[deleteCol] = moveId;
   m_colToId[moveCol] = -1;
+  m_idToCol_v.erase(deleteId);
   m_idToCol_v[moveId] = deleteCol;
   m_nParticles--;
   //    cout << " Ferdig: delete:" << deleteId << " delCol:" <<deleteCol << "
   //    moveCol:" << moveCol << endl;
 }
 //------------------------------------------------------------------------------
+void PD_Particles::setPdConnections(int id, BondList connections) {
+  if (connections.layout() == m_bondLayout.get() ||
+      connections.layout() == nullptr) {
+    m_PdConnections[id] = std::move(connections);
+    return;
+  }
+
+  // Bonds of another particle set, e.g. a discretization, are stored again
+  // with the layout of these particles
+  BondList &PDconnections = m_PdConnections[id];
+  PDconnections = BondList(*m_bondLayout);
+  PDconnections.reserve(connections.size());
+  for (const auto &con : connections) {
+    vector<double> values(con.second.size());
+    for (unsigned int k = 0; k < values.size(); k++) {
+      values[k] = con.second[k];
+    }
+    PDconnections.push_back(con.first, values);
+  }
+}
+//------------------------------------------------------------------------------
+void PD_Particles::bondStorage(const BondData::Storage storage) {
+  m_bondLayout->storage(storage);
+}
+//------------------------------------------------------------------------------
+bool PD_Particles::breakBond(const int id_i, pair<int, BondData> &con) {
+  // Breaks the bond 'con', an element of the connection list of id_i, and
+  // records the event. May be called from the threads of a parallel
+  // particle loop. All breaks go through here, so that the "connected" bond
+  // parameter and its packed copy agree. False if the bond was broken
+  // already.
+  BondList &PDconnections = m_PdConnections.at(id_i);
+  const int l_j = &con - PDconnections.data();
+  const IdToColMap &idToCol = m_idToCol_v;
+  const int i = idToCol[id_i];
+
+  if (i >= 0 && i < (int)m_connectedBits.size() && m_colToId(i) == id_i) {
+    // The bit decides the thread that breaks a bond broken by two at once
+    const uint64_t bit = uint64_t(1) << (l_j % 64);
+    uint64_t &word = m_connectedBits[i][l_j / 64];
+    uint64_t previous;
+#ifdef USE_OPENMP
+#pragma omp atomic capture
+#endif
+    {
+      previous = word;
+      word &= ~bit;
+    }
+    if (!(previous & bit))
+      return false;
+  } else if (con.second[m_indexConnected] <= 0.5) {
+    return false;
+  }
+
+  con.second[m_indexConnected] = 0;
+#ifdef USE_OPENMP
+#pragma omp critical(pdBondBreak)
+#endif
+  m_brokenBonds.push_back(BondBreak{id_i, con.first, l_j});
+  return true;
+}
+//------------------------------------------------------------------------------
+void PD_Particles::buildBondCache() {
+  // Must be called when the local particles or their connection lists
+  // change other than by breakBond(), e.g. after an MPI exchange or a node
+  // split. Invalidates the bond coefficients cached by the forces.
+  m_connectedBits.resize(m_nParticles);
+  m_neighbourCols.resize(m_nParticles);
+  const bool hasConnected = m_indexConnected >= 0;
+  const IdToColMap &idToCol = m_idToCol_v;
+  size_t nBonds = 0;
+
+#ifdef USE_OPENMP
+#pragma omp parallel for reduction(+ : nBonds)
+#endif
+  for (unsigned int i = 0; i < m_nParticles; i++) {
+    vector<uint64_t> &words = m_connectedBits[i];
+    vector<int> &cols = m_neighbourCols[i];
+    const auto it = m_PdConnections.find(m_colToId(i));
+    if (it == m_PdConnections.end()) {
+      words.clear();
+      cols.clear();
+      continue;
+    }
+    const BondList &PDconnections = it->second;
+    const int nConnections = PDconnections.size();
+    words.assign((nConnections + 63) / 64, 0);
+    cols.resize(nConnections);
+    nBonds += nConnections;
+
+    for (int l_j = 0; l_j < nConnections; l_j++) {
+      if (!hasConnected || PDconnections[l_j].second[m_indexConnected] > 0.5)
+        words[l_j / 64] |= uint64_t(1) << (l_j % 64);
+      cols[l_j] = idToCol[PDconnections[l_j].first];
+    }
+  }
+  m_nCachedBonds = nBonds;
+  m_bondCacheStamp++;
+}
+//------------------------------------------------------------------------------
+void PD_Particles::updateNeighbourColumns() {
+  // Must be called when the columns move without the connection lists
+  // changing, e.g. when the ghost particles are exchanged
+  const unsigned int nCols =
+      std::min<size_t>(m_nParticles, m_neighbourCols.size());
+  const IdToColMap &idToCol = m_idToCol_v;
+
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+  for (unsigned int i = 0; i < nCols; i++) {
+    vector<int> &cols = m_neighbourCols[i];
+    const auto it = m_PdConnections.find(m_colToId(i));
+    if (it == m_PdConnections.end())
+      continue;
+    const BondList &PDconnections = it->second;
+    const int nConnections = cols.size();
+
+    for (int l_j = 0; l_j < nConnections; l_j++) {
+      cols[l_j] = idToCol[PDconnections[l_j].first];
+    }
+  }
+}
+//------------------------------------------------------------------------------
+void PD_Particles::subscribeBondBreaks(BondBreakSubscriber *subscriber) {
+  // A new subscriber starts from the current bonds, the pending events are
+  // only for the previous ones
+  publishBondBreaks();
+  if (std::find(m_bondBreakSubscribers.begin(), m_bondBreakSubscribers.end(),
+                subscriber) == m_bondBreakSubscribers.end()) {
+    m_bondBreakSubscribers.push_back(subscriber);
+  }
+}
+//------------------------------------------------------------------------------
+void PD_Particles::unsubscribeBondBreaks(BondBreakSubscriber *subscriber) {
+  m_bondBreakSubscribers.erase(std::remove(m_bondBreakSubscribers.begin(),
+                                           m_bondBreakSubscribers.end(),
+                                           subscriber),
+                               m_bondBreakSubscribers.end());
+}
+//------------------------------------------------------------------------------
+void PD_Particles::markConnectionsChanged(const int id) {
+  // The connection list of the local particle id was replaced or rewired
+  // other than by breakBond(). Not thread safe.
+  m_changedConnections.push_back(id);
+}
+//------------------------------------------------------------------------------
+void PD_Particles::publishBondBreaks() {
+  // Must be called before the particles change columns or ranks, the events
+  // refer to the current local particles.
+  if (m_brokenBonds.empty() && m_changedConnections.empty())
+    return;
+
+  // The bond index l_j of a break is not valid in a replaced connection
+  // list, those particles are recomputed instead
+  std::sort(m_changedConnections.begin(), m_changedConnections.end());
+  m_changedConnections.erase(std::unique(m_changedConnections.begin(),
+                                         m_changedConnections.end()),
+                             m_changedConnections.end());
+  if (!m_changedConnections.empty()) {
+    const vector<int> &changed = m_changedConnections;
+    m_brokenBonds.erase(
+        std::remove_if(m_brokenBonds.begin(), m_brokenBonds.end(),
+                       [&changed](const BondBreak &bondBreak) {
+                         return std::binary_search(changed.begin(),
+                                                   changed.end(),
+                                                   bondBreak.id_i);
+                       }),
+        m_brokenBonds.end());
+  }
+
+  // The order of the threads is arbitrary, the subscribers get the events
+  // sorted by particle and bond.
+  std::sort(m_brokenBonds.begin(), m_brokenBonds.end(),
+            [](const BondBreak &a, const BondBreak &b) {
+              return a.id_i < b.id_i || (a.id_i == b.id_i && a.l_j < b.l_j);
+            });
+
+  for (BondBreakSubscriber *subscriber : m_bondBreakSubscribers) {
+    if (!m_brokenBonds.empty())
+      subscriber->bondsBroken(m_brokenBonds);
+    if (!m_changedConnections.empty())
+      subscriber->connectionsChanged(m_changedConnections);
+  }
+  m_brokenBonds.clear();
+  m_changedConnections.clear();
+}
+//------------------------------------------------------------------------------
 const unordered_map<string, int> &PD_Particles::PdParameters() const {
   return m_PdParameters;
 }
 //------------------------------------------------------------------------------
+size_t PD_Particles::matrixBytes() const {
+  return Particles::matrixBytes() + MemoryTracker::matBytes(m_r0) +
+         MemoryTracker::matBytes(m_r_prev) + MemoryTracker::matBytes(m_F) +
+         MemoryTracker::matBytes(m_b) + MemoryTracker::matBytes(m_u) +
+         MemoryTracker::matBytes(m_stableMass) +
+         MemoryTracker::matBytes(m_Fold);
+}
+//------------------------------------------------------------------------------
+size_t PD_Particles::connectionBytes() const {
+  // The parameters of the bonds of a particle are one allocation
+  size_t nBytes = MemoryTracker::mapBytes(m_PdConnections);
+  for (const auto &id_connections : m_PdConnections) {
+    nBytes += id_connections.second.allocatedBytes();
+  }
+  return nBytes;
+}
+//------------------------------------------------------------------------------
+size_t PD_Particles::nConnections() const {
+  size_t nBonds = 0;
+  for (const auto &id_connections : m_PdConnections) {
+    nBonds += id_connections.second.size();
+  }
+  return nBonds;
+}
+//------------------------------------------------------------------------------
+size_t PD_Particles::bondCacheBytes() const {
+  size_t nBytes = MemoryTracker::vectorBytes(m_connectedBits) +
+                  MemoryTracker::vectorBytes(m_neighbourCols);
+  for (const vector<uint64_t> &words : m_connectedBits) {
+    nBytes += MemoryTracker::vectorBytes(words);
+  }
+  for (const vector<int> &cols : m_neighbourCols) {
+    nBytes += MemoryTracker::vectorBytes(cols);
+  }
+  return nBytes;
+}
+//------------------------------------------------------------------------------
+size_t PD_Particles::ghostListBytes() const {
+  size_t nBytes = MemoryTracker::mapBytes(m_sendtParticles) +
+                  MemoryTracker::mapBytes(m_receivedParticles) +
+                  MemoryTracker::vectorBytes(m_sendtParticles2) +
+                  MemoryTracker::vectorBytes(m_receivedParticles2);
+  for (const auto &rank_ids : m_sendtParticles) {
+    nBytes += MemoryTracker::vectorBytes(rank_ids.second);
+  }
+  for (const auto &rank_ids : m_receivedParticles) {
+    nBytes += MemoryTracker::vectorBytes(rank_ids.second);
+  }
+  for (const vector<int> &ids : m_sendtParticles2) {
+    nBytes += MemoryTracker::vectorBytes(ids);
+  }
+  for (const vector<int> &ids : m_receivedParticles2) {
+    nBytes += MemoryTracker::vectorBytes(ids);
+  }
+  return nBytes;
+}
+//------------------------------------------------------------------------------
+size_t PD_Particles::elementBytes() const {
+  size_t nBytes = MemoryTracker::vectorBytes(m_triElements) +
+                  MemoryTracker::vectorBytes(m_quadElements) +
+                  MemoryTracker::mapBytes(m_idToElement) +
+                  MemoryTracker::mapBytes(m_elementToId) +
+                  MemoryTracker::matBytes(m_gaussianPoints) +
+                  MemoryTracker::matBytes(m_shapeFunction) +
+                  MemoryTracker::matBytes(m_gaussianWeights);
+  for (const PD_triElement &element : m_triElements) {
+    nBytes += element.allocatedBytes();
+  }
+  for (const PD_quadElement &element : m_quadElements) {
+    nBytes += element.allocatedBytes();
+  }
+  return nBytes;
+}
+//------------------------------------------------------------------------------
 int PD_Particles::getPdParamId(string paramId) const {
   if (m_PdParameters.count(paramId) != 1) {
     cerr << "ERROR: accessing a PD_particles parameter that does not exist: "
@@ -134,7 +414,8 @@ int PD_Particles::getPdParamId(string paramId) const {
   return m_PdParameters.at(paramId);
 }
 //------------------------------------------------------------------------------
-int PD_Particles::registerPdParameter(string paramId, double value) {
+int PD_Particles::registerPdParameter(string paramId, double value,
+                                      const BondData::Precision precision) {
   if (m_PdParameters.count(paramId) == 1) {
 #ifdef DEBUG
     cerr << "WARNING: PD-parameter already registered: " << paramId << endl;
@@ -144,17 +425,51 @@ int PD_Particles::registerPdParameter(string paramId, double value) {
   int pos = m_PdParameters.size();
   m_PdParameters[paramId] = pos;
 
-  // Adding the new parameter to all connections
-  for (unsigned int col = 0; col < m_nParticles; col++) {
-    const int id = m_colToId(col);
-    for (auto &con : m_PdConnections[id]) {
-      con.second.push_back(value);
-    }
+  // A layout still shared with a copy of the particles is copied first
+  if (m_bondLayout.use_count() > 1)
+    m_bondLayout = std::make_shared<BondLayout>(*m_bondLayout);
+  m_bondLayout->addParameter(precision);
+
+  if (paramId == "connected")
+    m_indexConnected = pos;
+
+  // Adding the new parameter to all connections, the ghosts included since
+  // the layout has changed
+  for (auto &id_connections : m_PdConnections) {
+    id_connections.second.addParameters(*m_bondLayout, value);
   }
 
   return pos;
 }
 //------------------------------------------------------------------------------
+vector<double> PD_Particles::bondPrecisionErrors() const {
+  // The largest relative difference, over the local bonds, between each
+  // bond parameter and its value at the registered precision. Zero for the
+  // double parameters, and in the mixed storage where the values are already
+  // reduced. Used to validate the precisions with all-double storage.
+  const int nParams = m_PdParameters.size();
+  vector<double> maxErrors(nParams, 0);
+
+  for (unsigned int i = 0; i < m_nParticles; i++) {
+    const auto it = m_PdConnections.find(m_colToId(i));
+    if (it == m_PdConnections.end())
+      continue;
+
+    for (const auto &con : it->second) {
+      for (int k = 0; k < nParams; k++) {
+        const double value = con.second[k];
+        const double reduced =
+            BondData::reduced(value, m_bondLayout->registeredPrecision(k));
+        double error = fabs(value - reduced);
+        if (value != 0)
+          error /= fabs(value);
+        maxErrors[k] = std::max(maxErrors[k], error);
+      }
+    }
+  }
+  return maxErrors;
+}
+//------------------------------------------------------------------------------
 void PD_Particles::dimensionalScaling(const double E0, const double L0,
                                       const double v0, const double t0,
                                       const double rho0) {
@@ -185,6 +500,8 @@ void PD_Particles::dimensionalScaling(const double E0, const double L0,
       m_data(i, pos_scaling.first) /= pos_scaling.second;
     }
   }
+  // The volumes changed
+  m_bondCacheStamp++;
 }
 //------------------------------------------------------------------------------
 void PD_Particles::clearGhostParameters() {
@@ -1,8 +1,12 @@
 #ifndef PD_PARTICLES_H
 #define PD_PARTICLES_H
 
+#include "bonddata.h"
 #include "particles.h"
 
+#include <cstdint>
+#include <memory>
+
 namespace PDtools {
 
 class PD_triElement;
@@ -14,6 +18,27 @@ struct ConnectionData {
   vector<double> i_data;
 };
 
+//------------------------------------------------------------------------------
+// A bond broken during the current step: the bond l_j in the connection list
+// of the local particle id_i, connecting it to id_j.
+struct BondBreak {
+  int id_i;
+  int id_j;
+  int l_j;
+};
+
+//------------------------------------------------------------------------------
+// Receives the bonds broken since the previous publication, to update
+// bond-derived quantities for the involved particles only. Particles whose
+// connection list was replaced, e.g. by a node split, are published to
+// connectionsChanged() instead, and their quantities are recomputed.
+class BondBreakSubscriber {
+public:
+  virtual ~BondBreakSubscriber() {}
+  virtual void bondsBroken(const vector<BondBreak> &brokenBonds) = 0;
+  virtual void connectionsChanged(const vector<int> &ids) = 0;
+};
+
 //------------------------------------------------------------------------------
 // Extending the particle struct for PD-data
 //------------------------------------------------------------------------------
@@ -31,7 +56,10 @@ protected:
   vec m_stableMass;
   mat m_Fold;
 
-  unordered_map<int, vector<pair<int, vector<double>>>> m_PdConnections;
+  unordered_map<int, BondList> m_PdConnections;
+  // The offsets and precisions of the bond parameters, shared with the copies
+  // of the particles until one of them registers a parameter
+  std::shared_ptr<BondLayout> m_bondLayout;
   //    unordered_map<int, vector<ConnectionData>> m_PdConnections;
   unordered_map<string, int> m_PdParameters;
 
@@ -46,11 +74,36 @@ protected:
   vector<PD_triElement> m_triElements;
   vector<PD_quadElement> m_quadElements;
 
+  // Bond-break events and their subscribers
+  vector<BondBreak> m_brokenBonds;
+  vector<int> m_changedConnections;
+  vector<BondBreakSubscriber *> m_bondBreakSubscribers;
+  int m_indexConnected = -1;
+
+  // Packed copy of the "connected" bond parameter, per local column. Bit l_j
+  // is set when bond l_j in the connection list is connected. Built from the
+  // parameter by buildBondCache(), after that both are only changed by
+  // breakBond(). The loops of the solver steps read the bits. The parameter,
+  // an 8-bit flag, stays the record of the bond: it seeds the bits, moves
+  // with the connection lists between the cores, and serves the ghosts and
+  // the setup before the solver builds the cache (initialize(), the weighted
+  // volumes).
+  vector<vector<uint64_t>> m_connectedBits;
+  // The column of the particle at the other end of bond l_j, per local
+  // column, so the force loops do not look up the id-to-column map
+  vector<vector<int>> m_neighbourCols;
+  size_t m_nCachedBonds = 0;
+  // Incremented when the cache is rebuilt, the caches derived from the
+  // connection lists (e.g. Force::updateBondCache()) are stale when it differs
+  unsigned long m_bondCacheStamp = 0;
+
   // For gaussian integration
   mat m_gaussianPoints;
   mat m_shapeFunction;
   vec m_gaussianWeights;
 
+  virtual void resizeStorage(const unsigned int capacity);
+
 public:
   PD_Particles();
 
@@ -61,12 +114,30 @@ public:
 
   void initializeBodyForces();
 
-  void setPdConnections(int id, vector<pair<int, vector<double>>> connections);
+  void setPdConnections(int id, BondList connections);
 
-  vector<pair<int, vector<double>>> &pdConnections(int id);
+  BondList &pdConnections(int id);
+  const BondLayout &bondLayout() const;
+  void bondStorage(const BondData::Storage storage);
 
   virtual void deleteParticleById(const int deleteId);
 
+  bool breakBond(const int id_i, pair<int, BondData> &con);
+  void subscribeBondBreaks(BondBreakSubscriber *subscriber);
+  void unsubscribeBondBreaks(BondBreakSubscriber *subscriber);
+  void markConnectionsChanged(const int id);
+  void publishBondBreaks();
+
+  void buildBondCache();
+  void updateNeighbourColumns();
+  const vector<uint64_t> &connectedBits(const int i) const;
+  const vector<int> &neighbourColumns(const int i) const;
+  int nConnectedBonds(const int i) const;
+  size_t nCachedBonds() const;
+  unsigned long bondCacheStamp() const;
+  template <typename Function>
+  void forEachConnectedBond(const int i, Function f) const;
+
   mat &r0();
   mat &r_prev();
   mat &F();
@@ -77,9 +148,20 @@ public:
 
   const unordered_map<string, int> &PdParameters() const;
 
+  virtual size_t matrixBytes() const;
+  size_t connectionBytes() const;
+  size_t nConnections() const;
+  size_t bondCacheBytes() const;
+  size_t ghostListBytes() const;
+  size_t elementBytes() const;
+
+  vector<double> bondPrecisionErrors() const;
+
   int getPdParamId(string paramId) const;
 
-  int registerPdParameter(string paramId, double value = 0);
+  int registerPdParameter(
+      string paramId, double value = 0,
+      const BondData::Precision precision = BondData::Double);
 
   void dimensionalScaling(const double E0, const double L0, const double v0,
                           const double t0, const double rho0);
@@ -109,14 +191,51 @@ public:
 //------------------------------------------------------------------------------
 // Inline functions
 
-inline void
-PD_Particles::setPdConnections(int id,
-                               vector<pair<int, vector<double>>> connections) {
-  m_PdConnections[id] = connections;
+inline BondList &PD_Particles::pdConnections(int id) {
+  return m_PdConnections.at(id);
 }
 
-inline vector<pair<int, vector<double>>> &PD_Particles::pdConnections(int id) {
-  return m_PdConnections.at(id);
+inline const BondLayout &PD_Particles::bondLayout() const {
+  return *m_bondLayout;
+}
+
+inline const vector<uint64_t> &PD_Particles::connectedBits(const int i) const {
+  return m_connectedBits[i];
+}
+
+inline const vector<int> &PD_Particles::neighbourColumns(const int i) const {
+  return m_neighbourCols[i];
+}
+
+inline int PD_Particles::nConnectedBonds(const int i) const {
+  int nConnected = 0;
+  for (const uint64_t word : m_connectedBits[i]) {
+    nConnected += __builtin_popcountll(word);
+  }
+  return nConnected;
+}
+
+// The bonds of the local particles in the cache, connected or not
+inline size_t PD_Particles::nCachedBonds() const { return m_nCachedBonds; }
+
+inline unsigned long PD_Particles::bondCacheStamp() const {
+  return m_bondCacheStamp;
+}
+
+// Calls f(l_j) for the connected bonds of column i, in increasing l_j. The
+// broken bonds are skipped a word (64 bonds) at a time.
+template <typename Function>
+inline void PD_Particles::forEachConnectedBond(const int i, Function f) const {
+  const vector<uint64_t> &words = m_connectedBits[i];
+  const int nWords = words.size();
+  for (int w = 0; w < nWords; w++) {
+    uint64_t word = words[w];
+    while (word) {
+      const int l_j = 64 * w + __builtin_ctzll(word);
+      word &= word - 1;
+      f(l_j);
+    }
+  }
 }
 
 inline void PD_Particles::sendtParticles(map<int, vector<int>> sp) {
@@ -1,9 +1,11 @@
 #include "saveparticles.h"
 #include "PDtools/Grid/grid.h"
+#include "PDtools/PdFunctions/memorytracker.h"
 #include "particles.h"
 
 #include <algorithm>
 #include <cfloat>
+#include <cstdio>
 #include <fstream>
 #ifdef USE_MPI
 #include <mpi.h>
@@ -117,6 +119,8 @@ void SaveParticles::writeBody(Particles &particles, const string &savePath) {
   outStream.open(savePath.c_str(), std::ofstream::out | std::ofstream::app);
   outStream.setf(std::ios::scientific);
   outStream.precision(14);
+  // The file buffer of the stream
+  MemoryTracker::recordBuffer(MemoryTracker::OutputBuffers, BUFSIZ);
 
   for (int i = 0; i < nParticles; i++) {
     const int id = colToId(i);
@@ -138,7 +142,7 @@ void SaveParticles::writeBody(Particles &particles, const string &savePath) {
 
     for (const auto &parameter : m_dataParameters) {
       outStream << " "
-                << particles.data()(i, parameter.first) * parameter.second;
+                << particles.data().value(i, parameter.first) * parameter.second;
     }
 
     outStream << endl;
@@ -196,13 +200,17 @@ void SaveParticles::writeBinaryBody(Particles &particles,
   const ivec &colToId = particles.colToId();
   const arma::mat &r = particles.r();
   const arma::mat &v = particles.v();
-  const arma::mat &data = particles.data();
+  const ParticleData &data = particles.data();
   int nColumns = 0;
   if (m_saveId) {
     nColumns++;
   }
   nColumns += m_header.size();
   int offset = headerOffset + bodyOffset * nColumns;
+  // One row, and the particles of the ranks with MPI
+  MemoryTracker::recordBuffer(MemoryTracker::OutputBuffers,
+                              nColumns * sizeof(double) +
+                                  m_nCores * sizeof(int));
 
   for (int j = 0; j < nParticles; j++) {
     const int id = colToId(j);
@@ -0,0 +1,252 @@
+#include "commtracer.h"
+
+#include "Particles/pd_particles.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <set>
+
+#if USE_MPI
+#include <mpi.h>
+#endif
+
+namespace PDtools {
+//------------------------------------------------------------------------------
+bool CommTracer::s_enabled = false;
+std::ofstream CommTracer::s_trace;
+string CommTracer::s_tracePath;
+map<pair<int, int>, CommTracer::Link> CommTracer::s_step;
+int CommTracer::s_stepAllreduces = 0;
+double CommTracer::s_stepAllreduceSeconds = 0;
+array<CommTracer::Link, CommTracer::nChannels> CommTracer::s_total;
+size_t CommTracer::s_nNeighbours = 0;
+int CommTracer::s_nAllreduces = 0;
+double CommTracer::s_allreduceSeconds = 0;
+int CommTracer::s_nSteps = 0;
+double CommTracer::s_particles = 0;
+double CommTracer::s_ghosts = 0;
+double CommTracer::s_bonds = 0;
+//------------------------------------------------------------------------------
+namespace {
+template <typename T> void writeBinary(std::ofstream &file, const T value) {
+  file.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+int rank() {
+  int myRank = 0;
+#if USE_MPI
+  MPI_Comm_rank(MPI_COMM_WORLD, &myRank);
+#endif
+  return myRank;
+}
+
+int nRanks() {
+  int nCores = 1;
+#if USE_MPI
+  MPI_Comm_size(MPI_COMM_WORLD, &nCores);
+#endif
+  return nCores;
+}
+}
+//------------------------------------------------------------------------------
+void CommTracer::enable(const bool enabled) { s_enabled = enabled; }
+//------------------------------------------------------------------------------
+void CommTracer::setTrace(const string &path) {
+  const int myRank = rank();
+  s_tracePath = myRank == 0 ? path : path + std::to_string(myRank);
+  s_trace.open(s_tracePath, std::ios::binary);
+  if (!s_trace) {
+    cerr << "ERROR: could not open the communication trace " << s_tracePath
+         << endl;
+    return;
+  }
+
+  s_trace.write("PDTRACE1", 8);
+  writeBinary<int32_t>(s_trace, myRank);
+  writeBinary<int32_t>(s_trace, nRanks());
+}
+//------------------------------------------------------------------------------
+double CommTracer::now() {
+  if (!s_enabled)
+    return 0;
+#if USE_MPI
+  return MPI_Wtime();
+#else
+  const std::chrono::duration<double> t =
+      std::chrono::steady_clock::now().time_since_epoch();
+  return t.count();
+#endif
+}
+//------------------------------------------------------------------------------
+void CommTracer::record(const int channel, const int neighbour,
+                        const size_t bytesSent, const size_t bytesReceived,
+                        const double seconds, const int messages) {
+  if (!s_enabled)
+    return;
+
+  Link &link = s_step[pair<int, int>(channel, neighbour)];
+  link.messages += messages;
+  link.bytesSent += bytesSent;
+  link.bytesReceived += bytesReceived;
+  link.seconds += seconds;
+}
+//------------------------------------------------------------------------------
+void CommTracer::recordAllreduce(const double seconds) {
+  if (!s_enabled)
+    return;
+
+  s_stepAllreduces++;
+  s_stepAllreduceSeconds += seconds;
+}
+//------------------------------------------------------------------------------
+void CommTracer::endStep(const int timeStep, PD_Particles &particles) {
+  if (!s_enabled)
+    return;
+
+  if (s_trace.is_open())
+    writeStep(timeStep, particles);
+
+  std::set<int> neighbours;
+  for (const auto &channel_link : s_step) {
+    const Link &link = channel_link.second;
+    Link &total = s_total[channel_link.first.first];
+    total.messages += link.messages;
+    total.bytesSent += link.bytesSent;
+    total.bytesReceived += link.bytesReceived;
+    total.seconds += link.seconds;
+    neighbours.insert(channel_link.first.second);
+  }
+  s_nNeighbours = std::max(s_nNeighbours, neighbours.size());
+  s_nAllreduces += s_stepAllreduces;
+  s_allreduceSeconds += s_stepAllreduceSeconds;
+
+  s_nSteps++;
+  s_particles += particles.nParticles();
+  s_ghosts += particles.nGhostParticles();
+  s_bonds += particles.nCachedBonds();
+
+  s_step.clear();
+  s_stepAllreduces = 0;
+  s_stepAllreduceSeconds = 0;
+}
+//------------------------------------------------------------------------------
+void CommTracer::writeStep(const int timeStep, PD_Particles &particles) {
+  writeBinary<int32_t>(s_trace, timeStep);
+  writeBinary<int32_t>(s_trace, particles.nParticles());
+  writeBinary<int32_t>(s_trace, particles.nGhostParticles());
+  writeBinary<int64_t>(s_trace, particles.nCachedBonds());
+  writeBinary<int32_t>(s_trace, s_stepAllreduces);
+  writeBinary<double>(s_trace, s_stepAllreduceSeconds);
+  writeBinary<int32_t>(s_trace, s_step.size());
+
+  for (const auto &channel_link : s_step) {
+    const Link &link = channel_link.second;
+    writeBinary<int32_t>(s_trace, channel_link.first.first);
+    writeBinary<int32_t>(s_trace, channel_link.first.second);
+    writeBinary<int32_t>(s_trace, link.messages);
+    writeBinary<int64_t>(s_trace, link.bytesSent);
+    writeBinary<int64_t>(s_trace, link.bytesReceived);
+    writeBinary<double>(s_trace, link.seconds);
+  }
+}
+//------------------------------------------------------------------------------
+void CommTracer::summary() {
+  if (!s_enabled)
+    return;
+
+  if (s_trace.is_open())
+    s_trace.close();
+
+  // Per rank averages over the steps, reduced over the ranks
+  const double nSteps = std::max(s_nSteps, 1);
+  enum Values {
+    Particles,
+    Ghosts,
+    Bonds,
+    Neighbours,
+    HaloRatio,
+    Allreduces,
+    AllreduceSeconds,
+    nValues
+  };
+  const int nLinkValues = 3;
+  const int n = nValues + nLinkValues * nChannels;
+  vector<double> values(n);
+  values[Particles] = s_particles / nSteps;
+  values[Ghosts] = s_ghosts / nSteps;
+  values[Bonds] = s_bonds / nSteps;
+  values[Neighbours] = s_nNeighbours;
+  values[HaloRatio] = s_particles > 0 ? s_ghosts / s_particles : 0;
+  values[Allreduces] = s_nAllreduces / nSteps;
+  values[AllreduceSeconds] = s_allreduceSeconds;
+  for (int c = 0; c < nChannels; c++) {
+    double *linkValues = &values[nValues + nLinkValues * c];
+    linkValues[0] = s_total[c].bytesSent / nSteps;
+    linkValues[1] = s_total[c].messages / nSteps;
+    linkValues[2] = s_total[c].seconds;
+  }
+
+  vector<double> v_min = values;
+  vector<double> v_sum = values;
+  vector<double> v_max = values;
+#if USE_MPI
+  MPI_Allreduce(MPI_IN_PLACE, v_min.data(), n, MPI_DOUBLE, MPI_MIN,
+                MPI_COMM_WORLD);
+  MPI_Allreduce(MPI_IN_PLACE, v_sum.data(), n, MPI_DOUBLE, MPI_SUM,
+                MPI_COMM_WORLD);
+  MPI_Allreduce(MPI_IN_PLACE, v_max.data(), n, MPI_DOUBLE, MPI_MAX,
+                MPI_COMM_WORLD);
+#endif
+
+  if (rank() != 0)
+    return;
+
+  const int nCores = nRanks();
+  char line[256];
+  auto print = [&](const char *name, const int k) {
+    const double avg = v_sum[k] / nCores;
+    const double imbalance = avg > 0 ? v_max[k] / avg : 1;
+    snprintf(line, sizeof(line), "%-32s %12.4g %12.4g %12.4g %8.2f", name,
+             v_min[k], avg, v_max[k], imbalance);
+    cout << line << endl;
+  };
+
+  cout << "Communication summary over " << s_nSteps << " steps and " << nCores
+       << " rank(s), per rank and step unless stated" << endl;
+  snprintf(line, sizeof(line), "%-32s %12s %12s %12s %8s", "", "min", "avg",
+           "max", "max/avg");
+  cout << line << endl;
+  print("particles", Particles);
+  print("ghosts", Ghosts);
+  print("bonds", Bonds);
+  print("neighbour ranks (max)", Neighbours);
+  print("ghosts per particle", HaloRatio);
+
+  const char *channelNames[nChannels] = {"ghost exchange", "migration",
+                                         "modifier lists"};
+  for (int c = 0; c < nChannels; c++) {
+    const int k = nValues + nLinkValues * c;
+    print((string(channelNames[c]) + " bytes sent").c_str(), k);
+    print((string(channelNames[c]) + " messages").c_str(), k + 1);
+    print((string(channelNames[c]) + " seconds, run").c_str(), k + 2);
+  }
+  print("ADR allreduces", Allreduces);
+  print("ADR allreduce seconds, run", AllreduceSeconds);
+
+  // Ghosts per local particle over all ranks
+  const double haloRatio =
+      v_sum[Particles] > 0 ? v_sum[Ghosts] / v_sum[Particles] : 0;
+  const double particleImbalance =
+      v_sum[Particles] > 0 ? v_max[Particles] * nCores / v_sum[Particles] : 1;
+  const double bondImbalance =
+      v_sum[Bonds] > 0 ? v_max[Bonds] * nCores / v_sum[Bonds] : 1;
+  cout << "halo-to-interior ratio: " << haloRatio << endl;
+  cout << "load imbalance (max/avg): particles " << particleImbalance
+       << ", bonds " << bondImbalance << endl;
+  if (!s_tracePath.empty())
+    cout << "Communication trace written to " << s_tracePath
+         << (nCores > 1 ? " and the rank files" : "") << endl;
+}
+//------------------------------------------------------------------------------
+}
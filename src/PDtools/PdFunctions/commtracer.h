@@ -0,0 +1,84 @@
+#ifndef COMMTRACER_H
+#define COMMTRACER_H
+
+#include "config.h"
+
+#include <fstream>
+
+namespace PDtools {
+class PD_Particles;
+
+//------------------------------------------------------------------------------
+// Traces the MPI communication of the time steps: the bytes, the messages
+// and the time spent in MPI_Sendrecv per neighbour rank for the ghost
+// exchange, the particle migration of updateGrid() and the modifier list
+// updates, the time in the ADR MPI_Allreduce calls, and the particles,
+// ghosts and bonds of the rank.
+//
+// The tracer is process-global, as the exchange functions are free
+// functions. Each rank may write a binary trace, <path> on rank 0 and
+// <path><rank> on the others, as the particle files:
+//
+//   header: char[8] "PDTRACE1", int32 rank, int32 nCores
+//   step:   int32 step, int32 nParticles, int32 nGhosts, int64 nBonds,
+//           int32 nAllreduce, float64 allreduceSeconds, int32 nLinks
+//   link:   int32 channel, int32 neighbour, int32 messages,
+//           int64 bytesSent, int64 bytesReceived, float64 seconds
+//
+// with nLinks link records after each step record.
+//------------------------------------------------------------------------------
+class CommTracer {
+public:
+  enum Channel { GhostExchange, Migration, ModifierLists, nChannels };
+
+  static void enable(const bool enabled);
+  static bool enabled();
+  static void setTrace(const string &path);
+
+  static double now();
+  static void record(const int channel, const int neighbour,
+                     const size_t bytesSent, const size_t bytesReceived,
+                     const double seconds, const int messages = 2);
+  static void recordAllreduce(const double seconds);
+
+  // Closes a time step, with the particles at its end
+  static void endStep(const int timeStep, PD_Particles &particles);
+
+  // Collective, printed by the first rank
+  static void summary();
+
+protected:
+  struct Link {
+    int messages = 0;
+    size_t bytesSent = 0;
+    size_t bytesReceived = 0;
+    double seconds = 0;
+  };
+
+  static bool s_enabled;
+  static std::ofstream s_trace;
+  static string s_tracePath;
+
+  // The current step, per channel and neighbour rank
+  static map<pair<int, int>, Link> s_step;
+  static int s_stepAllreduces;
+  static double s_stepAllreduceSeconds;
+
+  // The run
+  static array<Link, nChannels> s_total;
+  static size_t s_nNeighbours;
+  static int s_nAllreduces;
+  static double s_allreduceSeconds;
+  static int s_nSteps;
+  static double s_particles;
+  static double s_ghosts;
+  static double s_bonds;
+
+  static void writeStep(const int timeStep, PD_Particles &particles);
+};
+//------------------------------------------------------------------------------
+// Inline functions
+inline bool CommTracer::enabled() { return s_enabled; }
+//------------------------------------------------------------------------------
+}
+#endif // COMMTRACER_H
@@ -0,0 +1,343 @@
+#include "memorytracker.h"
+
+#include "Grid/grid.h"
+#include "Particles/pd_particles.h"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+#if USE_MPI
+#include <mpi.h>
+#endif
+
+namespace PDtools {
+//------------------------------------------------------------------------------
+bool MemoryTracker::s_enabled = false;
+int MemoryTracker::s_interval = 100;
+array<size_t, MemoryTracker::nComponents> MemoryTracker::s_current = {};
+array<size_t, MemoryTracker::nComponents> MemoryTracker::s_peak = {};
+size_t MemoryTracker::s_peakTotal = 0;
+int MemoryTracker::s_dim = 3;
+double MemoryTracker::s_nParticles = 0;
+double MemoryTracker::s_nGhosts = 0;
+double MemoryTracker::s_nBonds = 0;
+double MemoryTracker::s_nCells = 0;
+double MemoryTracker::s_nOwnedCells = 0;
+double MemoryTracker::s_nGhostValues = 0;
+//------------------------------------------------------------------------------
+namespace {
+const double MiB = 1024. * 1024.;
+
+int rank() {
+  int myRank = 0;
+#if USE_MPI
+  MPI_Comm_rank(MPI_COMM_WORLD, &myRank);
+#endif
+  return myRank;
+}
+
+int nRanks() {
+  int nCores = 1;
+#if USE_MPI
+  MPI_Comm_size(MPI_COMM_WORLD, &nCores);
+#endif
+  return nCores;
+}
+
+// A size in bytes from /proc/self/status, 0 where there is none
+double processStatus(const string &key) {
+  std::ifstream status("/proc/self/status");
+  string line;
+  while (std::getline(status, line)) {
+    if (line.compare(0, key.size(), key) == 0 && line.size() > key.size() &&
+        line[key.size()] == ':') {
+      return 1024. * atof(line.c_str() + key.size() + 1);
+    }
+  }
+  return 0;
+}
+
+void reduce(vector<double> &v_min, vector<double> &v_sum,
+            vector<double> &v_max) {
+#if USE_MPI
+  const int n = v_sum.size();
+  MPI_Allreduce(MPI_IN_PLACE, v_min.data(), n, MPI_DOUBLE, MPI_MIN,
+                MPI_COMM_WORLD);
+  MPI_Allreduce(MPI_IN_PLACE, v_sum.data(), n, MPI_DOUBLE, MPI_SUM,
+                MPI_COMM_WORLD);
+  MPI_Allreduce(MPI_IN_PLACE, v_max.data(), n, MPI_DOUBLE, MPI_MAX,
+                MPI_COMM_WORLD);
+#else
+  (void)v_min;
+  (void)v_sum;
+  (void)v_max;
+#endif
+}
+}
+//------------------------------------------------------------------------------
+void MemoryTracker::enable(const bool enabled) { s_enabled = enabled; }
+//------------------------------------------------------------------------------
+void MemoryTracker::setInterval(const int interval) {
+  s_interval = std::max(interval, 1);
+}
+//------------------------------------------------------------------------------
+void MemoryTracker::set(const int component, const size_t bytes) {
+  if (!s_enabled)
+    return;
+
+  s_current[component] = bytes;
+  s_peak[component] = std::max(s_peak[component], bytes);
+
+  size_t total = 0;
+  for (const size_t b : s_current) {
+    total += b;
+  }
+  s_peakTotal = std::max(s_peakTotal, total);
+}
+//------------------------------------------------------------------------------
+void MemoryTracker::recordBuffer(const int component, const size_t bytes) {
+  if (s_enabled && bytes > s_current[component])
+    set(component, bytes);
+}
+//------------------------------------------------------------------------------
+void MemoryTracker::sample(PD_Particles &particles, Grid &grid) {
+  if (!s_enabled)
+    return;
+
+  set(ParticleMatrices, particles.matrixBytes());
+  set(ParticleParameters, particles.data().allocatedBytes());
+  set(PdConnections, particles.connectionBytes());
+  set(BondCache, particles.bondCacheBytes());
+  set(VerletLists, particles.verletListBytes());
+  set(GridCells, grid.allocatedBytes());
+  set(GhostLists, particles.ghostListBytes());
+  set(ElementQuadrature, particles.elementBytes());
+
+  s_dim = particles.dim();
+  s_nParticles = particles.nParticles();
+  s_nGhosts = particles.nGhostParticles();
+  s_nBonds = particles.nConnections();
+  s_nCells = grid.gridpoints().size();
+  s_nOwnedCells = grid.myGridPoints().size();
+  s_nGhostValues = 1 + M_DIM + particles.ghostParameters().size();
+}
+//------------------------------------------------------------------------------
+void MemoryTracker::endStep(const int timeStep, PD_Particles &particles,
+                            Grid &grid) {
+  if (s_enabled && timeStep % s_interval == 0)
+    sample(particles, grid);
+}
+//------------------------------------------------------------------------------
+void MemoryTracker::report(const string &title) {
+  if (!s_enabled)
+    return;
+
+  // The current and the peak bytes of the components, then the totals
+  enum Totals { Current, Peak, Resident, ResidentPeak, nTotals };
+  const int nValues = 2 * nComponents + nTotals;
+  vector<double> values(nValues);
+  double total = 0;
+  for (int c = 0; c < nComponents; c++) {
+    values[c] = s_current[c];
+    values[nComponents + c] = s_peak[c];
+    total += s_current[c];
+  }
+  double *totals = &values[2 * nComponents];
+  totals[Current] = total;
+  totals[Peak] = s_peakTotal;
+  totals[Resident] = processStatus("VmRSS");
+  totals[ResidentPeak] = processStatus("VmHWM");
+
+  vector<double> v_min = values;
+  vector<double> v_sum = values;
+  vector<double> v_max = values;
+  reduce(v_min, v_sum, v_max);
+
+  // The rank of the largest peak
+  struct {
+    double value;
+    int rank;
+  } peakRank = {totals[Peak], rank()};
+#if USE_MPI
+  MPI_Allreduce(MPI_IN_PLACE, &peakRank, 1, MPI_DOUBLE_INT, MPI_MAXLOC,
+                MPI_COMM_WORLD);
+#endif
+
+  if (rank() != 0)
+    return;
+
+  const int nCores = nRanks();
+  char line[256];
+  auto print = [&](const char *name, const int k, const int k_peak) {
+    snprintf(line, sizeof(line), "%-28s %10.2f %10.2f %10.2f %12.2f", name,
+             v_min[k] / MiB, v_sum[k] / nCores / MiB, v_max[k] / MiB,
+             v_max[k_peak] / MiB);
+    cout << line << endl;
+  };
+
+  cout << "Memory " << title << ", MiB per rank over " << nCores
+       << " rank(s)" << endl;
+  snprintf(line, sizeof(line), "%-28s %10s %10s %10s %12s", "", "min", "avg",
+           "max", "peak max");
+  cout << line << endl;
+  for (int c = 0; c < nComponents; c++) {
+    print(name(c), c, nComponents + c);
+  }
+  print("total accounted", 2 * nComponents + Current,
+        2 * nComponents + Peak);
+  print("resident set size", 2 * nComponents + Resident,
+        2 * nComponents + ResidentPeak);
+  cout << "peak accounted on rank " << peakRank.rank << ": "
+       << peakRank.value / MiB << " MiB" << endl;
+}
+//------------------------------------------------------------------------------
+void MemoryTracker::project(const double nParticles, const int nRanks,
+                            const double horizon) {
+  if (!s_enabled)
+    return;
+
+  // The bytes and units summed over the ranks of this run
+  enum Units { Particles, Ghosts, Bonds, Cells, OwnedCells, nUnits };
+  const int nValues = nComponents + nUnits;
+  vector<double> sum(nValues);
+  for (int c = 0; c < nComponents; c++) {
+    sum[c] = s_current[c];
+  }
+  double *units = &sum[nComponents];
+  units[Particles] = s_nParticles;
+  units[Ghosts] = s_nGhosts;
+  units[Bonds] = s_nBonds;
+  units[Cells] = s_nCells;
+  units[OwnedCells] = s_nOwnedCells;
+  vector<double> v_min = sum;
+  vector<double> v_max = sum;
+  reduce(v_min, sum, v_max);
+
+  if (rank() != 0)
+    return;
+
+  // The units of an interior rank of the projected run, on a lattice of
+  // the particle spacing with a layer of ghost cells around the subdomain
+  const int dim = s_dim;
+  const double n = nParticles / nRanks;
+  double bondsPerParticle = 2 * horizon;
+  if (dim == 2)
+    bondsPerParticle = M_PI * horizon * horizon;
+  else if (dim == 3)
+    bondsPerParticle = 4. / 3. * M_PI * pow(horizon, 3);
+
+  const double particlesPerCell =
+      units[OwnedCells] > 0 ? units[Particles] / units[OwnedCells] : 1;
+  const double cellSide = pow(std::max(particlesPerCell, 1.), 1. / dim);
+  const double side = pow(n, 1. / dim);
+  const double ghosts = nRanks > 1 ? pow(side + 2 * cellSide, dim) - n : 0;
+  const double cells = pow(side / cellSide + 2, dim);
+  const double bonds = n * bondsPerParticle;
+
+  auto perUnit = [&](const int c, const double unit, const double fallback) {
+    return unit > 0 ? sum[c] / unit : fallback;
+  };
+  const double rows = units[Particles] + units[Ghosts];
+  array<double, nComponents> bytesPerUnit;
+  array<double, nComponents> projected;
+  array<const char *, nComponents> unitNames;
+  for (int c = 0; c < nComponents; c++) {
+    switch (c) {
+    case ParticleMatrices:
+    case ParticleParameters:
+    case VerletLists:
+      bytesPerUnit[c] = perUnit(c, rows, 0);
+      projected[c] = bytesPerUnit[c] * (n + ghosts);
+      unitNames[c] = "particle";
+      break;
+    case PdConnections:
+    case BondCache:
+    case StiffnessMatrix:
+      bytesPerUnit[c] = perUnit(c, units[Bonds], 0);
+      projected[c] = bytesPerUnit[c] * bonds;
+      unitNames[c] = "bond";
+      break;
+    case GridCells:
+      bytesPerUnit[c] = perUnit(c, units[Cells], 0);
+      projected[c] = bytesPerUnit[c] * cells;
+      unitNames[c] = "cell";
+      break;
+    case GhostLists:
+      // The ids sent and received
+      bytesPerUnit[c] = perUnit(c, units[Ghosts], 2 * sizeof(int));
+      projected[c] = bytesPerUnit[c] * ghosts;
+      unitNames[c] = "ghost";
+      break;
+    case GhostBuffers:
+      // The values of a ghost sent and received
+      bytesPerUnit[c] =
+          perUnit(c, units[Ghosts], 2 * sizeof(double) * s_nGhostValues);
+      projected[c] = bytesPerUnit[c] * ghosts;
+      unitNames[c] = "ghost";
+      break;
+    case ElementQuadrature:
+      bytesPerUnit[c] = perUnit(c, units[Particles], 0);
+      projected[c] = bytesPerUnit[c] * n;
+      unitNames[c] = "particle";
+      break;
+    default:
+      bytesPerUnit[c] = v_max[c];
+      projected[c] = v_max[c];
+      unitNames[c] = "rank";
+    }
+  }
+
+  cout << "Memory projection for " << nParticles << " particles on " << nRanks
+       << " rank(s), delta/lc " << horizon << endl;
+  cout << "per interior rank: " << n << " particles, " << ghosts
+       << " ghosts, " << bonds << " bonds, " << cells << " grid cells"
+       << endl;
+  cout << "bonds per particle: " << bondsPerParticle << ", this run "
+       << (units[Particles] > 0 ? units[Bonds] / units[Particles] : 0) << endl;
+
+  char line[256];
+  snprintf(line, sizeof(line), "%-28s %12s %-9s %12s", "", "bytes", "per",
+           "MiB/rank");
+  cout << line << endl;
+  double total = 0;
+  for (int c = 0; c < nComponents; c++) {
+    snprintf(line, sizeof(line), "%-28s %12.1f %-9s %12.2f", name(c),
+             bytesPerUnit[c], unitNames[c], projected[c] / MiB);
+    cout << line << endl;
+    total += projected[c];
+  }
+  snprintf(line, sizeof(line), "%-28s %12s %-9s %12.2f", "total", "", "",
+           total / MiB);
+  cout << line << endl;
+}
+//------------------------------------------------------------------------------
+const char *MemoryTracker::name(const int component) {
+  switch (component) {
+  case ParticleMatrices:
+    return "particle matrices";
+  case ParticleParameters:
+    return "particle parameters";
+  case PdConnections:
+    return "PD connections";
+  case BondCache:
+    return "bond cache";
+  case VerletLists:
+    return "verlet lists";
+  case GridCells:
+    return "grid cells";
+  case GhostLists:
+    return "ghost lists";
+  case GhostBuffers:
+    return "ghost/migration buffers";
+  case StiffnessMatrix:
+    return "stiffness matrix";
+  case ElementQuadrature:
+    return "element quadrature";
+  case OutputBuffers:
+    return "output buffers";
+  }
+  return "";
+}
+//------------------------------------------------------------------------------
+}
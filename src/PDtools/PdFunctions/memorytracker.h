@@ -0,0 +1,129 @@
+#ifndef MEMORYTRACKER_H
+#define MEMORYTRACKER_H
+
+#include "config.h"
+
+#include <algorithm>
+
+namespace PDtools {
+class PD_Particles;
+class Grid;
+
+//------------------------------------------------------------------------------
+// Accounts the memory of a rank per component: the particle matrices and
+// parameters, the PD connections and the bond cache, the verlet lists, the
+// grid cells, the ghost lists and exchange buffers, the stiffness matrix of
+// the static solver, the element quadrature and the output buffers.
+//
+// The sizes are computed from the containers, with the allocation overhead
+// of glibc malloc, and do not count memory freed to the allocator. sample()
+// sets the current size of the components held by the particles and the
+// grid and keeps the peak of each and of their sum. Buffers that only live
+// during a call record their largest size. The tracker is process-global,
+// as the exchange functions are free functions.
+//
+// project() scales the bytes of this run per particle, bond, ghost and grid
+// cell to a run of a given size, to estimate the memory per rank before
+// allocating it.
+//------------------------------------------------------------------------------
+class MemoryTracker {
+public:
+  enum Component {
+    ParticleMatrices,
+    ParticleParameters,
+    PdConnections,
+    BondCache,
+    VerletLists,
+    GridCells,
+    GhostLists,
+    GhostBuffers,
+    StiffnessMatrix,
+    ElementQuadrature,
+    OutputBuffers,
+    nComponents
+  };
+
+  static void enable(const bool enabled);
+  static bool enabled();
+  static void setInterval(const int interval);
+
+  static void set(const int component, const size_t bytes);
+  static void recordBuffer(const int component, const size_t bytes);
+  static void sample(PD_Particles &particles, Grid &grid);
+  // Samples every interval steps
+  static void endStep(const int timeStep, PD_Particles &particles, Grid &grid);
+
+  // Collective, printed by the first rank
+  static void report(const string &title);
+  static void project(const double nParticles, const int nRanks,
+                      const double horizon);
+
+  // The heap held by an allocation and by the containers
+  static size_t heapBytes(const size_t nBytes);
+  template <typename T> static size_t vectorBytes(const vector<T> &v);
+  template <typename T> static size_t matBytes(const arma::Mat<T> &m);
+  template <typename K, typename V>
+  static size_t mapBytes(const unordered_map<K, V> &m);
+  template <typename K, typename V>
+  static size_t mapBytes(const map<K, V> &m);
+
+protected:
+  static bool s_enabled;
+  static int s_interval;
+  static array<size_t, nComponents> s_current;
+  static array<size_t, nComponents> s_peak;
+  static size_t s_peakTotal;
+
+  // The work of the last sample, the units of the projection
+  static int s_dim;
+  static double s_nParticles;
+  static double s_nGhosts;
+  static double s_nBonds;
+  static double s_nCells;
+  static double s_nOwnedCells;
+  static double s_nGhostValues;
+
+  static const char *name(const int component);
+};
+//------------------------------------------------------------------------------
+// Inline functions
+inline bool MemoryTracker::enabled() { return s_enabled; }
+
+// glibc malloc: an 8 byte header, 16 byte alignment and 32 bytes at least
+inline size_t MemoryTracker::heapBytes(const size_t nBytes) {
+  if (nBytes == 0)
+    return 0;
+  return std::max<size_t>(32, (nBytes + 8 + 15) & ~size_t(15));
+}
+
+template <typename T>
+inline size_t MemoryTracker::vectorBytes(const vector<T> &v) {
+  return heapBytes(v.capacity() * sizeof(T));
+}
+
+// Armadillo keeps the small matrices in the object
+template <typename T>
+inline size_t MemoryTracker::matBytes(const arma::Mat<T> &m) {
+  if (m.n_elem <= arma::arma_config::mat_prealloc)
+    return 0;
+  return heapBytes(m.n_elem * sizeof(T));
+}
+
+// The buckets and the nodes, not the heap of the values
+template <typename K, typename V>
+inline size_t MemoryTracker::mapBytes(const unordered_map<K, V> &m) {
+  const size_t nodeBytes =
+      heapBytes(sizeof(void *) + sizeof(typename unordered_map<K, V>::value_type));
+  return heapBytes(m.bucket_count() * sizeof(void *)) + m.size() * nodeBytes;
+}
+
+// The red-black tree nodes, not the heap of the values
+template <typename K, typename V>
+inline size_t MemoryTracker::mapBytes(const map<K, V> &m) {
+  const size_t nodeBytes =
+      heapBytes(4 * sizeof(void *) + sizeof(typename map<K, V>::value_type));
+  return m.size() * nodeBytes;
+}
+//------------------------------------------------------------------------------
+}
+#endif // MEMORYTRACKER_H
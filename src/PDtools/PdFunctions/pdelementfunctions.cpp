@@ -15,11 +15,11 @@ void setPdElementConnections(PD_Particles &discretization, Grid &grid,
   const unordered_map<int, GridPoint> &gridpoints = grid.gridpoints();
   const vector<int> &mygridPoints = grid.myGridPoints();
   const mat &R = discretization.r();
-  const ivec &idToCol = discretization.getIdToCol_v();
+  const IdToColMap &idToCol = discretization.getIdToCol_v();
   const vector<PD_quadElement> &quadElements = discretization.getQuadElements();
 
   // The order is important!
-  discretization.registerPdParameter("connected");
+  discretization.registerPdParameter("connected", 0, BondData::Flag);
   discretization.registerPdParameter("overlap");
   vector<size_t> pCols;
   pCols.reserve(4);
@@ -41,7 +41,7 @@ void setPdElementConnections(PD_Particles &discretization, Grid &grid,
       int id_i = idCol_i.first;
       int col_i = idCol_i.second;
       unordered_map<int, vector<double>> connections;
-      vector<pair<int, vector<double>>> connectionsVector;
+      BondList connectionsVector(discretization.bondLayout());
 
       int totoalNumberPolygons = 0;
       int intersectingPolygons = 0;
@@ -76,8 +76,7 @@ void setPdElementConnections(PD_Particles &discretization, Grid &grid,
         connectionData.push_back(1.0);     // Connected
         connectionData.push_back(overlap); // Overlap factor
         connections[element_id] = connectionData;
-        connectionsVector.push_back(
-            pair<int, vector<double>>(element_id, connectionData));
+        connectionsVector.push_back(element_id, connectionData);
         intersectingPolygons++;
         totoalNumberPolygons++;
       }
@@ -115,8 +114,7 @@ void setPdElementConnections(PD_Particles &discretization, Grid &grid,
           connectionData.push_back(1.0);     // Connected
           connectionData.push_back(overlap); // Overlap factor
           connections[element_id] = connectionData;
-          connectionsVector.push_back(
-              pair<int, vector<double>>(element_id, connectionData));
+          connectionsVector.push_back(element_id, connectionData);
           intersectingPolygons++;
 
           /*
@@ -141,7 +139,7 @@ void setPdElementConnections(PD_Particles &discretization, Grid &grid,
               connectionData.push_back(1.0); // Connected
               connectionData.push_back(overlap); // Overlap factor
               connections[element_id] = connectionData;
-              connectionsVector.push_back(pair<int, vector<double>>(element_id,
+              connectionsVector.push_back(pair<int, BondData>(element_id,
           connectionData) );
               intersectingPolygons++;
               tot_area += area_intersection;
@@ -153,9 +151,9 @@ void setPdElementConnections(PD_Particles &discretization, Grid &grid,
 
 #ifdef USE_OPENMP
 #pragma omp critical
-      { particles.setPdConnections(id_i, connectionsVector); }
+      { particles.setPdConnections(id_i, std::move(connectionsVector)); }
 #else
-      discretization.setPdConnections(id_i, connectionsVector);
+      discretization.setPdConnections(id_i, std::move(connectionsVector));
 #endif
 #if DEBUG_PRINT_ELEMENTS
       if (tot_area / A0 < 0.98) {
@@ -3,6 +3,7 @@
 #include "Grid/grid.h"
 #include "PDtools/Force/force.h"
 #include "Particles/pd_particles.h"
+#include <algorithm>
 #include <boost/algorithm/string.hpp>
 #include <limits>
 #include <math.h>
@@ -26,13 +27,13 @@ void setPdConnections(PD_Particles &particles, Grid &grid, double delta,
   const unordered_map<int, GridPoint> &gridpoints = grid.gridpoints();
   const vector<int> &mygridPoints = grid.myGridPoints();
   const mat &R = particles.r();
-  const mat &data = particles.data();
+  const ParticleData &data = particles.data();
 #if USE_EXTENDED_RANGE_RADIUS
   const int indexRadius = particles.getParamId("radius");
 #endif
   // The order is important!
   particles.registerPdParameter("dr0");
-  particles.registerPdParameter("connected");
+  particles.registerPdParameter("connected", 0, BondData::Flag);
   const int iGroupId = particles.getParamId("groupId");
 
 //    int nBonds = 0;
@@ -50,7 +51,7 @@ void setPdConnections(PD_Particles &particles, Grid &grid, double delta,
       const vec &r_i = R.row(col_i).t();
       const int group_i = data(col_i, iGroupId);
       unordered_map<int, vector<double>> connections;
-      vector<pair<int, vector<double>>> connectionsVector;
+      BondList connectionsVector(particles.bondLayout());
 
 #if USE_EXTENDED_RANGE_RADIUS
       const double radius_i = data(col_i, indexRadius);
@@ -91,8 +92,7 @@ void setPdConnections(PD_Particles &particles, Grid &grid, double delta,
           connectionData.push_back(dr);
           connectionData.push_back(1.0); // Connected
           connections[id_j] = connectionData;
-          connectionsVector.push_back(
-              pair<int, vector<double>>(id_j, connectionData));
+          connectionsVector.push_back(id_j, connectionData);
         }
       }
 
@@ -129,17 +129,16 @@ void setPdConnections(PD_Particles &particles, Grid &grid, double delta,
             connectionData.push_back(dr);
             connectionData.push_back(1.0); // Connected
             connections[id_j] = connectionData;
-            connectionsVector.push_back(
-                pair<int, vector<double>>(id_j, connectionData));
+            connectionsVector.push_back(id_j, connectionData);
           }
         }
       }
 
 #ifdef USE_OPENMP
 #pragma omp critical
-      { particles.setPdConnections(id_i, connectionsVector); }
+      { particles.setPdConnections(id_i, std::move(connectionsVector)); }
 #else
-      particles.setPdConnections(id_i, connectionsVector);
+      particles.setPdConnections(id_i, std::move(connectionsVector));
 #endif
     }
   }
@@ -150,8 +149,12 @@ void applyVolumeCorrection(PD_Particles &particles, double delta, double lc,
 #if USE_EXTENDED_RANGE_LC == 0
   (void)lc;
 #endif
-  const mat &data = particles.data();
-  const ivec &idToCol = particles.getIdToCol_v();
+  // The initial weight, the volume of the neighbourhood, is summed here
+  // where the bond volumes become final. It is the reference of the damage,
+  // summed from the stored scalings as the damage updates subtract them.
+  const int indexInitialWeight = particles.registerParameter("initialWeight");
+  ParticleData &data = particles.data();
+  const IdToColMap &idToCol = particles.getIdToCol_v();
   const ivec &colToId = particles.colToId();
   const int indexDr0 = particles.getPdParamId("dr0");
   //    const int indexRadius = particles.getParamId("radius");
@@ -173,8 +176,7 @@ void applyVolumeCorrection(PD_Particles &particles, double delta, double lc,
       const double r_i = 0.;
 #endif
 
-      vector<pair<int, vector<double>>> &PDconnections =
-          particles.pdConnections(id_i);
+      BondList &PDconnections = particles.pdConnections(id_i);
       double vol_delta = 0;
 
       for (auto &con : PDconnections) {
@@ -211,9 +213,10 @@ void applyVolumeCorrection(PD_Particles &particles, double delta, double lc,
         volumeCorrection = v1;
 
         con.second[indexVolumeScaling] = volumeCorrection;
-        const double vol_i = data(i, indexVolume);
-        vol_delta += vol_i * volumeCorrection;
+        const double vol_j = data(idToCol[con.first], indexVolume);
+        vol_delta += vol_j * con.second[indexVolumeScaling];
       }
+      data(i, indexInitialWeight) = vol_delta;
     }
   } else if (dim == 3) {
 #ifdef USE_OPENMP
@@ -221,8 +224,7 @@ void applyVolumeCorrection(PD_Particles &particles, double delta, double lc,
 #endif
     for (unsigned int i = 0; i < particles.nParticles(); i++) {
       const int pId = colToId(i);
-      vector<pair<int, vector<double>>> &PDconnections =
-          particles.pdConnections(pId);
+      BondList &PDconnections = particles.pdConnections(pId);
       double vol_delta = 0;
 
       for (auto &con : PDconnections) {
@@ -243,16 +245,17 @@ void applyVolumeCorrection(PD_Particles &particles, double delta, double lc,
           volumeCorrection = 0.5 * (delta + radius_j - dr) / radius_j;
         }
         con.second[indexVolumeScaling] = volumeCorrection;
-        const double vol_i = data(i, indexVolume);
-        vol_delta += vol_i * volumeCorrection;
+        const double vol_j = data(idToCol[con.first], indexVolume);
+        vol_delta += vol_j * con.second[indexVolumeScaling];
       }
+      data(i, indexInitialWeight) = vol_delta;
     }
   }
 }
 //------------------------------------------------------------------------------
 void reCalculatePdMicromodulus(PD_Particles &particles, int dim) {
-  arma::mat &data = particles.data();
-  const ivec &idToCol = particles.getIdToCol_v();
+  ParticleData &data = particles.data();
+  const IdToColMap &idToCol = particles.getIdToCol_v();
   const ivec &colToId = particles.colToId();
   const int indexVolume = particles.getParamId("volume");
   const int indexMicromodulus = particles.getParamId("micromodulus");
@@ -267,8 +270,7 @@ void reCalculatePdMicromodulus(PD_Particles &particles, int dim) {
     const int pId = colToId(i);
     double dRvolume = 0;
 
-    const vector<pair<int, vector<double>>> &PDconnections =
-        particles.pdConnections(pId);
+    const BondList &PDconnections = particles.pdConnections(pId);
     for (auto &con : PDconnections) {
       const int id_j = con.first;
       const int col_j = idToCol[id_j];
@@ -284,14 +286,14 @@ void reCalculatePdMicromodulus(PD_Particles &particles, int dim) {
 //------------------------------------------------------------------------------
 void reCalculatePdFractureCriterion(PD_Particles &particles, double G0,
                                     double delta, double h) {
-  arma::mat &data = particles.data();
+  ParticleData &data = particles.data();
   const ivec &colToId = particles.colToId();
   const int indexMicromodulus = particles.getParamId("micromodulus");
   int indexS0 = particles.getParamId("s0");
   const double delta4 = delta * delta * delta * delta;
   const double delta5 = delta4 * delta;
 
-  const ivec &idToCol = particles.getIdToCol_v();
+  const IdToColMap &idToCol = particles.getIdToCol_v();
   int indexVolume = particles.getParamId("volume");
   int indexVolumeScaling = particles.getPdParamId("volumeScaling");
 
@@ -318,8 +320,7 @@ void reCalculatePdFractureCriterion(PD_Particles &particles, double G0,
 
       double v = 0;
 
-      vector<pair<int, vector<double>>> &PDconnections =
-          particles.pdConnections(pId);
+      BondList &PDconnections = particles.pdConnections(pId);
       for (auto &con : PDconnections) {
         int id_j = con.first;
         int col_j = idToCol[id_j];
@@ -336,7 +337,7 @@ void reCalculatePdFractureCriterion(PD_Particles &particles, double G0,
 }
 //------------------------------------------------------------------------------
 void calculateRadius(PD_Particles &particles, int dim, double h) {
-  arma::mat &data = particles.data();
+  ParticleData &data = particles.data();
   const int indexVolume = particles.getParamId("volume");
   const int indexRadius = particles.getParamId("radius");
 
@@ -379,10 +380,13 @@ void calculateRadius(PD_Particles &particles, int dim, double h) {
 //------------------------------------------------------------------------------
 void surfaceCorrection(PD_Particles &particles, vector<Force *> &forces,
                        double E, double nu, int dim) {
+  // Runs before the solver, which builds the bond cache the energy densities
+  // loop over
+  particles.buildBondCache();
   const double strain = 0.001;
   vec3 scaleFactor;
   arma::mat &r = particles.r();
-  const ivec &idToCol = particles.getIdToCol_v();
+  const IdToColMap &idToCol = particles.getIdToCol_v();
   const ivec &colToId = particles.colToId();
   arma::mat g = zeros(particles.nParticles(), dim);
 
@@ -467,8 +471,7 @@ void surfaceCorrection(PD_Particles &particles, vector<Force *> &forces,
     const int pId = colToId(i);
     const int col_i = i;
 
-    vector<pair<int, vector<double>>> &PDconnections =
-        particles.pdConnections(pId);
+    BondList &PDconnections = particles.pdConnections(pId);
 
     for (auto &con : PDconnections) {
       const int id_j = con.first;
@@ -488,6 +491,10 @@ void surfaceCorrection(PD_Particles &particles, vector<Force *> &forces,
       con.second[indexForceScaling] *= G;
     }
   }
+
+  for (Force *force : forces) {
+    force->invalidateBondCache();
+  }
 }
 //------------------------------------------------------------------------------
 void applyInitialStrainStrain(PD_Particles &particles, double strain, int axis,
@@ -514,7 +521,7 @@ void setPD_N3L(PD_Particles &particles) {
 #ifdef USE_N3L
   const int indexMyPosistion = particles.registerPdParameter("myPosistion", -1);
   const ivec &colToId = particles.colToId();
-  const ivec &idToCol = particles.getIdToCol_v();
+  const IdToColMap &idToCol = particles.getIdToCol_v();
   int n = 0;
   const arma::mat &r = particles.r();
   const int nParticles = particles.nParticles();
@@ -524,15 +531,13 @@ void setPD_N3L(PD_Particles &particles) {
 #endif
   for (int i = 0; i < nParticles; i++) {
     const int id_i = colToId(i);
-    vector<pair<int, vector<double>>> &PDconnections_i =
-        particles.pdConnections(id_i);
+    BondList &PDconnections_i = particles.pdConnections(id_i);
 
     for (auto &con_i : PDconnections_i) {
       const int id_j = con_i.first;
       const int j = idToCol[id_j];
 
-      const vector<pair<int, vector<double>>> &PDconnections_j =
-          particles.pdConnections(id_j);
+      const BondList &PDconnections_j = particles.pdConnections(id_j);
 
       int found = false;
       int counter = 0;
@@ -570,8 +575,8 @@ void removeVoidConnections(PD_Particles &particles, Grid &grid,
   (void)delta;
   (void)lc;
 
-  arma::mat &data = particles.data();
-  ivec &idToCol = particles.getIdToCol_v();
+  ParticleData &data = particles.data();
+  const IdToColMap &idToCol = particles.getIdToCol_v();
   const ivec &colToId = particles.colToId();
 
   const mat &R0 = particles.r0();
@@ -594,8 +599,7 @@ void removeVoidConnections(PD_Particles &particles, Grid &grid,
 #endif
   for (unsigned int i = 0; i < particles.nParticles(); i++) {
     const int pId_i = colToId.at(i);
-    vector<pair<int, vector<double>>> &PDconnections =
-        particles.pdConnections(pId_i);
+    BondList &PDconnections = particles.pdConnections(pId_i);
     const vec &r_i = R0.row(i).t();
     ivec filled(m);
     arma::mat filledCenters = arma::zeros(M_DIM, m);
@@ -604,6 +608,8 @@ void removeVoidConnections(PD_Particles &particles, Grid &grid,
     for (auto &con : PDconnections) {
       const int id_j = con.first;
       const int col_j = idToCol[id_j];
+      if (col_j < 0)
+        continue;
       const double dr0_ij = con.second[indexDr0];
       const vec &r_j = R0.row(col_j).t();
 
@@ -637,7 +643,7 @@ void removeVoidConnections(PD_Particles &particles, Grid &grid,
       for (auto &con_b : PDconnections) {
         const int id_b = con_b.first;
         const int b = idToCol[id_b];
-        if (col_j == b)
+        if (b < 0 || col_j == b)
           continue;
         const vec &r_b = R0.row(b).t();
         const double radius = sf * data(b, indexRadius);
@@ -672,30 +678,25 @@ void removeVoidConnections(PD_Particles &particles, Grid &grid,
       }
 
       if (remove) {
-        con.second[indexConnected] = 0;
+        particles.breakBond(pId_i, con);
       }
     }
   }
 
-  // Enforcing symmetry
+  // Enforcing symmetry, serial since the bonds of the neighbours are broken
   int nFound = 0;
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
   for (unsigned int i = 0; i < particles.nParticles(); i++) {
     const int id_i = colToId.at(i);
-    const vector<pair<int, vector<double>>> &PDconnections_i =
-        particles.pdConnections(id_i);
+    const BondList &PDconnections_i = particles.pdConnections(id_i);
 
     for (auto &con_j : PDconnections_i) {
       const int id_j = con_j.first;
       const bool connected = con_j.second[indexConnected];
       if (!connected) {
-        vector<pair<int, vector<double>>> &PDconnections_j =
-            particles.pdConnections(id_j);
+        BondList &PDconnections_j = particles.pdConnections(id_j);
         for (auto &con_k : PDconnections_j) {
           if (con_k.first == id_i) {
-            con_k.second[indexConnected] = 0;
+            particles.breakBond(id_j, con_k);
             nFound++;
           }
         }
@@ -718,22 +719,15 @@ void cleanUpPdConnections(PD_Particles &particles) {
 #endif
   for (unsigned int i = 0; i < particles.nParticles(); i++) {
     const int id_i = colToId(i);
-    vector<pair<int, vector<double>>> &PDconnections_i =
-        particles.pdConnections(id_i);
-    vector<pair<int, vector<double>>> removeConnections;
-
-    for (auto &con_j : PDconnections_i) {
-      const bool connected = con_j.second[indexConnected];
-      if (!connected) {
-        removeConnections.push_back(con_j);
-      }
-    }
+    BondList &PDconnections_i = particles.pdConnections(id_i);
 
-    for (auto &con_j : removeConnections) {
-      PDconnections_i.erase(
-          std::remove(PDconnections_i.begin(), PDconnections_i.end(), con_j),
-          PDconnections_i.end());
-    }
+    // Removing the bonds that are not connected
+    PDconnections_i.erase(
+        std::remove_if(PDconnections_i.begin(), PDconnections_i.end(),
+                       [&](const pair<int, BondData> &con_j) {
+                         return !con_j.second[indexConnected];
+                       }),
+        PDconnections_i.end());
 
     if (PDconnections_i.size() <= minNumberOfConnections) {
       std::cerr << "Warning: node_id " << id_i
@@ -749,7 +743,7 @@ void addFractures(PD_Particles &particles,
   //    double error_thres = 2.2204e-016;
   double error_thres = 1.e-10;
   cout << "Removing explicit fractures" << endl;
-  const ivec &idToCol = particles.getIdToCol_v();
+  const IdToColMap &idToCol = particles.getIdToCol_v();
   const ivec &colToId = particles.colToId();
   const mat &R0 = particles.r0();
   const int indexConnected = particles.getPdParamId("connected");
@@ -759,8 +753,7 @@ void addFractures(PD_Particles &particles,
   int broken_bonds = 0;
   for (unsigned int i = 0; i < particles.nParticles(); i++) {
     const int id_i = colToId(i);
-    vector<pair<int, vector<double>>> &PDconnections =
-        particles.pdConnections(id_i);
+    BondList &PDconnections = particles.pdConnections(id_i);
     vec r0 = R0.row(i).t();
 
     for (auto &con : PDconnections) {
@@ -834,7 +827,7 @@ void addFractures(PD_Particles &particles,
       }
 
       if (intersect) {
-        con.second[indexConnected] = 0;
+        particles.breakBond(id_i, con);
         broken_bonds++;
       }
     }
@@ -949,4 +942,55 @@ string getFileEnding(string filename) {
   return elements[elements.size() - 1];
 }
 //------------------------------------------------------------------------------
+void principalStresses2d(const int n, const double *s_xx, const double *s_yy,
+                         const double *s_xy, double *p_max, double *p_min) {
+#ifdef USE_OPENMP
+#pragma omp simd
+#endif
+  for (int k = 0; k < n; k++) {
+    const double first = 0.5 * (s_xx[k] + s_yy[k]);
+    const double dx = 0.5 * (s_xx[k] - s_yy[k]);
+    const double second = sqrt(dx * dx + s_xy[k] * s_xy[k]);
+    p_max[k] = first + second;
+    p_min[k] = first - second;
+  }
+}
+//------------------------------------------------------------------------------
+void principalStresses3d(const int n, const double *s_xx, const double *s_yy,
+                         const double *s_zz, const double *s_xy,
+                         const double *s_xz, const double *s_yz, double *p_max,
+                         double *p_mid, double *p_min) {
+  // Trigonometric solution of the characteristic equation of the deviatoric
+  // part. The loop is branch free so that it vectorizes, an (almost)
+  // isotropic stress gives r = 0 and three equal principal stresses.
+  const double thirdPi2 = 2. * M_PI / 3.;
+  const double isotropic = 1e-100;
+
+#ifdef USE_OPENMP
+#pragma omp simd
+#endif
+  for (int k = 0; k < n; k++) {
+    const double mean = (s_xx[k] + s_yy[k] + s_zz[k]) / 3.;
+    const double a = s_xx[k] - mean;
+    const double b = s_yy[k] - mean;
+    const double c = s_zz[k] - mean;
+    const double offDiagonal =
+        s_xy[k] * s_xy[k] + s_xz[k] * s_xz[k] + s_yz[k] * s_yz[k];
+    const double p2 = (a * a + b * b + c * c + 2. * offDiagonal) / 6.;
+    const bool deviatoric = p2 > isotropic;
+    const double p = deviatoric ? sqrt(p2) : 0.;
+
+    const double det = a * (b * c - s_yz[k] * s_yz[k]) -
+                       s_xy[k] * (s_xy[k] * c - s_yz[k] * s_xz[k]) +
+                       s_xz[k] * (s_xy[k] * s_yz[k] - b * s_xz[k]);
+    double r = deviatoric ? 0.5 * det / (p2 * p) : 0.;
+    r = std::max(-1., std::min(1., r));
+
+    const double phi = acos(r) / 3.;
+    p_max[k] = mean + 2. * p * cos(phi);
+    p_min[k] = mean + 2. * p * cos(phi + thirdPi2);
+    p_mid[k] = 3. * mean - p_max[k] - p_min[k];
+  }
+}
+//------------------------------------------------------------------------------
 }
@@ -36,6 +36,15 @@ vector<int> optimalConfigurationCores(const int nCores,
                                       const vector<double> &domain,
                                       const int dim);
 string getFileEnding(string filename);
+
+// Closed-form principal stresses of n symmetric stress tensors, stored as
+// separate component arrays. The results are sorted, p_max >= p_mid >= p_min.
+void principalStresses2d(const int n, const double *s_xx, const double *s_yy,
+                         const double *s_xy, double *p_max, double *p_min);
+void principalStresses3d(const int n, const double *s_xx, const double *s_yy,
+                         const double *s_zz, const double *s_xy,
+                         const double *s_xz, const double *s_yz, double *p_max,
+                         double *p_mid, double *p_min);
 }
 //------------------------------------------------------------------------------
 #endif // PDFUNCTIONS_H
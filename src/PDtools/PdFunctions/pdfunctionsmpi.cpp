@@ -8,6 +8,8 @@
 #endif
 
 #include "config.h"
+#include "commtracer.h"
+#include "memorytracker.h"
 #include "Grid/grid.h"
 #include "Modfiers/modifier.h"
 #include "Particles/pd_particles.h"
@@ -39,12 +41,12 @@ void exchangeGhostParticles_boundary(Grid &grid, PD_Particles &particles) {
   const vector<int> &ghostParameters = particles.ghostParameters();
   const int needVelocity = particles.needGhostVelocity();
   const int needR0 = particles.getNeedGhostR0();
-  ivec &idToCol = particles.getIdToCol_v();
+  IdToColMap &idToCol = particles.getIdToCol_v();
   ivec &colToId = particles.colToId();
   mat &r = particles.r();
   mat &r0 = particles.r0();
   mat &v = particles.v();
-  mat &data = particles.data();
+  ParticleData &data = particles.data();
 
   // Sending the ghost particles to the other cpus
   const int nParticles = particles.nParticles();
@@ -56,6 +58,11 @@ void exchangeGhostParticles_boundary(Grid &grid, PD_Particles &particles) {
 
   int nGhostParticles = particles.nGhostParticles();
 
+  size_t listBytes = MemoryTracker::mapBytes(toNeighbours);
+  for (const auto &id_toNeighbours : toNeighbours) {
+    listBytes += MemoryTracker::vectorBytes(id_toNeighbours.second);
+  }
+
   for (const auto &id_toNeighbours : toNeighbours) {
     const int toNode = id_toNeighbours.first;
     const vector<pair<int, int>> &l_p = id_toNeighbours.second;
@@ -87,6 +94,7 @@ void exchangeGhostParticles_boundary(Grid &grid, PD_Particles &particles) {
     int nSendElements = ghostSend.size();
     int nRecieveElements;
     MPI_Status status;
+    const double traceStart = CommTracer::now();
     MPI_Sendrecv(&nSendElements, 1, MPI_INT, toNode, myRank * 10000,
                  &nRecieveElements, 1, MPI_INT, toNode, 10000 * toNode,
                  MPI_COMM_WORLD, &status);
@@ -96,6 +104,14 @@ void exchangeGhostParticles_boundary(Grid &grid, PD_Particles &particles) {
     MPI_Sendrecv(&ghostSend[0], nSendElements, MPI_DOUBLE, toNode,
                  myRank * 12000, &ghostRecieve, nRecieveElements, MPI_DOUBLE,
                  toNode, 12000 * toNode, MPI_COMM_WORLD, &status);
+    CommTracer::record(CommTracer::GhostExchange, toNode,
+                       sizeof(int) + nSendElements * sizeof(double),
+                       sizeof(int) + nRecieveElements * sizeof(double),
+                       CommTracer::now() - traceStart);
+    MemoryTracker::recordBuffer(MemoryTracker::GhostBuffers,
+                                MemoryTracker::vectorBytes(ghostSend) +
+                                    nRecieveElements * sizeof(double) +
+                                    listBytes);
 
     double l_r[3] = {0, 0, 0};
     size_t j = 0;
@@ -103,6 +119,8 @@ void exchangeGhostParticles_boundary(Grid &grid, PD_Particles &particles) {
       //            int j = i*nGhostparams;
       const int col = nParticles + nGhostParticles;
       const int id = ghostRecieve[j++];
+      particles.ensureCapacity(col + 1);
+      particles.ensureIdCapacity(id);
       idToCol[id] = col;
       colToId[col] = id;
 
@@ -160,11 +178,11 @@ void exchangeInitialGhostParticles_boundary(Grid &grid,
 
   const vector<int> &ghostParameters = particles.ghostParameters();
   const int nPdParameters = particles.PdParameters().size();
-  ivec &idToCol = particles.getIdToCol_v();
+  IdToColMap &idToCol = particles.getIdToCol_v();
   ivec &colToId = particles.colToId();
   mat &r = particles.r();
   mat &r0 = particles.r0();
-  mat &data = particles.data();
+  ParticleData &data = particles.data();
 
   // Sending the ghost particles to the other CPU's
   const size_t nParticles = particles.nParticles();
@@ -196,8 +214,8 @@ void exchangeInitialGhostParticles_boundary(Grid &grid,
       for (const auto &con : pd_connections) {
         sendData.push_back(con.first);
 
-        for (const double &param : con.second) {
-          sendData.push_back(param);
+        for (int k = 0; k < con.second.size(); k++) {
+          sendData.push_back(con.second[k]);
         }
       }
     }
@@ -222,6 +240,8 @@ void exchangeInitialGhostParticles_boundary(Grid &grid,
     while (j < nRecieveElements) {
       const int col = nParticles + nGhostParticles;
       const int id = (int)recieveData[j++];
+      particles.ensureCapacity(col + 1);
+      particles.ensureIdCapacity(id);
 
       idToCol[id] = col;
       colToId[col] = id;
@@ -236,7 +256,8 @@ void exchangeInitialGhostParticles_boundary(Grid &grid,
       }
 
       const int nPdConnections = recieveData[j++];
-      vector<pair<int, vector<double>>> connectionsVector;
+      BondList connectionsVector(particles.bondLayout());
+      connectionsVector.reserve(nPdConnections);
 
       for (int i = 0; i < nPdConnections; i++) {
         const int con_id = (int)recieveData[j++];
@@ -246,10 +267,9 @@ void exchangeInitialGhostParticles_boundary(Grid &grid,
           connectionData.push_back(recieveData[j++]);
         }
 
-        connectionsVector.push_back(
-            pair<int, vector<double>>(con_id, connectionData));
+        connectionsVector.push_back(con_id, connectionData);
       }
-      particles.setPdConnections(id, connectionsVector);
+      particles.setPdConnections(id, std::move(connectionsVector));
       nGhostParticles++;
 
       // Adding to the ghost particles to the correct grid point
@@ -288,7 +308,7 @@ void updateGrid(Grid &grid, PD_Particles &particles, const bool ADR) {
   mat &r = particles.r();
   mat &r0 = particles.r0();
   ivec &colToId = particles.colToId();
-  ivec &idToCol = particles.getIdToCol_v();
+  IdToColMap &idToCol = particles.getIdToCol_v();
   unordered_map<int, GridPoint> &gridpoints = grid.gridpoints();
 
   double r_i[3] = {0, 0, 0};
@@ -352,7 +372,7 @@ void updateGrid(Grid &grid, PD_Particles &particles, const bool ADR) {
   mat &r_prev = particles.r_prev();
   vec &stableMass = particles.stableMass();
   ivec &isStatic = particles.isStatic();
-  mat &data = particles.data();
+  ParticleData &data = particles.data();
 
   vector<int> gotParticles;
 
@@ -364,7 +384,7 @@ void updateGrid(Grid &grid, PD_Particles &particles, const bool ADR) {
 
     // Sending data
     for (const int id : sParticles) {
-      const int i = idToCol[id];
+      const int i = idToCol.at(id);
       const auto &pd_connections = particles.pdConnections(id);
 
       sendData.push_back(id);
@@ -399,8 +419,8 @@ void updateGrid(Grid &grid, PD_Particles &particles, const bool ADR) {
       for (const auto &con : pd_connections) {
         sendData.push_back(con.first);
 
-        for (const double &param : con.second) {
-          sendData.push_back(param);
+        for (int k = 0; k < con.second.size(); k++) {
+          sendData.push_back(con.second[k]);
         }
       }
 
@@ -422,6 +442,7 @@ void updateGrid(Grid &grid, PD_Particles &particles, const bool ADR) {
 #if DEBUG_MPI_PRINT
     cout << me << "->" << toCore << " sending " << nSendElements << endl;
 #endif
+    const double traceStart = CommTracer::now();
     MPI_Sendrecv(&nSendElements, 1, MPI_INT, toCore, 0, &nRecieveElements, 1,
                  MPI_INT, toCore, 0, MPI_COMM_WORLD, &status);
 #if DEBUG_MPI_PRINT
@@ -432,12 +453,21 @@ void updateGrid(Grid &grid, PD_Particles &particles, const bool ADR) {
     MPI_Sendrecv(&sendData[0], nSendElements, MPI_DOUBLE, toCore, 1,
                  &recieveData, nRecieveElements, MPI_DOUBLE, toCore, 1,
                  MPI_COMM_WORLD, &status);
+    CommTracer::record(CommTracer::Migration, toCore,
+                       sizeof(int) + nSendElements * sizeof(double),
+                       sizeof(int) + nRecieveElements * sizeof(double),
+                       CommTracer::now() - traceStart);
+    MemoryTracker::recordBuffer(MemoryTracker::GhostBuffers,
+                                MemoryTracker::vectorBytes(sendData) +
+                                    nRecieveElements * sizeof(double));
 
     // Storing the received particle data
     int j = 0;
     while (j < nRecieveElements) {
       const int i = nParticles;
       const int id = recieveData[j++];
+      particles.ensureCapacity(i + 1);
+      particles.ensureIdCapacity(id);
       idToCol[id] = i;
       colToId[i] = id;
 
@@ -467,7 +497,8 @@ void updateGrid(Grid &grid, PD_Particles &particles, const bool ADR) {
       }
       isStatic(i) = recieveData[j++];
       const int nPdConnections = recieveData[j++];
-      vector<pair<int, vector<double>>> connectionsVector;
+      BondList connectionsVector(particles.bondLayout());
+      connectionsVector.reserve(nPdConnections);
 
       for (int i = 0; i < nPdConnections; i++) {
         const int con_id = (int)recieveData[j++];
@@ -477,8 +508,7 @@ void updateGrid(Grid &grid, PD_Particles &particles, const bool ADR) {
           connectionData.push_back(recieveData[j++]);
         }
 
-        connectionsVector.push_back(
-            pair<int, vector<double>>(con_id, connectionData));
+        connectionsVector.push_back(con_id, connectionData);
       }
       // Verlet lists
       for (int verletId = 0; verletId < nVerletLists; verletId++) {
@@ -490,7 +520,7 @@ void updateGrid(Grid &grid, PD_Particles &particles, const bool ADR) {
         particles.setVerletList(id, verletlist, verletId);
       }
 
-      particles.setPdConnections(id, connectionsVector);
+      particles.setPdConnections(id, std::move(connectionsVector));
       nParticles++;
       particlesFrom[toCore].push_back(id);
       gotParticles.push_back(id);
@@ -553,6 +583,7 @@ void updateModifierLists(Modifier &modifier, PD_Particles &particles,
     int nSendElements = sendData.size();
     int nRecieveElements;
     MPI_Status status;
+    const double traceStart = CommTracer::now();
     MPI_Sendrecv(&nSendElements, 1, MPI_INT, core, me * 1000 + counter,
                  &nRecieveElements, 1, MPI_INT, core, 1000 * core + counter,
                  MPI_COMM_WORLD, &status);
@@ -562,6 +593,10 @@ void updateModifierLists(Modifier &modifier, PD_Particles &particles,
     MPI_Sendrecv(&sendData[0], nSendElements, MPI_INT, core,
                  me * 1200 + counter, &toBeAdded, nRecieveElements, MPI_INT,
                  core, 1200 * core + counter, MPI_COMM_WORLD, &status);
+    CommTracer::record(CommTracer::ModifierLists, core,
+                       (1 + nSendElements) * sizeof(int),
+                       (1 + nRecieveElements) * sizeof(int),
+                       CommTracer::now() - traceStart);
 
     if (nRecieveElements > 0) {
       for (const int id : toBeAdded) {
@@ -592,11 +627,11 @@ void exchangeInitialPeriodicBoundaryParticles(Grid &grid,
 
   const vector<int> &ghostParameters = particles.ghostParameters();
   const int nPdParameters = particles.PdParameters().size();
-  ivec &idToCol_v = particles.getIdToCol_v();
+  IdToColMap &idToCol_v = particles.getIdToCol_v();
   ivec &colToId = particles.colToId();
   mat &r = particles.r();
   mat &r0 = particles.r0();
-  mat &data = particles.data();
+  ParticleData &data = particles.data();
 
   // Sending the ghost particles to the other cpus
   const int nParticles = particles.nParticles();
@@ -637,8 +672,8 @@ void exchangeInitialPeriodicBoundaryParticles(Grid &grid,
       for (const auto &con : pd_connections) {
         sendData.push_back(con.first);
 
-        for (const double &param : con.second) {
-          sendData.push_back(param);
+        for (int k = 0; k < con.second.size(); k++) {
+          sendData.push_back(con.second[k]);
         }
       }
     }
@@ -664,6 +699,8 @@ void exchangeInitialPeriodicBoundaryParticles(Grid &grid,
     while (j < nRecieveElements) {
       const int col = nParticles + nGhostParticles;
       const int id = recieveData[j++];
+      particles.ensureCapacity(col + 1);
+      particles.ensureIdCapacity(id);
       idToCol_v[id] = col;
       colToId[col] = id;
 
@@ -678,7 +715,8 @@ void exchangeInitialPeriodicBoundaryParticles(Grid &grid,
       }
 
       const int nPdConnections = recieveData[j++];
-      vector<pair<int, vector<double>>> connectionsVector;
+      BondList connectionsVector(particles.bondLayout());
+      connectionsVector.reserve(nPdConnections);
 
       for (int i = 0; i < nPdConnections; i++) {
         const int con_id = (int)recieveData[j++];
@@ -688,10 +726,9 @@ void exchangeInitialPeriodicBoundaryParticles(Grid &grid,
           connectionData.push_back(recieveData[j++]);
         }
 
-        connectionsVector.push_back(
-            pair<int, vector<double>>(con_id, connectionData));
+        connectionsVector.push_back(con_id, connectionData);
       }
-      particles.setPdConnections(id, connectionsVector);
+      particles.setPdConnections(id, std::move(connectionsVector));
       nGhostParticles++;
 
       // Adding to the ghost particles to the correct grid point
@@ -730,12 +767,12 @@ void exchangePeriodicBoundaryParticles(Grid &grid, PD_Particles &particles) {
   const int needVelocity = particles.needGhostVelocity();
   const int needR0 = particles.getNeedGhostR0();
 //  const int nPdParameters = particles.PdParameters().size();
-  ivec & idToCol = particles.getIdToCol_v();
+  IdToColMap & idToCol = particles.getIdToCol_v();
   ivec &colToId = particles.colToId();
   mat &r = particles.r();
   mat &r0 = particles.r0();
   mat &v = particles.v();
-  mat &data = particles.data();
+  ParticleData &data = particles.data();
 
   // Sending the ghost particles to the other cpus
   const int nParticles = particles.nParticles();
@@ -787,6 +824,7 @@ void exchangePeriodicBoundaryParticles(Grid &grid, PD_Particles &particles) {
     int nRecieveElements;
     MPI_Status status;
 
+    const double traceStart = CommTracer::now();
     MPI_Sendrecv(&nSendElements, 1, MPI_INT, toRank, myRank * 100,
                  &nRecieveElements, 1, MPI_INT, toRank, toRank * 100,
                  MPI_COMM_WORLD, &status);
@@ -796,12 +834,21 @@ void exchangePeriodicBoundaryParticles(Grid &grid, PD_Particles &particles) {
     MPI_Sendrecv(&sendData[0], nSendElements, MPI_DOUBLE, toRank, myRank,
                  &recieveData, nRecieveElements, MPI_DOUBLE, toRank, toRank,
                  MPI_COMM_WORLD, &status);
+    CommTracer::record(CommTracer::GhostExchange, toRank,
+                       sizeof(int) + nSendElements * sizeof(double),
+                       sizeof(int) + nRecieveElements * sizeof(double),
+                       CommTracer::now() - traceStart);
+    MemoryTracker::recordBuffer(MemoryTracker::GhostBuffers,
+                                MemoryTracker::vectorBytes(sendData) +
+                                    nRecieveElements * sizeof(double));
 
     // Storing the received ghost data
     int j = 0;
     while (j < nRecieveElements) {
       const int col = nParticles + nGhostParticles;
       const int id = recieveData[j++];
+      particles.ensureCapacity(col + 1);
+      particles.ensureIdCapacity(id);
 
       idToCol[id] = col;
       colToId[col] = id;
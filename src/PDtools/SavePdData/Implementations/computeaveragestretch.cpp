@@ -19,7 +19,7 @@ ComputeAverageStretch::~ComputeAverageStretch()
 //------------------------------------------------------------------------------
 void ComputeAverageStretch::update(const int id_i, const int i)
 {
-    const vector<pair<int, vector<double>>> & PDconnections = m_particles.pdConnections(id_i);
+    const BondList & PDconnections = m_particles.pdConnections(id_i);
     double sAvg = 0;
     for(auto &con:PDconnections)
     {
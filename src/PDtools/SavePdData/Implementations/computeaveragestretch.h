@@ -17,7 +17,7 @@ public:
 private:
     int m_indexStretch;
     int m_indexAverageStretch;
-    arma::mat *m_data;
+    ParticleData *m_data;
 };
 //------------------------------------------------------------------------------
 }
@@ -14,8 +14,7 @@ ComputeDamage::ComputeDamage(PD_Particles &particles)
 ComputeDamage::~ComputeDamage() {}
 //------------------------------------------------------------------------------
 void ComputeDamage::update(const int id_i, const int i) {
-  const vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_i);
+  const BondList &PDconnections = m_particles.pdConnections(id_i);
   const int jnum = PDconnections.size();
   const double maxConnections = jnum;
   if (maxConnections <= 0) {
@@ -23,13 +22,7 @@ void ComputeDamage::update(const int id_i, const int i) {
     return;
   }
 
-  double tot = 0;
-  for (int jj = 0; jj < jnum; jj++) {
-    const auto &con = PDconnections[jj];
-    if (con.second[m_indexConnected] <= 0.5)
-      continue;
-    tot += 1;
-  }
+  const double tot = m_particles.nConnectedBonds(i);
 
   (*m_data)(i, m_indexDamage) = 1. - tot / maxConnections;
   //    (*m_data)(i, m_indexDamage) = tot;
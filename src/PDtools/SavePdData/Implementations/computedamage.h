@@ -18,7 +18,7 @@ private:
   int m_indexDamage;
   int m_indexMaxPdConnections;
   int m_indexConnected;
-  arma::mat *m_data;
+  ParticleData *m_data;
 };
 //------------------------------------------------------------------------------
 }
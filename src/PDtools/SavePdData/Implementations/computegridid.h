@@ -16,7 +16,7 @@ public:
 protected:
   Grid &m_grid;
   arma::mat &m_r;
-  arma::mat &m_data;
+  ParticleData &m_data;
   int m_indexgrid;
 };
 //------------------------------------------------------------------------------
@@ -19,7 +19,7 @@ private:
   int m_indexVolume;
   int m_indexRho;
   arma::mat *m_v;
-  arma::mat *m_data;
+  ParticleData *m_data;
 };
 //------------------------------------------------------------------------------
 }
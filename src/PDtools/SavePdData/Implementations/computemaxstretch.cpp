@@ -13,8 +13,7 @@ ComputeMaxStretch::ComputeMaxStretch(PD_Particles &particles)
 ComputeMaxStretch::~ComputeMaxStretch() {}
 //------------------------------------------------------------------------------
 void ComputeMaxStretch::update(const int id_i, const int i) {
-  vector<pair<int, vector<double>>> &PDconnections =
-      m_particles.pdConnections(id_i);
+  BondList &PDconnections = m_particles.pdConnections(id_i);
   double sMax = 0;
   for (auto &con : PDconnections) {
     double s = con.second[m_indexStretch];
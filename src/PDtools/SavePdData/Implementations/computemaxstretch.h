@@ -17,7 +17,7 @@ private:
   int m_indexDamage;
   int m_indexStretch;
   int m_indexMaxStretch;
-  arma::mat *m_data;
+  ParticleData *m_data;
 };
 //------------------------------------------------------------------------------
 }
@@ -13,7 +13,7 @@ ComputePotentialEnergy::ComputePotentialEnergy(PD_Particles &particles,
 ComputePotentialEnergy::~ComputePotentialEnergy() {}
 //------------------------------------------------------------------------------
 void ComputePotentialEnergy::update(const int id_i, const int i) {
-  m_data(id_i, m_indexPotential) = 0;
+  m_data(i, m_indexPotential) = 0;
 
   for (Force *force : m_forces) {
     force->calculatePotentialEnergy(id_i, i, m_indexPotential);
@@ -16,7 +16,7 @@ public:
 
 private:
   vector<Force *> &m_forces;
-  arma::mat &m_data;
+  ParticleData &m_data;
   int m_indexPotential;
 };
 //------------------------------------------------------------------------------
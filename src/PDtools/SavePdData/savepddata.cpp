@@ -164,11 +164,16 @@ void SavePdData::evaluate(double t, int i) {
   (void)t;
   (void)i;
 
+  // Only called on the steps that are saved. The compute properties only
+  // write their own particle.
   const ivec &colToId = m_particles->colToId();
-  for (unsigned int i = 0; i < m_particles->nParticles(); i++) {
-    const int id = colToId(i);
-    for (ComputeProperty *computeProperty : m_computeProperties) {
-      computeProperty->update(id, i);
+  const int nParticles = m_particles->nParticles();
+  for (ComputeProperty *computeProperty : m_computeProperties) {
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int i = 0; i < nParticles; i++) {
+      computeProperty->update(colToId(i), i);
     }
   }
 }
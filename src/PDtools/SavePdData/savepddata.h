@@ -10,6 +10,7 @@
 //------------------------------------------------------------------------------
 namespace PDtools {
 class PD_Particles;
+class ParticleData;
 class SaveParticles;
 class Force;
 class Grid;
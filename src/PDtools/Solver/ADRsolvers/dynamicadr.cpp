@@ -1,11 +1,14 @@
 #include "dynamicadr.h"
 
+#include "PDtools/Particles/pd_particles.h"
+
 namespace PDtools
 //------------------------------------------------------------------------------
 {
 dynamicADR::dynamicADR() {}
 //------------------------------------------------------------------------------
 void dynamicADR::solve() {
+  m_particles->buildBondCache();
   initialize();
   checkInitialization();
   calculateForces(0);
@@ -15,11 +18,15 @@ void dynamicADR::solve() {
   // Looping over all time, particles and components.
   for (int i = 0; i < m_steps; i++) {
     stepForward(i);
+    endStep(i + 1);
   }
 }
 //------------------------------------------------------------------------------
 void dynamicADR::stepForward(int timeStep) {
-  integrateStepOne();
+  {
+    Profiler::ScopedTimer timer(m_profiler, m_phaseIntegrateStepOne);
+    integrateStepOne();
+  }
   updateGridAndCommunication();
 
   modifiersStepOne();
@@ -35,7 +42,10 @@ void dynamicADR::stepForward(int timeStep) {
   //----------------------------------------------------------------------
 
   modifiersStepTwo();
-  integrateStepTwo();
+  {
+    Profiler::ScopedTimer timer(m_profiler, m_phaseIntegrateStepTwo);
+    integrateStepTwo();
+  }
 
   m_t += m_dt;
 }
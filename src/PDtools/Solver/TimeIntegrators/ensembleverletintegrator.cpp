@@ -0,0 +1,429 @@
+#include "ensembleverletintegrator.h"
+
+#include "PDtools/Force/force.h"
+#include "PDtools/Modfiers/modifier.h"
+#include "PDtools/Particles/pd_particles.h"
+
+#include <limits>
+
+namespace PDtools {
+//------------------------------------------------------------------------------
+EnsembleVerletIntegrator::EnsembleVerletIntegrator(
+    vector<double> micromodulusScale, vector<double> s0Scale,
+    vector<double> loadingRateScale)
+    : m_K(micromodulusScale.size()), m_cScale(micromodulusScale),
+      m_s0Scale(s0Scale), m_loadingRateScale(loadingRateScale) {
+  if (m_loadingRateScale.empty())
+    m_loadingRateScale.assign(m_K, 1.);
+}
+//------------------------------------------------------------------------------
+EnsembleVerletIntegrator::~EnsembleVerletIntegrator() {
+  if (m_ensembleFile.is_open())
+    m_ensembleFile.close();
+}
+//------------------------------------------------------------------------------
+void EnsembleVerletIntegrator::stepForward(int timeStep) {
+  applyBoundaryConditions();
+  copyParticlesToMember0();
+  synchronizeBoundary();
+  {
+    Profiler::ScopedTimer timer(m_profiler, m_phaseIntegrateStepOne);
+    integrateStepOne();
+  }
+  copyMember0ToParticles();
+
+  updateGridAndCommunication();
+  updateProperties(timeStep + 1, m_adaptiveDt && saveDue(timeStep + 1));
+  updateGhosts();
+
+  if (m_fracture)
+    evaluateFracture();
+  modifiersStepOne();
+  save(timeStep + 1);
+  //----------------------------------------------------------------------
+  calculateForces(timeStep + 1);
+  //----------------------------------------------------------------------
+  modifiersStepTwo();
+  copyParticlesToMember0();
+  synchronizeBoundary();
+  {
+    Profiler::ScopedTimer timer(m_profiler, m_phaseIntegrateStepTwo);
+    integrateStepTwo();
+  }
+  copyMember0ToParticles();
+
+  m_t += m_dt;
+
+  if (m_adaptiveDt)
+    updateDt(timeStep + 1);
+}
+//------------------------------------------------------------------------------
+void EnsembleVerletIntegrator::save(int timeStep) {
+  const int saveCounter = m_saveCounter;
+  TimeIntegrator::save(timeStep);
+
+  const bool saved = m_adaptiveDt ? (m_saveCounter != saveCounter)
+                                  : (timeStep % m_saveInterval == 0);
+  if (saved)
+    saveEnsemble();
+}
+//------------------------------------------------------------------------------
+void EnsembleVerletIntegrator::integrateStepOne() {
+  // v(t + 0.5dt) = v(t) + 0.5 F(t)/rho dt
+  // x(t + dt)    = x(t) + v(t + 0.5dt) dt
+  const ParticleData &data = m_particles->data();
+  const arma::imat &isStatic = m_particles->isStatic();
+  const int stride = m_dim * m_K;
+
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+  for (int i = 0; i < m_nParticles; i++) {
+    if (isStatic(i))
+      continue;
+
+    const double dtRho = 0.5 * m_dt / data(i, m_indexRho);
+    double *r_i = &m_rE[i * stride];
+    double *v_i = &m_vE[i * stride];
+    const double *F_i = &m_FE[i * stride];
+
+    for (int k = 0; k < stride; k++) {
+      v_i[k] += F_i[k] * dtRho;
+      r_i[k] += v_i[k] * m_dt;
+    }
+  }
+}
+//------------------------------------------------------------------------------
+void EnsembleVerletIntegrator::integrateStepTwo() {
+  const ParticleData &data = m_particles->data();
+  const arma::imat &isStatic = m_particles->isStatic();
+  const int stride = m_dim * m_K;
+
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+  for (int i = 0; i < m_nParticles; i++) {
+    if (isStatic(i))
+      continue;
+
+    const double dtRho = 0.5 * m_dt / data(i, m_indexRho);
+    double *v_i = &m_vE[i * stride];
+    const double *F_i = &m_FE[i * stride];
+
+    for (int k = 0; k < stride; k++) {
+      v_i[k] += F_i[k] * dtRho;
+    }
+  }
+}
+//------------------------------------------------------------------------------
+void EnsembleVerletIntegrator::enableFracture() { m_fracture = true; }
+//------------------------------------------------------------------------------
+void EnsembleVerletIntegrator::setEnsembleOutput(string path) {
+  m_ensembleOutput = path;
+}
+//------------------------------------------------------------------------------
+void EnsembleVerletIntegrator::initialize() {
+  VelocityVerletIntegrator::initialize();
+
+  m_nParticles = m_particles->nParticles();
+  m_indexVolume = m_particles->getParamId("volume");
+  m_indexConnected = m_particles->getPdParamId("connected");
+
+  const mat &r = m_particles->r();
+  const mat &v = m_particles->v();
+  const int stride = m_dim * m_K;
+  m_rE.assign(m_nParticles * stride, 0);
+  m_vE.assign(m_nParticles * stride, 0);
+  m_FE.assign(m_nParticles * stride, 0);
+
+  for (int i = 0; i < m_nParticles; i++) {
+    for (int d = 0; d < m_dim; d++) {
+      for (int m = 0; m < m_K; m++) {
+        m_rE[(i * m_dim + d) * m_K + m] = r(i, d);
+        m_vE[(i * m_dim + d) * m_K + m] = v(i, d);
+      }
+    }
+  }
+
+  buildBondTopology();
+
+  m_boundaryCols.clear();
+  const IdToColMap &idToCol = m_particles->getIdToCol_v();
+  const arma::imat &isStatic = m_particles->isStatic();
+  for (int i = 0; i < m_nParticles; i++) {
+    if (isStatic(i))
+      m_boundaryCols.push_back(i);
+  }
+  for (Modifier *modifier : m_boundaryModifiers) {
+    for (const int id : modifier->localParticleIds()) {
+      const int i = idToCol[id];
+      if (!isStatic(i))
+        m_boundaryCols.push_back(i);
+    }
+  }
+
+  if (!m_ensembleOutput.empty() && m_myRank == 0) {
+    m_ensembleFile.open(m_ensembleOutput);
+    m_ensembleFile << "# t member brokenBonds kineticEnergy maxDisplacement"
+                   << endl;
+  }
+}
+//------------------------------------------------------------------------------
+void EnsembleVerletIntegrator::checkInitialization() {
+  if (m_K < 1 || m_s0Scale.size() != m_cScale.size() ||
+      m_loadingRateScale.size() != m_cScale.size()) {
+    cerr << "Error: the ensemble needs at least one member and one "
+         << "parameter set per member" << endl;
+    throw EnsembleNotSupported;
+  }
+  if (m_loadingRateScale[0] != 1.) {
+    cerr << "Error: the loading rate of the first ensemble member must be 1, "
+         << "it runs the boundary conditions as configured" << endl;
+    throw EnsembleNotSupported;
+  }
+  if (m_nCores > 1 || m_particles->nGhostParticles() > 0) {
+    cerr << "Error: the ensemble integrator runs on a single rank without "
+         << "periodic boundaries" << endl;
+    throw EnsembleNotSupported;
+  }
+  if (m_oneBodyForces.size() != 1 ||
+      m_oneBodyForces[0]->name != "PD bond force") {
+    cerr << "Error: the ensemble integrator only supports a single "
+         << "'bond force'" << endl;
+    throw EnsembleNotSupported;
+  }
+  if (!m_spModifiers.empty()) {
+    cerr << "Error: the ensemble integrator evaluates fracture itself, "
+         << "other modifiers are not supported" << endl;
+    throw EnsembleNotSupported;
+  }
+#if USE_N3L
+  cerr << "Error: the ensemble integrator does not support USE_N3L" << endl;
+  throw EnsembleNotSupported;
+#endif
+
+  TimeIntegrator::checkInitialization();
+}
+//------------------------------------------------------------------------------
+void EnsembleVerletIntegrator::calculateForces(int timeStep) {
+  (void)timeStep;
+  const int K = m_K;
+  const int dim = m_dim;
+  const double *cScale = m_cScale.data();
+
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+  for (int i = 0; i < m_nParticles; i++) {
+    double *F_i = &m_FE[i * dim * K];
+    const double *r_i = &m_rE[i * dim * K];
+
+    for (int k = 0; k < dim * K; k++) {
+      F_i[k] = 0;
+    }
+
+    for (int b = m_bondOffset[i]; b < m_bondOffset[i + 1]; b++) {
+      const double *r_j = &m_rE[m_bondCol[b] * dim * K];
+      const double k_ij = m_bondK[b];
+      const double dr0 = m_bondDr0[b];
+      const double *connected = &m_connected[b * K];
+      double *stretch = &m_stretch[b * K];
+
+      // Members are contiguous, the inner loop vectorizes over the ensemble
+      for (int m = 0; m < K; m++) {
+        double dr2 = 0;
+        for (int d = 0; d < dim; d++) {
+          const double dx = r_j[d * K + m] - r_i[d * K + m];
+          dr2 += dx * dx;
+        }
+        const double dr = sqrt(dr2);
+        const double s = (dr - dr0) / dr0;
+        const double fbond = connected[m] * cScale[m] * k_ij * s / dr;
+
+        for (int d = 0; d < dim; d++) {
+          F_i[d * K + m] += (r_j[d * K + m] - r_i[d * K + m]) * fbond;
+        }
+        stretch[m] = s;
+      }
+    }
+  }
+
+  // Member 0 is mirrored in the particles for the modifiers and output
+  mat &F = m_particles->F();
+  for (int i = 0; i < m_nParticles; i++) {
+    for (int d = 0; d < m_dim; d++) {
+      F(i, d) = m_FE[(i * m_dim + d) * m_K];
+    }
+  }
+}
+//------------------------------------------------------------------------------
+void EnsembleVerletIntegrator::buildBondTopology() {
+  // The member independent part of the bond force is the bond coefficient
+  // cached by PD_bondForce
+  Force *bondForce = m_oneBodyForces[0];
+  bondForce->updateBondCache();
+
+  const ivec &colToId = m_particles->colToId();
+  const IdToColMap &idToCol = m_particles->getIdToCol_v();
+  const ParticleData &data = m_particles->data();
+  const int indexDr0 = m_particles->getPdParamId("dr0");
+  const int indexS0 = m_particles->getParamId("s0");
+  const int indexUnbreakable = m_particles->hasParameter("unbreakable")
+                                   ? m_particles->getParamId("unbreakable")
+                                   : -1;
+  const double noFracture = std::numeric_limits<double>::max();
+
+  m_bondOffset.assign(m_nParticles + 1, 0);
+  m_bondCol.clear();
+  m_bondK.clear();
+  m_bondDr0.clear();
+  m_bondS0.clear();
+  m_connected.clear();
+
+  for (int i = 0; i < m_nParticles; i++) {
+    const int id_i = colToId(i);
+    const bool unbreakable_i =
+        indexUnbreakable >= 0 && data(i, indexUnbreakable) >= 1;
+
+    const BondList &PDconnections = m_particles->pdConnections(id_i);
+    const int nConnections = PDconnections.size();
+    for (int l_j = 0; l_j < nConnections; l_j++) {
+      const auto &con = PDconnections[l_j];
+      const int j = idToCol[con.first];
+      const bool unbreakable =
+          unbreakable_i ||
+          (indexUnbreakable >= 0 && data(j, indexUnbreakable) >= 1);
+
+      m_bondCol.push_back(j);
+      m_bondK.push_back(bondForce->cachedBondCoefficient(i, l_j));
+      m_bondDr0.push_back(con.second[indexDr0]);
+      m_bondS0.push_back(unbreakable ? noFracture
+                                     : std::min(data(i, indexS0),
+                                                data(j, indexS0)));
+
+      const double connected = con.second[m_indexConnected] > 0.5 ? 1 : 0;
+      for (int m = 0; m < m_K; m++) {
+        m_connected.push_back(connected);
+      }
+    }
+    m_bondOffset[i + 1] = m_bondCol.size();
+  }
+  m_stretch.assign(m_connected.size(), 0);
+}
+//------------------------------------------------------------------------------
+void EnsembleVerletIntegrator::evaluateFracture() {
+  const int K = m_K;
+  const int nBonds = m_bondCol.size();
+  const double *s0Scale = m_s0Scale.data();
+
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+  for (int b = 0; b < nBonds; b++) {
+    const double s0 = m_bondS0[b];
+    double *connected = &m_connected[b * K];
+    const double *stretch = &m_stretch[b * K];
+
+    for (int m = 0; m < K; m++) {
+      connected[m] = (stretch[m] > s0Scale[m] * s0) ? 0 : connected[m];
+    }
+  }
+
+  // The topology of member 0 is kept in the bonds for the output. Bonds
+  // only break, so the new breaks go through breakBond() to keep the
+  // connectivity bits and the bond-break events in sync.
+  const ivec &colToId = m_particles->colToId();
+  int b = 0;
+  for (int i = 0; i < m_nParticles; i++) {
+    const int id_i = colToId(i);
+    for (auto &con : m_particles->pdConnections(id_i)) {
+      if (m_connected[b * K] <= 0.5)
+        m_particles->breakBond(id_i, con);
+      b++;
+    }
+  }
+}
+//------------------------------------------------------------------------------
+void EnsembleVerletIntegrator::copyMember0ToParticles() {
+  mat &r = m_particles->r();
+  mat &v = m_particles->v();
+
+  for (int i = 0; i < m_nParticles; i++) {
+    for (int d = 0; d < m_dim; d++) {
+      r(i, d) = m_rE[(i * m_dim + d) * m_K];
+      v(i, d) = m_vE[(i * m_dim + d) * m_K];
+    }
+  }
+}
+//------------------------------------------------------------------------------
+void EnsembleVerletIntegrator::copyParticlesToMember0() {
+  const mat &r = m_particles->r();
+  const mat &v = m_particles->v();
+  const mat &F = m_particles->F();
+
+  for (int i = 0; i < m_nParticles; i++) {
+    for (int d = 0; d < m_dim; d++) {
+      m_rE[(i * m_dim + d) * m_K] = r(i, d);
+      m_vE[(i * m_dim + d) * m_K] = v(i, d);
+      m_FE[(i * m_dim + d) * m_K] = F(i, d);
+    }
+  }
+}
+//------------------------------------------------------------------------------
+void EnsembleVerletIntegrator::synchronizeBoundary() {
+  // The boundary conditions are applied to member 0 only. The boundary
+  // motion is proportional to the loading rate, the other members follow
+  // it scaled by theirs.
+  const mat &r0 = m_particles->r0();
+  for (const int i : m_boundaryCols) {
+    for (int d = 0; d < m_dim; d++) {
+      const int k = (i * m_dim + d) * m_K;
+      const double u = m_rE[k] - r0(i, d);
+      for (int m = 1; m < m_K; m++) {
+        const double rate = m_loadingRateScale[m];
+        m_rE[k + m] = r0(i, d) + rate * u;
+        m_vE[k + m] = rate * m_vE[k];
+        m_FE[k + m] = rate * m_FE[k];
+      }
+    }
+  }
+}
+//------------------------------------------------------------------------------
+void EnsembleVerletIntegrator::saveEnsemble() {
+  if (!m_ensembleFile.is_open())
+    return;
+
+  const ParticleData &data = m_particles->data();
+  const mat &r0 = m_particles->r0();
+
+  for (int m = 0; m < m_K; m++) {
+    int brokenBonds = 0;
+    for (unsigned int b = 0; b < m_bondCol.size(); b++) {
+      if (m_connected[b * m_K + m] <= 0.5)
+        brokenBonds++;
+    }
+
+    double kineticEnergy = 0;
+    double maxDisplacement = 0;
+    for (int i = 0; i < m_nParticles; i++) {
+      const double vol_i = data(i, m_indexVolume);
+      const double rho_i = data(i, m_indexRho);
+      double v2 = 0;
+      double u2 = 0;
+      for (int d = 0; d < m_dim; d++) {
+        const int k = (i * m_dim + d) * m_K + m;
+        const double u = m_rE[k] - r0(i, d);
+        v2 += m_vE[k] * m_vE[k];
+        u2 += u * u;
+      }
+      kineticEnergy += 0.5 * rho_i * vol_i * v2;
+      maxDisplacement = std::max(maxDisplacement, u2);
+    }
+
+    // Each bond is stored from both particles
+    m_ensembleFile << m_t << " " << m << " " << brokenBonds / 2 << " "
+                   << kineticEnergy << " " << sqrt(maxDisplacement) << endl;
+  }
+}
+//------------------------------------------------------------------------------
+}
@@ -0,0 +1,83 @@
+#ifndef ENSEMBLEVERLETINTEGRATOR_H
+#define ENSEMBLEVERLETINTEGRATOR_H
+
+#include "velocityverletintegrator.h"
+
+#include <fstream>
+
+namespace PDtools {
+//------------------------------------------------------------------------------
+// Velocity Verlet for an ensemble of K independent members sharing one bond
+// topology. Each member has its own positions, velocities, forces and
+// per-bond 'connected' mask, stored interleaved over the members so the
+// bond loop is swept once for all members.
+//
+// The members differ in material, a scaling of the micromodulus (E) and of
+// the critical stretch (s0/G0), and in loading rate. Boundary conditions,
+// modifiers and the regular output run on member 0, at the loading rate
+// they are configured with. The particles driven by the boundary conditions
+// follow the displacement, velocity and force of member 0 in all members,
+// scaled by the loading rate of the member. A per-member summary is written
+// to the ensemble output file.
+//
+// Supported for the bond force with the critical stretch criterion, on a
+// single rank without ghost particles.
+class EnsembleVerletIntegrator : public VelocityVerletIntegrator {
+public:
+  EnsembleVerletIntegrator(vector<double> micromodulusScale,
+                           vector<double> s0Scale,
+                           vector<double> loadingRateScale = {});
+  ~EnsembleVerletIntegrator();
+
+  virtual void stepForward(int timeStep);
+  virtual void save(int timeStep);
+  virtual void integrateStepOne();
+  virtual void integrateStepTwo();
+  void enableFracture();
+  void setEnsembleOutput(string path);
+
+  enum EnsembleErrorMessages { EnsembleNotSupported };
+
+protected:
+  int m_K;
+  int m_nParticles = 0;
+  vector<double> m_cScale;
+  vector<double> m_s0Scale;
+  vector<double> m_loadingRateScale;
+  bool m_fracture = false;
+  string m_ensembleOutput;
+  std::ofstream m_ensembleFile;
+  int m_indexVolume;
+  int m_indexConnected;
+
+  // Member state, indexed [(i*dim + d)*K + m]
+  vector<double> m_rE;
+  vector<double> m_vE;
+  vector<double> m_FE;
+
+  // Shared bond topology (CSR over the particle columns)
+  vector<int> m_bondOffset;
+  vector<int> m_bondCol;
+  vector<double> m_bondK;
+  vector<double> m_bondDr0;
+  vector<double> m_bondS0;
+
+  // Member bond state, indexed [b*K + m]
+  vector<double> m_connected;
+  vector<double> m_stretch;
+
+  vector<int> m_boundaryCols;
+
+  virtual void initialize();
+  virtual void checkInitialization();
+  virtual void calculateForces(int timeStep);
+  void buildBondTopology();
+  void evaluateFracture();
+  void copyMember0ToParticles();
+  void copyParticlesToMember0();
+  void synchronizeBoundary();
+  void saveEnsemble();
+};
+//------------------------------------------------------------------------------
+}
+#endif // ENSEMBLEVERLETINTEGRATOR_H
@@ -13,7 +13,7 @@ void EulerCromerIntegrator::integrateStepOne() {
   mat &r = m_particles->r();
   mat &v = m_particles->v();
   const mat &F = m_particles->F();
-  const mat &data = m_particles->data();
+  const ParticleData &data = m_particles->data();
   const arma::imat &isStatic = m_particles->isStatic();
 
 #ifdef USE_OPENMP
@@ -0,0 +1,267 @@
+#include "multirateverletintegrator.h"
+
+#include "PDtools/Force/force.h"
+#include "PDtools/Particles/pd_particles.h"
+
+#include <limits>
+
+namespace PDtools {
+//------------------------------------------------------------------------------
+MultiRateVerletIntegrator::MultiRateVerletIntegrator(int nLevels,
+                                                     int levelUpdateFrequency)
+    : m_nLevels(nLevels), m_levelUpdateFrequency(levelUpdateFrequency) {}
+//------------------------------------------------------------------------------
+MultiRateVerletIntegrator::~MultiRateVerletIntegrator() {}
+//------------------------------------------------------------------------------
+void MultiRateVerletIntegrator::stepForward(int timeStep) {
+  if (timeStep % m_levelUpdateFrequency == 0)
+    assignRateLevels();
+
+  applyBoundaryConditions();
+
+  // The substeps, with the forces of the fine levels, are the step one of
+  // the profile
+  {
+    Profiler::ScopedTimer timer(m_profiler, m_phaseIntegrateStepOne);
+    // Opening half kick of every level
+    for (int l = 0; l <= m_maxLevel; l++) {
+      kick(l, 0.5 * m_dt / (1 << l));
+    }
+
+    const int nSub = 1 << m_maxLevel;
+    const double h = m_dt / nSub;
+
+    for (int k = 1; k <= nSub; k++) {
+      drift(h);
+
+      if (k == nSub)
+        break;
+
+      // The levels whose step ends at substep k
+      int lmin = m_maxLevel;
+      while (lmin > 0 && k % (1 << (m_maxLevel - lmin + 1)) == 0) {
+        lmin--;
+      }
+
+      updateGhosts();
+      calculateLevelForces(lmin);
+
+      // Closing half kick and the opening half kick of the next step
+      for (int l = lmin; l <= m_maxLevel; l++) {
+        kick(l, m_dt / (1 << l));
+      }
+    }
+  }
+
+  // Synchronised macro step for all levels
+  updateGridAndCommunication();
+  updateProperties(timeStep + 1, m_adaptiveDt && saveDue(timeStep + 1));
+  updateGhosts();
+#if USE_MPI
+  // Particles might have changed columns
+  updateLevelLists();
+#endif
+
+  modifiersStepOne();
+  save(timeStep + 1);
+  //----------------------------------------------------------------------
+  zeroForces();
+  calculateForces(timeStep + 1);
+  //----------------------------------------------------------------------
+  updateGhosts();
+
+  modifiersStepTwo();
+  {
+    Profiler::ScopedTimer timer(m_profiler, m_phaseIntegrateStepTwo);
+    integrateStepTwo();
+  }
+
+  m_t += m_dt;
+
+  if (m_adaptiveDt)
+    updateDt(timeStep + 1);
+}
+//------------------------------------------------------------------------------
+void MultiRateVerletIntegrator::integrateStepTwo() {
+  for (int l = 0; l <= m_maxLevel; l++) {
+    kick(l, 0.5 * m_dt / (1 << l));
+  }
+}
+//------------------------------------------------------------------------------
+void MultiRateVerletIntegrator::initialize() {
+  m_indexRateLevel = m_particles->registerParameter("rateLevel");
+  m_particles->addGhostParameter("rateLevel");
+  VelocityVerletIntegrator::initialize();
+}
+//------------------------------------------------------------------------------
+void MultiRateVerletIntegrator::checkInitialization() {
+#if USE_N3L
+  // The partial force evaluations of the fine levels must only write to the
+  // evaluated particles.
+  cerr << "Error: the multi-rate integrator does not support USE_N3L" << endl;
+  throw N3LNotSupported;
+#endif
+  if (m_nLevels < 1) {
+    cerr << "Error: the multi-rate integrator needs at least one level, "
+         << "nLevels = " << m_nLevels << endl;
+    throw InvalidNumberOfLevels;
+  }
+  m_levelUpdateFrequency = std::max(1, m_levelUpdateFrequency);
+
+  TimeIntegrator::checkInitialization();
+}
+//------------------------------------------------------------------------------
+void MultiRateVerletIntegrator::assignRateLevels() {
+  // Level l is stable when dt/2^l < safety*sqrt(2 rho/K), using the same
+  // stiffness bound as in the adaptive time stepping.
+  const ivec &colToId = m_particles->colToId();
+  ParticleData &data = m_particles->data();
+  const arma::imat &isStatic = m_particles->isStatic();
+  const int nParticles = m_particles->nParticles();
+  const int maxAllowedLevel = m_nLevels - 1;
+  int maxLevel = 0;
+
+#ifdef USE_OPENMP
+#pragma omp parallel for reduction(max : maxLevel)
+#endif
+  for (int i = 0; i < nParticles; i++) {
+    int level = 0;
+
+    if (!isStatic(i)) {
+      const int id = colToId(i);
+      double stiffness = 0;
+      for (Force *oneBodyForce : m_oneBodyForces) {
+        stiffness += oneBodyForce->calculateStableMass(id, i, 1.);
+      }
+
+      if (stiffness > 0) {
+        const double dtStable =
+            m_dtSafety * sqrt(2. * data(i, m_indexRho) / stiffness);
+        if (m_dt > dtStable) {
+          level = std::ceil(std::log2(m_dt / dtStable));
+          level = std::min(level, maxAllowedLevel);
+        }
+      }
+    }
+
+    data(i, m_indexRateLevel) = level;
+    maxLevel = std::max(maxLevel, level);
+  }
+#if USE_MPI
+  // All ranks must run the same number of substeps
+  MPI_Allreduce(MPI_IN_PLACE, &maxLevel, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+#endif
+  m_maxLevel = maxLevel;
+
+  updateGhosts();
+  updateLevelLists();
+}
+//------------------------------------------------------------------------------
+void MultiRateVerletIntegrator::updateLevelLists() {
+  const ParticleData &data = m_particles->data();
+  const ivec &colToId = m_particles->colToId();
+  const IdToColMap &idToCol = m_particles->getIdToCol_v();
+  const int nParticles = m_particles->nParticles();
+
+  m_levelCols.assign(m_maxLevel + 1, vector<int>());
+  m_stateCols.assign(m_maxLevel + 1, vector<int>());
+
+  for (int i = 0; i < nParticles; i++) {
+    const int level = data(i, m_indexRateLevel);
+    m_levelCols[level].push_back(i);
+
+    // The state of a particle is needed at the finest level of itself and
+    // its neighbours (ghosts included).
+    int stateLevel = level;
+    const int id = colToId(i);
+    for (const auto &con : m_particles->pdConnections(id)) {
+      const int j = idToCol[con.first];
+      stateLevel = std::max(stateLevel, int(data(j, m_indexRateLevel)));
+    }
+
+    for (int l = 1; l <= stateLevel; l++) {
+      m_stateCols[l].push_back(i);
+    }
+  }
+}
+//------------------------------------------------------------------------------
+void MultiRateVerletIntegrator::kick(int level, double dt) {
+  mat &v = m_particles->v();
+  const mat &F = m_particles->F();
+  const ParticleData &data = m_particles->data();
+  const arma::imat &isStatic = m_particles->isStatic();
+  const vector<int> &cols = m_levelCols[level];
+  const int nCols = cols.size();
+
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+  for (int c = 0; c < nCols; c++) {
+    const int i = cols[c];
+    if (isStatic(i))
+      continue;
+
+    const double dtRho = dt / data(i, m_indexRho);
+    for (int d = 0; d < m_dim; d++) {
+      v(i, d) += F(i, d) * dtRho;
+    }
+  }
+}
+//------------------------------------------------------------------------------
+void MultiRateVerletIntegrator::drift(double h) {
+  mat &r = m_particles->r();
+  const mat &v = m_particles->v();
+  const arma::imat &isStatic = m_particles->isStatic();
+  const int nParticles = m_particles->nParticles();
+
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+  for (int i = 0; i < nParticles; i++) {
+    if (isStatic(i))
+      continue;
+
+    for (int d = 0; d < m_dim; d++) {
+      r(i, d) += v(i, d) * h;
+    }
+  }
+}
+//------------------------------------------------------------------------------
+void MultiRateVerletIntegrator::calculateLevelForces(int level) {
+  const ivec &colToId = m_particles->colToId();
+  mat &F = m_particles->F();
+
+  for (int l = level; l <= m_maxLevel; l++) {
+    for (const int i : m_levelCols[l]) {
+      for (int d = 0; d < m_dim; d++) {
+        F(i, d) = 0;
+      }
+    }
+  }
+
+  bool hasUpdateState = false;
+  for (Force *oneBodyForce : m_oneBodyForces) {
+    if (!oneBodyForce->getHasUpdateState())
+      continue;
+    hasUpdateState = true;
+
+    for (const int i : m_stateCols[level]) {
+      const int id = colToId[i];
+      oneBodyForce->updateState(id, i);
+    }
+  }
+  if (hasUpdateState) {
+    updateGhosts();
+  }
+
+  for (int l = level; l <= m_maxLevel; l++) {
+    for (const int i : m_levelCols[l]) {
+      const int id = colToId[i];
+      for (Force *oneBodyForce : m_oneBodyForces) {
+        oneBodyForce->calculateForces(id, i);
+      }
+    }
+  }
+}
+//------------------------------------------------------------------------------
+}
@@ -0,0 +1,51 @@
+#ifndef MULTIRATEVERLETINTEGRATOR_H
+#define MULTIRATEVERLETINTEGRATOR_H
+
+#include "velocityverletintegrator.h"
+
+namespace PDtools {
+//------------------------------------------------------------------------------
+// Velocity Verlet with subcycling. Particles are grouped into rate levels
+// from their local stability limit; level l is integrated with the step
+// dt/2^l, so only the (few) stiff particles are evaluated at the finest rate.
+//
+// Within a macro step all particles drift every substep. Particles on a
+// coarser level move with their constant half-step velocity, which is a
+// linear interpolation of their position over the coarse step, and the
+// interface forces on the finer levels are evaluated against these
+// interpolated positions. Particle states (e.g. the deformation gradient in
+// NOPD) are updated for the active particles and their neighbours.
+//
+// Modifiers, properties, output and the global force state (e.g. contact
+// verlet lists) are only evaluated at the macro steps.
+class MultiRateVerletIntegrator : public VelocityVerletIntegrator {
+public:
+  MultiRateVerletIntegrator(int nLevels = 3, int levelUpdateFrequency = 10);
+  ~MultiRateVerletIntegrator();
+
+  virtual void stepForward(int timeStep);
+  virtual void integrateStepTwo();
+
+  enum MultiRateErrorMessages { N3LNotSupported, InvalidNumberOfLevels };
+
+protected:
+  int m_nLevels;
+  int m_maxLevel = 0;
+  int m_levelUpdateFrequency;
+  int m_indexRateLevel;
+  // Local columns per rate level
+  vector<vector<int>> m_levelCols;
+  // Local columns with a state update at each level (incl. neighbours)
+  vector<vector<int>> m_stateCols;
+
+  virtual void initialize();
+  virtual void checkInitialization();
+  void assignRateLevels();
+  void updateLevelLists();
+  void kick(int level, double dt);
+  void drift(double h);
+  void calculateLevelForces(int level);
+};
+//------------------------------------------------------------------------------
+}
+#endif // MULTIRATEVERLETINTEGRATOR_H
@@ -4,7 +4,7 @@
 
 namespace PDtools {
 //------------------------------------------------------------------------------
-VelocityVerletIntegrator::VelocityVerletIntegrator() {}
+VelocityVerletIntegrator::VelocityVerletIntegrator() { m_hasStepTwo = true; }
 //------------------------------------------------------------------------------
 VelocityVerletIntegrator::~VelocityVerletIntegrator() {}
 //------------------------------------------------------------------------------
@@ -15,7 +15,7 @@ void VelocityVerletIntegrator::integrateStepOne() {
   mat &r = m_particles->r();
   mat &v = m_particles->v();
   const mat &F = m_particles->F();
-  const mat &data = m_particles->data();
+  const ParticleData &data = m_particles->data();
   const double dtRhoHalf = 0.5 * m_dt;
   const arma::imat &isStatic = m_particles->isStatic();
 
@@ -42,7 +42,7 @@ void VelocityVerletIntegrator::integrateStepTwo() {
   // Updating to the full-step velocity
   mat &v = m_particles->v();
   const mat &F = m_particles->F();
-  const mat &data = m_particles->data();
+  const ParticleData &data = m_particles->data();
   const double dtRhoHalf = 0.5 * m_dt;
   const arma::imat &isStatic = m_particles->isStatic();
 
@@ -62,4 +62,17 @@ void VelocityVerletIntegrator::integrateStepTwo() {
   }
 }
 //------------------------------------------------------------------------------
+void VelocityVerletIntegrator::integrateStepTwo(const int i) {
+  if (m_particles->isStatic()(i))
+    return;
+
+  mat &v = m_particles->v();
+  const mat &F = m_particles->F();
+  const double dtRho = 0.5 * m_dt / m_particles->data()(i, m_indexRho);
+
+  for (int d = 0; d < m_dim; d++) {
+    v(i, d) += F(i, d) * dtRho;
+  }
+}
+//------------------------------------------------------------------------------
 }
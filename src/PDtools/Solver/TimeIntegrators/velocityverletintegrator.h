@@ -12,6 +12,7 @@ public:
 
   virtual void integrateStepOne();
   virtual void integrateStepTwo();
+  virtual void integrateStepTwo(const int i);
 };
 //------------------------------------------------------------------------------
 }
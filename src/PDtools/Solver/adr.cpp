@@ -8,6 +8,7 @@
 #include "PDtools/Grid/grid.h"
 #include "PDtools/Modfiers/modifier.h"
 #include "PDtools/Particles/pd_particles.h"
+#include "PDtools/PdFunctions/commtracer.h"
 #include "PDtools/PdFunctions/pdfunctions.h"
 #include "PDtools/SavePdData/savepddata.h"
 
@@ -23,6 +24,7 @@ ADR::ADR() {
 }
 //------------------------------------------------------------------------------
 void ADR::solve() {
+  m_particles->buildBondCache();
   initialize();
   checkInitialization();
   save(0);
@@ -30,6 +32,7 @@ void ADR::solve() {
   // Looping over all time, particles and components.
   for (int i = 0; i < m_steps; i++) {
     stepForward(i);
+    endStep(i + 1);
   }
 }
 //------------------------------------------------------------------------------
@@ -101,12 +104,18 @@ void ADR::iterate(int maxNumberOfSteps) {
   for (counter = 0; counter < maxNumberOfSteps; counter++) {
     //        cout << counter << " global_error:" << m_globalError << "
     //        err_threshold:"<< m_errorThreshold << endl;
-    integrateStepOne();
+    {
+      Profiler::ScopedTimer timer(m_profiler, m_phaseIntegrateStepOne);
+      integrateStepOne();
+    }
     updateGridAndCommunication();
     zeroForces();
     calculateForces(0);
     staticModifiers();
-    integrateStepTwo();
+    {
+      Profiler::ScopedTimer timer(m_profiler, m_phaseIntegrateStepTwo);
+      integrateStepTwo();
+    }
     updateGridAndCommunication();
 
     //        if(m_myRank == 0)
@@ -297,9 +306,15 @@ void ADR::integrateStepOne() {
     }
   }
 #if USE_MPI
+  double traceStart = CommTracer::now();
   MPI_Allreduce(MPI_IN_PLACE, &maxU, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+  CommTracer::recordAllreduce(CommTracer::now() - traceStart);
+  traceStart = CommTracer::now();
   MPI_Allreduce(MPI_IN_PLACE, &avgU, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+  CommTracer::recordAllreduce(CommTracer::now() - traceStart);
+  traceStart = CommTracer::now();
   MPI_Allreduce(MPI_IN_PLACE, &np, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+  CommTracer::recordAllreduce(CommTracer::now() - traceStart);
 #endif
 
   //    if(m_myRank == 0)
@@ -376,10 +391,14 @@ void ADR::integrateStepTwo() {
     }
   }
 #if USE_MPI
+  double traceStart = CommTracer::now();
   MPI_Allreduce(MPI_IN_PLACE, &numerator, 1, MPI_DOUBLE, MPI_SUM,
                 MPI_COMM_WORLD);
+  CommTracer::recordAllreduce(CommTracer::now() - traceStart);
+  traceStart = CommTracer::now();
   MPI_Allreduce(MPI_IN_PLACE, &denominator, 1, MPI_DOUBLE, MPI_SUM,
                 MPI_COMM_WORLD);
+  CommTracer::recordAllreduce(CommTracer::now() - traceStart);
 #endif
 
   m_c = 0;
@@ -395,8 +414,10 @@ void ADR::integrateStepTwo() {
 }
 //------------------------------------------------------------------------------
 void ADR::staticModifiers() {
-  for (Modifier *modifier : m_boundaryModifiers) {
-    modifier->staticEvaluation();
+  const int nModifiers = m_boundaryModifiers.size();
+  for (int m = 0; m < nModifiers; m++) {
+    Profiler::ScopedTimer timer(m_profiler, m_boundaryModifierPhases[m]);
+    m_boundaryModifiers[m]->staticEvaluation();
   }
 }
 //------------------------------------------------------------------------------
@@ -404,6 +425,7 @@ void ADR::calculateStableMass() {
 #if USE_MPI
   m_mainGrid->clearGhostParticles();
   exchangeInitialGhostParticles(*m_mainGrid, *m_particles);
+  m_particles->updateNeighbourColumns();
 #endif
   const ivec &colToId = m_particles->colToId();
   arma::vec &stableMass = m_particles->stableMass();
@@ -470,6 +492,8 @@ void ADR::calculateStableMass() {
 }
 //------------------------------------------------------------------------------
 void ADR::updateGridAndCommunication() {
+  Profiler::ScopedTimer timer(m_profiler, m_phaseUpdateGrid);
+
   m_mainGrid->clearParticles();
   updateGrid(*m_mainGrid, *m_particles, true);
 
@@ -482,6 +506,7 @@ void ADR::updateGridAndCommunication() {
     updateModifierLists(*modifier, *m_particles, counter);
     counter++;
   }
+  m_particles->buildBondCache();
 #endif
 
   //    updateElementQuadrature(*m_particles);
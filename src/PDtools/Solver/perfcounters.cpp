@@ -0,0 +1,161 @@
+#include "perfcounters.h"
+
+#ifdef __linux__
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif
+
+namespace PDtools {
+//------------------------------------------------------------------------------
+PerfCounters::PerfCounters() { m_available.fill(false); }
+//------------------------------------------------------------------------------
+PerfCounters::~PerfCounters() { close(); }
+//------------------------------------------------------------------------------
+bool PerfCounters::open() {
+  close();
+  bool opened = false;
+
+#ifdef __linux__
+  int nThreads = 1;
+#ifdef USE_OPENMP
+  nThreads = omp_get_max_threads();
+#endif
+  array<int, nEvents> closed;
+  closed.fill(-1);
+  m_fds.assign(nThreads, closed);
+
+  // Each thread opens the counters of itself. A thread the runtime did not
+  // start keeps its closed counters.
+#ifdef USE_OPENMP
+#pragma omp parallel num_threads(nThreads)
+  openEvents(m_fds[omp_get_thread_num()]);
+#else
+  openEvents(m_fds[0]);
+#endif
+
+  for (int event = 0; event < nEvents; event++) {
+    m_available[event] = true;
+    for (const array<int, nEvents> &fds : m_fds) {
+      m_available[event] = m_available[event] && fds[event] >= 0;
+    }
+    if (m_available[event]) {
+      opened = true;
+      continue;
+    }
+    for (array<int, nEvents> &fds : m_fds) {
+      if (fds[event] >= 0)
+        ::close(fds[event]);
+      fds[event] = -1;
+    }
+  }
+#endif
+
+  return opened;
+}
+//------------------------------------------------------------------------------
+void PerfCounters::openEvents(array<int, nEvents> &fds) {
+#ifdef __linux__
+  for (int event = 0; event < nEvents; event++) {
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format =
+        PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    switch (event) {
+    case Cycles:
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = PERF_COUNT_HW_CPU_CYCLES;
+      break;
+    case Instructions:
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+      break;
+    case L1dMisses:
+      attr.type = PERF_TYPE_HW_CACHE;
+      attr.config = PERF_COUNT_HW_CACHE_L1D |
+                    (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                    (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+      break;
+    case LlcMisses:
+      attr.type = PERF_TYPE_HW_CACHE;
+      attr.config = PERF_COUNT_HW_CACHE_LL |
+                    (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                    (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+      break;
+    case BranchMisses:
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+      break;
+    }
+
+    // The calling thread, on any CPU
+    fds[event] = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+  }
+#else
+  (void)fds;
+#endif
+}
+//------------------------------------------------------------------------------
+void PerfCounters::close() {
+#ifdef __linux__
+  for (array<int, nEvents> &fds : m_fds) {
+    for (const int fd : fds) {
+      if (fd >= 0)
+        ::close(fd);
+    }
+  }
+#endif
+  m_fds.clear();
+  m_available.fill(false);
+}
+//------------------------------------------------------------------------------
+void PerfCounters::read(array<double, nEvents> &counts) const {
+  counts.fill(0);
+
+#ifdef __linux__
+  // A counter of another thread is read as well, the kernel brings it up to
+  // date on the CPU that thread runs on
+  for (const array<int, nEvents> &fds : m_fds) {
+    for (int event = 0; event < nEvents; event++) {
+      if (!m_available[event])
+        continue;
+
+      // The value, the time enabled and the time running
+      uint64_t values[3];
+      if (::read(fds[event], values, sizeof(values)) != sizeof(values))
+        continue;
+
+      if (values[2] > 0 && values[2] < values[1])
+        counts[event] += values[0] * ((double)values[1] / values[2]);
+      else
+        counts[event] += values[0];
+    }
+  }
+#endif
+}
+//------------------------------------------------------------------------------
+const char *PerfCounters::name(const int event) {
+  switch (event) {
+  case Cycles:
+    return "cycles";
+  case Instructions:
+    return "instructions";
+  case L1dMisses:
+    return "L1d-misses";
+  case LlcMisses:
+    return "LLC-misses";
+  case BranchMisses:
+    return "branch-misses";
+  }
+  return "";
+}
+//------------------------------------------------------------------------------
+}
@@ -0,0 +1,62 @@
+#ifndef PERFCOUNTERS_H
+#define PERFCOUNTERS_H
+
+#include "config.h"
+
+namespace PDtools {
+//------------------------------------------------------------------------------
+// Hardware event counters of the OpenMP threads, from perf_event_open on
+// Linux. Each thread of a parallel region opens its own counters, a read sums
+// them over the threads. The threads of the later parallel regions are
+// counted as long as the OpenMP runtime keeps its pool of threads, as it does
+// unless the number of threads changes.
+//
+// Each event is opened on its own, the events the kernel or the CPU does not
+// provide, or perf_event_paranoid forbids, are unavailable and read as zero.
+// An event that does not open on every thread is unavailable as well, its sum
+// would miss the work of the others. Elsewhere no event is available.
+//
+// The generic perf events have no L2 cache event, L2 misses are therefore
+// not counted. When the CPU has fewer counters than events they are
+// multiplexed and the counts are scaled to the time they were enabled.
+//------------------------------------------------------------------------------
+class PerfCounters {
+public:
+  enum Event {
+    Cycles,
+    Instructions,
+    L1dMisses,
+    LlcMisses,
+    BranchMisses,
+    nEvents
+  };
+
+  PerfCounters();
+  ~PerfCounters();
+  PerfCounters(const PerfCounters &) = delete;
+  PerfCounters &operator=(const PerfCounters &) = delete;
+
+  // Returns false when no event could be opened. Called outside of a parallel
+  // region.
+  bool open();
+  void close();
+  bool available(const int event) const;
+  void read(array<double, nEvents> &counts) const;
+
+  static const char *name(const int event);
+
+protected:
+  // The file descriptors per thread
+  vector<array<int, nEvents>> m_fds;
+  array<bool, nEvents> m_available;
+
+  static void openEvents(array<int, nEvents> &fds);
+};
+//------------------------------------------------------------------------------
+// Inline functions
+inline bool PerfCounters::available(const int event) const {
+  return m_available[event];
+}
+//------------------------------------------------------------------------------
+}
+#endif // PERFCOUNTERS_H
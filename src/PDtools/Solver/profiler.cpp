@@ -0,0 +1,246 @@
+#include "profiler.h"
+
+#include <cstdio>
+
+#if USE_MPI
+#include <mpi.h>
+#endif
+
+namespace PDtools {
+//------------------------------------------------------------------------------
+void Profiler::enable(const bool enabled) {
+  m_enabled = enabled;
+  m_start = std::chrono::steady_clock::now();
+}
+//------------------------------------------------------------------------------
+int Profiler::phase(const string &name) {
+  if (m_phases.count(name) > 0)
+    return m_phases.at(name);
+
+  const int phase = m_names.size();
+  m_phases[name] = phase;
+  m_names.push_back(name);
+  m_times.push_back(0);
+  m_calls.push_back(0);
+  m_counted.push_back(0);
+  m_counts.push_back({});
+  m_particleWork.push_back(0);
+  m_bondWork.push_back(0);
+  return phase;
+}
+//------------------------------------------------------------------------------
+bool Profiler::enableCounters() {
+  m_countersEnabled = true;
+  return m_counters.open();
+}
+//------------------------------------------------------------------------------
+void Profiler::countPhase(const int phase) { m_counted[phase] = 1; }
+//------------------------------------------------------------------------------
+void Profiler::addCounts(const int phase,
+                         const array<double, PerfCounters::nEvents> &start) {
+  array<double, PerfCounters::nEvents> end;
+  m_counters.read(end);
+  for (int e = 0; e < PerfCounters::nEvents; e++) {
+    m_counts[phase][e] += end[e] - start[e];
+  }
+  m_particleWork[phase] += m_nParticles;
+  m_bondWork[phase] += m_nBonds;
+}
+//------------------------------------------------------------------------------
+void Profiler::setCsv(const string &path, const int interval) {
+  m_csvPath = path;
+  m_csvInterval = interval;
+}
+//------------------------------------------------------------------------------
+void Profiler::step(const int timeStep) {
+  if (!m_enabled || m_csvInterval <= 0 || timeStep % m_csvInterval != 0)
+    return;
+
+  // The time since the previous row
+  const int nPhases = m_names.size();
+  m_csvTimes.resize(nPhases, 0);
+  vector<double> times(nPhases);
+  for (int k = 0; k < nPhases; k++) {
+    times[k] = m_times[k] - m_csvTimes[k];
+    m_csvTimes[k] = m_times[k];
+  }
+  reduce(times, Max);
+
+  if (myRank() != 0)
+    return;
+
+  if (!m_csv.is_open()) {
+    m_csv.open(m_csvPath);
+    if (!m_csv) {
+      cerr << "ERROR: could not open the profile " << m_csvPath << endl;
+      m_csvInterval = 0;
+      return;
+    }
+    m_csv << "step";
+    for (const string &name : m_names)
+      m_csv << "," << name;
+    m_csv << endl;
+  }
+
+  m_csv << timeStep;
+  for (const double t : times)
+    m_csv << "," << t;
+  m_csv << endl;
+}
+//------------------------------------------------------------------------------
+void Profiler::report() {
+  if (!m_enabled)
+    return;
+
+  const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - m_start;
+  vector<double> total = {elapsed.count()};
+  vector<double> t_min = m_times;
+  vector<double> t_avg = m_times;
+  vector<double> t_max = m_times;
+  reduce(total, Max);
+  reduce(t_min, Min);
+  reduce(t_avg, Sum);
+  reduce(t_max, Max);
+
+  if (myRank() == 0)
+    printTimes(total[0], t_min, t_avg, t_max);
+
+  if (m_countersEnabled)
+    reportCounters();
+}
+//------------------------------------------------------------------------------
+void Profiler::printTimes(const double total, const vector<double> &t_min,
+                          const vector<double> &t_avg,
+                          const vector<double> &t_max) const {
+  int nCores = 1;
+#if USE_MPI
+  MPI_Comm_size(MPI_COMM_WORLD, &nCores);
+#endif
+
+  char line[256];
+  cout << "Run profile, wall time in seconds over " << nCores
+       << " rank(s), nested phases included" << endl;
+  snprintf(line, sizeof(line), "%-40s %10s %11s %11s %11s %7s %7s", "phase",
+           "calls", "min", "avg", "max", "max/avg", "%");
+  cout << line << endl;
+
+  for (unsigned int k = 0; k < m_names.size(); k++) {
+    if (m_calls[k] == 0 && t_max[k] == 0)
+      continue;
+
+    const double avg = t_avg[k] / nCores;
+    const double imbalance = avg > 0 ? t_max[k] / avg : 1;
+    const double percent = total > 0 ? 100 * avg / total : 0;
+    snprintf(line, sizeof(line), "%-40s %10ld %11.4e %11.4e %11.4e %7.2f %7.2f",
+             m_names[k].c_str(), m_calls[k], t_min[k], avg, t_max[k],
+             imbalance, percent);
+    cout << line << endl;
+  }
+  snprintf(line, sizeof(line), "%-40s %10s %11s %11s %11.4e", "total", "", "",
+           "", total);
+  cout << line << endl;
+}
+//------------------------------------------------------------------------------
+void Profiler::reportCounters() {
+  // Summed over the ranks, an event counts only if all ranks have it
+  const int nPhases = m_names.size();
+  const int nEvents = PerfCounters::nEvents;
+  vector<double> counts(nPhases * nEvents);
+  for (int k = 0; k < nPhases; k++) {
+    for (int e = 0; e < nEvents; e++) {
+      counts[k * nEvents + e] = m_counts[k][e];
+    }
+  }
+  vector<double> available(nEvents);
+  for (int e = 0; e < nEvents; e++) {
+    available[e] = m_counters.available(e);
+  }
+  vector<double> particleWork = m_particleWork;
+  vector<double> bondWork = m_bondWork;
+  reduce(counts, Sum);
+  reduce(available, Min);
+  reduce(particleWork, Sum);
+  reduce(bondWork, Sum);
+
+  if (myRank() != 0)
+    return;
+
+  bool anyAvailable = false;
+  for (const double a : available) {
+    anyAvailable = anyAvailable || a > 0;
+  }
+  if (!anyAvailable) {
+    cout << "Hardware counters unavailable, see perf_event_paranoid" << endl;
+    return;
+  }
+
+  char line[256];
+  char value[32];
+  const vector<pair<string, const vector<double> *>> rates = {
+      {"per particle", &particleWork}, {"per bond", &bondWork}};
+
+  for (const auto &rate : rates) {
+    cout << "Hardware counters " << rate.first
+         << ", all threads of each rank" << endl;
+    int length = snprintf(line, sizeof(line), "%-40s", "phase");
+    for (int e = 0; e < nEvents; e++) {
+      length += snprintf(line + length, sizeof(line) - length, " %13s",
+                         PerfCounters::name(e));
+    }
+    snprintf(line + length, sizeof(line) - length, " %7s", "IPC");
+    cout << line << endl;
+
+    for (int k = 0; k < nPhases; k++) {
+      const double work = (*rate.second)[k];
+      if (!m_counted[k] || work <= 0)
+        continue;
+
+      const double *c = &counts[k * nEvents];
+      length = snprintf(line, sizeof(line), "%-40s", m_names[k].c_str());
+      for (int e = 0; e < nEvents; e++) {
+        if (available[e] > 0)
+          snprintf(value, sizeof(value), "%13.4g", c[e] / work);
+        else
+          snprintf(value, sizeof(value), "%13s", "n/a");
+        length += snprintf(line + length, sizeof(line) - length, " %s", value);
+      }
+
+      const bool hasIpc = available[PerfCounters::Cycles] > 0 &&
+                          available[PerfCounters::Instructions] > 0 &&
+                          c[PerfCounters::Cycles] > 0;
+      if (hasIpc)
+        snprintf(value, sizeof(value), "%7.2f",
+                 c[PerfCounters::Instructions] / c[PerfCounters::Cycles]);
+      else
+        snprintf(value, sizeof(value), "%7s", "n/a");
+      snprintf(line + length, sizeof(line) - length, " %s", value);
+      cout << line << endl;
+    }
+  }
+}
+//------------------------------------------------------------------------------
+int Profiler::myRank() {
+  int rank = 0;
+#if USE_MPI
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#endif
+  return rank;
+}
+//------------------------------------------------------------------------------
+void Profiler::reduce(vector<double> &values, const int operation) {
+#if USE_MPI
+  MPI_Op op = MPI_SUM;
+  if (operation == Min)
+    op = MPI_MIN;
+  else if (operation == Max)
+    op = MPI_MAX;
+  MPI_Allreduce(MPI_IN_PLACE, values.data(), values.size(), MPI_DOUBLE, op,
+                MPI_COMM_WORLD);
+#else
+  (void)values;
+  (void)operation;
+#endif
+}
+//------------------------------------------------------------------------------
+}
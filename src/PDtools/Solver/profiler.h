@@ -0,0 +1,126 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "config.h"
+#include "perfcounters.h"
+
+#include <chrono>
+#include <fstream>
+
+namespace PDtools {
+//------------------------------------------------------------------------------
+// Wall time spent in the phases of a run.
+//
+// A phase is registered once by name and timed with a ScopedTimer, which
+// reads the clock twice when the profiler is enabled and does nothing else
+// when it is not. Phases may be nested, their times are inclusive. The
+// phases must be registered in the same order on all ranks, the report and
+// the CSV rows reduce the times over the ranks phase by phase.
+//
+// With the hardware counters enabled, the counted phases also sum the
+// counters of all OpenMP threads, reported per particle and per bond of the
+// work set when the phase ran. The phases are timed outside of the parallel
+// regions, so the counts cover the work of every thread.
+//------------------------------------------------------------------------------
+class Profiler {
+public:
+  class ScopedTimer {
+  public:
+    ScopedTimer(Profiler &profiler, const int phase);
+    ~ScopedTimer();
+
+  protected:
+    Profiler &m_profiler;
+    const int m_phase;
+    std::chrono::steady_clock::time_point m_start;
+    bool m_counted = false;
+    array<double, PerfCounters::nEvents> m_counts;
+  };
+
+  void enable(const bool enabled);
+  bool enabled() const;
+  int phase(const string &name);
+  void add(const int phase, const double seconds);
+
+  // Collective, returns false when no counter is available on this rank
+  bool enableCounters();
+  void countPhase(const int phase);
+  void setWork(const double nParticles, const double nBonds);
+
+  // A CSV row of the slowest rank's time per phase since the previous row,
+  // every interval steps
+  void setCsv(const string &path, const int interval);
+  void step(const int timeStep);
+
+  // Collective, printed by the first rank
+  void report();
+
+protected:
+  bool m_enabled = false;
+  std::chrono::steady_clock::time_point m_start;
+  vector<string> m_names;
+  unordered_map<string, int> m_phases;
+  vector<double> m_times;
+  vector<long> m_calls;
+
+  string m_csvPath;
+  int m_csvInterval = 0;
+  std::ofstream m_csv;
+  vector<double> m_csvTimes;
+
+  bool m_countersEnabled = false;
+  PerfCounters m_counters;
+  vector<char> m_counted;
+  vector<array<double, PerfCounters::nEvents>> m_counts;
+  vector<double> m_particleWork;
+  vector<double> m_bondWork;
+  double m_nParticles = 0;
+  double m_nBonds = 0;
+
+  void addCounts(const int phase,
+                 const array<double, PerfCounters::nEvents> &start);
+  void printTimes(const double total, const vector<double> &t_min,
+                  const vector<double> &t_avg,
+                  const vector<double> &t_max) const;
+  void reportCounters();
+
+  static int myRank();
+  static void reduce(vector<double> &values, const int operation);
+  enum ReduceOperation { Min, Sum, Max };
+};
+//------------------------------------------------------------------------------
+// Inline functions
+inline bool Profiler::enabled() const { return m_enabled; }
+
+inline void Profiler::add(const int phase, const double seconds) {
+  m_times[phase] += seconds;
+  m_calls[phase]++;
+}
+
+inline void Profiler::setWork(const double nParticles, const double nBonds) {
+  m_nParticles = nParticles;
+  m_nBonds = nBonds;
+}
+
+inline Profiler::ScopedTimer::ScopedTimer(Profiler &profiler, const int phase)
+    : m_profiler(profiler), m_phase(phase) {
+  if (!m_profiler.m_enabled)
+    return;
+  m_counted = m_profiler.m_countersEnabled && m_profiler.m_counted[phase];
+  if (m_counted)
+    m_profiler.m_counters.read(m_counts);
+  m_start = std::chrono::steady_clock::now();
+}
+
+inline Profiler::ScopedTimer::~ScopedTimer() {
+  if (!m_profiler.m_enabled)
+    return;
+  const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - m_start;
+  m_profiler.add(m_phase, elapsed.count());
+  if (m_counted)
+    m_profiler.addCounts(m_phase, m_counts);
+}
+//------------------------------------------------------------------------------
+}
+#endif // PROFILER_H
@@ -8,6 +8,8 @@
 #include "PDtools/Grid/grid.h"
 #include "PDtools/Modfiers/modifier.h"
 #include "PDtools/Particles/pd_particles.h"
+#include "PDtools/PdFunctions/commtracer.h"
+#include "PDtools/PdFunctions/memorytracker.h"
 #include "PDtools/PdFunctions/pdfunctions.h"
 #include "PDtools/SavePdData/savepddata.h"
 #include "PDtools/Domain/domain.h"
@@ -28,14 +30,31 @@ void Solver::setRankAndCores(int rank, int cores) {
 }
 //------------------------------------------------------------------------------
 void Solver::setCalculateProperties(vector<CalculateProperty *> &calcProp) {
-  m_properties = calcProp;
+  m_propertyScheduler.setProperties(calcProp);
+  m_properties = m_propertyScheduler.properties();
+
+  m_propertyPhases.clear();
+  for (CalculateProperty *property : m_properties) {
+    m_propertyPhases.push_back(m_profiler.phase("property/" + property->type));
+  }
 }
 //------------------------------------------------------------------------------
 void Solver::setSaveParticles(SavePdData *saveParticles) {
   m_saveParticles = saveParticles;
 }
 //------------------------------------------------------------------------------
-Solver::Solver() {}
+Profiler &Solver::profiler() { return m_profiler; }
+//------------------------------------------------------------------------------
+Solver::Solver() {
+  m_phaseUpdateGrid = m_profiler.phase("updateGrid");
+  m_profiler.countPhase(m_phaseUpdateGrid);
+  m_phaseGhostExchange = m_profiler.phase("ghostExchange");
+  m_phaseUpdateState = m_profiler.phase("updateState");
+  m_phaseIntegrateStepOne = m_profiler.phase("integrateStepOne");
+  m_phaseIntegrateStepTwo = m_profiler.phase("integrateStepTwo");
+  m_phaseForcesAndStepTwo = m_profiler.phase("forcesAndStepTwo");
+  m_phaseSave = m_profiler.phase("save");
+}
 //------------------------------------------------------------------------------
 Solver::~Solver() {
   for (Force *force : m_oneBodyForces) {
@@ -71,24 +90,31 @@ void Solver::applyBoundaryConditions() {
   const ivec &colToId = m_particles->colToId();
   const int nParticles = m_particles->nParticles();
 
-  for (Modifier *modifier : m_boundaryModifiers) {
-    modifier->evaluateStepOne();
+  const int nModifiers = m_boundaryModifiers.size();
+
+  for (int m = 0; m < nModifiers; m++) {
+    Profiler::ScopedTimer timer(m_profiler, m_boundaryModifierPhases[m]);
+    m_boundaryModifiers[m]->evaluateStepOne();
   }
 
-  for (Modifier *modifier : m_boundaryModifiers) {
+  for (int m = 0; m < nModifiers; m++) {
+    Modifier *modifier = m_boundaryModifiers[m];
     if (!modifier->hasStepOne())
       continue;
 
+    Profiler::ScopedTimer timer(m_profiler, m_boundaryModifierPhases[m]);
     for (int i = 0; i < nParticles; i++) {
       const int id = colToId(i);
       modifier->evaluateStepOne(id, i);
     }
   }
 
-  for (Modifier *modifier : m_boundaryModifiers) {
+  for (int m = 0; m < nModifiers; m++) {
+    Modifier *modifier = m_boundaryModifiers[m];
     if (!modifier->hasUpdateOne())
       continue;
 
+    Profiler::ScopedTimer timer(m_profiler, m_boundaryModifierPhases[m]);
     for (int i = 0; i < nParticles; i++) {
       const int id = colToId(i);
       modifier->updateStepOne(id, i);
@@ -97,6 +123,11 @@ void Solver::applyBoundaryConditions() {
 }
 //------------------------------------------------------------------------------
 void Solver::updateGridAndCommunication() {
+  Profiler::ScopedTimer timer(m_profiler, m_phaseUpdateGrid);
+
+  // The bond-break events refer to the current local particles
+  m_particles->publishBondBreaks();
+
   m_mainGrid->clearParticles();
   updateGrid(*m_mainGrid, *m_particles);
 
@@ -109,18 +140,25 @@ void Solver::updateGridAndCommunication() {
     updateModifierLists(*modifier, *m_particles, counter);
     counter++;
   }
+  m_particles->buildBondCache();
 #endif
   updateElementQuadrature(*m_particles);
 }
 //------------------------------------------------------------------------------
 void Solver::updateGhosts() {
   // TODO: needs optimization
+  Profiler::ScopedTimer timer(m_profiler, m_phaseGhostExchange);
   m_mainGrid->clearGhostParticles();
   exchangeGhostParticles(*m_mainGrid, *m_particles);
+#if USE_MPI
+  // The ghosts may have new columns
+  m_particles->updateNeighbourColumns();
+#endif
 }
 //------------------------------------------------------------------------------
 void Solver::save(int timesStep) {
   if (timesStep % m_saveInterval == 0) {
+    Profiler::ScopedTimer timer(m_profiler, m_phaseSave);
     m_saveParticles->evaluate(m_t, timesStep);
     m_saveParticles->saveData(m_t, timesStep);
 
@@ -133,16 +171,22 @@ void Solver::save(int timesStep) {
 void Solver::initialize() {}
 //------------------------------------------------------------------------------
 void Solver::modifiersStepOne() {
-  for (Modifier *modifier : m_spModifiers) {
-    modifier->evaluateStepOne();
+  const int nModifiers = m_spModifiers.size();
+
+  for (int m = 0; m < nModifiers; m++) {
+    Profiler::ScopedTimer timer(m_profiler, m_spModifierPhases[m]);
+    m_spModifiers[m]->evaluateStepOne();
   }
   const ivec &colToId = m_particles->colToId();
   const int nParticles = m_particles->nParticles();
 
   if (!m_spModifiers.empty()) {
-    for (Modifier *modifier : m_spModifiers) {
+    for (int m = 0; m < nModifiers; m++) {
+      Modifier *modifier = m_spModifiers[m];
       if (!modifier->hasStepOne())
         continue;
+
+      Profiler::ScopedTimer timer(m_profiler, m_spModifierPhases[m]);
 #ifdef USE_OPENMP
 #pragma omp parallel for
 #endif
@@ -152,9 +196,12 @@ void Solver::modifiersStepOne() {
       }
     }
 
-    for (Modifier *modifier : m_spModifiers) {
+    for (int m = 0; m < nModifiers; m++) {
+      Modifier *modifier = m_spModifiers[m];
       if (!modifier->hasUpdateOne())
         continue;
+
+      Profiler::ScopedTimer timer(m_profiler, m_spModifierPhases[m]);
 #ifdef USE_OPENMP
 #pragma omp parallel for
 #endif
@@ -165,8 +212,9 @@ void Solver::modifiersStepOne() {
     }
   }
 
-  for (Modifier *modifier : m_spModifiers) {
-    modifier->evaluateStepOnePost();
+  for (int m = 0; m < nModifiers; m++) {
+    Profiler::ScopedTimer timer(m_profiler, m_spModifierPhases[m]);
+    m_spModifiers[m]->evaluateStepOnePost();
   }
 
   // Forces modifiers
@@ -181,20 +229,28 @@ void Solver::modifiersStepOne() {
       oneBodyForce->evaluateStepOne(id, i);
     }
   }
+
+  m_particles->publishBondBreaks();
 }
 //------------------------------------------------------------------------------
 void Solver::modifiersStepTwo() {
-  for (Modifier *modifier : m_boundaryModifiers) {
-    modifier->evaluateStepTwo();
+  const int nBoundaryModifiers = m_boundaryModifiers.size();
+  for (int m = 0; m < nBoundaryModifiers; m++) {
+    Profiler::ScopedTimer timer(m_profiler, m_boundaryModifierPhases[m]);
+    m_boundaryModifiers[m]->evaluateStepTwo();
   }
 
   const ivec &colToId = m_particles->colToId();
   const int nParticles = m_particles->nParticles();
 
+  const int nModifiers = m_spModifiers.size();
   if (!m_spModifiers.empty()) {
-    for (Modifier *modifier : m_spModifiers) {
+    for (int m = 0; m < nModifiers; m++) {
+      Modifier *modifier = m_spModifiers[m];
       if (!modifier->hasStepTwo())
         continue;
+
+      Profiler::ScopedTimer timer(m_profiler, m_spModifierPhases[m]);
 #ifdef USE_OPENMP
 #pragma omp parallel for
 #endif
@@ -246,7 +302,11 @@ void Solver::setT(double _t) { m_t = _t; }
 //------------------------------------------------------------------------------
 void Solver::setDim(double _dim) { m_dim = _dim; }
 //------------------------------------------------------------------------------
-void Solver::addForce(Force *force) { m_oneBodyForces.push_back(force); }
+void Solver::addForce(Force *force) {
+  m_oneBodyForces.push_back(force);
+  m_forcePhases.push_back(m_profiler.phase("force/" + force->name));
+  m_profiler.countPhase(m_forcePhases.back());
+}
 //------------------------------------------------------------------------------
 void Solver::setSaveInterval(double saveInterval) {
   m_saveInterval = saveInterval;
@@ -254,10 +314,15 @@ void Solver::setSaveInterval(double saveInterval) {
 //------------------------------------------------------------------------------
 void Solver::addSpModifier(Modifier *modifier) {
   m_spModifiers.push_back(modifier);
+  m_spModifierPhases.push_back(m_profiler.phase("modifier/" + modifier->name()));
+  // The fracture criteria
+  m_profiler.countPhase(m_spModifierPhases.back());
 }
 //------------------------------------------------------------------------------
 void Solver::addBoundaryModifier(Modifier *modifier) {
   m_boundaryModifiers.push_back(modifier);
+  m_boundaryModifierPhases.push_back(
+      m_profiler.phase("modifier/" + modifier->name()));
 }
 //------------------------------------------------------------------------------
 void Solver::addQsModifiers(Modifier *modifier) {
@@ -282,22 +347,76 @@ void Solver::checkInitialization() {
 }
 //------------------------------------------------------------------------------
 void Solver::calculateForces(int timeStep) {
-  (void)timeStep;
+  const ivec &colToId = m_particles->colToId();
+  const int nParticles = m_particles->nParticles();
+  requestStress(timeStep);
+  m_propertyScheduler.stateChanged();
+  updateForceStates();
+
+  // Force by force when profiling, each force adds to its particle in the
+  // same order either way
+  if (m_profiler.enabled()) {
+    m_profiler.setWork(nParticles, m_particles->nCachedBonds());
+    const int nForces = m_oneBodyForces.size();
+    for (int f = 0; f < nForces; f++) {
+      Profiler::ScopedTimer timer(m_profiler, m_forcePhases[f]);
+      Force *oneBodyForce = m_oneBodyForces[f];
+      for (int i = 0; i < nParticles; i++) {
+        oneBodyForce->calculateForces(colToId[i], i);
+      }
+    }
+    return;
+  }
+
+  // Calculating one-body forces
+  for (int i = 0; i < nParticles; i++) {
+    //        if(isStatic(i))
+    //            continue;
 
+    const int id = colToId[i];
+
+    for (Force *oneBodyForce : m_oneBodyForces) {
+      oneBodyForce->calculateForces(id, i);
+    }
+  }
+}
+//------------------------------------------------------------------------------
+void Solver::updateForceStates() {
+  // Updates the ghosts and the force states before a force evaluation.
+  // Local particle states (e.g. the lagged LPS dilation) are updated before
+  // the ghost exchange and are communicated with it. Only states that read
+  // the neighbours (e.g. the NOPD deformation gradient) need the updated
+  // ghost positions and a second exchange.
+  Profiler::ScopedTimer timer(m_profiler, m_phaseUpdateState);
   const ivec &colToId = m_particles->colToId();
   const int nParticles = m_particles->nParticles();
+
+  // Bonds broken since the last publication, e.g. by the static modifiers
+  m_particles->publishBondBreaks();
+
+  for (Force *oneBodyForce : m_oneBodyForces) {
+    if (!oneBodyForce->getHasUpdateState() ||
+        !oneBodyForce->getHasLocalUpdateState())
+      continue;
+
+    for (int i = 0; i < nParticles; i++) {
+      const int id = colToId[i];
+      oneBodyForce->updateState(id, i);
+    }
+  }
+
   updateGhosts();
 
-  bool hasUpdateState = false;
   // Updating overall state
   for (Force *oneBodyForce : m_oneBodyForces) {
     oneBodyForce->updateState();
   }
-  //    updateGhosts(); // Tmp solution
 
   // Updating single particle states
+  bool hasUpdateState = false;
   for (Force *oneBodyForce : m_oneBodyForces) {
-    if (!oneBodyForce->getHasUpdateState())
+    if (!oneBodyForce->getHasUpdateState() ||
+        oneBodyForce->getHasLocalUpdateState())
       continue;
     hasUpdateState = true;
 
@@ -306,36 +425,55 @@ void Solver::calculateForces(int timeStep) {
       oneBodyForce->updateState(id, i);
     }
   }
-  // TODO: only needed for updated one body forces used in NOPD
   if (hasUpdateState) {
     updateGhosts();
-    //    updateGridAndCommunication();
   }
+}
+//------------------------------------------------------------------------------
+void Solver::requestStress(const int timeStep) {
+  // The stress of a force evaluation is read by the properties of the same
+  // step (ADR and the static solvers) or of the next one (the time
+  // integrators).
+  bool computeStress = false;
+  const int nProperties = m_properties.size();
+  for (int p = 0; p < nProperties; p++) {
+    if (!m_properties[p]->needsForceStress())
+      continue;
 
-  // Calculating one-body forces
-  for (int i = 0; i < nParticles; i++) {
-    //        if(isStatic(i))
-    //            continue;
-
-    const int id = colToId[i];
-
-    for (Force *oneBodyForce : m_oneBodyForces) {
-      oneBodyForce->calculateForces(id, i);
+    if (m_propertyScheduler.needed(p, timeStep) ||
+        m_propertyScheduler.needed(p, timeStep + 1) || saveMayReadForces()) {
+      computeStress = true;
+      break;
     }
   }
+
+  for (Force *oneBodyForce : m_oneBodyForces) {
+    oneBodyForce->setComputeStress(computeStress);
+  }
 }
 //------------------------------------------------------------------------------
-void Solver::updateProperties(const int timeStep) {
-  for (CalculateProperty *property : m_properties) {
-    const int updateFrequency = property->updateFrequency();
-
-    if (timeStep % updateFrequency == 0) {
-      property->clean();
-      property->update();
-    }
+bool Solver::saveMayReadForces() const {
+  // The output is on the step multiples the properties are scheduled on
+  return false;
+}
+//------------------------------------------------------------------------------
+void Solver::updateProperties(const int timeStep, const bool all) {
+  // The properties read on this step that are not up to date
+  for (const int p : m_propertyScheduler.schedule(timeStep, all)) {
+    CalculateProperty *property = m_properties[p];
+    Profiler::ScopedTimer timer(m_profiler, m_propertyPhases[p]);
+    property->clean();
+    property->update();
   }
 }
 //------------------------------------------------------------------------------
+void Solver::endStep(const int timeStep) {
+  m_profiler.step(timeStep);
+  CommTracer::endStep(timeStep, *m_particles);
+  if (m_mainGrid != nullptr)
+    MemoryTracker::endStep(timeStep, *m_particles, *m_mainGrid);
+}
+//------------------------------------------------------------------------------
 void Solver::printProgress(const double progress) {
   int barWidth = 70;
 
@@ -6,6 +6,8 @@
 #endif
 
 #include "config.h"
+#include "profiler.h"
+#include "PDtools/CalculateProperties/propertyscheduler.h"
 
 namespace PDtools {
 class PD_Particles;
@@ -27,7 +29,9 @@ protected:
   vector<Modifier *> m_spModifiers;
   vector<Modifier *> m_boundaryModifiers;
   vector<Modifier *> m_qsModifiers;
+  // In the order of the scheduler, the dependencies first
   vector<CalculateProperty *> m_properties;
+  PropertyScheduler m_propertyScheduler;
 
   int m_dim = 3;
   int m_steps = 0;
@@ -41,6 +45,21 @@ protected:
   int m_myRank = 0;
   int m_nCores = 1;
 
+  // Phases of the run profile, one per force, modifier and property in the
+  // order they were added
+  Profiler m_profiler;
+  int m_phaseUpdateState;
+  int m_phaseGhostExchange;
+  int m_phaseUpdateGrid;
+  int m_phaseIntegrateStepOne;
+  int m_phaseIntegrateStepTwo;
+  int m_phaseForcesAndStepTwo;
+  int m_phaseSave;
+  vector<int> m_forcePhases;
+  vector<int> m_spModifierPhases;
+  vector<int> m_boundaryModifierPhases;
+  vector<int> m_propertyPhases;
+
   enum SolverErrorMessages { NumberOfStepNotSet, ParticlesNotSet };
 
 public:
@@ -74,11 +93,16 @@ public:
   void setRankAndCores(int rank, int cores);
   void setCalculateProperties(vector<CalculateProperty *> &calcProp);
   void setSaveParticles(SavePdData *saveParticles);
+  Profiler &profiler();
 
 protected:
   void checkInitialization();
   virtual void calculateForces(int timeStep);
-  void updateProperties(const int timeStep);
+  void updateForceStates();
+  void requestStress(const int timeStep);
+  virtual bool saveMayReadForces() const;
+  void updateProperties(const int timeStep, const bool all = false);
+  void endStep(const int timeStep);
   void printProgress(const double progress);
 };
 //------------------------------------------------------------------------------
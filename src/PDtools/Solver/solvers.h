@@ -2,7 +2,9 @@
 #define SOLVERS
 
 #include "ADRsolvers/dynamicadr.h"
+#include "TimeIntegrators/ensembleverletintegrator.h"
 #include "TimeIntegrators/eulercromerintegrator.h"
+#include "TimeIntegrators/multirateverletintegrator.h"
 #include "TimeIntegrators/velocityverletintegrator.h"
 #include "adr.h"
 #include "solver.h"
@@ -3,6 +3,7 @@
 #include "PDtools/Force/force.h"
 #include "PDtools/Modfiers/modifier.h"
 #include "PDtools/Particles/pd_particles.h"
+#include "PDtools/PdFunctions/memorytracker.h"
 #include "PDtools/SavePdData/savepddata.h"
 
 namespace PDtools
@@ -12,12 +13,14 @@ StaticSolver::StaticSolver(int maxIterations, int threshold)
     : m_maxIterations(maxIterations), m_threshold(threshold) {}
 //------------------------------------------------------------------------------
 void StaticSolver::solve() {
+  m_particles->buildBondCache();
   initialize();
   checkInitialization();
 
   // Looping over all time, particles and components.
   for (int i = 0; i < m_steps; i++) {
     stepForward(i);
+    endStep(i + 1);
   }
 }
 //------------------------------------------------------------------------------
@@ -136,6 +139,7 @@ void StaticSolver::initialize() {
 //------------------------------------------------------------------------------
 void StaticSolver::save(int i) {
   if (i % m_saveInterval == 0) {
+    Profiler::ScopedTimer timer(m_profiler, m_phaseSave);
     m_saveParticles->evaluate(m_t, i);
     computeStress();
     m_saveParticles->saveData(m_t, i);
@@ -144,22 +148,30 @@ void StaticSolver::save(int i) {
 //------------------------------------------------------------------------------
 void StaticSolver::createStiffnessMatrix() {
   const int nParticles = m_particles->nParticles();
-  arma::mat &m_data = m_particles->data();
-  const ivec &idToCol = m_particles->getIdToCol_v();
+  ParticleData &m_data = m_particles->data();
+  const IdToColMap &idToCol = m_particles->getIdToCol_v();
   arma::mat &m_dr0 = m_particles->r0();
 
   const int m_indexVolume = m_particles->getParamId("volume");
   const int m_indexDr0 = m_particles->getPdParamId("dr0");
   const int m_indexVolumeScaling = m_particles->getPdParamId("volumeScaling");
-  const int m_indexConnected = m_particles->getPdParamId("connected");
   const int m_indexMicromodulus = m_particles->getParamId("micromodulus");
 
+  // Sharing the bond coefficients k_ij = 0.5 (c_i + c_j) g_ij V_j
+  // volumeScaling_ij with the bond force when it is used
+  const Force *bondCache = nullptr;
+  for (Force *oneBodyForce : m_oneBodyForces) {
+    oneBodyForce->updateBondCache();
+    if (oneBodyForce->bondCacheValid())
+      bondCache = oneBodyForce;
+  }
+  const bool hasBondCache = bondCache != nullptr;
+
   int total_values = 0;
   for (int i = 0; i < nParticles; i++) {
     pair<int, int> id(i, i);
     const int pId = id.first;
-    vector<pair<int, vector<double>>> &PDconnections =
-        m_particles->pdConnections(pId);
+    BondList &PDconnections = m_particles->pdConnections(pId);
     const int nConnections = PDconnections.size();
     total_values += nConnections + 1;
   }
@@ -175,27 +187,28 @@ void StaticSolver::createStiffnessMatrix() {
     int i_a = a * m_dim;
     const double c_i = m_data(a, m_indexMicromodulus);
 
-    vector<pair<int, vector<double>>> &PDconnections =
-        m_particles->pdConnections(pId);
-    const int nConnections = PDconnections.size();
+    BondList &PDconnections = m_particles->pdConnections(pId);
     arma::mat C_ij = arma::zeros(m_dim, m_dim);
 
-    for (int l_j = 0; l_j < nConnections; l_j++) {
+    m_particles->forEachConnectedBond(a, [&](const int l_j) {
       const auto &con = PDconnections[l_j];
-      if (con.second[m_indexConnected] <= 0.5)
-        continue;
-
       const int id_j = con.first;
       const int b = idToCol[id_j];
       const int i_b = b * m_dim;
 
-      const double c_j = m_data(b, m_indexMicromodulus);
-      const double vol_j = m_data(b, m_indexVolume);
-      const double dr0 = con.second[m_indexDr0];
-      const double volumeScaling = con.second[m_indexVolumeScaling];
-      const double c_ab = 0.5 * (c_i + c_j);
-
-      const double coeff = c_ab / (pow(dr0, 3)) * vol_j * volumeScaling;
+      double coeff;
+      if (hasBondCache) {
+        const double dr0Inv = bondCache->cachedDr0Inv(a, l_j);
+        coeff = bondCache->cachedBondCoefficient(a, l_j) * dr0Inv * dr0Inv *
+                dr0Inv;
+      } else {
+        const double c_j = m_data(b, m_indexMicromodulus);
+        const double vol_j = m_data(b, m_indexVolume);
+        const double dr0 = con.second[m_indexDr0];
+        const double volumeScaling = con.second[m_indexVolumeScaling];
+        const double c_ab = 0.5 * (c_i + c_j);
+        coeff = c_ab / (pow(dr0, 3)) * vol_j * volumeScaling;
+      }
       const vec &r_la = m_dr0.row(l_a).t();
       const vec &r_b = m_dr0.row(b).t();
       const arma::vec dr0_v = r_la - r_b;
@@ -225,7 +238,7 @@ void StaticSolver::createStiffnessMatrix() {
           values(pos++) = -element;
         }
       }
-    }
+    });
     for (int d1 = 0; d1 < m_dim; d1++) {
       locations(0, pos) = i_a + d1;
       locations(1, pos) = i_a + d1;
@@ -244,6 +257,22 @@ void StaticSolver::createStiffnessMatrix() {
   }
 
   C = arma::sp_mat(locations, values, m_degFreedom, m_degFreedom);
+
+  // The triplets are held while the matrix is built
+  const size_t stiffnessBytes =
+      MemoryTracker::heapBytes(C.n_nonzero *
+                               (sizeof(double) + sizeof(arma::uword))) +
+      MemoryTracker::heapBytes((C.n_cols + 1) * sizeof(arma::uword));
+  const size_t vectorBytes =
+      MemoryTracker::matBytes(u_k) + MemoryTracker::matBytes(r_k) +
+      MemoryTracker::matBytes(r_k1) + MemoryTracker::matBytes(p_k) +
+      MemoryTracker::matBytes(Ap) + MemoryTracker::matBytes(b_k);
+  MemoryTracker::set(MemoryTracker::StiffnessMatrix,
+                     stiffnessBytes + vectorBytes +
+                         MemoryTracker::matBytes(locations) +
+                         MemoryTracker::matBytes(values));
+  MemoryTracker::set(MemoryTracker::StiffnessMatrix,
+                     stiffnessBytes + vectorBytes);
   cout << "Stiffness matrix complete" << endl;
 }
 //------------------------------------------------------------------------------
@@ -255,9 +284,15 @@ void StaticSolver::computeStress() {
   const int m_indexVolume = m_particles->getParamId("volume");
   const int m_indexDr0 = m_particles->getPdParamId("dr0");
   const int m_indexVolumeScaling = m_particles->getPdParamId("volumeScaling");
-  const int m_indexConnected = m_particles->getPdParamId("connected");
   const int m_indexMicromodulus = m_particles->getParamId("micromodulus");
   const int m_indexForceScaling = m_particles->getPdParamId("forceScalingBond");
+  const Force *bondCache = nullptr;
+  for (Force *oneBodyForce : m_oneBodyForces) {
+    oneBodyForce->updateBondCache();
+    if (oneBodyForce->bondCacheValid())
+      bondCache = oneBodyForce;
+  }
+  const bool hasBondCache = bondCache != nullptr;
 
   indexStress[0] = m_particles->getParamId("s_xx");
   indexStress[1] = m_particles->getParamId("s_yy");
@@ -265,34 +300,38 @@ void StaticSolver::computeStress() {
   indexStress[3] = m_particles->getParamId("s_xy");
   indexStress[4] = m_particles->getParamId("s_xz");
   indexStress[5] = m_particles->getParamId("s_yz");
-  arma::mat &m_data = m_particles->data();
+  ParticleData &m_data = m_particles->data();
   const arma::mat &U = m_particles->u();
   const arma::mat &R = m_particles->r();
   const arma::mat &m_dr0 = m_particles->r0();
-  const ivec &idToCol = m_particles->getIdToCol_v();
+  const IdToColMap &idToCol = m_particles->getIdToCol_v();
 
   for (size_t a = 0; a < m_particles->nParticles(); a++) {
-    vector<pair<int, vector<double>>> &PDconnections =
-        m_particles->pdConnections(a);
-    const int nConnections = PDconnections.size();
+    BondList &PDconnections = m_particles->pdConnections(a);
     const double c_i = m_data(a, m_indexMicromodulus);
     arma::mat C_ij = arma::zeros(m_dim, m_dim);
 
-    for (int l_j = 0; l_j < nConnections; l_j++) {
+    m_particles->forEachConnectedBond(a, [&](const int l_j) {
       const auto &con = PDconnections.at(l_j);
-      if (con.second[m_indexConnected] <= 0.5 || !con.second[m_indexCompute])
-        continue;
+      if (!con.second[m_indexCompute])
+        return;
       const int id_b = con.first;
       const int b = idToCol[id_b];
 
-      const double c_j = m_data(b, m_indexMicromodulus);
-      const double vol_j = m_data(b, m_indexVolume);
-      const double dr0 = con.second[m_indexDr0];
-      const double volumeScaling = con.second[m_indexVolumeScaling];
-      const double g_ij = con.second[m_indexForceScaling];
-      const double c_ab = 0.5 * (c_i + c_j) * g_ij;
-
-      const double coeff = c_ab / (pow(dr0, 3)) * vol_j * volumeScaling;
+      double coeff;
+      if (hasBondCache) {
+        const double dr0Inv = bondCache->cachedDr0Inv(a, l_j);
+        coeff = bondCache->cachedBondCoefficient(a, l_j) * dr0Inv * dr0Inv *
+                dr0Inv;
+      } else {
+        const double c_j = m_data(b, m_indexMicromodulus);
+        const double vol_j = m_data(b, m_indexVolume);
+        const double dr0 = con.second[m_indexDr0];
+        const double volumeScaling = con.second[m_indexVolumeScaling];
+        const double g_ij = con.second[m_indexForceScaling];
+        const double c_ab = 0.5 * (c_i + c_j) * g_ij;
+        coeff = c_ab / (pow(dr0, 3)) * vol_j * volumeScaling;
+      }
       const vec &r_la = m_dr0.row(a).t();
       const vec &r_b = m_dr0.row(b).t();
       const arma::vec dr0_v = r_la - r_b;
@@ -327,7 +366,7 @@ void StaticSolver::computeStress() {
         m_data(a, indexStress[4]) += 0.5 * k[0] * dr_ab[2];
         m_data(a, indexStress[5]) += 0.5 * k[1] * dr_ab[2];
       }
-    }
+    });
   }
 }
 //------------------------------------------------------------------------------
@@ -7,42 +7,324 @@
 
 #include "Utilities/epd_functions.h"
 
+#include <limits>
+
 namespace PDtools {
 //------------------------------------------------------------------------------
 void TimeIntegrator::solve() {
+  m_particles->buildBondCache();
   initialize();
   checkInitialization();
   calculateForces(0);
   updateProperties(0);
   save(0);
 
-  // Looping over all time, particles and components.
-  for (int i = 0; i < m_steps; i++) {
+  if (!m_adaptiveDt) {
+    // Looping over all time, particles and components.
+    for (int i = 0; i < m_steps; i++) {
+      stepForward(i);
+      endStep(i + 1);
+    }
+    return;
+  }
+
+  // With adaptive steps the run ends at the same simulated time as a run
+  // with 'steps' fixed steps of the initial dt.
+  updateDt(0);
+  const double tolerance = 1e-9 * m_dt0;
+  for (int i = 0; m_t < m_tEnd - tolerance; i++) {
     stepForward(i);
+    endStep(i + 1);
   }
 }
 //------------------------------------------------------------------------------
 void TimeIntegrator::stepForward(int timeStep) {
   applyBoundaryConditions();
-  integrateStepOne();
+  {
+    Profiler::ScopedTimer timer(m_profiler, m_phaseIntegrateStepOne);
+    integrateStepOne();
+  }
 
   updateGridAndCommunication();
-  updateProperties(timeStep + 1);
+  // With adaptive steps the output is on the simulated time, and all the
+  // properties are computed for it whatever the step
+  updateProperties(timeStep + 1, m_adaptiveDt && saveDue(timeStep + 1));
   updateGhosts();
   //    updateElementQuadrature(*m_particles);
 
   modifiersStepOne();
   save(timeStep + 1);
   //----------------------------------------------------------------------
-  zeroForces();
-  calculateForces(timeStep + 1);
-  //----------------------------------------------------------------------
-  updateGhosts();
+  if (m_fusedPipeline) {
+    Profiler::ScopedTimer timer(m_profiler, m_phaseForcesAndStepTwo);
+    calculateForcesAndStepTwo(timeStep + 1);
+  } else {
+    zeroForces();
+    calculateForces(timeStep + 1);
+    //------------------------------------------------------------------
+    updateGhosts();
 
-  modifiersStepTwo();
-  integrateStepTwo();
+    modifiersStepTwo();
+    Profiler::ScopedTimer timer(m_profiler, m_phaseIntegrateStepTwo);
+    integrateStepTwo();
+  }
 
   m_t += m_dt;
+
+  if (m_adaptiveDt)
+    updateDt(timeStep + 1);
+}
+//------------------------------------------------------------------------------
+void TimeIntegrator::save(int timeStep) {
+  if (!m_adaptiveDt) {
+    Solver::save(timeStep);
+    return;
+  }
+
+  if (!saveDue(timeStep))
+    return;
+
+  // Numbering the output as a fixed dt0 run would have done
+  Profiler::ScopedTimer timer(m_profiler, m_phaseSave);
+  const int saveStep = m_saveCounter * m_saveInterval;
+  m_saveParticles->evaluate(m_t, saveStep);
+  m_saveParticles->saveData(m_t, saveStep);
+  m_saveCounter++;
+  m_nextSaveTime += m_saveInterval * m_dt0;
+
+  const double t = (timeStep == 0) ? m_t : m_t + m_dt;
+  const double progress = t / m_tEnd;
+  if (m_myRank == 0)
+    printProgress(progress);
+}
+//------------------------------------------------------------------------------
+void TimeIntegrator::setAdaptiveDt(double dtMin, double dtMax, double safety,
+                                   double growth, double hysteresis,
+                                   int updateFrequency) {
+  m_adaptiveDt = true;
+  m_dtMin = dtMin;
+  m_dtMax = dtMax;
+  m_dtSafety = safety;
+  m_dtGrowth = growth;
+  m_dtHysteresis = hysteresis;
+  m_dtUpdateFrequency = std::max(1, updateFrequency);
+}
+//------------------------------------------------------------------------------
+void TimeIntegrator::setFusedPipeline(bool fused, int blockSize) {
+  m_useFusedPipeline = fused;
+  m_blockSize = std::max(1, blockSize);
+}
+//------------------------------------------------------------------------------
+void TimeIntegrator::integrateStepTwo(const int i) { (void)i; }
+//------------------------------------------------------------------------------
+bool TimeIntegrator::canFusePipeline() {
+#if USE_N3L
+  // Forces are also accumulated on the neighbours
+  return false;
+#endif
+  // Step two modifiers evaluated after all forces, and before the
+  // integration, need the unfused order.
+  for (Modifier *modifier : m_spModifiers) {
+    if (modifier->hasStepTwo())
+      return false;
+  }
+  // As do the forces with step two modifiers, and the forces reading the
+  // velocities of the neighbours: the blocks before a particle's are already
+  // kicked by step two, so they would see a mix of both steps.
+  for (Force *oneBodyForce : m_oneBodyForces) {
+    if (oneBodyForce->getHasStepTwoModifier() ||
+        oneBodyForce->getReadsNeighbourVelocity())
+      return false;
+  }
+  return true;
+}
+//------------------------------------------------------------------------------
+bool TimeIntegrator::fusedPipeline() const { return m_fusedPipeline; }
+//------------------------------------------------------------------------------
+void TimeIntegrator::calculateForcesAndStepTwo(int timeStep) {
+  // The same per particle operations as zeroForces, calculateForces,
+  // modifiersStepTwo and integrateStepTwo, checked against them by the
+  // FUSED_PIPELINE tests, but the particles are swept once in cache sized
+  // blocks that are zeroed, get their forces and are integrated.
+  const ivec &colToId = m_particles->colToId();
+  const IdToColMap &idToCol = m_particles->getIdToCol_v();
+  const int nParticles = m_particles->nParticles();
+  const int nGhosts = m_particles->nGhostParticles();
+  mat &F = m_particles->F();
+
+  requestStress(timeStep);
+  m_propertyScheduler.stateChanged();
+  updateForceStates();
+
+  // The boundary modifiers act on their particles between the forces and
+  // the integration.
+  m_deferStepTwo.resize(nParticles);
+  for (Modifier *modifier : m_boundaryModifiers) {
+    for (const int id : modifier->localParticleIds()) {
+      m_deferStepTwo[idToCol[id]] = 1;
+    }
+  }
+
+  for (int d = 0; d < m_dim; d++) {
+    for (int i = nParticles; i < nParticles + nGhosts; i++) {
+      F(i, d) = 0;
+    }
+  }
+
+  for (int iStart = 0; iStart < nParticles; iStart += m_blockSize) {
+    const int iEnd = std::min(iStart + m_blockSize, nParticles);
+
+    for (int d = 0; d < m_dim; d++) {
+      for (int i = iStart; i < iEnd; i++) {
+        F(i, d) = 0;
+      }
+    }
+
+    if (m_profiler.enabled()) {
+      // Force by force as in calculateForces(), so that the profile has the
+      // same force phases. They are timed block by block, their calls are
+      // the number of blocks.
+      size_t nBlockBonds = 0;
+      for (int i = iStart; i < iEnd; i++) {
+        nBlockBonds += m_particles->pdConnections(colToId[i]).size();
+      }
+      m_profiler.setWork(iEnd - iStart, nBlockBonds);
+      const int nForces = m_oneBodyForces.size();
+      for (int f = 0; f < nForces; f++) {
+        Profiler::ScopedTimer timer(m_profiler, m_forcePhases[f]);
+        Force *oneBodyForce = m_oneBodyForces[f];
+        for (int i = iStart; i < iEnd; i++) {
+          oneBodyForce->calculateForces(colToId[i], i);
+        }
+      }
+    } else {
+      for (int i = iStart; i < iEnd; i++) {
+        const int id = colToId[i];
+        for (Force *oneBodyForce : m_oneBodyForces) {
+          oneBodyForce->calculateForces(id, i);
+        }
+      }
+    }
+
+    if (!m_hasStepTwo)
+      continue;
+
+    for (int i = iStart; i < iEnd; i++) {
+      if (!m_deferStepTwo[i])
+        integrateStepTwo(i);
+    }
+  }
+
+  updateGhosts();
+  const int nBoundaryModifiers = m_boundaryModifiers.size();
+  for (int m = 0; m < nBoundaryModifiers; m++) {
+    Profiler::ScopedTimer timer(m_profiler, m_boundaryModifierPhases[m]);
+    m_boundaryModifiers[m]->evaluateStepTwo();
+  }
+
+  for (Modifier *modifier : m_boundaryModifiers) {
+    for (const int id : modifier->localParticleIds()) {
+      const int i = idToCol[id];
+      if (!m_deferStepTwo[i])
+        continue;
+      if (m_hasStepTwo)
+        integrateStepTwo(i);
+      m_deferStepTwo[i] = 0;
+    }
+  }
+}
+//------------------------------------------------------------------------------
+double TimeIntegrator::calculateStableDt() {
+  // The stable mass of a force evaluated with dt = 1 is a bound on the
+  // stiffness of the particle (as used in ADR). The central difference
+  // scheme is stable for dt < sqrt(2 rho/K).
+  const ivec &colToId = m_particles->colToId();
+  const ParticleData &data = m_particles->data();
+  const arma::imat &isStatic = m_particles->isStatic();
+  const int nParticles = m_particles->nParticles();
+  double dtStable = std::numeric_limits<double>::max();
+
+#ifdef USE_OPENMP
+#pragma omp parallel for reduction(min : dtStable)
+#endif
+  for (int i = 0; i < nParticles; i++) {
+    if (isStatic(i))
+      continue;
+
+    const int id = colToId(i);
+    double stiffness = 0;
+    for (Force *oneBodyForce : m_oneBodyForces) {
+      stiffness += oneBodyForce->calculateStableMass(id, i, 1.);
+    }
+
+    if (stiffness <= 0)
+      continue;
+
+    const double dt_i = sqrt(2. * data(i, m_indexRho) / stiffness);
+    dtStable = std::min(dtStable, dt_i);
+  }
+#if USE_MPI
+  MPI_Allreduce(MPI_IN_PLACE, &dtStable, 1, MPI_DOUBLE, MPI_MIN,
+                MPI_COMM_WORLD);
+#endif
+
+  return dtStable;
+}
+//------------------------------------------------------------------------------
+void TimeIntegrator::updateDt(int timeStep) {
+  if (timeStep % m_dtUpdateFrequency == 0) {
+    const double dtStable = calculateStableDt();
+
+    if (dtStable < std::numeric_limits<double>::max()) {
+      const double dtNew = m_dtSafety * dtStable;
+
+      // Shrinking at once, growing only outside the hysteresis band and
+      // by at most the growth factor per update.
+      if (dtNew < m_dtTarget) {
+        m_dtTarget = dtNew;
+      } else if (dtNew > (1. + m_dtHysteresis) * m_dtTarget) {
+        m_dtTarget = std::min(dtNew, m_dtGrowth * m_dtTarget);
+      }
+      m_dtTarget = std::max(m_dtMin, std::min(m_dtMax, m_dtTarget));
+    }
+  }
+
+  // Landing exactly on the save times and the end time
+  double dt = m_dtTarget;
+  dt = std::min(dt, m_nextSaveTime - m_t);
+  dt = std::min(dt, m_tEnd - m_t);
+
+  if (dt <= 0 || dt == m_dt)
+    return;
+
+  m_dt = dt;
+  for (Modifier *modifier : m_boundaryModifiers) {
+    modifier->setDt(m_dt);
+  }
+  for (Modifier *modifier : m_spModifiers) {
+    modifier->setDt(m_dt);
+  }
+}
+//------------------------------------------------------------------------------
+bool TimeIntegrator::saveDue(int timeStep) const {
+  if (!m_adaptiveDt)
+    return timeStep % m_saveInterval == 0;
+
+  // Output is triggered by the simulated time. The state saved from within
+  // stepForward is already advanced to t + dt.
+  const double t = (timeStep == 0) ? m_t : m_t + m_dt;
+  return t >= m_nextSaveTime - 1e-9 * m_dt0;
+}
+//------------------------------------------------------------------------------
+bool TimeIntegrator::saveMayReadForces() const {
+  if (!m_adaptiveDt)
+    return false;
+
+  // The forces evaluated in a step are read by the output of the next step.
+  // It is due if the next dt, at most the grown target, reaches the save
+  // time.
+  const double dtNext = std::min(m_dtMax, m_dtGrowth * m_dtTarget);
+  return m_t + m_dt + dtNext >= m_nextSaveTime - 1e-9 * m_dt0;
 }
 //------------------------------------------------------------------------------
 void TimeIntegrator::initialize() {
@@ -56,7 +338,22 @@ void TimeIntegrator::initialize() {
     throw ParticlesMissingRhoOrMass;
   }
 
+  if (m_adaptiveDt) {
+    m_dt0 = m_dt;
+    m_dtTarget = m_dt;
+    m_tEnd = m_t + m_steps * m_dt0;
+    m_nextSaveTime = m_t;
+    m_saveCounter = 0;
+
+    if (m_dtMin <= 0)
+      m_dtMin = 1e-3 * m_dt0;
+    if (m_dtMax <= 0)
+      m_dtMax = 1e3 * m_dt0;
+  }
+
   Solver::initialize();
+
+  m_fusedPipeline = m_useFusedPipeline && canFusePipeline();
 }
 //------------------------------------------------------------------------------
 void TimeIntegrator::checkInitialization() {
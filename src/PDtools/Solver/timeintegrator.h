@@ -9,12 +9,40 @@ class TimeIntegrator : public Solver {
 protected:
   int m_indexRho;
 
+  // Adaptive time stepping
+  bool m_adaptiveDt = false;
+  double m_dt0 = 0;
+  double m_dtTarget = 0;
+  double m_dtMin = 0;
+  double m_dtMax = 0;
+  double m_dtSafety = 0.8;
+  double m_dtGrowth = 1.1;
+  double m_dtHysteresis = 0.1;
+  int m_dtUpdateFrequency = 10;
+  double m_tEnd = 0;
+  double m_nextSaveTime = 0;
+  int m_saveCounter = 0;
+
+  // Fused force and step two pipeline, off unless enabled
+  bool m_useFusedPipeline = false;
+  bool m_fusedPipeline = false;
+  int m_blockSize = 1024;
+  bool m_hasStepTwo = false;
+  vector<char> m_deferStepTwo;
+
 public:
   TimeIntegrator() { ; }
   virtual ~TimeIntegrator() { ; }
 
   virtual void solve();
   virtual void stepForward(int i);
+  virtual void save(int timeStep);
+  void setAdaptiveDt(double dtMin, double dtMax, double safety = 0.8,
+                     double growth = 1.1, double hysteresis = 0.1,
+                     int updateFrequency = 10);
+  void setFusedPipeline(bool fused, int blockSize = 1024);
+  // Whether the fused pipeline is used, known after the initialization
+  bool fusedPipeline() const;
   enum IntegratorErrorMessages { TimeStepNotSet, ParticlesMissingRhoOrMass };
 
 protected:
@@ -22,6 +50,13 @@ protected:
   virtual void initialize();
   virtual void integrateStepOne() = 0;
   virtual void integrateStepTwo() = 0;
+  virtual void integrateStepTwo(const int i);
+  bool canFusePipeline();
+  void calculateForcesAndStepTwo(int timeStep);
+  double calculateStableDt();
+  void updateDt(int timeStep);
+  bool saveDue(int timeStep) const;
+  virtual bool saveMayReadForces() const;
 };
 //------------------------------------------------------------------------------
 }
@@ -8,7 +8,7 @@ namespace PDtools {
 //------------------------------------------------------------------------------
 vec3 centroidOfQuad(PD_Particles &nodes, const PD_quadElement &quadElement) {
   const mat &R = nodes.r();
-  const ivec &idToCol = nodes.getIdToCol_v();
+  const IdToColMap &idToCol = nodes.getIdToCol_v();
 
   const array<size_t, 4> vertexIds = quadElement.verticeIds();
   vec3 r = {0, 0, 0};
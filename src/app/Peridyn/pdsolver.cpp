@@ -4,6 +4,8 @@
 #include <PDtools/CalculateProperties/calculateproperties.h>
 #include <PDtools/Force/forces.h>
 #include <PDtools/Modfiers/modifiers.h>
+#include <PDtools/PdFunctions/commtracer.h>
+#include <PDtools/PdFunctions/memorytracker.h>
 #include <PDtools/PdFunctions/pdfunctions.h>
 #include <PDtools/Solver/solvers.h>
 
@@ -11,6 +13,7 @@
 #include "Mesh/meshtopdpartices.h"
 #include "Mesh/pdmesh.h"
 
+#include <algorithm>
 #include <boost/algorithm/string.hpp>
 #include <boost/regex.h>
 
@@ -165,17 +168,21 @@ int PdSolver::initialize() {
   //--------------------------------------------------------------------------
   if (isRoot)
     cout << "Loading the particles" << endl;
-  if (!m_cfg.exists("particlesPath")) {
-    cerr << "'particlesPath' must be set in the configuration file" << endl;
+  if (!m_cfg.exists("particlesPath") && !m_cfg.exists("lattice")) {
+    cerr << "'particlesPath' or 'lattice' must be set in the configuration "
+            "file"
+         << endl;
     exit(EXIT_FAILURE);
   }
-  string particlesPath =
-      static_cast<const char *>(m_cfg.lookup("particlesPath"));
+  string particlesPath;
+  m_cfg.lookupValue("particlesPath", particlesPath);
   //    string particlesPath = static_cast<const char
   //    *>(m_cfg.lookup("particlesPath"));
   string fileType = getFileEnding(particlesPath);
 
-  if (boost::iequals(fileType, "msh")) {
+  if (m_cfg.exists("lattice")) {
+    m_particles = generateLattice(dim);
+  } else if (boost::iequals(fileType, "msh")) {
     int quadratureDegree = 1;
     m_cfg.lookupValue("quadratureDegree", quadratureDegree);
     PdMesh msh = loadMesh2d(particlesPath);
@@ -186,6 +193,38 @@ int PdSolver::initialize() {
 
   m_particles.dimensionalScaling(E0, L0, v0, t0, rho0);
   m_particles.dim(dim); // Brute forcing the dimension
+
+  // The bond parameters are stored with their registered precision, or all
+  // as doubles. "validate" stores doubles and reports the error of the
+  // registered precisions at the end of the run.
+  string bondPrecision;
+  if (m_cfg.lookupValue("bondPrecision", bondPrecision)) {
+    if (boost::iequals(bondPrecision, "mixed")) {
+      m_particles.bondStorage(BondData::Mixed);
+    } else if (boost::iequals(bondPrecision, "double")) {
+      m_particles.bondStorage(BondData::AllDouble);
+    } else if (boost::iequals(bondPrecision, "validate")) {
+      m_particles.bondStorage(BondData::Validate);
+    } else {
+      cerr << "'bondPrecision' must be 'mixed', 'double' or 'validate'"
+           << endl;
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  // The id-to-column map is dense by default and turns hashed when the ids
+  // get sparse. Setting "dense" or "hashed" fixes the mode.
+  string idToColMap;
+  if (m_cfg.lookupValue("idToColMap", idToColMap)) {
+    if (boost::iequals(idToColMap, "dense")) {
+      m_particles.idToColMode(IdToColMap::Dense);
+    } else if (boost::iequals(idToColMap, "hashed")) {
+      m_particles.idToColMode(IdToColMap::Hashed);
+    } else {
+      cerr << "'idToColMap' must be 'dense' or 'hashed'" << endl;
+      exit(EXIT_FAILURE);
+    }
+  }
   //--------------------------------------------------------------------------
   // TODO: Setting the initial position. Should not be done here
   //--------------------------------------------------------------------------
@@ -254,7 +293,7 @@ int PdSolver::initialize() {
   }
   cleanUpPdConnections(m_particles);
 
-  m_particles.registerPdParameter("volumeScaling", 1);
+  m_particles.registerPdParameter("volumeScaling", 1, BondData::Float);
   if (performVolumeCorrection) {
     applyVolumeCorrection(m_particles, delta, lc, dim);
   }
@@ -267,6 +306,8 @@ int PdSolver::initialize() {
 
   int nSteps;
   double dt;
+  TimeIntegrator *timeIntegrator = nullptr;
+  EnsembleVerletIntegrator *ensembleIntegrator = nullptr;
 
   if (!m_cfg.lookupValue("nSteps", nSteps)) {
     cerr << "Error reading the 'nSteps' in config file" << endl;
@@ -300,19 +341,169 @@ int PdSolver::initialize() {
     solver = new StaticSolver(maxIterations, threshold);
     m_cfg.lookupValue("dt", dt);
   } else if (boost::iequals(solverType, "velocity verlet")) {
-    solver = new VelocityVerletIntegrator();
+    timeIntegrator = new VelocityVerletIntegrator();
+    solver = timeIntegrator;
+    m_cfg.lookupValue("dt", dt);
+  } else if (boost::iequals(solverType, "multi-rate verlet")) {
+    int nRateLevels = 3;
+    int rateLevelUpdateFrequency = 10;
+    m_cfg.lookupValue("nRateLevels", nRateLevels);
+    m_cfg.lookupValue("rateLevelUpdateFrequency", rateLevelUpdateFrequency);
+    timeIntegrator =
+        new MultiRateVerletIntegrator(nRateLevels, rateLevelUpdateFrequency);
+    solver = timeIntegrator;
+    m_cfg.lookupValue("dt", dt);
+  } else if (boost::iequals(solverType, "ensemble verlet")) {
+    // Members as scalings of the configured material and loading rate:
+    // ensemble = ({E = ..; G0 = ..;}, {E = ..; s0 = ..; loadingRate = ..;})
+    // The loading rate scales the boundary motion, the first member runs
+    // the boundary conditions as configured. The boundary conditions are
+    // shared, other load cases need separate runs.
+    if (!m_cfg.exists("ensemble")) {
+      cerr << "Error: 'ensemble' must be set for " << solverType << endl;
+      exit(EXIT_FAILURE);
+    }
+    libconfig::Setting &cfg_ensemble = m_cfg.lookup("ensemble");
+    vector<double> micromodulusScale;
+    vector<double> s0Scale;
+    vector<double> loadingRateScale;
+    const vector<string> memberKeys = {"E", "s0", "G0", "loadingRate"};
+
+    for (int m = 0; m < cfg_ensemble.getLength(); m++) {
+      for (int k = 0; k < cfg_ensemble[m].getLength(); k++) {
+        const string key = cfg_ensemble[m][k].getName();
+        if (std::find(memberKeys.begin(), memberKeys.end(), key) ==
+            memberKeys.end()) {
+          cerr << "Error: the ensemble member setting '" << key
+               << "' is not supported, only 'E', 's0', 'G0' and "
+               << "'loadingRate' vary per member" << endl;
+          exit(EXIT_FAILURE);
+        }
+      }
+
+      double E_m = E;
+      double eScale = 1;
+      double s0_scale = 1;
+      if (cfg_ensemble[m].lookupValue("E", E_m)) {
+        E_m /= E0;
+        eScale = E_m / E;
+      }
+
+      double G0_m;
+      double s0_m;
+      if (cfg_ensemble[m].lookupValue("s0", s0_m)) {
+        double s0_base = 1;
+        m_cfg.lookupValue("s0", s0_base);
+        s0_scale = s0_m / s0_base;
+      } else if (cfg_ensemble[m].lookupValue("G0", G0_m)) {
+        if (G0 <= 0) {
+          cerr << "Error: 'G0' must be set to scale the ensemble 'G0'" << endl;
+          exit(EXIT_FAILURE);
+        }
+        // The critical stretch scales as sqrt(G0/E)
+        s0_scale = sqrt(G0_m / G0 / eScale);
+      }
+      double loadingRate = 1;
+      cfg_ensemble[m].lookupValue("loadingRate", loadingRate);
+      if (m == 0 && loadingRate != 1) {
+        cerr << "Error: the 'loadingRate' of the first ensemble member must "
+             << "be 1" << endl;
+        exit(EXIT_FAILURE);
+      }
+
+      micromodulusScale.push_back(eScale);
+      s0Scale.push_back(s0_scale);
+      loadingRateScale.push_back(loadingRate);
+    }
+    ensembleIntegrator = new EnsembleVerletIntegrator(
+        micromodulusScale, s0Scale, loadingRateScale);
+    timeIntegrator = ensembleIntegrator;
+    solver = timeIntegrator;
     m_cfg.lookupValue("dt", dt);
   } else if (boost::iequals(solverType, "euler-chromer")) {
-    solver = new EulerCromerIntegrator();
+    timeIntegrator = new EulerCromerIntegrator();
+    solver = timeIntegrator;
     m_cfg.lookupValue("dt", dt);
   } else {
     cerr << "Error: solver not set" << endl;
     exit(EXIT_FAILURE);
   }
   dt /= t0;
+
+  int adaptiveDt = 0;
+  m_cfg.lookupValue("adaptiveDt", adaptiveDt);
+
+  if (adaptiveDt) {
+    if (timeIntegrator == nullptr) {
+      cerr << "'adaptiveDt' is only supported for the time integrators"
+           << endl;
+      exit(EXIT_FAILURE);
+    }
+    double dtMin = 1e-3 * dt * t0;
+    double dtMax = 1e3 * dt * t0;
+    double dtSafety = 0.8;
+    double dtGrowth = 1.1;
+    double dtHysteresis = 0.1;
+    int dtUpdateFrequency = 10;
+    m_cfg.lookupValue("dtMin", dtMin);
+    m_cfg.lookupValue("dtMax", dtMax);
+    m_cfg.lookupValue("dtSafety", dtSafety);
+    m_cfg.lookupValue("dtGrowth", dtGrowth);
+    m_cfg.lookupValue("dtHysteresis", dtHysteresis);
+    m_cfg.lookupValue("dtUpdateFrequency", dtUpdateFrequency);
+    timeIntegrator->setAdaptiveDt(dtMin / t0, dtMax / t0, dtSafety, dtGrowth,
+                                  dtHysteresis, dtUpdateFrequency);
+  }
+
+  if (timeIntegrator != nullptr) {
+    int fusedPipeline = 0;
+    int blockSize = 1024;
+    m_cfg.lookupValue("fusedPipeline", fusedPipeline);
+    m_cfg.lookupValue("blockSize", blockSize);
+    timeIntegrator->setFusedPipeline(fusedPipeline, blockSize);
+  }
   solver->setDim(dim);
   solver->setRankAndCores(m_myRank, m_nCores);
 
+  int commTrace = 0;
+  m_cfg.lookupValue("commTrace", commTrace);
+  if (commTrace) {
+    PDtools::CommTracer::enable(true);
+
+    string commTracePath;
+    if (m_cfg.lookupValue("commTracePath", commTracePath))
+      PDtools::CommTracer::setTrace(commTracePath);
+  }
+
+  int memoryReport = 0;
+  m_cfg.lookupValue("memoryReport", memoryReport);
+  if (memoryReport || m_cfg.exists("memoryProjection")) {
+    PDtools::MemoryTracker::enable(true);
+
+    int memoryInterval = 100;
+    m_cfg.lookupValue("memoryInterval", memoryInterval);
+    PDtools::MemoryTracker::setInterval(memoryInterval);
+  }
+
+  int profile = 0;
+  m_cfg.lookupValue("profile", profile);
+  if (profile) {
+    solver->profiler().enable(true);
+
+    string profileCsv;
+    int profileCsvInterval = 100;
+    m_cfg.lookupValue("profileCsvInterval", profileCsvInterval);
+    if (m_cfg.lookupValue("profileCsv", profileCsv))
+      solver->profiler().setCsv(profileCsv, profileCsvInterval);
+
+    int perfCounters = 0;
+    m_cfg.lookupValue("perfCounters", perfCounters);
+    if (perfCounters && !solver->profiler().enableCounters() && isRoot)
+      cerr << "Warning: hardware counters unavailable, profiling the wall "
+              "time only"
+           << endl;
+  }
+
   if (isRoot)
     cout << "Solver set: " << solverType << endl;
 
@@ -809,6 +1000,10 @@ int PdSolver::initialize() {
 
       if (boost::iequals(solverType, "ADR")) {
         qsModifiers.push_back(new ADRfracture(alpha));
+      } else if (ensembleIntegrator != nullptr) {
+        if (alpha != 0 && isRoot)
+          cout << "Warning: 'alpha' is ignored in the ensemble" << endl;
+        ensembleIntegrator->enableFracture();
       } else {
         spModifiers.push_back(new PmbFracture(alpha));
       }
@@ -1335,6 +1530,8 @@ int PdSolver::initialize() {
 
   solver->setSaveInterval(saveFrequency);
   solver->setSaveParticles(saveParticles);
+  if (ensembleIntegrator != nullptr)
+    ensembleIntegrator->setEnsembleOutput(savePath + "/ensemble.txt");
 
   const auto &saveNeededProperties = saveParticles->neededProperties();
   for (const auto &property : saveNeededProperties) {
@@ -1361,6 +1558,7 @@ int PdSolver::initialize() {
       if (boost::iequals(type, property->type)) {
         if (property->updateFrequency() > updateFrquency)
           property->setUpdateFrquency(updateFrquency);
+        property->addConsumer(updateFrquency);
         alreadyAdded = true;
         break;
       }
@@ -1384,7 +1582,14 @@ int PdSolver::initialize() {
       property->setUpdateFrquency(updateFrquency);
       calcProperties.push_back(property);
     } else if (boost::iequals(type, "damage")) {
-      CalculateProperty *property = new CalculateDamage(delta);
+      int incrementalDamage = true;
+      m_cfg.lookupValue("incrementalDamage", incrementalDamage);
+      CalculateDamage *property = new CalculateDamage(delta);
+      property->setIncremental(incrementalDamage);
+      property->setUpdateFrquency(updateFrquency);
+      calcProperties.push_back(property);
+    } else if (boost::iequals(type, "principalStress")) {
+      CalculateProperty *property = new CalculatePrincipalStress();
       property->setUpdateFrquency(updateFrquency);
       calcProperties.push_back(property);
     } else {
@@ -1392,6 +1597,7 @@ int PdSolver::initialize() {
            << endl;
       exit(1);
     }
+    calcProperties.back()->addConsumer(updateFrquency);
     computeProperties.push_back(type);
   }
 
@@ -1427,8 +1633,130 @@ int PdSolver::initialize() {
 }
 //------------------------------------------------------------------------------
 void PdSolver::solve() {
+  using PDtools::MemoryTracker;
+  if (MemoryTracker::enabled()) {
+    MemoryTracker::sample(m_particles, m_grid);
+
+    // memoryProjection = {particles = 1e9; ranks = 1000;}
+    if (m_cfg.exists("memoryProjection")) {
+      libconfig::Setting &cfg_projection = m_cfg.lookup("memoryProjection");
+      double nParticles = 0;
+      int nRanks = 0;
+      double delta = 0;
+      double lc = 0;
+      cfg_projection.lookupValue("particles", nParticles);
+      cfg_projection.lookupValue("ranks", nRanks);
+      m_cfg.lookupValue("delta", delta);
+      m_cfg.lookupValue("lc", lc);
+      if (nParticles <= 0 || nRanks <= 0) {
+        cerr << "'memoryProjection' must set 'particles' and 'ranks'" << endl;
+        exit(EXIT_FAILURE);
+      }
+      MemoryTracker::project(nParticles, nRanks, delta / lc);
+      return;
+    }
+    MemoryTracker::report("at startup");
+  }
+
   if (isRoot)
     cout << "Starting solver" << endl;
   solver->solve();
+
+  if (MemoryTracker::enabled()) {
+    MemoryTracker::sample(m_particles, m_grid);
+    MemoryTracker::report("at the end of the run, with the peaks");
+  }
+
+  if (solver->profiler().enabled())
+    solver->profiler().report();
+
+  PDtools::CommTracer::summary();
+
+  if (m_particles.bondLayout().storage() == PDtools::BondData::Validate)
+    reportBondPrecision();
+}
+//------------------------------------------------------------------------------
+PDtools::PD_Particles PdSolver::generateLattice(const int dim) {
+  // lattice = {type = "hexagonal"; spacing = 1e-3;
+  //            box = [x0, x1, y0, y1, z0, z1];
+  //            holes = ({center = [x, y, z]; radius = r;});
+  //            notches = ({box = [x0, x1, y0, y1, z0, z1];});
+  //            groups = ({groupId = 1; box = [x0, x1, y0, y1, z0, z1];});};
+  using namespace PDtools;
+  libconfig::Setting &cfg_lattice = m_cfg.lookup("lattice");
+
+  auto readBox = [](libconfig::Setting &cfg_box) {
+    if (cfg_box.getLength() != 2 * M_DIM) {
+      cerr << "A lattice box must be set on the form "
+           << "'box = [x0, x1, y0, y1, z0, z1]'" << endl;
+      exit(EXIT_FAILURE);
+    }
+    vector<pair<double, double>> box;
+    for (int d = 0; d < M_DIM; d++) {
+      box.push_back(pair<double, double>(cfg_box[2 * d], cfg_box[2 * d + 1]));
+    }
+    return box;
+  };
+
+  string type;
+  double spacing;
+  if (!cfg_lattice.lookupValue("type", type) ||
+      !cfg_lattice.lookupValue("spacing", spacing) ||
+      !cfg_lattice.exists("box")) {
+    cerr << "'lattice' must set 'type', 'spacing' and 'box'" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  LatticeGenerator lattice(LatticeGenerator::type(type), spacing,
+                           readBox(cfg_lattice["box"]));
+  if (lattice.dim() != dim) {
+    cerr << "The " << type << " lattice is " << lattice.dim()
+         << "d, the simulation " << dim << "d" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  if (cfg_lattice.exists("holes")) {
+    libconfig::Setting &cfg_holes = cfg_lattice["holes"];
+    for (int i = 0; i < cfg_holes.getLength(); i++) {
+      libconfig::Setting &cfg_center = cfg_holes[i]["center"];
+      vec3 center = {cfg_center[0], cfg_center[1], cfg_center[2]};
+      lattice.addHole(center, cfg_holes[i]["radius"]);
+    }
+  }
+  if (cfg_lattice.exists("notches")) {
+    libconfig::Setting &cfg_notches = cfg_lattice["notches"];
+    for (int i = 0; i < cfg_notches.getLength(); i++) {
+      lattice.addNotch(readBox(cfg_notches[i]["box"]));
+    }
+  }
+  if (cfg_lattice.exists("groups")) {
+    libconfig::Setting &cfg_groups = cfg_lattice["groups"];
+    for (int i = 0; i < cfg_groups.getLength(); i++) {
+      lattice.addGroup(cfg_groups[i]["groupId"],
+                       readBox(cfg_groups[i]["box"]));
+    }
+  }
+
+  return lattice.generate(m_grid);
+}
+//------------------------------------------------------------------------------
+void PdSolver::reportBondPrecision() {
+  using namespace PDtools;
+  vector<double> maxErrors = m_particles.bondPrecisionErrors();
+#if USE_MPI
+  MPI_Allreduce(MPI_IN_PLACE, maxErrors.data(), maxErrors.size(), MPI_DOUBLE,
+                MPI_MAX, MPI_COMM_WORLD);
+#endif
+  if (!isRoot)
+    return;
+
+  cout << "Largest relative error of the reduced precision bond parameters:"
+       << endl;
+  for (const auto &param : m_particles.PdParameters()) {
+    const int k = param.second;
+    if (m_particles.bondLayout().registeredPrecision(k) == BondData::Double)
+      continue;
+    cout << "  " << param.first << ": " << maxErrors[k] << endl;
+  }
 }
 //------------------------------------------------------------------------------
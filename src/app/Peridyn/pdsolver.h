@@ -16,6 +16,8 @@ public:
 
 private:
   void setDomain();
+  PDtools::PD_Particles generateLattice(const int dim);
+  void reportBondPrecision();
 
   const std::string m_configPath;
   const int m_myRank;
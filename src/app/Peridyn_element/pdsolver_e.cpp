@@ -306,7 +306,7 @@ int PdSolver_e::initialize()
 //    removeVoidConnections(m_particles, m_grid, delta, lc);
 
 //    cleanUpPdConnections(m_discretization);
-    m_discretization.registerPdParameter("volumeScaling", 1);
+    m_discretization.registerPdParameter("volumeScaling", 1, BondData::Float);
     setPD_N3L(m_discretization);
     //--------------------------------------------------------------------------
     // Setting the solver
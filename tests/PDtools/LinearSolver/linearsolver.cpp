@@ -98,7 +98,7 @@ TEST_F(PD_LINEAR_SOLVER_FIXTURE, TEST_CG)
     //--------------------------------------------------------------------------
     // Setting the stiffness matrix
     //--------------------------------------------------------------------------
-    arma::mat & m_data = m_particles.data();
+    ParticleData & m_data = m_particles.data();
     std::unordered_map<int, int> & m_pIds = m_particles.pIds();
 
     const int m_indexVolume = m_particles.getParamId("volume");
@@ -116,7 +116,7 @@ TEST_F(PD_LINEAR_SOLVER_FIXTURE, TEST_CG)
         const int a = id.second;
         const double c_i = m_data(a, m_indexMicromodulus);
 
-        vector<pair<int, vector<double>>> & PDconnections = m_particles.pdConnections(pId);
+        BondList & PDconnections = m_particles.pdConnections(pId);
         const int nConnections = PDconnections.size();
 
         for(int l_j=0; l_j<nConnections; l_j++)
@@ -171,7 +171,7 @@ TEST_F(PD_LINEAR_SOLVER_FIXTURE, TEST_CG)
     {
         pair<int, int> id(l_a, l_a);
         const int pId = id.first;
-        vector<pair<int, vector<double>>> & PDconnections = m_particles.pdConnections(pId);
+        BondList & PDconnections = m_particles.pdConnections(pId);
         const int nConnections = PDconnections.size();
         total_values += nConnections + 1;
     }
@@ -189,7 +189,7 @@ TEST_F(PD_LINEAR_SOLVER_FIXTURE, TEST_CG)
         int i_a = a*m_dim;
         const double c_i = m_data(a, m_indexMicromodulus);
 
-        vector<pair<int, vector<double>>> & PDconnections = m_particles.pdConnections(pId);
+        BondList & PDconnections = m_particles.pdConnections(pId);
         const int nConnections = PDconnections.size();
         arma::mat C_ij = arma::zeros(m_dim, m_dim);
 
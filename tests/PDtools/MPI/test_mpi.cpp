@@ -16,13 +16,12 @@ protected:
     {
         testParticles.nParticles(test_nParticles);
         testParticles.initializeMatrices();
-        mat & data = testParticles.data();
         mat & r = testParticles.r();
 
-        auto & parameters = testParticles.parameters();
-        parameters["v_x"] = 0;
-        parameters["v_y"] = 1;
-        parameters["volume"] = 2;
+        const int i_v_x = testParticles.registerParameter("v_x");
+        const int i_v_y = testParticles.registerParameter("v_y");
+        const int i_volume = testParticles.registerParameter("volume");
+        ParticleData & data = testParticles.data();
 
         vec v_x, v_y, volume;
         mat _r;
@@ -33,9 +32,12 @@ protected:
         volume << 8.76566e-06 << 8.22899e-06 << 8.0501e-06  << 8.31843e-06 << 7.78176e-06 << 6.44008e-06 << 7.33453e-06 << 8.0501e-06 << 8.31843e-06 << 7.0662e-06 << 8.13954e-06 << arma::endr;
 
         r = _r.t();
-        data.col(parameters["v_x"]) = v_x;
-        data.col(parameters["v_y"]) = v_y;
-        data.col(parameters["volume"]) = volume;
+        for(int i=0; i<test_nParticles;i++)
+        {
+            data(i, i_v_x) = v_x(i);
+            data(i, i_v_y) = v_y(i);
+            data(i, i_volume) = volume(i);
+        }
 
         unordered_map<int, int> & pIds = testParticles.pIds();
         for(int i=0; i<test_nParticles;i++)
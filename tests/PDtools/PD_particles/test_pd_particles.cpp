@@ -15,12 +15,11 @@ class PD_PARTICLES_FIXTURE : public ::testing::Test {
     {
         testParticles.nParticles(test_nParticles);
         testParticles.initializeMatrices();
-        mat & data = testParticles.data();
         mat & r = testParticles.r();
         mat & v = testParticles.v();
 
-        auto & parameters = testParticles.parameters();
-        parameters["volume"] = 0;
+        const int i_volume = testParticles.registerParameter("volume");
+        ParticleData & data = testParticles.data();
         arma::vec volume;
 
         mat _r, _v;
@@ -33,7 +32,10 @@ class PD_PARTICLES_FIXTURE : public ::testing::Test {
 
         r = _r.t();
         v = _v.t();
-        data.col(parameters["volume"]) = volume;
+        for(int i=0; i<test_nParticles;i++)
+        {
+            data(i, i_volume) = volume(i);
+        }
 
         unordered_map<int, int> & pIds = testParticles.pIds();
         for(int i=0; i<test_nParticles;i++)
@@ -58,8 +60,8 @@ TEST_F(PD_PARTICLES_FIXTURE, PD_LOAD_XYZ)
     const mat & r_test = testParticles.r();
     const mat & v = particles.v();
     const mat & v_test = testParticles.v();
-    const mat & data = particles.data();
-    const mat & data_test = testParticles.data();
+    const ParticleData & data = particles.data();
+    const ParticleData & data_test = testParticles.data();
     const auto & parameters = particles.parameters();
     auto & parameters_test = testParticles.parameters();
 
@@ -77,7 +79,7 @@ TEST_F(PD_PARTICLES_FIXTURE, PD_LOAD_XYZ)
         {
             int particles_type_pos = param.second;
             int testParticles_type_pos = parameters_test[param.first];
-            ASSERT_EQ(data_test(id_test, testParticles_type_pos), data(id_load, particles_type_pos))
+            ASSERT_EQ(data_test.value(id_test, testParticles_type_pos), data.value(id_load, particles_type_pos))
                     << "The data in Testparticles does not match the data read from file";
         }
     }
@@ -151,7 +153,7 @@ TEST_F(PD_PARTICLES_FIXTURE, CREATE_PD_CONNECTIONS)
 
     const unordered_map<int, int> & pIds = particles.pIds();
     const mat & R = particles.r();
-    mat & data = particles.data();
+    ParticleData & data = particles.data();
 
     for(const pair<int, int> &idCol:pIds)
     {
@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+#include <PDtools/Particles/bonddata.h>
+
+using namespace PDtools;
+
+namespace {
+// dr0, stretch, connected and volumeScaling as registered by the solver
+void addSolverParameters(BondLayout &layout) {
+    layout.addParameter(BondData::Double);
+    layout.addParameter(BondData::Float);
+    layout.addParameter(BondData::Flag);
+    layout.addParameter(BondData::Float);
+}
+
+vector<double> bondValues(const int l) {
+    return {1e-3 * (l + 1) + 1e-12, 0.1 + 1e-9 * l, double(l % 2), 0.75};
+}
+
+void expectBond(const BondData &bond, const int l) {
+    const vector<double> values = bondValues(l);
+    EXPECT_EQ(values[0], bond[0]) << "bond " << l;
+    EXPECT_EQ(BondData::reduced(values[1], BondData::Float), bond[1])
+        << "bond " << l;
+    EXPECT_EQ(values[2], bond[2]) << "bond " << l;
+    EXPECT_EQ(values[3], bond[3]) << "bond " << l;
+}
+
+BondList bondList(const BondLayout &layout, const int nBonds) {
+    BondList bonds(layout);
+    for (int l = 0; l < nBonds; l++) {
+        bonds.push_back(100 + l, bondValues(l));
+    }
+    return bonds;
+}
+}
+
+TEST(BOND_DATA, MIXED_PRECISION_ROUND_TRIP)
+{
+    BondLayout layout;
+    addSolverParameters(layout);
+    EXPECT_EQ(0u, layout.offset(0));
+    EXPECT_EQ(8u, layout.offset(1));
+    EXPECT_EQ(12u, layout.offset(2));
+    EXPECT_EQ(16u, layout.offset(3));
+    EXPECT_EQ(24u, layout.nBytes());
+
+    BondData bond(layout, bondValues(0));
+    expectBond(bond, 0);
+
+    // Flags store value > 0.5, the floats are rounded once
+    bond[2] = 0.7;
+    EXPECT_EQ(1, bond[2]);
+    bond[2] = 0.2;
+    EXPECT_EQ(0, bond[2]);
+    bond[1] = 1. / 3.;
+    EXPECT_EQ(float(1. / 3.), bond[1]);
+    bond[1] += 1.;
+    EXPECT_EQ(float(float(1. / 3.) + 1.), bond[1]);
+
+    // The typed fields read the stored values
+    EXPECT_EQ(bond[0], layout.field<double>(0)(bond));
+    EXPECT_EQ(bond[1], layout.field<float>(1)(bond));
+    EXPECT_EQ(0, layout.field<uint8_t>(2)(bond));
+    layout.field<float>(3).set(bond, 0.5f);
+    EXPECT_EQ(0.5, bond[3]);
+    EXPECT_ANY_THROW(layout.field<double>(1));
+}
+
+TEST(BOND_DATA, ALL_DOUBLE_STORAGE_KEEPS_THE_REGISTERED_PRECISION)
+{
+    BondLayout layout;
+    layout.storage(BondData::Validate);
+    addSolverParameters(layout);
+    EXPECT_EQ(BondData::Double, layout.precision(1));
+    EXPECT_EQ(BondData::Float, layout.registeredPrecision(1));
+    EXPECT_EQ(BondData::Flag, layout.registeredPrecision(2));
+    EXPECT_EQ(32u, layout.nBytes());
+
+    BondData bond(layout, {0, 1. / 3., 0.7, 0});
+    EXPECT_EQ(1. / 3., bond[1]);
+    EXPECT_EQ(0.7, bond[2]);
+    EXPECT_ANY_THROW(layout.storage(BondData::Mixed));
+}
+
+TEST(BOND_DATA, LIST_PUSH_BACK_ERASE_AND_COPY)
+{
+    BondLayout layout;
+    addSolverParameters(layout);
+    const int nBonds = 37;
+    BondList bonds = bondList(layout, nBonds);
+    ASSERT_EQ(size_t(nBonds), bonds.size());
+    for (int l = 0; l < nBonds; l++) {
+        EXPECT_EQ(100 + l, bonds[l].first);
+        expectBond(bonds[l].second, l);
+    }
+
+    // The bonds of a list are contiguous
+    for (int l = 1; l < nBonds; l++) {
+        EXPECT_EQ(bonds[0].second.bytes() + l * layout.nBytes(),
+                  bonds[l].second.bytes());
+    }
+
+    // Erasing keeps each bond in its slot and moves the values down
+    bonds.erase(bonds.begin() + 5);
+    bonds.erase(bonds.begin(), bonds.begin() + 2);
+    ASSERT_EQ(size_t(nBonds - 3), bonds.size());
+    vector<int> kept;
+    for (int l = 2; l < nBonds; l++) {
+        if (l != 5)
+            kept.push_back(l);
+    }
+    for (unsigned int l = 0; l < kept.size(); l++) {
+        EXPECT_EQ(100 + kept[l], bonds[l].first);
+        expectBond(bonds[l].second, kept[l]);
+    }
+
+    // A copied list has its own storage, a bond copied out of a list owns
+    // its values
+    BondList copy(bonds);
+    BondData bond = bonds[0].second;
+    bonds[0].second[0] = -1;
+    copy[1].second[0] = -2;
+    expectBond(copy[0].second, kept[0]);
+    expectBond(bonds[1].second, kept[1]);
+    expectBond(bond, kept[0]);
+
+    // Assigning to a bond of a list copies the values
+    bonds[0].second = bond;
+    expectBond(bonds[0].second, kept[0]);
+    EXPECT_EQ(bonds[1].second.bytes() - layout.nBytes(),
+              bonds[0].second.bytes());
+
+    // Bonds added after a copy, through the pair interface
+    copy.push_back(BondList::value_type(7, bond));
+    EXPECT_EQ(7, copy.back().first);
+    expectBond(copy.back().second, kept[0]);
+}
+
+TEST(BOND_DATA, ADD_PARAMETERS_REPACKS_THE_LIST)
+{
+    BondLayout layout;
+    addSolverParameters(layout);
+    const int nBonds = 9;
+    BondList bonds = bondList(layout, nBonds);
+
+    // A flag fits in the padding, a double needs a longer stride
+    for (const BondData::Precision precision :
+         {BondData::Flag, BondData::Double}) {
+        layout.addParameter(precision);
+        bonds.addParameters(layout, 1);
+        ASSERT_EQ(size_t(nBonds), bonds.size());
+        for (int l = 0; l < nBonds; l++) {
+            EXPECT_EQ(layout.size(), bonds[l].second.size());
+            expectBond(bonds[l].second, l);
+            EXPECT_EQ(1, bonds[l].second[layout.size() - 1]);
+        }
+    }
+    EXPECT_EQ(32u, layout.nBytes());
+}
+
+TEST(BOND_DATA, TWO_LAYOUTS_SIDE_BY_SIDE)
+{
+    // E.g. a particle set and its discretization, registered differently
+    BondLayout layout1;
+    addSolverParameters(layout1);
+    BondLayout layout2;
+    layout2.addParameter(BondData::Flag);
+    layout2.addParameter(BondData::Double);
+
+    BondList bonds1 = bondList(layout1, 4);
+    BondList bonds2(layout2);
+    bonds2.push_back(3, {1, 0.25});
+    EXPECT_EQ(&layout2, bonds2[0].second.layout());
+    EXPECT_EQ(0.25, bonds2[0].second[1]);
+    for (int l = 0; l < 4; l++) {
+        expectBond(bonds1[l].second, l);
+    }
+
+    // Into a list of another layout, the values are copied by index
+    BondData bond(layout1, bondValues(2));
+    BondData &other = bonds2[0].second;
+    other = bond;
+    EXPECT_EQ(&layout2, other.layout());
+    EXPECT_EQ(bondValues(2)[0] > 0.5, other[0]);
+    EXPECT_EQ(BondData::reduced(bondValues(2)[1], BondData::Float), other[1]);
+}
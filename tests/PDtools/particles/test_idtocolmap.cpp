@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include <PDtools/Particles/idtocolmap.h>
+
+using namespace PDtools;
+
+namespace {
+// Maps the ids to the columns id % 97 and checks every id read back, the
+// unmapped ids in between must read as -1
+void expectMapped(const IdToColMap &idToCol, const vector<int> &ids,
+                  const int maxId) {
+    vector<bool> mapped(maxId + 1, false);
+    for (const int id : ids) {
+        mapped[id] = true;
+    }
+    for (int id = 0; id <= maxId; id++) {
+        const int expected = mapped[id] ? id % 97 : -1;
+        EXPECT_EQ(expected, idToCol[id]) << "id " << id;
+        EXPECT_EQ(expected, idToCol.at(id)) << "id " << id;
+    }
+}
+
+vector<int> sparseIds() {
+    vector<int> ids;
+    for (int id = 3; id < 5000; id += 7) {
+        ids.push_back(id);
+    }
+    return ids;
+}
+}
+
+TEST(ID_TO_COL_MAP, DENSE_AND_HASHED_LOOKUPS)
+{
+    const vector<int> ids = sparseIds();
+    for (const IdToColMap::Mode mode : {IdToColMap::Dense, IdToColMap::Hashed}) {
+        IdToColMap idToCol;
+        idToCol.initialize(16, mode);
+        for (const int id : ids) {
+            idToCol[id] = id % 97;
+        }
+        EXPECT_EQ(mode, idToCol.mode());
+        expectMapped(idToCol, ids, ids.back() + 10);
+    }
+}
+
+TEST(ID_TO_COL_MAP, MISSES_DO_NOT_INSERT)
+{
+    for (const IdToColMap::Mode mode : {IdToColMap::Dense, IdToColMap::Hashed}) {
+        IdToColMap idToCol;
+        idToCol.initialize(16, mode);
+        idToCol[5] = 1;
+        const size_t nBytes = idToCol.allocatedBytes();
+        const unsigned int denseSize = idToCol.denseSize();
+
+        // Reads of ids far beyond the mapped range, also through a
+        // non-const map
+        EXPECT_EQ(-1, idToCol.at(100000));
+        EXPECT_EQ(-1, idToCol(100000));
+        EXPECT_EQ(-1, idToCol.at(-1));
+        const IdToColMap &constIdToCol = idToCol;
+        EXPECT_EQ(-1, constIdToCol[200000]);
+
+        EXPECT_EQ(nBytes, idToCol.allocatedBytes());
+        EXPECT_EQ(denseSize, idToCol.denseSize());
+        EXPECT_EQ(1, idToCol.at(5));
+    }
+}
+
+TEST(ID_TO_COL_MAP, ERASE)
+{
+    vector<int> ids = sparseIds();
+    for (const IdToColMap::Mode mode : {IdToColMap::Dense, IdToColMap::Hashed}) {
+        IdToColMap idToCol;
+        idToCol.initialize(16, mode);
+        for (const int id : ids) {
+            idToCol[id] = id % 97;
+        }
+
+        // Every third id, the hashed table must still find the ids probed
+        // past the erased ones
+        vector<int> kept;
+        for (unsigned int k = 0; k < ids.size(); k++) {
+            if (k % 3 == 0)
+                idToCol.erase(ids[k]);
+            else
+                kept.push_back(ids[k]);
+        }
+        idToCol.erase(ids.back() + 1000);
+        expectMapped(idToCol, kept, ids.back() + 10);
+
+        // Erased ids can be mapped again
+        idToCol[ids[0]] = ids[0] % 97;
+        kept.push_back(ids[0]);
+        expectMapped(idToCol, kept, ids.back() + 10);
+    }
+}
+
+TEST(ID_TO_COL_MAP, MODE_SWITCH_KEEPS_ENTRIES)
+{
+    const vector<int> ids = sparseIds();
+    IdToColMap idToCol;
+    idToCol.initialize(16, IdToColMap::Dense);
+    for (const int id : ids) {
+        idToCol[id] = id % 97;
+    }
+
+    idToCol.setMode(IdToColMap::Hashed);
+    EXPECT_EQ(IdToColMap::Hashed, idToCol.mode());
+    expectMapped(idToCol, ids, ids.back() + 10);
+
+    idToCol.setMode(IdToColMap::Dense);
+    EXPECT_EQ(IdToColMap::Dense, idToCol.mode());
+    expectMapped(idToCol, ids, ids.back() + 10);
+}
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include <PDtools/Particles/particledata.h>
+
+#include <cstdint>
+
+using namespace PDtools;
+
+namespace {
+bool aligned(const void *pointer) {
+    return reinterpret_cast<uintptr_t>(pointer) % 64 == 0;
+}
+
+void fillColumn(ParticleData &data, const int k) {
+    for (unsigned int i = 0; i < data.nRows(); i++) {
+        data.setValue(i, k, 100 * k + i + 0.5);
+    }
+}
+
+void expectColumn(const ParticleData &data, const int k,
+                  const unsigned int nRows) {
+    for (unsigned int i = 0; i < nRows; i++) {
+        EXPECT_EQ(100 * k + i + 0.5, data.value(i, k))
+            << "row " << i << " of column " << k;
+    }
+}
+}
+
+TEST(PARTICLE_DATA, COLUMNS_ARE_ALIGNED)
+{
+    // Row counts that are not a multiple of the alignment
+    for (const unsigned int nRows : {1u, 7u, 13u, 1001u}) {
+        ParticleData data;
+        data.initialize(nRows, 3);
+        data.allocateColumn(0, ParticleData::DoubleField, true);
+        data.allocateColumn(1);
+        data.allocateColumn(2, ParticleData::DoubleField, true);
+        data.allocateColumn(3, ParticleData::FloatField);
+        data.allocateColumn(4, ParticleData::DoubleField, true);
+
+        for (const int k : {0, 1, 2, 4}) {
+            EXPECT_TRUE(aligned(data.colptr(k))) << nRows << " rows";
+        }
+        EXPECT_TRUE(aligned(data.floatColptr(3))) << nRows << " rows";
+        EXPECT_EQ(ParticleData::FloatField, data.type(3));
+
+        // The hot columns are side by side, one padded column apart
+        const size_t stride = (nRows * sizeof(double) + 63) / 64 * 64;
+        EXPECT_EQ(stride, size_t(reinterpret_cast<char *>(data.colptr(2)) -
+                                 reinterpret_cast<char *>(data.colptr(0))));
+        EXPECT_EQ(stride, size_t(reinterpret_cast<char *>(data.colptr(4)) -
+                                 reinterpret_cast<char *>(data.colptr(2))));
+    }
+}
+
+TEST(PARTICLE_DATA, COLUMNS_GROW_WITHOUT_MOVING)
+{
+    const unsigned int nRows = 37;
+    ParticleData data;
+    data.initialize(nRows, 2);
+    data.allocateColumn(0, ParticleData::DoubleField, true);
+    fillColumn(data, 0);
+    const double *column0 = data.colptr(0);
+
+    // Columns registered later, past the hot block and with gaps
+    for (const int k : {1, 5, 64, 3}) {
+        data.allocateColumn(k);
+        fillColumn(data, k);
+    }
+    data.allocateColumn(70, ParticleData::FloatField);
+    fillColumn(data, 70);
+
+    EXPECT_EQ(71, data.nColumns());
+    EXPECT_EQ(column0, data.colptr(0));
+    EXPECT_FALSE(data.hasColumn(2));
+    EXPECT_FALSE(data.hasColumn(71));
+    for (const int k : {0, 1, 3, 5, 64}) {
+        expectColumn(data, k, nRows);
+    }
+    for (unsigned int i = 0; i < nRows; i++) {
+        EXPECT_EQ(float(100 * 70 + i + 0.5), data.value(i, 70));
+    }
+
+    // Allocating a column again keeps it
+    data.allocateColumn(5);
+    expectColumn(data, 5, nRows);
+}
+
+TEST(PARTICLE_DATA, RESIZE_AND_COPY_KEEP_THE_VALUES)
+{
+    const unsigned int nRows = 20;
+    ParticleData data;
+    data.initialize(nRows, 1);
+    data.allocateColumn(0, ParticleData::DoubleField, true);
+    data.allocateColumn(2);
+    fillColumn(data, 0);
+    fillColumn(data, 2);
+
+    ParticleData copy(data);
+    data.setValue(3, 0, -1);
+    expectColumn(copy, 0, nRows);
+    expectColumn(copy, 2, nRows);
+    EXPECT_NE(data.colptr(0), copy.colptr(0));
+    EXPECT_FALSE(copy.hasColumn(1));
+
+    // Growing keeps the rows and zeroes the new ones, shrinking keeps the
+    // rows that fit
+    copy.resizeRows(3 * nRows);
+    EXPECT_EQ(3 * nRows, copy.nRows());
+    expectColumn(copy, 2, nRows);
+    for (unsigned int i = nRows; i < 3 * nRows; i++) {
+        EXPECT_EQ(0, copy(i, 2));
+    }
+    EXPECT_TRUE(aligned(copy.colptr(0)));
+    copy.resizeRows(5);
+    expectColumn(copy, 0, 5);
+    expectColumn(copy, 2, 5);
+    EXPECT_EQ(2 * 64u, copy.allocatedBytes());
+}
+
+#ifdef DEBUG_MODE
+TEST(PARTICLE_DATA, FLOAT_COLUMNS_ARE_NOT_READ_AS_DOUBLES)
+{
+    ParticleData data;
+    data.initialize(4, 0);
+    data.allocateColumn(0);
+    data.allocateColumn(1, ParticleData::FloatField);
+    EXPECT_NO_THROW(data.colptr(0));
+    EXPECT_ANY_THROW(data.colptr(1));
+    EXPECT_ANY_THROW(data(0, 1));
+    data.setValue(2, 1, 0.25);
+    EXPECT_EQ(0.25, data.value(2, 1));
+}
+#endif
@@ -15,13 +15,12 @@ protected:
     {
         testParticles.nParticles(test_nParticles);
         testParticles.initializeMatrices();
-        mat & data = testParticles.data();
         mat & r = testParticles.r();
 
-        auto & parameters = testParticles.parameters();
-        parameters["v_x"] = 0;
-        parameters["v_y"] = 1;
-        parameters["volume"] = 2;
+        const int i_v_x = testParticles.registerParameter("v_x");
+        const int i_v_y = testParticles.registerParameter("v_y");
+        const int i_volume = testParticles.registerParameter("volume");
+        ParticleData & data = testParticles.data();
 
         vec v_x, v_y, volume;
         mat _r;
@@ -32,9 +31,12 @@ protected:
         volume << 8.76566e-06 << 8.22899e-06 << 8.0501e-06  << 8.31843e-06 << 7.78176e-06 << 6.44008e-06 << 7.33453e-06 << 8.0501e-06 << 8.31843e-06 << 7.0662e-06 << 8.13954e-06 << arma::endr;
 
         r = _r.t();
-        data.col(parameters["v_x"]) = v_x;
-        data.col(parameters["v_y"]) = v_y;
-        data.col(parameters["volume"]) = volume;
+        for(int i=0; i<test_nParticles;i++)
+        {
+            data(i, i_v_x) = v_x(i);
+            data(i, i_v_y) = v_y(i);
+            data(i, i_volume) = volume(i);
+        }
 
         unordered_map<int, int> & pIds = testParticles.pIds();
         for(int i=0; i<test_nParticles;i++)
@@ -58,8 +60,8 @@ TEST_F(PARTICLES_FIXTURE, LOAD_XYZ)
 
     const mat & r = particles.r();
     const mat & r_test = testParticles.r();
-    const mat & data = particles.data();
-    const mat & data_test = testParticles.data();
+    const ParticleData & data = particles.data();
+    const ParticleData & data_test = testParticles.data();
     const auto & parameters = particles.parameters();
     auto & parameters_test = testParticles.parameters();
 
@@ -79,7 +81,7 @@ TEST_F(PARTICLES_FIXTURE, LOAD_XYZ)
             int particles_type_pos = param.second;
             int testParticles_type_pos = parameters_test[param.first];
 
-            ASSERT_EQ(data_test(id_test, testParticles_type_pos), data(id_load, particles_type_pos))
+            ASSERT_EQ(data_test.value(id_test, testParticles_type_pos), data.value(id_load, particles_type_pos))
                     << "The data in Testparticles does not match the data read from file";
         }
     }
@@ -212,7 +214,7 @@ TEST_F(PARTICLES_FIXTURE, VERLET_LIST)
 
     const unordered_map<int, int> & pIds = particles.pIds();
     const mat & R = particles.r();
-    mat & data = particles.data();
+    ParticleData & data = particles.data();
 
     for(const pair<int, int> &idCol:pIds)
     {
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <PDtools/PdFunctions/pdfunctions.h>
+
+#include <algorithm>
+#include <random>
+
+using namespace PDtools;
+
+namespace {
+// The stress tensors R diag(p) R^T of known principal stresses p, rotated by
+// random rotations R
+struct Stresses3d {
+    vector<double> s_xx, s_yy, s_zz, s_xy, s_xz, s_yz;
+    vector<array<double, 3>> principal;
+
+    void add(array<double, 3> p, std::mt19937 &rng) {
+        // A random unit quaternion
+        std::normal_distribution<double> normal;
+        double q[4];
+        double norm = 0;
+        for (int k = 0; k < 4; k++) {
+            q[k] = normal(rng);
+            norm += q[k] * q[k];
+        }
+        for (int k = 0; k < 4; k++) {
+            q[k] /= sqrt(norm);
+        }
+        const double w = q[0], x = q[1], y = q[2], z = q[3];
+        const double R[3][3] = {
+            {1 - 2 * (y * y + z * z), 2 * (x * y - w * z), 2 * (x * z + w * y)},
+            {2 * (x * y + w * z), 1 - 2 * (x * x + z * z), 2 * (y * z - w * x)},
+            {2 * (x * z - w * y), 2 * (y * z + w * x), 1 - 2 * (x * x + y * y)}};
+
+        double S[3][3];
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) {
+                S[i][j] = 0;
+                for (int k = 0; k < 3; k++) {
+                    S[i][j] += R[i][k] * p[k] * R[j][k];
+                }
+            }
+        }
+        s_xx.push_back(S[0][0]);
+        s_yy.push_back(S[1][1]);
+        s_zz.push_back(S[2][2]);
+        s_xy.push_back(S[0][1]);
+        s_xz.push_back(S[0][2]);
+        s_yz.push_back(S[1][2]);
+
+        std::sort(p.begin(), p.end());
+        principal.push_back(p);
+    }
+};
+}
+
+TEST(PRINCIPAL_STRESSES, THREE_DIMENSIONS)
+{
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> uniform(-1e8, 1e8);
+    Stresses3d stresses;
+    for (int n = 0; n < 200; n++) {
+        stresses.add({uniform(rng), uniform(rng), uniform(rng)}, rng);
+    }
+    // Repeated principal stresses, an isotropic and a zero stress
+    stresses.add({2e7, 2e7, -5e6}, rng);
+    stresses.add({-3e6, 4e7, 4e7}, rng);
+    stresses.add({1e6, 1e6, 1e6}, rng);
+    stresses.add({0, 0, 0}, rng);
+    // Uniaxial, unrotated
+    stresses.s_xx.push_back(5e7);
+    for (vector<double> *s : {&stresses.s_yy, &stresses.s_zz, &stresses.s_xy,
+                              &stresses.s_xz, &stresses.s_yz}) {
+        s->push_back(0);
+    }
+    stresses.principal.push_back({0, 0, 5e7});
+
+    const int n = stresses.principal.size();
+    vector<double> p_max(n), p_mid(n), p_min(n);
+    principalStresses3d(n, stresses.s_xx.data(), stresses.s_yy.data(),
+                        stresses.s_zz.data(), stresses.s_xy.data(),
+                        stresses.s_xz.data(), stresses.s_yz.data(),
+                        p_max.data(), p_mid.data(), p_min.data());
+
+    for (int k = 0; k < n; k++) {
+        const array<double, 3> &p = stresses.principal[k];
+        const double scale = std::max(1., std::max(fabs(p[0]), fabs(p[2])));
+        EXPECT_NEAR(p[2], p_max[k], 1e-7 * scale) << "tensor " << k;
+        EXPECT_NEAR(p[1], p_mid[k], 1e-7 * scale) << "tensor " << k;
+        EXPECT_NEAR(p[0], p_min[k], 1e-7 * scale) << "tensor " << k;
+        // Sorted, up to the rounding of repeated principal stresses
+        EXPECT_GE(p_max[k] - p_mid[k], -1e-14 * scale) << "tensor " << k;
+        EXPECT_GE(p_mid[k] - p_min[k], -1e-14 * scale) << "tensor " << k;
+    }
+}
+
+TEST(PRINCIPAL_STRESSES, TWO_DIMENSIONS)
+{
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> uniform(-1e8, 1e8);
+    std::uniform_real_distribution<double> angle(0, M_PI);
+
+    vector<double> s_xx, s_yy, s_xy, expected_max, expected_min;
+    for (int n = 0; n < 200; n++) {
+        const double p1 = n == 0 ? 3e7 : uniform(rng);
+        const double p2 = n == 0 ? 3e7 : uniform(rng);
+        const double theta = angle(rng);
+        const double c = cos(theta);
+        const double s = sin(theta);
+        s_xx.push_back(c * c * p1 + s * s * p2);
+        s_yy.push_back(s * s * p1 + c * c * p2);
+        s_xy.push_back(c * s * (p1 - p2));
+        expected_max.push_back(std::max(p1, p2));
+        expected_min.push_back(std::min(p1, p2));
+    }
+
+    const int n = s_xx.size();
+    vector<double> p_max(n), p_min(n);
+    principalStresses2d(n, s_xx.data(), s_yy.data(), s_xy.data(),
+                        p_max.data(), p_min.data());
+
+    for (int k = 0; k < n; k++) {
+        const double scale = std::max(fabs(expected_max[k]),
+                                      fabs(expected_min[k]));
+        EXPECT_NEAR(expected_max[k], p_max[k], 1e-12 * scale) << "tensor " << k;
+        EXPECT_NEAR(expected_min[k], p_min[k], 1e-12 * scale) << "tensor " << k;
+    }
+}
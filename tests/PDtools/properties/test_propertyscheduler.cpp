@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include <PDtools/CalculateProperties/calculateproperty.h>
+#include <PDtools/CalculateProperties/propertyscheduler.h>
+
+using namespace PDtools;
+
+namespace {
+// A property that only records what the scheduler tells it
+class TestProperty : public CalculateProperty {
+public:
+    TestProperty(const string &type, const vector<string> &dependencies)
+        : CalculateProperty(type) {
+        m_dependencies = dependencies;
+    }
+    virtual void setPresentDependencies(const vector<string> &types) {
+        presentTypes = types;
+    }
+    virtual void update() {}
+
+    vector<string> presentTypes;
+};
+
+vector<string> scheduledTypes(PropertyScheduler &scheduler, const int step,
+                              const bool all = false) {
+    vector<string> types;
+    for (const int p : scheduler.schedule(step, all)) {
+        types.push_back(scheduler.properties()[p]->type);
+    }
+    return types;
+}
+}
+
+TEST(PROPERTY_SCHEDULER, DEPENDENCIES_COME_FIRST)
+{
+    // Principal stress from stress from strain, damage on its own, and a
+    // dependency on a property that is not computed
+    TestProperty principal("principal_stress", {"stress", "strain"});
+    TestProperty damage("damage", {});
+    TestProperty stress("stress", {"strain", "missing"});
+    TestProperty strain("strain", {});
+
+    PropertyScheduler scheduler;
+    scheduler.setProperties({&principal, &damage, &stress, &strain});
+
+    const vector<CalculateProperty *> &properties = scheduler.properties();
+    ASSERT_EQ(4u, properties.size());
+    EXPECT_EQ("strain", properties[0]->type);
+    EXPECT_EQ("stress", properties[1]->type);
+    EXPECT_EQ("principal_stress", properties[2]->type);
+    EXPECT_EQ("damage", properties[3]->type);
+
+    EXPECT_EQ(vector<string>({"stress", "strain"}), principal.presentTypes);
+    EXPECT_EQ(vector<string>({"strain"}), stress.presentTypes);
+    EXPECT_TRUE(damage.presentTypes.empty());
+}
+
+TEST(PROPERTY_SCHEDULER, CYCLIC_DEPENDENCIES_THROW)
+{
+    TestProperty a("a", {"b"});
+    TestProperty b("b", {"c"});
+    TestProperty c("c", {"a"});
+
+    PropertyScheduler scheduler;
+    EXPECT_ANY_THROW(scheduler.setProperties({&a, &b, &c}));
+}
+
+TEST(PROPERTY_SCHEDULER, ONLY_THE_PROPERTIES_READ_ON_THE_STEP)
+{
+    // The stress is read every 10 steps, the principal stress computed from
+    // it every 4 and the damage every 3
+    TestProperty principal("principal_stress", {"stress"});
+    TestProperty stress("stress", {});
+    TestProperty damage("damage", {});
+    principal.addConsumer(4);
+    stress.addConsumer(10);
+    damage.addConsumer(3);
+
+    PropertyScheduler scheduler;
+    scheduler.setProperties({&principal, &stress, &damage});
+
+    EXPECT_EQ(vector<string>({"stress", "principal_stress", "damage"}),
+              scheduledTypes(scheduler, 0));
+    EXPECT_TRUE(scheduledTypes(scheduler, 1).empty());
+    EXPECT_EQ(vector<string>({"damage"}), scheduledTypes(scheduler, 3));
+    EXPECT_EQ(vector<string>({"stress", "principal_stress"}),
+              scheduledTypes(scheduler, 4));
+    EXPECT_EQ(vector<string>({"stress"}), scheduledTypes(scheduler, 10));
+    EXPECT_EQ(vector<string>({"stress", "principal_stress", "damage"}),
+              scheduledTypes(scheduler, 11, true));
+
+    // The stress is needed for a step the principal stress is read on
+    const int p_stress = 0;
+    EXPECT_EQ("stress", scheduler.properties()[p_stress]->type);
+    EXPECT_TRUE(scheduler.needed(p_stress, 8));
+    EXPECT_TRUE(scheduler.needed(p_stress, 10));
+    EXPECT_FALSE(scheduler.needed(p_stress, 9));
+}
+
+TEST(PROPERTY_SCHEDULER, ONCE_PER_STEP_AND_STATE)
+{
+    TestProperty stress("stress", {});
+    TestProperty damage("damage", {});
+
+    PropertyScheduler scheduler;
+    scheduler.setProperties({&stress, &damage});
+
+    EXPECT_EQ(2u, scheduledTypes(scheduler, 5).size());
+    EXPECT_TRUE(scheduledTypes(scheduler, 5).empty());
+    EXPECT_TRUE(scheduledTypes(scheduler, 5, true).empty());
+
+    // E.g. a relaxation of an ADR step evaluated the forces again
+    scheduler.stateChanged();
+    EXPECT_EQ(2u, scheduledTypes(scheduler, 5).size());
+    EXPECT_EQ(2u, scheduledTypes(scheduler, 6).size());
+}
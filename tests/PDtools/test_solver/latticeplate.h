@@ -0,0 +1,191 @@
+#ifndef LATTICEPLATE_H
+#define LATTICEPLATE_H
+
+#include <PDtools.h>
+#include <PDtools/CalculateProperties/calculateproperties.h>
+#include <PDtools/Force/forces.h>
+#include <PDtools/Modfiers/modifiers.h>
+#include <PDtools/Particles/latticegenerator.h>
+#include <PDtools/PdFunctions/pdfunctions.h>
+#include <PDtools/SavePdData/savepddata.h>
+#include <PDtools/Solver/solvers.h>
+
+#include <memory>
+
+namespace PDtools {
+//------------------------------------------------------------------------------
+// A square plate of a 2d square lattice with the bond force, set up as
+// PdSolver::initialize() does it and pulled apart along x by an initial
+// velocity field. For comparing runs of the solvers on the same system.
+//
+// The solver set up on the plate owns the forces, the fracture criterion and
+// the properties, and must be destroyed before the plate.
+//------------------------------------------------------------------------------
+class LatticePlate {
+public:
+  const int dim = 2;
+  const double E = 1;
+  const double nu = 1. / 3.;
+  const double rho = 1;
+  double lc;
+  double delta;
+  double h;
+
+  PD_Particles particles;
+  Grid grid;
+  vector<Force *> forces;
+  std::unique_ptr<SavePdData> saveParticles;
+
+  LatticePlate(const int nPerSide, const double strainRate) {
+    lc = 1. / nPerSide;
+    delta = 3 * lc;
+    h = lc;
+
+    vector<pair<double, double>> domain;
+    vector<pair<double, double>> box;
+    for (int d = 0; d < M_DIM; d++) {
+      if (d < dim) {
+        const double padding = delta + lc;
+        domain.push_back(pair<double, double>(-padding, 1 + padding));
+        box.push_back(pair<double, double>(0, 1));
+      } else {
+        domain.push_back(pair<double, double>(-0.5 * h, 0.5 * h));
+        box.push_back(pair<double, double>(-0.5 * h, 0.5 * h));
+      }
+    }
+
+    const arma::ivec3 periodicBoundaries = {0, 0, 0};
+    grid = Grid(domain, 1.45 * (delta + 0.5 * lc), periodicBoundaries);
+    grid.setIdAndCores(0, 1);
+    grid.dim(dim);
+    grid.initialize();
+    grid.setMyGridpoints();
+    grid.setInitialPositionScaling(1.0);
+
+    LatticeGenerator lattice(LatticeGenerator::Square, lc, box);
+    particles = lattice.generate(grid);
+
+    mat &r0 = particles.r0();
+    const mat &r = particles.r();
+    mat &v = particles.v();
+    v.zeros();
+    for (unsigned int i = 0; i < particles.nParticles(); i++) {
+      for (int d = 0; d < M_DIM; d++) {
+        r0(i, d) = r(i, d);
+      }
+      v(i, 0) = strainRate * (r(i, 0) - 0.5);
+    }
+
+    particles.registerParameter("rho", rho);
+    particles.registerParameter("s0", 1);
+    particles.registerParameter("radius");
+    calculateRadius(particles, dim, h);
+
+    grid.clearParticles();
+    grid.placeParticlesInGrid(particles);
+#ifdef USE_MPI
+    const vector<string> ghostParameters = {"volume", "radius", "groupId"};
+    for (const string &param : ghostParameters) {
+      particles.addGhostParameter(param);
+    }
+    exchangeGhostParticles(grid, particles);
+#endif
+    setPdConnections(particles, grid, delta, lc);
+    grid.clearGhostParticles();
+#if USE_MPI
+    exchangeInitialGhostParticles(grid, particles);
+#endif
+    cleanUpPdConnections(particles);
+
+    particles.registerPdParameter("volumeScaling", 1, BondData::Float);
+    applyVolumeCorrection(particles, delta, lc, dim);
+    setPD_N3L(particles);
+  }
+
+  // The integrator with the bond force, or the forces added to forces
+  // before, the fracture criterion if any, the properties read by it and by
+  // the output, and the output of saveParameters to savePath every
+  // saveInterval steps
+  void setup(TimeIntegrator &integrator, const int nSteps, const double dt,
+             const int saveInterval, const string &savePath,
+             const vector<string> &saveParameters,
+             Modifier *fracture = nullptr) {
+    if (forces.empty())
+      forces.push_back(new PD_bondForce(particles));
+    for (Force *force : forces) {
+      force->numericalInitialization(false);
+      force->initialize(E, nu, delta, dim, h, lc);
+    }
+
+    vector<pair<string, int>> neededProperties;
+    if (fracture != nullptr) {
+      fracture->setDim(dim);
+      fracture->setGrid(&grid);
+      fracture->setParticles(particles);
+      fracture->registerParticleParameters();
+      fracture->initialize();
+      for (const auto &property : fracture->neededProperties())
+        neededProperties.push_back(property);
+    }
+
+    saveParticles.reset(new SavePdData(saveParameters));
+    saveParticles->setDim(dim);
+    saveParticles->setRankAndCores(0, 1);
+    saveParticles->setUpdateFrquency(saveInterval);
+    saveParticles->setGrid(&grid);
+    saveParticles->setSavePath(savePath);
+    saveParticles->setParticles(&particles);
+    saveParticles->setForces(forces);
+    saveParticles->initialize();
+    for (const auto &property : saveParticles->neededProperties())
+      neededProperties.push_back(property);
+
+    // As PdSolver, one property of each type with a consumer per need
+    vector<CalculateProperty *> properties;
+    for (const auto &need : neededProperties) {
+      CalculateProperty *property = nullptr;
+      for (CalculateProperty *p : properties) {
+        if (p->type == need.first)
+          property = p;
+      }
+      if (property == nullptr) {
+        if (need.first == "stress")
+          property = new CalculateStressStrain(forces, E, nu, delta, false);
+        else if (need.first == "damage")
+          property = new CalculateDamage(delta);
+        else
+          continue;
+        property->setUpdateFrquency(need.second);
+        property->setDim(dim);
+        property->setParticles(particles);
+        property->initialize();
+        properties.push_back(property);
+      }
+      property->addConsumer(need.second);
+    }
+
+#ifdef USE_MPI
+    for (Force *force : forces) {
+      for (const string &param : force->ghostDependencies())
+        particles.addGhostParameter(param);
+    }
+#endif
+
+    integrator.setDim(dim);
+    integrator.setRankAndCores(0, 1);
+    integrator.setMainGrid(grid);
+    integrator.setParticles(particles);
+    integrator.setSteps(nSteps);
+    integrator.setDt(dt);
+    for (Force *force : forces)
+      integrator.addForce(force);
+    if (fracture != nullptr)
+      integrator.addSpModifier(fracture);
+    integrator.setSaveInterval(saveInterval);
+    integrator.setSaveParticles(saveParticles.get());
+    integrator.setCalculateProperties(properties);
+  }
+};
+//------------------------------------------------------------------------------
+}
+#endif // LATTICEPLATE_H
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include "latticeplate.h"
+
+#include <map>
+
+using namespace PDtools;
+
+namespace {
+// Runs the plate to the same end time and saves on the same simulated times
+// with a fixed dt, and with adaptive steps of up to twice that dt
+void runPlate(const string &savePath, const bool adaptive, const double dt,
+              const int nSteps, const int saveInterval) {
+    LatticePlate plate(20, 0.05);
+    VelocityVerletIntegrator integrator;
+    const vector<string> saveParameters = {"id", "x", "y", "s_xx", "damage"};
+    plate.setup(integrator, nSteps, dt, saveInterval, savePath,
+                saveParameters);
+    if (adaptive)
+        integrator.setAdaptiveDt(0.5 * dt, 2 * dt, 0.8, 2.0, 0., 1);
+    integrator.solve();
+}
+
+// The saved field by id
+std::map<int, double> savedField(const string &path, const string &field) {
+    PD_Particles particles = load_pd(path);
+    const ivec &colToId = particles.colToId();
+    const int index = particles.getParamId(field);
+    const ParticleData &data = particles.data();
+
+    std::map<int, double> values;
+    for (unsigned int i = 0; i < particles.nParticles(); i++) {
+        values[colToId(i)] = data(i, index);
+    }
+    return values;
+}
+}
+
+TEST(ADAPTIVE_DT, SAVED_FIELDS_MATCH_FIXED_DT)
+{
+    // The adaptive steps do not land on the step multiples of the output,
+    // every saved frame must still have its properties computed for it
+    const double dt = 0.01 * (1. / 20);
+    const int nSteps = 40;
+    const int saveInterval = 5;
+    const string fixedPath = string(TEST_SAVE_PATH) + "/fixedDt";
+    const string adaptivePath = string(TEST_SAVE_PATH) + "/adaptiveDt";
+
+    runPlate(fixedPath, false, dt, nSteps, saveInterval);
+    runPlate(adaptivePath, true, dt, nSteps, saveInterval);
+
+    for (int step = saveInterval; step <= nSteps; step += saveInterval) {
+        const string frame = "/" + std::to_string(step) + ".lmp";
+        for (const string field : {"s_xx", "damage"}) {
+            const std::map<int, double> fixed =
+                savedField(fixedPath + frame, field);
+            const std::map<int, double> adaptive =
+                savedField(adaptivePath + frame, field);
+            ASSERT_EQ(fixed.size(), adaptive.size());
+
+            double scale = 1e-12;
+            for (const auto &value : fixed)
+                scale = std::max(scale, std::fabs(value.second));
+
+            for (const auto &value : fixed) {
+                ASSERT_EQ(1u, adaptive.count(value.first));
+                EXPECT_NEAR(value.second, adaptive.at(value.first),
+                            1e-2 * scale)
+                    << field << " of particle " << value.first
+                    << " at step " << step;
+            }
+        }
+    }
+}
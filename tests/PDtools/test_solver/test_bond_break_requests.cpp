@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+#include "latticeplate.h"
+
+#include <set>
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif
+
+using namespace PDtools;
+
+namespace {
+// More threads than particle loops need on a single core machine, so the
+// requests and maxima are made by several threads
+class ThreadCount {
+public:
+    ThreadCount(const int nThreads) {
+#ifdef USE_OPENMP
+        m_nThreads = omp_get_max_threads();
+        omp_set_num_threads(nThreads);
+#else
+        (void)nThreads;
+#endif
+    }
+    ~ThreadCount() {
+#ifdef USE_OPENMP
+        omp_set_num_threads(m_nThreads);
+#endif
+    }
+
+private:
+    int m_nThreads = 1;
+};
+
+// Breaks the bonds of the particles in the ids from their own end, and
+// requests the break of the other end, as a criterion that can not write
+// to the connection lists of the neighbours in the parallel particle loop
+class RequestingModifier : public Modifier {
+public:
+    std::set<int> ids;
+    int nApplied = 0;
+
+    void evaluateStepOne(const int id_i, const int i) {
+        if (ids.count(id_i) == 0)
+            return;
+
+        BondList &PDconnections = m_particles->pdConnections(id_i);
+        m_particles->forEachConnectedBond(i, [&](const int l_j) {
+            auto &con = PDconnections[l_j];
+            m_particles->breakBond(id_i, con);
+            requestBondBreak(con.first, id_i);
+        });
+    }
+
+    void evaluateStepOnePost() { nApplied = applyBondBreakRequests(); }
+};
+
+bool connected(PD_Particles &particles, const int id_i, const int id_j) {
+    const int indexConnected = particles.getPdParamId("connected");
+    for (auto &con : particles.pdConnections(id_i)) {
+        if (con.first == id_j)
+            return con.second[indexConnected] > 0.5;
+    }
+    ADD_FAILURE() << "no bond from " << id_i << " to " << id_j;
+    return false;
+}
+
+// The connected bits against the flags of the bonds
+void expectBitsMatchFlags(PD_Particles &particles) {
+    const ivec &colToId = particles.colToId();
+    const int indexConnected = particles.getPdParamId("connected");
+    for (unsigned int i = 0; i < particles.nParticles(); i++) {
+        const BondList &PDconnections = particles.pdConnections(colToId(i));
+        int nConnected = 0;
+        for (const auto &con : PDconnections) {
+            if (con.second[indexConnected] > 0.5)
+                nConnected++;
+        }
+        EXPECT_EQ(nConnected, particles.nConnectedBonds(i))
+            << "particle " << colToId(i);
+    }
+}
+}
+
+TEST(BOND_BREAK_REQUESTS, NEIGHBOUR_BREAK_IS_APPLIED_SYMMETRICALLY)
+{
+    ThreadCount threads(4);
+    LatticePlate plate(16, 0);
+    PD_Particles &particles = plate.particles;
+
+    RequestingModifier modifier;
+    modifier.setDim(plate.dim);
+    modifier.setGrid(&plate.grid);
+    modifier.setParticles(particles);
+    particles.buildBondCache();
+
+    // Two neighbouring particles and one far from them, so some of the
+    // requests are for bonds already broken from the other end
+    const ivec &colToId = particles.colToId();
+    const int nParticles = particles.nParticles();
+    const int id_a = colToId(nParticles / 2);
+    const int id_b = particles.pdConnections(id_a)[0].first;
+    const int id_c = colToId(0);
+    modifier.ids = {id_a, id_b, id_c};
+
+    int nRequested = 0;
+    for (const int id : modifier.ids) {
+        for (const auto &con : particles.pdConnections(id)) {
+            if (modifier.ids.count(con.first) == 0)
+                nRequested++;
+        }
+    }
+
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int i = 0; i < nParticles; i++) {
+        modifier.evaluateStepOne(colToId(i), i);
+    }
+    modifier.evaluateStepOnePost();
+
+    // Only the bonds to the other particles are broken by the requests, the
+    // bonds between the listed particles were broken from both ends already
+    EXPECT_EQ(nRequested, modifier.nApplied);
+    for (const int id : modifier.ids) {
+        for (const auto &con : particles.pdConnections(id)) {
+            EXPECT_FALSE(connected(particles, id, con.first));
+            EXPECT_FALSE(connected(particles, con.first, id))
+                << "bond from " << con.first << " to " << id;
+        }
+    }
+    expectBitsMatchFlags(particles);
+
+    // A second step has nothing to break
+    modifier.evaluateStepOne(id_a, particles.getIdToCol_v()[id_a]);
+    modifier.evaluateStepOnePost();
+    EXPECT_EQ(0, modifier.nApplied);
+}
+
+TEST(ADR_FRACTURE, THREAD_MAXIMA_MERGE_TO_THE_SERIAL_MAXIMUM)
+{
+    ThreadCount threads(4);
+    LatticePlate plate(16, 0);
+    PD_Particles &particles = plate.particles;
+    const int indexStretch = particles.registerPdParameter("stretch");
+    const int indexS0 = particles.getParamId("s0");
+
+    ADRfracture fracture(0.25);
+    fracture.setDim(plate.dim);
+    fracture.setGrid(&plate.grid);
+    fracture.setParticles(particles);
+    fracture.registerParticleParameters();
+    fracture.initialize();
+    particles.buildBondCache();
+
+    // Stretches beyond the critical stretch spread over the columns, with
+    // the largest one in the first, a middle and the last column, so the
+    // threads find it in different columns
+    const ivec &colToId = particles.colToId();
+    const int nParticles = particles.nParticles();
+    const double s0 = 0.01;
+    const double s_max = 0.05;
+    for (int i = 0; i < nParticles; i++) {
+        particles.data()(i, indexS0) = s0;
+        BondList &PDconnections = particles.pdConnections(colToId(i));
+        for (unsigned int l_j = 0; l_j < PDconnections.size(); l_j++) {
+            double s = 0;
+            if ((i + l_j) % 7 == 0)
+                s = s0 * (1 + 0.01 * ((i * 13 + l_j) % 97));
+            PDconnections[l_j].second[indexStretch] = s;
+        }
+    }
+    const vector<int> maxCols = {nParticles - 1, nParticles / 2, 0};
+    for (const int i : maxCols) {
+        BondList &PDconnections = particles.pdConnections(colToId(i));
+        PDconnections[PDconnections.size() - 1].second[indexStretch] = s_max;
+        PDconnections[PDconnections.size() - 2].second[indexStretch] = s_max;
+    }
+
+    // The first maximum in the order of the columns and bonds
+    const int id_expected = colToId(0);
+    const int l_expected = particles.pdConnections(id_expected).size() - 2;
+
+    fracture.evaluateStepOne();
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int i = 0; i < nParticles; i++) {
+        fracture.evaluateStepOne(colToId(i), i);
+    }
+    fracture.evaluateStepOnePost();
+
+    EXPECT_EQ(id_expected, fracture.maxStretchBond().first);
+    EXPECT_EQ(l_expected, fracture.maxStretchBond().second);
+
+    fracture.evaluateStepTwo();
+    EXPECT_TRUE(fracture.state());
+    EXPECT_EQ(-1, fracture.maxStretchBond().first);
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include "latticeplate.h"
+
+using namespace PDtools;
+
+namespace {
+// The column of the local particle closest to (x, y)
+int closestColumn(PD_Particles &particles, const double x, const double y) {
+    const mat &r = particles.r();
+    int closest = 0;
+    double dr2_min = std::numeric_limits<double>::max();
+    for (unsigned int i = 0; i < particles.nParticles(); i++) {
+        const double dr2 = pow(r(i, 0) - x, 2) + pow(r(i, 1) - y, 2);
+        if (dr2 < dr2_min) {
+            dr2_min = dr2;
+            closest = i;
+        }
+    }
+    return closest;
+}
+
+// Breaks the first nBonds connected bonds of the particle at both ends
+void breakBonds(PD_Particles &particles, const int id_i, const int nBonds) {
+    const int indexConnected = particles.getPdParamId("connected");
+    int nBroken = 0;
+    for (auto &con : particles.pdConnections(id_i)) {
+        if (nBroken == nBonds)
+            break;
+        if (con.second[indexConnected] <= 0.5)
+            continue;
+        for (auto &con_j : particles.pdConnections(con.first)) {
+            if (con_j.first == id_i)
+                particles.breakBond(con.first, con_j);
+        }
+        particles.breakBond(id_i, con);
+        nBroken++;
+    }
+}
+
+// The weights of the damage and the weighted volume of the LPS force, kept
+// up to date from the bond events, against the sums over the bonds
+void expectSameAsRecomputed(PD_Particles &particles, const double delta) {
+    const ivec &colToId = particles.colToId();
+    const IdToColMap &idToCol = particles.getIdToCol_v();
+    const ParticleData &data = particles.data();
+    const int indexVolume = particles.getParamId("volume");
+    const int indexInitialWeight = particles.getParamId("initialWeight");
+    const int indexConnectedWeight = particles.getParamId("connectedWeight");
+    const int indexMass = particles.getParamId("LPS_mass");
+    const int indexConnected = particles.getPdParamId("connected");
+    const int indexVolumeScaling = particles.getPdParamId("volumeScaling");
+    const int indexDr0 = particles.getPdParamId("dr0");
+
+    for (unsigned int i = 0; i < particles.nParticles(); i++) {
+        const int id_i = colToId(i);
+        double initialWeight = 0;
+        double connectedWeight = 0;
+        double m = 0;
+        for (const auto &con : particles.pdConnections(id_i)) {
+            const int j = idToCol[con.first];
+            ASSERT_GE(j, 0) << "bond of " << id_i << " to " << con.first;
+
+            const double weight =
+                data(j, indexVolume) * con.second[indexVolumeScaling];
+            const double dr0 = con.second[indexDr0];
+            initialWeight += weight;
+            if (con.second[indexConnected] > 0.5) {
+                connectedWeight += weight;
+                m += delta / dr0 * dr0 * dr0 * weight;
+            }
+        }
+        EXPECT_NEAR(initialWeight, data(i, indexInitialWeight),
+                    1e-12 * initialWeight) << "particle " << id_i;
+        EXPECT_NEAR(connectedWeight, data(i, indexConnectedWeight),
+                    1e-12 * initialWeight) << "particle " << id_i;
+        EXPECT_NEAR(1. / m, data(i, indexMass), 1e-10 / m)
+            << "particle " << id_i;
+    }
+}
+}
+
+TEST(BOND_EVENTS, INCREMENTAL_UPDATES_MATCH_RECOMPUTE)
+{
+    LatticePlate plate(16, 0);
+    PD_Particles &particles = plate.particles;
+
+    CalculateDamage damage(plate.delta);
+    damage.setDim(plate.dim);
+    damage.setParticles(particles);
+    damage.initialize();
+
+    PD_LPS lps(particles);
+    lps.initialize(plate.E, plate.nu, plate.delta, plate.dim, plate.h,
+                   plate.lc);
+
+    MohrCoulombNodeSplit split(30, 1, 1);
+    split.setDim(plate.dim);
+    split.setParticles(particles);
+    split.registerParticleParameters();
+    split.initialize();
+    particles.buildBondCache();
+
+    // Breaks published as events
+    const int i_broken = closestColumn(particles, 0.5, 0.5);
+    breakBonds(particles, particles.colToId()(i_broken), 4);
+    particles.publishBondBreaks();
+    expectSameAsRecomputed(particles, plate.delta);
+
+    // A split of a particle with broken bonds that are not yet published
+    const int i_split = closestColumn(particles, 0.3, 0.5);
+    const int id_split = particles.colToId()(i_split);
+    breakBonds(particles, id_split, 3);
+    particles.data()(i_split, particles.getParamId("s_xx")) = 2;
+
+    const int nParticles = particles.nParticles();
+    split.evaluateStepOne();
+    ASSERT_EQ(nParticles + 1, (int)particles.nParticles());
+    const IdToColMap &idToCol = particles.getIdToCol_v();
+    EXPECT_LT(idToCol[id_split], 0);
+    expectSameAsRecomputed(particles, plate.delta);
+}
@@ -0,0 +1,222 @@
+#include <gtest/gtest.h>
+#include "latticeplate.h"
+
+#include <functional>
+#include <map>
+#include <set>
+
+using namespace PDtools;
+
+namespace {
+typedef std::function<double(double, double, double)> BondMeasure;
+
+// A smooth stress field on the plate, tensile enough along x that the
+// largest principal and von Mises stresses of some of the bonds exceed 1.3
+void setStressField(PD_Particles &particles) {
+    const mat &r = particles.r();
+    ParticleData &data = particles.data();
+    const int indexSxx = particles.getParamId("s_xx");
+    const int indexSyy = particles.getParamId("s_yy");
+    const int indexSxy = particles.getParamId("s_xy");
+    for (unsigned int i = 0; i < particles.nParticles(); i++) {
+        const double x = r(i, 0);
+        const double y = r(i, 1);
+        data(i, indexSxx) = 1 + 0.5 * sin(7 * x) * cos(5 * y);
+        data(i, indexSyy) = 0.5 * cos(3 * x + 2 * y);
+        data(i, indexSxy) = 0.3 * sin(11 * x * y);
+    }
+}
+
+void updatePrincipalStresses(LatticePlate &plate) {
+    CalculatePrincipalStress principalStress;
+    principalStress.setDim(plate.dim);
+    principalStress.setParticles(plate.particles);
+    principalStress.setPresentDependencies({"stress"});
+    principalStress.initialize();
+    principalStress.update();
+}
+
+void setup(Modifier &fracture, LatticePlate &plate) {
+    fracture.setDim(plate.dim);
+    fracture.setGrid(&plate.grid);
+    fracture.setParticles(plate.particles);
+    fracture.registerParticleParameters();
+    fracture.initialize();
+    setStressField(plate.particles);
+    updatePrincipalStresses(plate);
+    plate.particles.buildBondCache();
+}
+
+// The bonds (id_i, id_j) broken by a two-ended 2D criterion, as the
+// criteria evaluated them before BondFractureCriterion: each end of a bond
+// computes the bond stress and breaks its own direction. The bonds within
+// the rounding of the threshold are returned as undecided.
+void twoEndedBreaks(PD_Particles &particles, const BondMeasure &measure,
+                    const double threshold,
+                    std::set<pair<int, int>> &broken,
+                    std::set<pair<int, int>> &undecided) {
+    const ivec &colToId = particles.colToId();
+    const IdToColMap &idToCol = particles.getIdToCol_v();
+    const ParticleData &data = particles.data();
+    const int indexSxx = particles.getParamId("s_xx");
+    const int indexSyy = particles.getParamId("s_yy");
+    const int indexSxy = particles.getParamId("s_xy");
+
+    for (unsigned int i = 0; i < particles.nParticles(); i++) {
+        const int id_i = colToId(i);
+        for (const auto &con : particles.pdConnections(id_i)) {
+            const int j = idToCol[con.first];
+            const double sx = 0.5 * (data(i, indexSxx) + data(j, indexSxx));
+            const double sy = 0.5 * (data(i, indexSyy) + data(j, indexSyy));
+            const double sxy = 0.5 * (data(i, indexSxy) + data(j, indexSxy));
+            const double s = measure(sx, sy, sxy);
+            const pair<int, int> bond(id_i, con.first);
+            if (fabs(s - threshold) < 1e-9 * threshold)
+                undecided.insert(bond);
+            else if (s >= threshold)
+                broken.insert(bond);
+        }
+    }
+}
+
+// The bonds (id_i, id_j) broken after the criterion ran on the plate
+std::set<pair<int, int>> brokenBonds(PD_Particles &particles) {
+    const ivec &colToId = particles.colToId();
+    const int indexConnected = particles.getPdParamId("connected");
+    std::set<pair<int, int>> broken;
+    for (unsigned int i = 0; i < particles.nParticles(); i++) {
+        const int id_i = colToId(i);
+        int nConnected = 0;
+        for (const auto &con : particles.pdConnections(id_i)) {
+            if (con.second[indexConnected] <= 0.5)
+                broken.insert(pair<int, int>(id_i, con.first));
+            else
+                nConnected++;
+        }
+        EXPECT_EQ(nConnected, particles.nConnectedBonds(i))
+            << "particle " << id_i;
+    }
+    return broken;
+}
+
+void runStepOne(Modifier &fracture, PD_Particles &particles) {
+    const ivec &colToId = particles.colToId();
+    const int nParticles = particles.nParticles();
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int i = 0; i < nParticles; i++) {
+        fracture.evaluateStepOne(colToId(i), i);
+    }
+    fracture.evaluateStepOnePost();
+}
+
+// Both directions of the broken bonds, and the same bonds as the two-ended
+// criterion, apart from the undecided ones
+void expectSameAsTwoEnded(PD_Particles &particles,
+                          const std::set<pair<int, int>> &expected,
+                          const std::set<pair<int, int>> &undecided) {
+    const std::set<pair<int, int>> broken = brokenBonds(particles);
+    EXPECT_FALSE(expected.empty());
+    for (const auto &bond : broken) {
+        const pair<int, int> reverse(bond.second, bond.first);
+        EXPECT_EQ(1u, broken.count(reverse))
+            << "bond " << bond.first << "-" << bond.second;
+        if (undecided.count(bond) == 0)
+            EXPECT_EQ(1u, expected.count(bond))
+                << "bond " << bond.first << "-" << bond.second;
+    }
+    for (const auto &bond : expected) {
+        EXPECT_EQ(1u, broken.count(bond))
+            << "bond " << bond.first << "-" << bond.second;
+    }
+}
+
+// Records the bonds the criterion is evaluated for, without the bounds of
+// mayBreak() so that every bond is
+class RecordingVonMises : public VonMisesFracture {
+public:
+    std::vector<pair<int, int>> evaluated;
+
+    RecordingVonMises(const double sigma_y) : VonMisesFracture(sigma_y) {}
+
+    bool mayBreak(const int i, const int j) {
+        (void)i;
+        (void)j;
+        return true;
+    }
+
+    bool evaluateBond(const int i, const int j, const BondStress &bondStress) {
+        const ivec &colToId = m_particles->colToId();
+#ifdef USE_OPENMP
+#pragma omp critical(recordingVonMises)
+#endif
+        evaluated.push_back(pair<int, int>(colToId(i), colToId(j)));
+        return VonMisesFracture::evaluateBond(i, j, bondStress);
+    }
+};
+}
+
+TEST(BOND_FRACTURE_CRITERION, EVERY_BOND_IS_EVALUATED_ONCE_FROM_THE_LOWER_ID)
+{
+    LatticePlate plate(16, 0);
+    PD_Particles &particles = plate.particles;
+    RecordingVonMises fracture(1.3);
+    setup(fracture, plate);
+
+    size_t nBonds = 0;
+    for (unsigned int i = 0; i < particles.nParticles(); i++) {
+        nBonds += particles.pdConnections(particles.colToId()(i)).size();
+    }
+
+    runStepOne(fracture, particles);
+
+    std::set<pair<int, int>> unique;
+    for (const auto &bond : fracture.evaluated) {
+        EXPECT_LT(bond.first, bond.second);
+        EXPECT_TRUE(unique.insert(bond).second)
+            << "bond " << bond.first << "-" << bond.second << " twice";
+    }
+    EXPECT_EQ(nBonds, 2 * fracture.evaluated.size());
+}
+
+TEST(BOND_FRACTURE_CRITERION, MOHR_COULOMB_MATCHES_TWO_ENDED)
+{
+    LatticePlate plate(16, 0);
+    PD_Particles &particles = plate.particles;
+    const double T = 1.3;
+    MohrCoulombFracture fracture(30, 1, T);
+    setup(fracture, plate);
+
+    // The tensile check of the old criterion, the shear check was disabled
+    const BondMeasure p_max = [](double sx, double sy, double sxy) {
+        const double first = 0.5 * (sx + sy);
+        const double second = sqrt(0.25 * (sx - sy) * (sx - sy) + sxy * sxy);
+        return first + second;
+    };
+    std::set<pair<int, int>> expected;
+    std::set<pair<int, int>> undecided;
+    twoEndedBreaks(particles, p_max, T, expected, undecided);
+
+    runStepOne(fracture, particles);
+    expectSameAsTwoEnded(particles, expected, undecided);
+}
+
+TEST(BOND_FRACTURE_CRITERION, VON_MISES_MATCHES_TWO_ENDED)
+{
+    LatticePlate plate(16, 0);
+    PD_Particles &particles = plate.particles;
+    const double sigma_y = 1.3;
+    VonMisesFracture fracture(sigma_y);
+    setup(fracture, plate);
+
+    const BondMeasure s_vm2 = [](double sx, double sy, double sxy) {
+        return sx * sx - sx * sy + sy * sy + 3 * sxy * sxy;
+    };
+    std::set<pair<int, int>> expected;
+    std::set<pair<int, int>> undecided;
+    twoEndedBreaks(particles, s_vm2, sigma_y * sigma_y, expected, undecided);
+
+    runStepOne(fracture, particles);
+    expectSameAsTwoEnded(particles, expected, undecided);
+}
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include "latticeplate.h"
+
+#include <map>
+#include <memory>
+
+using namespace PDtools;
+
+namespace {
+struct PlateState {
+    std::map<int, vector<double>> particles;
+    int nBroken = 0;
+};
+
+// Runs the plate with velocity verlet and the critical stretch criterion,
+// or with an ensemble the ensemble integrator with fracture enabled, and
+// returns the positions, velocities and forces by id, and the bonds broken
+// (of member 0 for the ensemble)
+PlateState runPlate(const bool ensemble, const double strainRate,
+                    const double s0) {
+    LatticePlate plate(16, strainRate);
+    plate.particles.setParameter("s0", s0);
+    std::unique_ptr<VelocityVerletIntegrator> integrator;
+    Modifier *fracture = nullptr;
+    if (ensemble) {
+        // The other members are stiffer, tougher and loaded faster, so
+        // they break differently from member 0
+        EnsembleVerletIntegrator *members =
+                new EnsembleVerletIntegrator({1, 1.5}, {1, 0.8}, {1, 2});
+        members->enableFracture();
+        integrator.reset(members);
+    } else {
+        // Without the softening the critical stretch stays s0
+        integrator.reset(new VelocityVerletIntegrator());
+        fracture = new PmbFracture(0);
+    }
+    const string savePath = string(TEST_SAVE_PATH) +
+            (ensemble ? "/ensemble" : "/verlet");
+    plate.setup(*integrator, 60, 0.01 * plate.lc, 20, savePath,
+                {"id", "x", "y", "damage"}, fracture);
+    integrator->solve();
+
+    PlateState state;
+    PD_Particles &particles = plate.particles;
+    const ivec &colToId = particles.colToId();
+    const mat &r = particles.r();
+    const mat &v = particles.v();
+    const mat &F = particles.F();
+    const int indexConnected = particles.getPdParamId("connected");
+    for (unsigned int i = 0; i < particles.nParticles(); i++) {
+        vector<double> values;
+        for (int d = 0; d < plate.dim; d++) {
+            values.push_back(r(i, d));
+            values.push_back(v(i, d));
+            values.push_back(F(i, d));
+        }
+        state.particles[colToId(i)] = values;
+
+        for (const auto &con : particles.pdConnections(colToId(i))) {
+            if (con.second[indexConnected] <= 0.5)
+                state.nBroken++;
+        }
+    }
+    return state;
+}
+}
+
+TEST(ENSEMBLE, MEMBER_0_MATCHES_A_PLAIN_RUN)
+{
+    // The ensemble evaluates the bond force and the criterion itself, the
+    // stretch is rounded differently from the bond force
+    const PlateState expected = runPlate(false, 1.0, 0.002);
+    const PlateState state = runPlate(true, 1.0, 0.002);
+
+    EXPECT_GT(expected.nBroken, 0);
+    EXPECT_EQ(expected.nBroken, state.nBroken);
+    ASSERT_EQ(expected.particles.size(), state.particles.size());
+    for (const auto &particle : expected.particles) {
+        ASSERT_EQ(1u, state.particles.count(particle.first));
+        const vector<double> &values = state.particles.at(particle.first);
+        for (unsigned int k = 0; k < values.size(); k++) {
+            const double tolerance = 1e-9 * (1 + fabs(particle.second[k]));
+            EXPECT_NEAR(particle.second[k], values[k], tolerance)
+                << "value " << k << " of particle " << particle.first;
+        }
+    }
+}
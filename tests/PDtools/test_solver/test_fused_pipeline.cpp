@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include "latticeplate.h"
+
+#include <map>
+
+using namespace PDtools;
+
+namespace {
+struct PlateState {
+    std::map<int, vector<double>> particles;
+    int nBroken = 0;
+    bool fused = false;
+};
+
+// Runs the plate with the unfused or the fused force and step two pipeline
+// and returns the positions, velocities and forces by id, and the bonds
+// broken. A positive s0 breaks the bonds with the PMB criterion, a positive
+// dampening replaces the bond force by the dampened bond force.
+PlateState runPlate(const bool fused, const double strainRate,
+                    const double s0, const double dampening = 0) {
+    const string savePath = string(TEST_SAVE_PATH) +
+            (fused ? "/fusedPipeline" : "/unfusedPipeline");
+    LatticePlate plate(16, strainRate);
+    VelocityVerletIntegrator integrator;
+    Modifier *fracture = nullptr;
+    if (s0 > 0) {
+        plate.particles.setParameter("s0", s0);
+        fracture = new PmbFracture(0.25);
+    }
+    if (dampening > 0)
+        plate.forces.push_back(
+                    new PD_dampenedBondForce(plate.particles, dampening));
+    plate.setup(integrator, 60, 0.01 * plate.lc, 20, savePath,
+                {"id", "x", "y", "damage"}, fracture);
+    integrator.setFusedPipeline(fused, 32);
+    integrator.solve();
+
+    PlateState state;
+    state.fused = integrator.fusedPipeline();
+    PD_Particles &particles = plate.particles;
+    const ivec &colToId = particles.colToId();
+    const mat &r = particles.r();
+    const mat &v = particles.v();
+    const mat &F = particles.F();
+    const int indexConnected = particles.getPdParamId("connected");
+    for (unsigned int i = 0; i < particles.nParticles(); i++) {
+        vector<double> values;
+        for (int d = 0; d < plate.dim; d++) {
+            values.push_back(r(i, d));
+            values.push_back(v(i, d));
+            values.push_back(F(i, d));
+        }
+        state.particles[colToId(i)] = values;
+
+        for (const auto &con : particles.pdConnections(colToId(i))) {
+            if (con.second[indexConnected] <= 0.5)
+                state.nBroken++;
+        }
+    }
+    return state;
+}
+
+void expectSameState(const PlateState &unfused, const PlateState &fused) {
+    EXPECT_EQ(unfused.nBroken, fused.nBroken);
+    ASSERT_EQ(unfused.particles.size(), fused.particles.size());
+    for (const auto &particle : unfused.particles) {
+        ASSERT_EQ(1u, fused.particles.count(particle.first));
+        const vector<double> &values = fused.particles.at(particle.first);
+        for (unsigned int k = 0; k < values.size(); k++) {
+            EXPECT_DOUBLE_EQ(particle.second[k], values[k])
+                << "value " << k << " of particle " << particle.first;
+        }
+    }
+}
+}
+
+TEST(FUSED_PIPELINE, SAME_RESULT_AS_UNFUSED)
+{
+    const PlateState unfused = runPlate(false, 0.05, 0);
+    const PlateState fused = runPlate(true, 0.05, 0);
+    EXPECT_TRUE(fused.fused);
+    expectSameState(unfused, fused);
+}
+
+TEST(FUSED_PIPELINE, NEIGHBOUR_VELOCITIES_FALL_BACK_TO_UNFUSED)
+{
+    // The dampened bond force reads the velocities of the neighbours, which
+    // the fused sweep has already kicked for the blocks before
+    const PlateState unfused = runPlate(false, 0.05, 0, 0.1);
+    const PlateState fused = runPlate(true, 0.05, 0, 0.1);
+    EXPECT_FALSE(fused.fused);
+    expectSameState(unfused, fused);
+}
+
+TEST(FUSED_PIPELINE, SAME_RESULT_AS_UNFUSED_WITH_FRACTURE)
+{
+    const PlateState unfused = runPlate(false, 1.0, 0.002);
+    const PlateState fused = runPlate(true, 1.0, 0.002);
+    EXPECT_GT(unfused.nBroken, 0);
+    expectSameState(unfused, fused);
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include "latticeplate.h"
+
+#include <map>
+#include <memory>
+
+using namespace PDtools;
+
+namespace {
+struct PlateState {
+    std::map<int, vector<double>> particles;
+    int nBroken = 0;
+};
+
+// Runs the plate with velocity verlet, or with nLevels > 0 the multi-rate
+// integrator, and returns the positions, velocities and forces by id, and
+// the bonds broken. A positive s0 breaks the bonds with the PMB criterion.
+PlateState runPlate(const int nLevels, const double strainRate,
+                    const double s0) {
+    LatticePlate plate(16, strainRate);
+    std::unique_ptr<TimeIntegrator> integrator;
+    if (nLevels > 0)
+        integrator.reset(new MultiRateVerletIntegrator(nLevels));
+    else
+        integrator.reset(new VelocityVerletIntegrator());
+    Modifier *fracture = nullptr;
+    if (s0 > 0) {
+        plate.particles.setParameter("s0", s0);
+        fracture = new PmbFracture(0.25);
+    }
+    const string savePath = string(TEST_SAVE_PATH) +
+            (nLevels > 0 ? "/multiRate" : "/verlet");
+    plate.setup(*integrator, 60, 0.01 * plate.lc, 20, savePath,
+                {"id", "x", "y", "damage"}, fracture);
+    integrator->solve();
+
+    PlateState state;
+    PD_Particles &particles = plate.particles;
+    const ivec &colToId = particles.colToId();
+    const mat &r = particles.r();
+    const mat &v = particles.v();
+    const mat &F = particles.F();
+    const int indexConnected = particles.getPdParamId("connected");
+    for (unsigned int i = 0; i < particles.nParticles(); i++) {
+        vector<double> values;
+        for (int d = 0; d < plate.dim; d++) {
+            values.push_back(r(i, d));
+            values.push_back(v(i, d));
+            values.push_back(F(i, d));
+        }
+        state.particles[colToId(i)] = values;
+
+        for (const auto &con : particles.pdConnections(colToId(i))) {
+            if (con.second[indexConnected] <= 0.5)
+                state.nBroken++;
+        }
+    }
+    return state;
+}
+
+void expectSameState(const PlateState &expected, const PlateState &state) {
+    EXPECT_EQ(expected.nBroken, state.nBroken);
+    ASSERT_EQ(expected.particles.size(), state.particles.size());
+    for (const auto &particle : expected.particles) {
+        ASSERT_EQ(1u, state.particles.count(particle.first));
+        const vector<double> &values = state.particles.at(particle.first);
+        for (unsigned int k = 0; k < values.size(); k++) {
+            EXPECT_DOUBLE_EQ(particle.second[k], values[k])
+                << "value " << k << " of particle " << particle.first;
+        }
+    }
+}
+}
+
+TEST(MULTIRATE, SINGLE_LEVEL_MATCHES_VELOCITY_VERLET)
+{
+    // With one level every particle is kicked and drifted once per step,
+    // as in velocity verlet
+    const PlateState expected = runPlate(0, 0.05, 0);
+    const PlateState state = runPlate(1, 0.05, 0);
+    expectSameState(expected, state);
+}
+
+TEST(MULTIRATE, SINGLE_LEVEL_MATCHES_VELOCITY_VERLET_WITH_FRACTURE)
+{
+    const PlateState expected = runPlate(0, 1.0, 0.002);
+    const PlateState state = runPlate(1, 1.0, 0.002);
+    EXPECT_GT(expected.nBroken, 0);
+    expectSameState(expected, state);
+}
@@ -2,17 +2,25 @@
 #include <vector>
 #include <armadillo>
 #include <stdio.h>
-//#include <gtest/gtest.h>
+#include <gtest/gtest.h>
+#ifdef USE_MPI
+#include <mpi.h>
+#endif
 //#include "test_resources.h"
 
 using namespace std;
 
 int main(int argc, char **argv)
 {
-    (void) argc;
-    (void) argv;
-//    ::testing::InitGoogleTest(&argc, argv);
+#ifdef USE_MPI
+    MPI::Init(argc, argv);
+#endif
+    ::testing::InitGoogleTest(&argc, argv);
 //    ::testing::GTEST_FLAG(filter) = "PD_SOLVER_FIXTURE*";
 //    ::testing::GTEST_FLAG(filter) = "PD_LINEAR_SOLVER_FIXTURE*";
-//    return RUN_ALL_TESTS();
+    const int result = RUN_ALL_TESTS();
+#ifdef USE_MPI
+    MPI::Finalize();
+#endif
+    return result;
 }
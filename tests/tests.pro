@@ -14,6 +14,18 @@ LIBS *= -lgtest
 
 SOURCES += \
     main.cpp \
+    PDtools/particles/test_bonddata.cpp \
+    PDtools/particles/test_idtocolmap.cpp \
+    PDtools/particles/test_particledata.cpp \
+    PDtools/pdfunctions/test_principalstresses.cpp \
+    PDtools/properties/test_propertyscheduler.cpp \
+    PDtools/test_solver/test_adaptive_dt.cpp \
+    PDtools/test_solver/test_bond_break_requests.cpp \
+    PDtools/test_solver/test_bond_events.cpp \
+    PDtools/test_solver/test_bond_fracture_criterion.cpp \
+    PDtools/test_solver/test_ensemble.cpp \
+    PDtools/test_solver/test_fused_pipeline.cpp \
+    PDtools/test_solver/test_multirate.cpp \
 #    PDtools/particles/test_particles.cpp \
 #    PDtools/PD_particles/test_pd_particles.cpp \
 #    PDtools/grid/test_grid.cpp \
@@ -23,7 +35,8 @@ SOURCES += \
 #    PDtools/LinearSolver/linearsolver.cpp \
 #    PDtools/MPI/test_mpi.cpp
 
-#HEADERS += \
+HEADERS += \
+    PDtools/test_solver/latticeplate.h
 #    test_resources.h
 
 #-------------------------------------------------------------------------------